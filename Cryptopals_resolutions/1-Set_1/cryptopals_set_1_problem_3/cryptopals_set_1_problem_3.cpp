@@ -16,9 +16,15 @@
 typedef struct {
   unsigned char charMinDeviation;
   double valMinDeviation;
+  double valMaxLogLikelihood;
 } charXorId;
 
-const int numberEnglishLetters = 26;
+const int numberEnglishLetters = 26, numberByteValues = 256;
+const double englishLetterFrequency[numberEnglishLetters] = {
+    8.2e-2,  1.5e-2,  2.8e-2,   4.3e-2,  13.0e-2, 2.2e-2,  2.0e-2,
+    6.1e-2,  7.0e-2,  0.15e-2,  0.77e-2, 4.0e-2,  2.4e-2,  6.7e-2,
+    7.5e-2,  1.9e-2,  0.095e-2, 6.0e-2,  6.3e-2,  9.1e-2,  2.8e-2,
+    0.98e-2, 2.4e-2,  0.15e-2,  2.0e-2,  0.074e-2};
 const bool printXorStrings = false; /* if true it will print all the test xor
                                        strings into stdout */
 
@@ -36,96 +42,75 @@ error it returns false */
 void xorFunction(const std::vector<unsigned char> &vS1, const unsigned char c,
                  std::vector<unsigned char> &vRes);
 
-/* this function makes the calculation of the frequency of the characters that
-resulted from the xor, in the end it returns true if no error or false otherwise
-*/
-bool calcFrequencyData(const std::vector<unsigned char> &xorTest,
-                       int *freqXorChar);
+/* this function makes the fulling of the table logLikelihood with the log
+probability of every byte value in english text, the letters follow the english
+letter frequency, logLikelihood must have room for numberByteValues values */
+void buildLogLikelihoodTable(double *logLikelihood);
+
+/* this function makes the calculation of the histogram of the bytes of the
+vector v, histogram must have room for numberByteValues values */
+void calcByteHistogram(const std::vector<unsigned char> &v,
+                       unsigned int *histogram);
+
+/* this function scores every single byte key against the histogram, the score
+of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the data is ever built,
+in the end it returns the key with the highest score and that score by
+reference */
+unsigned char getBestXorKey(const unsigned int *histogram,
+                            const double *logLikelihood, double *bestScore);
 
 /* this function makes the calculation of the deviation from the english letter
-frequency, and then it returns the deviation and sets flag to true if no error
-or to false if otherwise */
-double deviationCalc(std::unordered_map<char, float> &englishLetterFrequency,
-                     int *freqXorChar, bool *flag);
+frequency of the data of the histogram once xored with the key, and then it
+returns that deviation */
+double deviationCalc(const unsigned int *histogram, const unsigned char key);
 
 int main() {
   clock_t start, end;
   double time;
   start = clock();
   /* work to verify */
-  std::unordered_map<char, float> englishLetterFrequency = {
-      {'a', 8.2e-2},   {'b', 1.5e-2},  {'c', 2.8e-2},  {'d', 4.3e-2},
-      {'e', 13.0e-2},  {'f', 2.2e-2},  {'g', 2.0e-2},  {'h', 6.1e-2},
-      {'i', 7.0e-2},   {'j', 0.15e-2}, {'k', 0.77e-2}, {'l', 4.0e-2},
-      {'m', 2.4e-2},   {'n', 6.7e-2},  {'o', 7.5e-2},  {'p', 1.9e-2},
-      {'q', 0.095e-2}, {'r', 6.0e-2},  {'s', 6.3e-2},  {'t', 9.1e-2},
-      {'u', 2.8e-2},   {'v', 0.98e-2}, {'w', 2.4e-2},  {'x', 0.15e-2},
-      {'y', 2.0e-2},   {'z', 0.074e-2}};
   std::string sHexEncrypted =
       "1b37373331363f78151b7f2b783431333d78397828372d363c78373e783a393b3736";
   std::string sBytesEncrypted = "", xorTestString;
   std::vector<unsigned char> encryptedBytesAscii =
       decodeHexToByte(sHexEncrypted);
   std::vector<unsigned char> xorTest;
+  unsigned int histogram[numberByteValues];
+  double logLikelihood[numberByteValues];
   charXorId cId;
-  double deviation;
-  bool b;
-  int xorPossibleKeys = pow(2, 8);
-  int *freqXorChar = (int *)calloc(numberEnglishLetters, sizeof(int)), i;
-  if (freqXorChar == nullptr) {
-    perror("\nfreqXorChar calloc failed.");
-    exit(1);
-  }
-  /* charXorId initialization */
-  cId.valMinDeviation = INT_MAX;
+  int xorPossibleKeys = pow(2, 8), i;
+  /* log probability of every byte value in english text */
+  buildLogLikelihoodTable(logLikelihood);
   /* convertion from vector of bytes to string */
   convertVectorBytesToString(encryptedBytesAscii, sBytesEncrypted);
   std::cout << "s(hex) = " << sHexEncrypted
             << ", s(ascii) = " << sBytesEncrypted << "\n"
             << std::endl;
-  /* xor test */
-  for (i = 0; i < xorPossibleKeys; ++i) {
-    /* reset structures */
-    xorTest.clear();
-    memset(freqXorChar, 0, numberEnglishLetters * sizeof(int));
-    xorTestString.clear();
-    /* xor */
-    xorFunction(encryptedBytesAscii, i, xorTest);
-    /* calculate frequency data */
-    b = calcFrequencyData(xorTest, freqXorChar);
-    if (b == false) {
-      perror("\nThere was an error in the function 'calcFrequencyData'");
-      exit(1);
-    }
-    deviation = deviationCalc(englishLetterFrequency, freqXorChar, &b);
-    if (b == false) {
-      perror("\nThere was an error in the function 'deviationCalc'");
-      exit(1);
-    }
-    if (deviation < cId.valMinDeviation) {
-      cId.valMinDeviation = deviation;
-      cId.charMinDeviation = i;
-    }
-    if (printXorStrings == true) {
-      /* convertion from vector of bytes to string */
+  /* xor test, every key is scored against the histogram of the string */
+  calcByteHistogram(encryptedBytesAscii, histogram);
+  cId.charMinDeviation =
+      getBestXorKey(histogram, logLikelihood, &cId.valMaxLogLikelihood);
+  cId.valMinDeviation = deviationCalc(histogram, cId.charMinDeviation);
+  if (printXorStrings == true) {
+    for (i = 0; i < xorPossibleKeys; ++i) {
+      /* reset structures */
+      xorTest.clear();
+      xorTestString.clear();
+      /* xor and convertion from vector of bytes to string */
+      xorFunction(encryptedBytesAscii, i, xorTest);
       convertVectorBytesToString(xorTest, xorTestString);
       std::cout << "xor with char '" << (char)(i) << "' results in string "
                 << xorTestString << "." << std::endl;
     }
   }
-  /* reset structures */
-  xorTest.clear();
-  xorTestString.clear();
   /* get best string available */
   xorFunction(encryptedBytesAscii, cId.charMinDeviation, xorTest);
   convertVectorBytesToString(xorTest, xorTestString);
-  std::cout << "\nMinimum deviation in xor with char '" << cId.charMinDeviation
-            << "' results in the string '" << xorTestString << "'."
-            << std::endl;
-  /* free memory */
-  memset(freqXorChar, 0, numberEnglishLetters * sizeof(int));
-  free(freqXorChar);
-  freqXorChar = nullptr;
+  std::cout << "\nMaximum log-likelihood in xor with char '"
+            << cId.charMinDeviation << "' results in the string '"
+            << xorTestString << "' with deviation " << cId.valMinDeviation
+            << "." << std::endl;
   /* end of the work */
   end = clock();
   time = (double)(end - start) / CLOCKS_PER_SEC;
@@ -183,44 +168,104 @@ void xorFunction(const std::vector<unsigned char> &vS1, const unsigned char c,
   return;
 }
 /******************************************************************************/
-/* this function makes the calculation of the frequency of the characters that
-resulted from the xor, in the end it returns true if no error or false otherwise
-*/
-bool calcFrequencyData(const std::vector<unsigned char> &xorTest,
-                       int *freqXorChar) {
-  if (freqXorChar == nullptr) {
-    return false;
+/* this function makes the fulling of the table logLikelihood with the log
+probability of every byte value in english text, the letters follow the english
+letter frequency, logLikelihood must have room for numberByteValues values */
+void buildLogLikelihoodTable(double *logLikelihood) {
+  /* share of every class of byte in english text */
+  const double lowercaseShare = 0.74, uppercaseShare = 0.04, spaceShare = 0.15,
+               punctuationShare = 0.05, digitShare = 0.01, newlineShare = 0.005,
+               otherPrintableShare = 1e-4, nonPrintableShare = 1e-6;
+  const char *punctuation = ".,;:!?'\"-";
+  double probability[numberByteValues], sum = 0;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    if (i >= 'a' && i <= 'z') {
+      probability[i] = lowercaseShare * englishLetterFrequency[i - 'a'];
+    } else if (i >= 'A' && i <= 'Z') {
+      probability[i] = uppercaseShare * englishLetterFrequency[i - 'A'];
+    } else if (i == ' ') {
+      probability[i] = spaceShare;
+    } else if (i != 0 && strchr(punctuation, i) != nullptr) {
+      probability[i] = punctuationShare / strlen(punctuation);
+    } else if (i >= '0' && i <= '9') {
+      probability[i] = digitShare / 10;
+    } else if (i == '\n') {
+      probability[i] = newlineShare;
+    } else if (i > ' ' && i < 0x7f) {
+      probability[i] = otherPrintableShare;
+    } else {
+      probability[i] = nonPrintableShare;
+    }
+    sum += probability[i];
   }
-  int i, size = xorTest.size();
-  unsigned char testChar;
+  for (i = 0; i < numberByteValues; ++i) {
+    logLikelihood[i] = log(probability[i] / sum);
+  }
+  return;
+}
+/******************************************************************************/
+/* this function makes the calculation of the histogram of the bytes of the
+vector v, histogram must have room for numberByteValues values */
+void calcByteHistogram(const std::vector<unsigned char> &v,
+                       unsigned int *histogram) {
+  int i, size = v.size();
+  memset(histogram, 0, numberByteValues * sizeof(unsigned int));
   for (i = 0; i < size; ++i) {
-    testChar = tolower(xorTest[i]);
-    if (testChar >= 'a' && testChar <= 'z') {
-      ++freqXorChar[testChar - 'a'];
+    ++histogram[v[i]];
+  }
+  return;
+}
+/******************************************************************************/
+/* this function scores every single byte key against the histogram, the score
+of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the data is ever built,
+in the end it returns the key with the highest score and that score by
+reference */
+unsigned char getBestXorKey(const unsigned int *histogram,
+                            const double *logLikelihood, double *bestScore) {
+  double scores[numberByteValues] = {0}, count;
+  unsigned char bestKey = 0;
+  int i, key;
+  /* only the byte values present in the data take part in the score, the keys
+  are the inner loop so that their sums do not wait on each other */
+  for (i = 0; i < numberByteValues; ++i) {
+    if (histogram[i] != 0) {
+      count = histogram[i];
+      for (key = 0; key < numberByteValues; ++key) {
+        scores[key] += count * logLikelihood[i ^ key];
+      }
     }
   }
-  return true;
+  for (key = 1; key < numberByteValues; ++key) {
+    if (scores[key] > scores[bestKey]) {
+      bestKey = key;
+    }
+  }
+  *bestScore = scores[bestKey];
+  return bestKey;
 }
 /******************************************************************************/
 /* this function makes the calculation of the deviation from the english letter
-frequency, and then it returns the deviation and sets flag to true if no error
-or to false if otherwise */
-double deviationCalc(std::unordered_map<char, float> &englishLetterFrequency,
-                     int *freqXorChar, bool *flag) {
-  if (freqXorChar == nullptr || flag == nullptr) {
-    *flag = false;
-    return 0;
-  }
-  int nSamples = 0, i;
-  double deviation = 0;
-  for (i = 0; i < numberEnglishLetters; ++i) {
-    nSamples += freqXorChar[i];
+frequency of the data of the histogram once xored with the key, and then it
+returns that deviation */
+double deviationCalc(const unsigned int *histogram, const unsigned char key) {
+  unsigned int freqXorChar[numberEnglishLetters] = {0}, nSamples = 0;
+  unsigned char testChar;
+  double deviation = 0, frequency;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    testChar = tolower(i ^ key);
+    if (testChar >= 'a' && testChar <= 'z') {
+      freqXorChar[testChar - 'a'] += histogram[i];
+      nSamples += histogram[i];
+    }
   }
   for (i = 0; i < numberEnglishLetters; ++i) {
-    deviation += fabs(static_cast<double>(freqXorChar[i]) / nSamples -
-                      englishLetterFrequency['a' + i]);
+    frequency =
+        nSamples == 0 ? 0 : static_cast<double>(freqXorChar[i]) / nSamples;
+    deviation += fabs(frequency - englishLetterFrequency[i]);
   }
-  *flag = true;
   return deviation;
 }
 /******************************************************************************/
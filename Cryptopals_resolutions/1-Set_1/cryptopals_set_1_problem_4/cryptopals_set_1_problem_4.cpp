@@ -3,6 +3,7 @@
 #include <cctype>
 #include <cstddef>
 #include <ctype.h>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <math.h>
@@ -10,7 +11,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
 #include <time.h>
+#include <unistd.h>
 #include <unordered_map>
 #include <vector>
 
@@ -18,6 +23,7 @@ typedef struct {
   unsigned char charMinDeviation;
   double valMinDeviation;
   double valMaxRatioLettersSpace;
+  double valMaxLogLikelihood;
 } charXorId;
 
 typedef struct {
@@ -29,9 +35,34 @@ typedef struct {
   charXorId charId;
 } lineChangedId;
 
-const int numberEnglishLetters = 26;
-const bool printContentFile = false; /* if true it will print the content of the
-                                      "4.txt" file */
+typedef struct {
+  double score; /* log-likelihood per byte once xored with key */
+  unsigned char key;
+  int chunk;
+  long lineNumber; /* inside its chunk until the chunks are merged */
+  std::string lineHex;
+} lineScoreId;
+
+/* order of the bounded heap of the best lines, the worst line at the front */
+struct lineScoreGreater {
+  bool operator()(const lineScoreId &l1, const lineScoreId &l2) const {
+    return l1.score > l2.score;
+  }
+};
+
+const int numberEnglishLetters = 26, numberByteValues = 256;
+const double englishLetterFrequency[numberEnglishLetters] = {
+    8.2e-2,  1.5e-2,  2.8e-2,   4.3e-2,  13.0e-2, 2.2e-2,  2.0e-2,
+    6.1e-2,  7.0e-2,  0.15e-2,  0.77e-2, 4.0e-2,  2.4e-2,  6.7e-2,
+    7.5e-2,  1.9e-2,  0.095e-2, 6.0e-2,  6.3e-2,  9.1e-2,  2.8e-2,
+    0.98e-2, 2.4e-2,  0.15e-2,  2.0e-2,  0.074e-2};
+const char *datasetFileName = "cryptopals_set_1_problem_4_dataset.txt";
+const std::size_t topLinesToReport = 5; /* size of the ranking of the lines
+                                           most likely to be xored english */
+
+/* this function returns the value of the hexadecimal character c, in lower or
+upper case, or -1 if c is not an hexadecimal character */
+int decodeHexNibble(const char c);
 
 /* this function does the decode from hexadecimal into bytes, returning the
 result in a vector of unsigned char */
@@ -47,83 +78,115 @@ error it returns false */
 void xorFunction(const std::vector<unsigned char> &vS1, const unsigned char c,
                  std::vector<unsigned char> &vRes);
 
-/* this function makes the calculation of the frequency of the characters that
-resulted from the xor, in the end it returns true if no error or false otherwise
-*/
-bool calcFrequencyData(const std::vector<unsigned char> &xorTest,
-                       int *freqXorChar);
+/* this function makes the fulling of the table logLikelihood with the log
+probability of every byte value in english text, the letters follow the english
+letter frequency, logLikelihood must have room for numberByteValues values */
+void buildLogLikelihoodTable(double *logLikelihood);
+
+/* this function makes the calculation of the histogram of the bytes of the
+vector v, histogram must have room for numberByteValues values */
+void calcByteHistogram(const std::vector<unsigned char> &v,
+                       unsigned int *histogram);
+
+/* this function scores every single byte key against the histogram, the score
+of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the data is ever built,
+in the end it returns the key with the highest score and that score by
+reference */
+unsigned char getBestXorKey(const unsigned int *histogram,
+                            const double *logLikelihood, double *bestScore);
 
 /* this function makes the calculation of the deviation from the english letter
-frequency, and then it returns the deviation and sets flag to true if no error
-or to false if otherwise */
-double deviationCalc(std::unordered_map<char, float> &englishLetterFrequency,
-                     int *freqXorChar, bool *flag);
+frequency of the data of the histogram once xored with the key, and then it
+returns that deviation */
+double deviationCalc(const unsigned int *histogram, const unsigned char key);
 
 /* this function makes the calculation of the ratio between all the english
-and spaces compared to the length of the message, and sets flag to true if no
-error or to false if otherwise */
-double ratioCalc(const std::vector<unsigned char> &xorTest, bool *flag);
+letters and spaces compared to the number of bytes of the histogram, once xored
+with the key */
+double ratioCalc(const unsigned int *histogram, const unsigned char key);
+
+/* this function decodes the hexadecimal line [begin, end), without its end of
+line, straight from the input into the histogram of its bytes, without building
+the decoded line, it returns true if the line is a non empty hexadecimal
+string, false otherwise */
+bool decodeHexLineToHistogram(const char *begin, const char *end,
+                              unsigned int *histogram);
+
+/* this function adds the line to the bounded heap bestLines, that keeps the
+topK lines with the highest score and has the worst of them at the front */
+void updateBestLines(std::vector<lineScoreId> &bestLines, lineScoreId &line,
+                     const std::size_t topK);
 
-/* this function for a given line in binary, it will do a xor test with a single
-english alphabet character, determine the best fit, based on the least deviation
-from the english letter frequency, and if this is the best fit it will also
-update the structure lineChangedId, in the end it returns true if no error or
-false otherwise */
-bool testCharactersXor(lineChangedId &lineChangedIdData,
-                       std::unordered_map<char, float> &englishLetterFrequency,
-                       const std::vector<unsigned char> &lineReadBinary,
-                       const std::string &lineReadHex, const int lineNumber);
+/* this function scores every line of the chunk [begin, end) of the input, the
+chunk starts at the beginning of a line, in the end it returns the topK lines
+with the highest score in bestLines and the number of lines of the chunk by
+reference */
+void scanChunk(const char *begin, const char *end, const int chunk,
+               const double *logLikelihood, const std::size_t topK,
+               std::vector<lineScoreId> &bestLines, long *nLines);
 
-int main() {
+/* this function memory maps the file fileName, splits it on line boundaries
+between the available threads and returns in bestLines the topK lines of the
+whole file with the highest log-likelihood per byte once xored with their best
+single byte key, sorted from the best line, it returns true if all ok or false
+otherwise */
+bool detectSingleCharacterXor(const char *fileName,
+                              const double *logLikelihood,
+                              const std::size_t topK,
+                              std::vector<lineScoreId> &bestLines);
+
+int main(int argc, char *argv[]) {
   clock_t start, end;
   double time;
   start = clock();
   /* work to verify */
-  std::unordered_map<char, float> englishLetterFrequency = {
-      {'a', 8.2e-2},   {'b', 1.5e-2},  {'c', 2.8e-2},  {'d', 4.3e-2},
-      {'e', 13.0e-2},  {'f', 2.2e-2},  {'g', 2.0e-2},  {'h', 6.1e-2},
-      {'i', 7.0e-2},   {'j', 0.15e-2}, {'k', 0.77e-2}, {'l', 4.0e-2},
-      {'m', 2.4e-2},   {'n', 6.7e-2},  {'o', 7.5e-2},  {'p', 1.9e-2},
-      {'q', 0.095e-2}, {'r', 6.0e-2},  {'s', 6.3e-2},  {'t', 9.1e-2},
-      {'u', 2.8e-2},   {'v', 0.98e-2}, {'w', 2.4e-2},  {'x', 0.15e-2},
-      {'y', 2.0e-2},   {'z', 0.074e-2}};
-  std::ifstream inputFile;
-  inputFile.open("cryptopals_set_1_problem_4_dataset.txt", std::ios::in);
-  std::string lineReadHex, lineReadBinary;
-  std::vector<unsigned char> encryptedBytesAscii;
+  std::vector<lineScoreId> bestLines;
+  std::vector<unsigned char> xorTest;
   lineChangedId lineChangedIdData = {};
-  int i = 1;
+  double logLikelihood[numberByteValues];
+  unsigned int histogram[numberByteValues];
+  std::size_t i;
+  const char *fileName = argc > 1 ? argv[1] : datasetFileName;
   bool b;
-  if (!inputFile) {
+  /* log probability of every byte value in english text */
+  buildLogLikelihoodTable(logLikelihood);
+  b = detectSingleCharacterXor(fileName, logLikelihood,
+                               topLinesToReport, bestLines);
+  if (b == false) {
     perror("File failed to be opened.");
     exit(1);
   } else {
-    std::cout << "The file '4.txt' was sucessfully opened." << std::endl;
+    std::cout << "The file '" << fileName << "' was sucessfully scanned."
+              << std::endl;
   }
-  if (printContentFile == true) {
-    std::cout << "\nFile content:\n" << std::endl;
+  if (bestLines.size() == 0) {
+    std::cout << "The file '" << fileName << "' has no hexadecimal lines."
+              << std::endl;
+    exit(1);
   }
-  while (inputFile.good() == true) {
-    lineReadHex.clear();
-    lineReadBinary.clear();
-    std::getline(inputFile, lineReadHex);
-    encryptedBytesAscii = decodeHexToByte(lineReadHex);
-    convertVectorBytesToString(encryptedBytesAscii, lineReadBinary);
-    if (printContentFile == true) {
-      std::cout << "File | Hex | line " << i << " | " << lineReadHex
-                << std::endl;
-      std::cout << "File | Bin | line " << i << " | " << lineReadBinary
-                << std::endl;
-    }
-    ++i;
-    b = testCharactersXor(lineChangedIdData, englishLetterFrequency,
-                          encryptedBytesAscii, lineReadHex, i);
-    if (b == false) {
-      perror("\nThere was an error in the function 'testCharactersXor'.");
-      exit(1);
-    }
+  std::cout << "\nBest " << bestLines.size() << " lines:" << std::endl;
+  for (i = 0; i < bestLines.size(); ++i) {
+    printf("line %ld | key %.2x | log-likelihood per byte %f\n",
+           bestLines[i].lineNumber, bestLines[i].key, bestLines[i].score);
   }
-  inputFile.close();
+  printf("\n");
+  /* decode the best line */
+  lineChangedIdData.lineChangedHexEncoded = bestLines[0].lineHex;
+  lineChangedIdData.lineChangedBinaryEncoded =
+      decodeHexToByte(bestLines[0].lineHex);
+  xorFunction(lineChangedIdData.lineChangedBinaryEncoded, bestLines[0].key,
+              lineChangedIdData.lineChangedBinaryDecoded);
+  convertVectorBytesToString(lineChangedIdData.lineChangedBinaryDecoded,
+                             lineChangedIdData.lineChangedBinaryDecodedString);
+  calcByteHistogram(lineChangedIdData.lineChangedBinaryEncoded, histogram);
+  lineChangedIdData.lineNumber = bestLines[0].lineNumber;
+  lineChangedIdData.charId.charMinDeviation = bestLines[0].key;
+  lineChangedIdData.charId.valMaxLogLikelihood = bestLines[0].score;
+  lineChangedIdData.charId.valMinDeviation =
+      deviationCalc(histogram, bestLines[0].key);
+  lineChangedIdData.charId.valMaxRatioLettersSpace =
+      ratioCalc(histogram, bestLines[0].key);
   std::cout << "Line changed was line number: " << lineChangedIdData.lineNumber
             << " with:\noriginal Hex value | '"
             << lineChangedIdData.lineChangedHexEncoded
@@ -147,24 +210,26 @@ std::vector<unsigned char> decodeHexToByte(std::string &s) {
     s.push_back('0');
   }
   std::vector<unsigned char> output;
-  unsigned char c;
   size_t size = s.size(), i;
   for (i = 0; i < size; i += 2) {
-    if (s[i] >= 'a') {
-      c = (10 + s[i] - 'a') * 16;
-    } else {
-      c = (s[i] - '0') * 16;
-    }
-    if (s[i + 1] >= 'a') {
-      c += 10 + s[i + 1] - 'a';
-    } else {
-      c += s[i + 1] - '0';
-    }
-    output.emplace_back(c);
+    output.emplace_back(decodeHexNibble(s[i]) * 16 + decodeHexNibble(s[i + 1]));
   }
   return output;
 }
 /******************************************************************************/
+/* this function returns the value of the hexadecimal character c, in lower or
+upper case, or -1 if c is not an hexadecimal character */
+int decodeHexNibble(const char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return 10 + c - 'a';
+  } else if (c >= 'A' && c <= 'F') {
+    return 10 + c - 'A';
+  }
+  return -1;
+}
+/******************************************************************************/
 /* this function makes the fulling of the string s based on the content of the
 vector v */
 void convertVectorBytesToString(const std::vector<unsigned char> &v,
@@ -187,147 +252,277 @@ void xorFunction(const std::vector<unsigned char> &vS1, const unsigned char c,
   return;
 }
 /******************************************************************************/
-/* this function makes the calculation of the frequency of the characters that
-resulted from the xor, in the end it returns true if no error or false otherwise
-*/
-bool calcFrequencyData(const std::vector<unsigned char> &xorTest,
-                       int *freqXorChar) {
-  if (freqXorChar == nullptr) {
-    return false;
+/* this function makes the fulling of the table logLikelihood with the log
+probability of every byte value in english text, the letters follow the english
+letter frequency, logLikelihood must have room for numberByteValues values */
+void buildLogLikelihoodTable(double *logLikelihood) {
+  /* share of every class of byte in english text */
+  const double lowercaseShare = 0.74, uppercaseShare = 0.04, spaceShare = 0.15,
+               punctuationShare = 0.05, digitShare = 0.01, newlineShare = 0.005,
+               otherPrintableShare = 1e-4, nonPrintableShare = 1e-6;
+  const char *punctuation = ".,;:!?'\"-";
+  double probability[numberByteValues], sum = 0;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    if (i >= 'a' && i <= 'z') {
+      probability[i] = lowercaseShare * englishLetterFrequency[i - 'a'];
+    } else if (i >= 'A' && i <= 'Z') {
+      probability[i] = uppercaseShare * englishLetterFrequency[i - 'A'];
+    } else if (i == ' ') {
+      probability[i] = spaceShare;
+    } else if (i != 0 && strchr(punctuation, i) != nullptr) {
+      probability[i] = punctuationShare / strlen(punctuation);
+    } else if (i >= '0' && i <= '9') {
+      probability[i] = digitShare / 10;
+    } else if (i == '\n') {
+      probability[i] = newlineShare;
+    } else if (i > ' ' && i < 0x7f) {
+      probability[i] = otherPrintableShare;
+    } else {
+      probability[i] = nonPrintableShare;
+    }
+    sum += probability[i];
   }
-  int i, size = xorTest.size();
-  unsigned char testChar;
+  for (i = 0; i < numberByteValues; ++i) {
+    logLikelihood[i] = log(probability[i] / sum);
+  }
+  return;
+}
+/******************************************************************************/
+/* this function makes the calculation of the histogram of the bytes of the
+vector v, histogram must have room for numberByteValues values */
+void calcByteHistogram(const std::vector<unsigned char> &v,
+                       unsigned int *histogram) {
+  int i, size = v.size();
+  memset(histogram, 0, numberByteValues * sizeof(unsigned int));
   for (i = 0; i < size; ++i) {
-    testChar = tolower(xorTest[i]);
-    if (testChar >= 'a' && testChar <= 'z') {
-      ++freqXorChar[testChar - 'a'];
+    ++histogram[v[i]];
+  }
+  return;
+}
+/******************************************************************************/
+/* this function scores every single byte key against the histogram, the score
+of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the data is ever built,
+in the end it returns the key with the highest score and that score by
+reference */
+unsigned char getBestXorKey(const unsigned int *histogram,
+                            const double *logLikelihood, double *bestScore) {
+  double scores[numberByteValues] = {0}, count;
+  unsigned char bestKey = 0;
+  int i, key;
+  /* only the byte values present in the data take part in the score, the keys
+  are the inner loop so that their sums do not wait on each other */
+  for (i = 0; i < numberByteValues; ++i) {
+    if (histogram[i] != 0) {
+      count = histogram[i];
+      for (key = 0; key < numberByteValues; ++key) {
+        scores[key] += count * logLikelihood[i ^ key];
+      }
     }
   }
-  return true;
+  for (key = 1; key < numberByteValues; ++key) {
+    if (scores[key] > scores[bestKey]) {
+      bestKey = key;
+    }
+  }
+  *bestScore = scores[bestKey];
+  return bestKey;
 }
 /******************************************************************************/
 /* this function makes the calculation of the deviation from the english letter
-frequency, and then it returns the deviation and sets flag to true if no error
-or to false if otherwise */
-double deviationCalc(std::unordered_map<char, float> &englishLetterFrequency,
-                     int *freqXorChar, bool *flag) {
-  if (freqXorChar == nullptr || flag == nullptr) {
-    *flag = false;
-    return 0;
-  }
-  int nSamples = 0, i;
-  double deviation = 0;
-  for (i = 0; i < numberEnglishLetters; ++i) {
-    nSamples += freqXorChar[i];
+frequency of the data of the histogram once xored with the key, and then it
+returns that deviation */
+double deviationCalc(const unsigned int *histogram, const unsigned char key) {
+  unsigned int freqXorChar[numberEnglishLetters] = {0}, nSamples = 0;
+  unsigned char testChar;
+  double deviation = 0, frequency;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    testChar = tolower(i ^ key);
+    if (testChar >= 'a' && testChar <= 'z') {
+      freqXorChar[testChar - 'a'] += histogram[i];
+      nSamples += histogram[i];
+    }
   }
   for (i = 0; i < numberEnglishLetters; ++i) {
-    deviation += fabs(static_cast<double>(freqXorChar[i]) / nSamples -
-                      englishLetterFrequency['a' + i]);
+    frequency =
+        nSamples == 0 ? 0 : static_cast<double>(freqXorChar[i]) / nSamples;
+    deviation += fabs(frequency - englishLetterFrequency[i]);
   }
-  *flag = true;
   return deviation;
 }
 /******************************************************************************/
 /* this function makes the calculation of the ratio between all the english
-and spaces compared to the length of the message, and sets flag to true if no
-error or to false if otherwise */
-double ratioCalc(const std::vector<unsigned char> &xorTest, bool *flag) {
-  if (xorTest.size() == 0) {
-    *flag = false;
-    return 0;
-  }
-  int i, size = xorTest.size(), nLettersAndSpaces = 0;
-  for (i = 0; i < size; ++i) {
-    if (xorTest[i] == ' ' ||
-        (tolower(xorTest[i]) >= 'a' && tolower(xorTest[i]) <= 'z')) {
-      ++nLettersAndSpaces;
+letters and spaces compared to the number of bytes of the histogram, once xored
+with the key */
+double ratioCalc(const unsigned int *histogram, const unsigned char key) {
+  unsigned int nBytes = 0, nLettersAndSpaces = 0;
+  unsigned char testChar;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    nBytes += histogram[i];
+    testChar = i ^ key;
+    if (testChar == ' ' || isalpha(testChar)) {
+      nLettersAndSpaces += histogram[i];
     }
   }
-  *flag = true;
-  return static_cast<double>(nLettersAndSpaces) / size;
+  if (nBytes == 0) {
+    return 0;
+  }
+  return static_cast<double>(nLettersAndSpaces) / nBytes;
 }
 /******************************************************************************/
-/* this function for a given line in binary, it will do a xor test with a single
-english alphabet character, determine the best fit, based on the least deviation
-from the english letter frequency, and if this is the best fit it will also
-update the structure lineChangedId, in the end it returns true if no error or
-false otherwise */
-bool testCharactersXor(lineChangedId &lineChangedIdData,
-                       std::unordered_map<char, float> &englishLetterFrequency,
-                       const std::vector<unsigned char> &lineReadBinary,
-                       const std::string &lineReadHex, const int lineNumber) {
-  if (lineReadBinary.size() == 0) {
-    perror("\nlineReadBinary has size 0, error.");
-    return false;
-  }
-  int i, xorPossibleKeys = pow(2, 8);
-  bool b;
-  double deviation, ratioLetters;
-  std::vector<unsigned char> xorTest;
-  std::string xorTestString;
-  int *freqXorChar = (int *)calloc(numberEnglishLetters, sizeof(int));
-  if (freqXorChar == nullptr) {
-    perror("\nfreqXorChar calloc failed.");
+/* this function decodes the hexadecimal line [begin, end), without its end of
+line, straight from the input into the histogram of its bytes, without building
+the decoded line, it returns true if the line is a non empty hexadecimal
+string, false otherwise */
+bool decodeHexLineToHistogram(const char *begin, const char *end,
+                              unsigned int *histogram) {
+  int nibble[2];
+  const char *p;
+  int i;
+  if (begin == end) {
     return false;
   }
-  /* xor test */
-  for (i = 0; i < xorPossibleKeys; ++i) {
-    /* reset structures */
-    xorTest.clear();
-    memset(freqXorChar, 0, numberEnglishLetters * sizeof(int));
-    xorTestString.clear();
-    /* xor */
-    xorFunction(lineReadBinary, i, xorTest);
-    /* calculate frequency data */
-    b = calcFrequencyData(xorTest, freqXorChar);
-    if (b == false) {
-      perror("\nThere was an error in the function 'calcFrequencyData'");
-      return false;
+  memset(histogram, 0, numberByteValues * sizeof(unsigned int));
+  for (p = begin; p < end; p += 2) {
+    for (i = 0; i < 2; ++i) {
+      /* zero padding */
+      nibble[i] = p + i == end ? 0 : decodeHexNibble(p[i]);
+      if (nibble[i] < 0) {
+        return false;
+      }
     }
-    deviation = deviationCalc(englishLetterFrequency, freqXorChar, &b);
-    if (b == false) {
-      perror("\nThere was an error in the function 'deviationCalc'");
-      exit(1);
+    ++histogram[nibble[0] * 16 + nibble[1]];
+  }
+  return true;
+}
+/******************************************************************************/
+/* this function adds the line to the bounded heap bestLines, that keeps the
+topK lines with the highest score and has the worst of them at the front */
+void updateBestLines(std::vector<lineScoreId> &bestLines, lineScoreId &line,
+                     const std::size_t topK) {
+  bestLines.emplace_back(std::move(line));
+  std::push_heap(bestLines.begin(), bestLines.end(), lineScoreGreater());
+  if (bestLines.size() > topK) {
+    std::pop_heap(bestLines.begin(), bestLines.end(), lineScoreGreater());
+    bestLines.pop_back();
+  }
+  return;
+}
+/******************************************************************************/
+/* this function scores every line of the chunk [begin, end) of the input, the
+chunk starts at the beginning of a line, in the end it returns the topK lines
+with the highest score in bestLines and the number of lines of the chunk by
+reference */
+void scanChunk(const char *begin, const char *end, const int chunk,
+               const double *logLikelihood, const std::size_t topK,
+               std::vector<lineScoreId> &bestLines, long *nLines) {
+  unsigned int histogram[numberByteValues];
+  const char *lineEnd, *hexEnd;
+  lineScoreId line;
+  unsigned char key;
+  double score;
+  long lineNumber = 0;
+  while (begin < end) {
+    lineEnd = static_cast<const char *>(memchr(begin, '\n', end - begin));
+    if (lineEnd == nullptr) {
+      lineEnd = end;
     }
-    ratioLetters = ratioCalc(xorTest, &b);
-    if (b == false) {
-      perror("\nThere was an error in the function 'ratioCalc'");
-      exit(1);
+    /* lines written on windows end in "\r\n" */
+    hexEnd = lineEnd;
+    if (hexEnd != begin && *(hexEnd - 1) == '\r') {
+      --hexEnd;
     }
-    if (lineChangedIdData.lineNumber == 0 ||
-        ratioLetters > lineChangedIdData.charId.valMaxRatioLettersSpace) {
-      lineChangedIdData.lineChangedHexEncoded.clear();
-      lineChangedIdData.lineChangedHexEncoded = lineReadHex;
-      lineChangedIdData.lineChangedBinaryEncoded.clear();
-      lineChangedIdData.lineChangedBinaryEncoded = lineReadBinary;
-      lineChangedIdData.lineChangedBinaryDecoded.clear();
-      lineChangedIdData.lineChangedBinaryDecoded = xorTest;
-      lineChangedIdData.lineChangedBinaryDecodedString.clear();
-      convertVectorBytesToString(
-          lineChangedIdData.lineChangedBinaryDecoded,
-          lineChangedIdData.lineChangedBinaryDecodedString);
-      lineChangedIdData.lineNumber = lineNumber;
-      lineChangedIdData.charId.valMinDeviation = deviation;
-      lineChangedIdData.charId.charMinDeviation = i;
-      lineChangedIdData.charId.valMaxRatioLettersSpace = ratioLetters;
-      if (printContentFile == true) {
-        std::cout << "\n###Updated line changed was line number: "
-                  << lineChangedIdData.lineNumber
-                  << " with:\noriginal Hex value | "
-                  << lineChangedIdData.lineChangedHexEncoded
-                  << " and with \ndecoded Ascii value | "
-                  << lineChangedIdData.lineChangedBinaryDecodedString
-                  << "\nresulted from xor with character "
-                  << lineChangedIdData.charId.charMinDeviation << ".\n"
-                  << std::endl;
+    if (decodeHexLineToHistogram(begin, hexEnd, histogram) == true) {
+      key = getBestXorKey(histogram, logLikelihood, &score);
+      /* normalization by the number of bytes of the line, so that lines of
+      different sizes can be compared */
+      score /= (hexEnd - begin + 1) / 2;
+      /* the line is only copied if it makes it into the heap */
+      if (bestLines.size() < topK || score > bestLines.front().score) {
+        line.score = score;
+        line.key = key;
+        line.chunk = chunk;
+        line.lineNumber = lineNumber;
+        line.lineHex.assign(begin, hexEnd);
+        updateBestLines(bestLines, line, topK);
       }
     }
+    ++lineNumber;
+    begin = lineEnd + 1;
+  }
+  *nLines = lineNumber;
+  return;
+}
+/******************************************************************************/
+/* this function memory maps the file fileName, splits it on line boundaries
+between the available threads and returns in bestLines the topK lines of the
+whole file with the highest log-likelihood per byte once xored with their best
+single byte key, sorted from the best line, it returns true if all ok or false
+otherwise */
+bool detectSingleCharacterXor(const char *fileName,
+                              const double *logLikelihood,
+                              const std::size_t topK,
+                              std::vector<lineScoreId> &bestLines) {
+  struct stat fileStat;
+  int fd = open(fileName, O_RDONLY), i, nChunks;
+  bestLines.clear();
+  if (fd < 0) {
+    return false;
+  }
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
+    return false;
+  }
+  std::size_t size = fileStat.st_size, position;
+  if (size == 0 || topK == 0) {
+    close(fd);
+    return true;
+  }
+  void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  madvise(map, size, MADV_SEQUENTIAL);
+  const char *data = static_cast<const char *>(map), *next;
+  nChunks = std::max(1u, std::thread::hardware_concurrency());
+  /* every chunk ends right after a new line, or at the end of the file */
+  std::vector<const char *> boundaries(nChunks + 1, data + size);
+  boundaries[0] = data;
+  for (i = 1; i < nChunks; ++i) {
+    position = std::max(size * i / nChunks,
+                        static_cast<std::size_t>(boundaries[i - 1] - data));
+    next = static_cast<const char *>(
+        memchr(data + position, '\n', size - position));
+    boundaries[i] = next == nullptr ? data + size : next + 1;
+  }
+  std::vector<std::vector<lineScoreId>> chunkBestLines(nChunks);
+  std::vector<long> chunkLines(nChunks, 0), firstLine(nChunks, 1);
+  std::vector<std::thread> workers;
+  for (i = 0; i < nChunks; ++i) {
+    workers.emplace_back(scanChunk, boundaries[i], boundaries[i + 1], i,
+                         logLikelihood, topK, std::ref(chunkBestLines[i]),
+                         &chunkLines[i]);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  munmap(map, size);
+  /* the line numbers of every chunk start after the lines of the previous
+  chunks */
+  for (i = 1; i < nChunks; ++i) {
+    firstLine[i] = firstLine[i - 1] + chunkLines[i - 1];
+  }
+  for (i = 0; i < nChunks; ++i) {
+    for (lineScoreId &line : chunkBestLines[i]) {
+      line.lineNumber += firstLine[i];
+      updateBestLines(bestLines, line, topK);
+    }
   }
-  /* free memory */
-  memset(freqXorChar, 0, numberEnglishLetters * sizeof(int));
-  free(freqXorChar);
-  freqXorChar = nullptr;
-  /* return no error status */
+  std::sort_heap(bestLines.begin(), bestLines.end(), lineScoreGreater());
   return true;
 }
 /******************************************************************************/
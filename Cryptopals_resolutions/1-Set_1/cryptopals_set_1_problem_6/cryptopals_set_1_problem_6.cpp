@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <atomic>
 #include <bits/stdc++.h>
 #include <cctype>
 #include <cstddef>
@@ -10,6 +11,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <thread>
 #include <time.h>
 #include <unordered_map>
 #include <vector>
@@ -19,10 +21,14 @@ const std::string base64CharsDecoder =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 const bool debugFlag = false;
 const int validKeyPoolSearch = 4;
+const double multipleKeySizeTolerance = 0.2; /* relative edit distance above
+                                                the best key length allowed to
+                                                its divisors */
 
 struct keyId {
   int keyLength;
   double editDistance;
+  double confidence; /* standard deviations below the mean edit distance */
 
   bool operator<(const struct keyId &k) const {
     return (editDistance < k.editDistance);
@@ -33,6 +39,7 @@ typedef struct {
   unsigned char charMinDeviation;
   double valMinDeviation;
   double valMaxRatioLettersSpace;
+  double valMaxLogLikelihood;
 } charXorId;
 
 typedef struct {
@@ -43,27 +50,40 @@ typedef struct {
 } lineChangedId;
 
 typedef struct {
-  double valMaxRatioLettersSpaceMean;
+  double valMaxLogLikelihoodMean;
   int keySize;
   std::vector<unsigned char> key;
 } bestKeyId;
 
-const int numberEnglishLetters = 26;
+const int numberEnglishLetters = 26, numberByteValues = 256;
+const double englishLetterFrequency[numberEnglishLetters] = {
+    8.2e-2,  1.5e-2,  2.8e-2,   4.3e-2,  13.0e-2, 2.2e-2,  2.0e-2,
+    6.1e-2,  7.0e-2,  0.15e-2,  0.77e-2, 4.0e-2,  2.4e-2,  6.7e-2,
+    7.5e-2,  1.9e-2,  0.095e-2, 6.0e-2,  6.3e-2,  9.1e-2,  2.8e-2,
+    0.98e-2, 2.4e-2,  0.15e-2,  2.0e-2,  0.074e-2};
 const int minKeySize = 2, maxKeySize = 40;
+const int maxKeySizeShortTextCheck = 300; /* far beyond the size of the text */
 
 /* this function makes the conversion from a string into a vector of bytes,
 in the end it just returns*/
 void convertStringToVectorBytes(const std::string &s,
                                 std::vector<unsigned char> &v);
 
-/* this function makes the calculation of the hamming distance between v1 and
-v2, if there is an error it returns b = false, true otherwise by reference */
-int calcHammingDistance(const std::vector<unsigned char> &v1,
-                        const std::vector<unsigned char> &v2, bool *b);
+/* this function makes the calculation of the hamming distance between the size
+bytes of p1 and of p2, 8 bytes at a time with a 64 bit popcount, dispatching to
+the popcnt instruction when the cpu supports it, in the end it just returns
+that distance */
+unsigned long long calcHammingDistance(const unsigned char *p1,
+                                       const unsigned char *p2,
+                                       std::size_t size);
 
-/* this function makes the calculation of the bits on in the char c, in the end
-it just returns that number */
-int calcBitsOn(unsigned char c);
+/* popcnt and portable kernels of calcHammingDistance */
+unsigned long long calcHammingDistancePopcnt(const unsigned char *p1,
+                                             const unsigned char *p2,
+                                             std::size_t size);
+unsigned long long calcHammingDistancePortable(const unsigned char *p1,
+                                               const unsigned char *p2,
+                                               std::size_t size);
 
 /* this function does the decode from base64 into bytes, returning the
 result in a vector of unsigned char by reference, if all is ok it will be also
@@ -78,8 +98,13 @@ void convertVectorBytesToString(const std::vector<unsigned char> &v,
                                 std::string &s);
 
 /* this function makes fulling of the vector keyL for every length of the key,
-orders the vector in ascending order by the editDistance and returns true if all
-ok, false otherwise */
+the edit distance of a key length is the hamming distance between the text and
+itself shifted by that length, per byte of overlap, so every block is compared
+with the next one, the key lengths are shared between the available threads,
+each key length also gets a confidence, the number of standard deviations its
+edit distance is below the mean of the range, in the end it orders the vector in
+ascending order by the editDistance and returns true if all ok, false
+otherwise */
 bool getKeyLengthProfileSorted(
     std::vector<unsigned char> &encryptedBytesAsciiFullText,
     std::vector<struct keyId> &keyL, int minKeySizeVal, int maxKeySizeVal);
@@ -104,31 +129,42 @@ error it returns false */
 void xorFunction(const std::vector<unsigned char> &vS1, const unsigned char c,
                  std::vector<unsigned char> &vRes);
 
-/* this function makes the calculation of the frequency of the characters that
-resulted from the xor, in the end it returns true if no error or false otherwise
-*/
-bool calcFrequencyData(const std::vector<unsigned char> &xorTest,
-                       int *freqXorChar);
+/* this function makes the fulling of the table logLikelihood with the log
+probability of every byte value in english text, the letters follow the english
+letter frequency, logLikelihood must have room for numberByteValues values */
+void buildLogLikelihoodTable(double *logLikelihood);
+
+/* this function makes the calculation of the histogram of the bytes of the
+vector v, histogram must have room for numberByteValues values */
+void calcByteHistogram(const std::vector<unsigned char> &v,
+                       unsigned int *histogram);
+
+/* this function scores every single byte key against the histogram, the score
+of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the data is ever built,
+in the end it returns the key with the highest score and that score by
+reference */
+unsigned char getBestXorKey(const unsigned int *histogram,
+                            const double *logLikelihood, double *bestScore);
 
 /* this function makes the calculation of the deviation from the english letter
-frequency, and then it returns the deviation and sets flag to true if no error
-or to false if otherwise */
-double deviationCalc(std::unordered_map<char, float> &englishLetterFrequency,
-                     int *freqXorChar, bool *flag);
+frequency of the data of the histogram once xored with the key, and then it
+returns that deviation */
+double deviationCalc(const unsigned int *histogram, const unsigned char key);
 
 /* this function makes the calculation of the ratio between all the english
-and spaces compared to the length of the message, and sets flag to true if no
-error or to false if otherwise */
-double ratioCalc(const std::vector<unsigned char> &xorTest, bool *flag);
+letters and spaces compared to the number of bytes of the histogram, once xored
+with the key */
+double ratioCalc(const unsigned int *histogram, const unsigned char key);
 
-/* this function for a given line in binary, it will do a xor test with a single
-english alphabet character, determine the best fit, based on the max ratio of
-english letters and spaces, and if this is the best fit it will also update
-the structure lineChangedId, in the end it returns true if no error or false
-otherwise */
+/* this function for a given line in binary, it will do a xor test with every
+single byte key, determine the best fit, based on the max log-likelihood of the
+line as english text, scored from the byte histogram of the line, and it will
+update the structure lineChangedId with it, in the end it returns true if no
+error or false otherwise */
 bool testCharactersXor(lineChangedId &lineChangedIdData,
-                       std::unordered_map<char, float> &englishLetterFrequency,
-                       std::vector<unsigned char> &lineReadBinary);
+                       const double *logLikelihood,
+                       const std::vector<unsigned char> &lineReadBinary);
 
 /* this function makes the decryption of the cypertext using the key to decrypt,
 the encryption & decryption process was a repeated XOR with a given key, if
@@ -137,6 +173,12 @@ bool decryptText(const std::vector<unsigned char> &encryptedBytesAsciiFullText,
                  const std::vector<unsigned char> &key,
                  std::vector<unsigned char> &decryptedText);
 
+/* this function makes the check that on a short text, with the search of the
+key length going up to the hundreds, the true key length of a repeating key xor
+ranks first, in the end it returns true if it does for every key tested, false
+otherwise */
+bool testKeyLengthShortText();
+
 int main() {
   clock_t start, end;
   double time;
@@ -216,8 +258,12 @@ int main() {
     printf("\n\n");
   }
   /* do study of the key length */
-  getKeyLengthProfileSorted(encryptedBytesAsciiFullText, keyL, minKeySize,
-                            maxKeySize);
+  b = getKeyLengthProfileSorted(encryptedBytesAsciiFullText, keyL, minKeySize,
+                                maxKeySize);
+  if (b == false) {
+    perror("There was a problem in the function 'getKeyLengthProfileSorted'.");
+    exit(1);
+  }
   key = getKey(encryptedBytesAsciiFullText, keyL, &b);
   if (b == false) {
     perror("There was a problem in the function 'getKey'.");
@@ -234,6 +280,9 @@ int main() {
   std::cout << "\nMessage decrypted:\n\n'" << decryptedText << "'" << std::endl;
   /* close file */
   inputFile.close();
+  b = testKeyLengthShortText();
+  std::cout << "\nShort text key length check: "
+            << (b == true ? "true" : "false") << "." << std::endl;
   /* end of the work */
   end = clock();
   time = (double)(end - start) / CLOCKS_PER_SEC;
@@ -253,36 +302,57 @@ void convertStringToVectorBytes(const std::string &s,
   return;
 }
 /******************************************************************************/
-/* this function makes the calculation of the hamming distance between v1 and
-v2, if there is an error it returns b = false, true otherwise by reference */
-int calcHammingDistance(const std::vector<unsigned char> &v1,
-                        const std::vector<unsigned char> &v2, bool *b) {
-  if (v1.size() != v2.size()) {
-    *b = false;
-    return 0;
-  }
-  std::vector<unsigned char> xorRes;
-  int i, size = v1.size(), hammingDistance = 0, n;
-  for (i = 0; i < size; ++i) {
-    xorRes.emplace_back(v1[i] ^ v2[i]);
-    n = calcBitsOn(xorRes[i]);
-    hammingDistance += n;
+/* this function makes the calculation of the hamming distance between the size
+bytes of p1 and of p2, 8 bytes at a time with a 64 bit popcount, dispatching to
+the popcnt instruction when the cpu supports it, in the end it just returns
+that distance */
+unsigned long long calcHammingDistance(const unsigned char *p1,
+                                       const unsigned char *p2,
+                                       std::size_t size) {
+#if defined(__x86_64__) || defined(__i386__)
+  static const bool hasPopcnt = __builtin_cpu_supports("popcnt");
+  if (hasPopcnt) {
+    return calcHammingDistancePopcnt(p1, p2, size);
+  }
+#endif
+  return calcHammingDistancePortable(p1, p2, size);
+}
+/******************************************************************************/
+/* loop shared by the kernels, it is always inlined so that every kernel
+compiles it with its own target */
+static inline __attribute__((always_inline)) unsigned long long
+calcHammingDistanceWords(const unsigned char *p1, const unsigned char *p2,
+                         std::size_t size) {
+  unsigned long long hammingDistance = 0;
+  uint64_t w1, w2;
+  std::size_t i;
+  for (i = 0; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    memcpy(&w1, p1 + i, sizeof(uint64_t));
+    memcpy(&w2, p2 + i, sizeof(uint64_t));
+    hammingDistance += __builtin_popcountll(w1 ^ w2);
+  }
+  for (; i < size; ++i) {
+    hammingDistance += __builtin_popcount(p1[i] ^ p2[i]);
   }
-  *b = true;
   return hammingDistance;
 }
 /******************************************************************************/
-/* this function makes the calculation of the bits on in the char c, in the end
-it just returns that number */
-int calcBitsOn(unsigned char c) {
-  int nBitsOn = 0, i, numberBitsOnByte = 8;
-  for (i = 0; i < numberBitsOnByte; ++i) {
-    if ((c & 1) == 1) {
-      ++nBitsOn;
-    }
-    c >>= 1;
-  }
-  return nBitsOn;
+/* popcnt kernel, without the target attribute __builtin_popcountll is a call
+to the table based routine of libgcc */
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("popcnt")))
+#endif
+unsigned long long
+calcHammingDistancePopcnt(const unsigned char *p1, const unsigned char *p2,
+                          std::size_t size) {
+  return calcHammingDistanceWords(p1, p2, size);
+}
+/******************************************************************************/
+/* portable kernel, for the cpus without popcnt */
+unsigned long long calcHammingDistancePortable(const unsigned char *p1,
+                                               const unsigned char *p2,
+                                               std::size_t size) {
+  return calcHammingDistanceWords(p1, p2, size);
 }
 /******************************************************************************/
 /* this function does the decode from base64 into bytes, returning the
@@ -359,56 +429,86 @@ void convertVectorBytesToString(const std::vector<unsigned char> &v,
 }
 /******************************************************************************/
 /* this function makes fulling of the vector keyL for every length of the key,
-orders the vector in ascending order by the editDistance and returns true if all
-ok, false otherwise */
+the edit distance of a key length is the hamming distance between the text and
+itself shifted by that length, per byte of overlap, so every block is compared
+with the next one, the key lengths are shared between the available threads,
+each key length also gets a confidence, the number of standard deviations its
+edit distance is below the mean of the range, in the end it orders the vector in
+ascending order by the editDistance and returns true if all ok, false
+otherwise */
 bool getKeyLengthProfileSorted(
     std::vector<unsigned char> &encryptedBytesAsciiFullText,
     std::vector<struct keyId> &keyL, int minKeySizeVal, int maxKeySizeVal) {
-  if (minKeySize > maxKeySizeVal || encryptedBytesAsciiFullText.size() == 0) {
+  int sizeFullText = encryptedBytesAsciiFullText.size(), nKeySizes, i,
+      bestDivisor = 0;
+  /* a key length needs at least two blocks to be compared, so that its
+  overlap is never shorter than the key length itself */
+  if (maxKeySizeVal > sizeFullText / 2) {
+    maxKeySizeVal = sizeFullText / 2;
+  }
+  if (minKeySizeVal < 1 || minKeySizeVal > maxKeySizeVal) {
     return false;
   }
-  int sizeFullText = encryptedBytesAsciiFullText.size(), nSlices, sliceSize, i,
-      j, k;
-  std::vector<unsigned char> slice1, slice2;
-  unsigned char c1, c2;
-  bool b;
-  double score;
-  std::string s1, s2;
-  struct keyId key;
-  for (i = minKeySize; i <= maxKeySizeVal; ++i) {
-    sliceSize = 2 * i;
-    nSlices = sizeFullText / sliceSize;
-    /* reset key values */
-    key.keyLength = i;
-    key.editDistance = 0;
-    score = 0;
-    for (j = 0; j < nSlices; ++j) {
-      /* slices fulling */
-      slice1.clear();
-      slice2.clear();
-      for (k = 0; k < i; ++k) {
-        c1 = encryptedBytesAsciiFullText[k + j * sliceSize];
-        c2 = encryptedBytesAsciiFullText[k + j * sliceSize + i];
-        slice1.emplace_back(c1);
-        slice2.emplace_back(c2);
-      }
-      /* slice calculation */
-      convertVectorBytesToString(slice1, s1);
-      convertVectorBytesToString(slice2, s2);
-      score += (double)calcHammingDistance(slice1, slice2, &b) / i;
-      if (b == false) {
-        std::cout << "There was an error in the function calcHammingDistance."
-                  << std::endl;
-        return false;
+  nKeySizes = maxKeySizeVal - minKeySizeVal + 1;
+  const unsigned char *data = encryptedBytesAsciiFullText.data();
+  std::vector<struct keyId> keyProfile(nKeySizes);
+  std::atomic<int> nextKeySize(minKeySizeVal);
+  std::vector<std::thread> workers;
+  unsigned int nThreads = std::max(1u, std::thread::hardware_concurrency());
+  double mean = 0, variance = 0, standardDeviation;
+  nThreads = std::min(nThreads, static_cast<unsigned int>(nKeySizes));
+  for (i = 0; i < (int)nThreads; ++i) {
+    workers.emplace_back([&]() {
+      int keySize, overlap;
+      while ((keySize = nextKeySize++) <= maxKeySizeVal) {
+        overlap = sizeFullText - keySize;
+        keyProfile[keySize - minKeySizeVal].keyLength = keySize;
+        keyProfile[keySize - minKeySizeVal].editDistance =
+            static_cast<double>(
+                calcHammingDistance(data, data + keySize, overlap)) /
+            overlap;
       }
-    }
-    /* normalization by the number of slices */
-    key.editDistance = score / nSlices;
-    /* update keyL vector */
-    keyL.emplace_back(key);
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  /* confidence of every key length */
+  for (i = 0; i < nKeySizes; ++i) {
+    mean += keyProfile[i].editDistance;
+  }
+  mean /= nKeySizes;
+  for (i = 0; i < nKeySizes; ++i) {
+    variance += (keyProfile[i].editDistance - mean) *
+                (keyProfile[i].editDistance - mean);
+  }
+  standardDeviation = sqrt(variance / nKeySizes);
+  for (i = 0; i < nKeySizes; ++i) {
+    keyProfile[i].confidence =
+        standardDeviation == 0
+            ? 0
+            : (mean - keyProfile[i].editDistance) / standardDeviation;
+    keyL.emplace_back(keyProfile[i]);
   }
   /* sort the keyL vector by the value of editDistance, in ascending order */
   std::sort(keyL.begin(), keyL.end());
+  /* every multiple of the key length has the same expected edit distance, so
+  on a short text a multiple may come first by chance, the shortest divisor of
+  the best key length with an edit distance close to it is moved to the front
+  */
+  for (i = 1; i < (int)keyL.size(); ++i) {
+    if (keyL[0].keyLength % keyL[i].keyLength == 0 &&
+        keyL[i].editDistance <=
+            keyL[0].editDistance * (1 + multipleKeySizeTolerance) &&
+        (bestDivisor == 0 ||
+         keyL[i].keyLength < keyL[bestDivisor].keyLength)) {
+      bestDivisor = i;
+    }
+  }
+  if (bestDivisor != 0) {
+    std::rotate(keyL.begin(), keyL.begin() + bestDivisor,
+                keyL.begin() + bestDivisor + 1);
+  }
   if (debugFlag == true) {
     /* print sort vector */
     std::cout << "\nKeySize and edit distance (Hamming distance) in decreasing "
@@ -417,16 +517,16 @@ bool getKeyLengthProfileSorted(
     for (i = 0; i < (int)keyL.size(); ++i) {
       std::cout << "Keysize = " << keyL[i].keyLength
                 << "\t | \teditDistance = " << keyL[i].editDistance
-                << std::endl;
+                << "\t | \tconfidence = " << keyL[i].confidence << std::endl;
     }
     /* print sort vector */
     std::cout << "\nValid KeySize and edit distance (Hamming distance) "
                  "considered for the search.\n"
               << std::endl;
-    for (i = 0; i < validKeyPoolSearch; ++i) {
+    for (i = 0; i < validKeyPoolSearch && i < (int)keyL.size(); ++i) {
       std::cout << "Keysize = " << keyL[i].keyLength
                 << "\t | \teditDistance = " << keyL[i].editDistance
-                << std::endl;
+                << "\t | \tconfidence = " << keyL[i].confidence << std::endl;
     }
   }
   return true;
@@ -446,15 +546,10 @@ getKey(std::vector<unsigned char> &encryptedBytesAscii,
   keySolId.keySize = -1;
   int i, j;
   bool b2;
-  double valMaxRatioLettersSpaceMean;
-  std::unordered_map<char, float> englishLetterFrequency = {
-      {'a', 8.2e-2},   {'b', 1.5e-2},  {'c', 2.8e-2},  {'d', 4.3e-2},
-      {'e', 13.0e-2},  {'f', 2.2e-2},  {'g', 2.0e-2},  {'h', 6.1e-2},
-      {'i', 7.0e-2},   {'j', 0.15e-2}, {'k', 0.77e-2}, {'l', 4.0e-2},
-      {'m', 2.4e-2},   {'n', 6.7e-2},  {'o', 7.5e-2},  {'p', 1.9e-2},
-      {'q', 0.095e-2}, {'r', 6.0e-2},  {'s', 6.3e-2},  {'t', 9.1e-2},
-      {'u', 2.8e-2},   {'v', 0.98e-2}, {'w', 2.4e-2},  {'x', 0.15e-2},
-      {'y', 2.0e-2},   {'z', 0.074e-2}};
+  double valMaxLogLikelihoodMean;
+  double logLikelihood[numberByteValues];
+  /* log probability of every byte value in english text */
+  buildLogLikelihoodTable(logLikelihood);
   if (encryptedBytesAscii.size() < maxKeySize) {
     std::cout << "Size of cypertext = " << encryptedBytesAscii.size()
               << std::endl;
@@ -463,7 +558,7 @@ getKey(std::vector<unsigned char> &encryptedBytesAscii,
     return keySolId.key;
   }
   /* get data parsed in keysize from cyphertext */
-  for (i = 0; i < validKeyPoolSearch; ++i) {
+  for (i = 0; i < validKeyPoolSearch && i < (int)keyL.size(); ++i) {
     dataParsedInKeySize.clear();
     dataParsedInKeySize =
         getDataParseInKeySize(encryptedBytesAscii, keyL[i].keyLength, &b2);
@@ -473,27 +568,27 @@ getKey(std::vector<unsigned char> &encryptedBytesAscii,
     }
     /* keySol memory allocation and test */
     keySol.emplace_back(auxLineChangedIdVector);
-    valMaxRatioLettersSpaceMean = 0;
+    valMaxLogLikelihoodMean = 0;
     for (j = 0; j < keyL[i].keyLength; ++j) {
       keySol[i].emplace_back(auxLineChangedIdElement);
-      b2 = testCharactersXor(keySol[i][j], englishLetterFrequency,
+      b2 = testCharactersXor(keySol[i][j], logLikelihood,
                              dataParsedInKeySize[j]);
       if (b2 == false) {
         perror("There was an error in the function 'testCharactersXor'.");
         *b = false;
         return keySolId.key;
       }
-      valMaxRatioLettersSpaceMean +=
-          keySol[i][j].charId.valMaxRatioLettersSpace;
+      valMaxLogLikelihoodMean += keySol[i][j].charId.valMaxLogLikelihood;
     }
-    /* normalization of valMaxRatioLettersSpace */
-    valMaxRatioLettersSpaceMean /= keyL[i].keyLength;
+    /* normalization of valMaxLogLikelihood by the number of bytes, so that
+    key lengths with columns of different sizes can be compared */
+    valMaxLogLikelihoodMean /= encryptedBytesAscii.size();
     /* test best key for length keyL[i].keyLength */
     if (keySolId.keySize == -1 ||
-        valMaxRatioLettersSpaceMean > keySolId.valMaxRatioLettersSpaceMean) {
+        valMaxLogLikelihoodMean > keySolId.valMaxLogLikelihoodMean) {
       /* we need to update the key */
       keySolId.keySize = keyL[i].keyLength;
-      keySolId.valMaxRatioLettersSpaceMean = valMaxRatioLettersSpaceMean;
+      keySolId.valMaxLogLikelihoodMean = valMaxLogLikelihoodMean;
       keySolId.key.clear();
       for (j = 0; j < keyL[i].keyLength; ++j) {
         keySolId.key.emplace_back(keySol[i][j].charId.charMinDeviation);
@@ -559,130 +654,156 @@ void xorFunction(const std::vector<unsigned char> &vS1, const unsigned char c,
   return;
 }
 /******************************************************************************/
-/* this function makes the calculation of the frequency of the characters that
-resulted from the xor, in the end it returns true if no error or false otherwise
-*/
-bool calcFrequencyData(const std::vector<unsigned char> &xorTest,
-                       int *freqXorChar) {
-  if (freqXorChar == nullptr) {
-    return false;
+/* this function makes the fulling of the table logLikelihood with the log
+probability of every byte value in english text, the letters follow the english
+letter frequency, logLikelihood must have room for numberByteValues values */
+void buildLogLikelihoodTable(double *logLikelihood) {
+  /* share of every class of byte in english text */
+  const double lowercaseShare = 0.74, uppercaseShare = 0.04, spaceShare = 0.15,
+               punctuationShare = 0.05, digitShare = 0.01, newlineShare = 0.005,
+               otherPrintableShare = 1e-4, nonPrintableShare = 1e-6;
+  const char *punctuation = ".,;:!?'\"-";
+  double probability[numberByteValues], sum = 0;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    if (i >= 'a' && i <= 'z') {
+      probability[i] = lowercaseShare * englishLetterFrequency[i - 'a'];
+    } else if (i >= 'A' && i <= 'Z') {
+      probability[i] = uppercaseShare * englishLetterFrequency[i - 'A'];
+    } else if (i == ' ') {
+      probability[i] = spaceShare;
+    } else if (i != 0 && strchr(punctuation, i) != nullptr) {
+      probability[i] = punctuationShare / strlen(punctuation);
+    } else if (i >= '0' && i <= '9') {
+      probability[i] = digitShare / 10;
+    } else if (i == '\n') {
+      probability[i] = newlineShare;
+    } else if (i > ' ' && i < 0x7f) {
+      probability[i] = otherPrintableShare;
+    } else {
+      probability[i] = nonPrintableShare;
+    }
+    sum += probability[i];
   }
-  int i, size = xorTest.size();
-  unsigned char testChar;
+  for (i = 0; i < numberByteValues; ++i) {
+    logLikelihood[i] = log(probability[i] / sum);
+  }
+  return;
+}
+/******************************************************************************/
+/* this function makes the calculation of the histogram of the bytes of the
+vector v, histogram must have room for numberByteValues values */
+void calcByteHistogram(const std::vector<unsigned char> &v,
+                       unsigned int *histogram) {
+  int i, size = v.size();
+  memset(histogram, 0, numberByteValues * sizeof(unsigned int));
   for (i = 0; i < size; ++i) {
-    testChar = tolower(xorTest[i]);
-    if (testChar >= 'a' && testChar <= 'z') {
-      ++freqXorChar[testChar - 'a'];
+    ++histogram[v[i]];
+  }
+  return;
+}
+/******************************************************************************/
+/* this function scores every single byte key against the histogram, the score
+of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the data is ever built,
+in the end it returns the key with the highest score and that score by
+reference */
+unsigned char getBestXorKey(const unsigned int *histogram,
+                            const double *logLikelihood, double *bestScore) {
+  double scores[numberByteValues] = {0}, count;
+  unsigned char bestKey = 0;
+  int i, key;
+  /* only the byte values present in the data take part in the score, the keys
+  are the inner loop so that their sums do not wait on each other */
+  for (i = 0; i < numberByteValues; ++i) {
+    if (histogram[i] != 0) {
+      count = histogram[i];
+      for (key = 0; key < numberByteValues; ++key) {
+        scores[key] += count * logLikelihood[i ^ key];
+      }
     }
   }
-  return true;
+  for (key = 1; key < numberByteValues; ++key) {
+    if (scores[key] > scores[bestKey]) {
+      bestKey = key;
+    }
+  }
+  *bestScore = scores[bestKey];
+  return bestKey;
 }
 /******************************************************************************/
 /* this function makes the calculation of the deviation from the english letter
-frequency, and then it returns the deviation and sets flag to true if no error
-or to false if otherwise */
-double deviationCalc(std::unordered_map<char, float> &englishLetterFrequency,
-                     int *freqXorChar, bool *flag) {
-  if (freqXorChar == nullptr || flag == nullptr) {
-    *flag = false;
-    return 0;
-  }
-  int nSamples = 0, i;
-  double deviation = 0;
-  for (i = 0; i < numberEnglishLetters; ++i) {
-    nSamples += freqXorChar[i];
+frequency of the data of the histogram once xored with the key, and then it
+returns that deviation */
+double deviationCalc(const unsigned int *histogram, const unsigned char key) {
+  unsigned int freqXorChar[numberEnglishLetters] = {0}, nSamples = 0;
+  unsigned char testChar;
+  double deviation = 0, frequency;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    testChar = tolower(i ^ key);
+    if (testChar >= 'a' && testChar <= 'z') {
+      freqXorChar[testChar - 'a'] += histogram[i];
+      nSamples += histogram[i];
+    }
   }
   for (i = 0; i < numberEnglishLetters; ++i) {
-    deviation += fabs(static_cast<double>(freqXorChar[i]) / nSamples -
-                      englishLetterFrequency['a' + i]);
+    frequency =
+        nSamples == 0 ? 0 : static_cast<double>(freqXorChar[i]) / nSamples;
+    deviation += fabs(frequency - englishLetterFrequency[i]);
   }
-  *flag = true;
   return deviation;
 }
 /******************************************************************************/
 /* this function makes the calculation of the ratio between all the english
-and spaces compared to the length of the message, and sets flag to true if no
-error or to false if otherwise */
-double ratioCalc(const std::vector<unsigned char> &xorTest, bool *flag) {
-  if (xorTest.size() == 0) {
-    *flag = false;
-    return 0;
-  }
-  int i, size = xorTest.size(), nLettersAndSpaces = 0;
-  for (i = 0; i < size; ++i) {
-    if (xorTest[i] == ' ' ||
-        (tolower(xorTest[i]) >= 'a' && tolower(xorTest[i]) <= 'z')) {
-      ++nLettersAndSpaces;
+letters and spaces compared to the number of bytes of the histogram, once xored
+with the key */
+double ratioCalc(const unsigned int *histogram, const unsigned char key) {
+  unsigned int nBytes = 0, nLettersAndSpaces = 0;
+  unsigned char testChar;
+  int i;
+  for (i = 0; i < numberByteValues; ++i) {
+    nBytes += histogram[i];
+    testChar = i ^ key;
+    if (testChar == ' ' || isalpha(testChar)) {
+      nLettersAndSpaces += histogram[i];
     }
   }
-  *flag = true;
-  return static_cast<double>(nLettersAndSpaces) / size;
+  if (nBytes == 0) {
+    return 0;
+  }
+  return static_cast<double>(nLettersAndSpaces) / nBytes;
 }
 /******************************************************************************/
-/* this function for a given line in binary, it will do a xor test with a single
-english alphabet character, determine the best fit, based on the max ratio of
-english letters and spaces, and if this is the best fit it will also update
-the structure lineChangedId, in the end it returns true if no error or false
-otherwise */
+/* this function for a given line in binary, it will do a xor test with every
+single byte key, determine the best fit, based on the max log-likelihood of the
+line as english text, scored from the byte histogram of the line, and it will
+update the structure lineChangedId with it, in the end it returns true if no
+error or false otherwise */
 bool testCharactersXor(lineChangedId &lineChangedIdData,
-                       std::unordered_map<char, float> &englishLetterFrequency,
-                       std::vector<unsigned char> &lineReadBinary) {
+                       const double *logLikelihood,
+                       const std::vector<unsigned char> &lineReadBinary) {
   if (lineReadBinary.size() == 0) {
     perror("\nlineReadBinary has size 0, error.");
     return false;
   }
-  int i, xorPossibleKeys = pow(2, 8);
-  bool b;
-  double deviation, ratioLetters;
-  std::vector<unsigned char> xorTest;
-  std::string xorTestString;
-  int *freqXorChar = (int *)calloc(numberEnglishLetters, sizeof(int));
-  if (freqXorChar == nullptr) {
-    perror("\nfreqXorChar calloc failed.");
-    return false;
-  }
-  /* xor test */
-  for (i = 0; i < xorPossibleKeys; ++i) {
-    /* reset structures */
-    xorTest.clear();
-    memset(freqXorChar, 0, numberEnglishLetters * sizeof(int));
-    xorTestString.clear();
-    /* xor */
-    xorFunction(lineReadBinary, i, xorTest);
-    /* calculate frequency data */
-    b = calcFrequencyData(xorTest, freqXorChar);
-    if (b == false) {
-      perror("\nThere was an error in the function 'calcFrequencyData'");
-      return false;
-    }
-    deviation = deviationCalc(englishLetterFrequency, freqXorChar, &b);
-    if (b == false) {
-      perror("\nThere was an error in the function 'deviationCalc'");
-      exit(1);
-    }
-    ratioLetters = ratioCalc(xorTest, &b);
-    if (b == false) {
-      perror("\nThere was an error in the function 'ratioCalc'");
-      exit(1);
-    }
-    if (ratioLetters > lineChangedIdData.charId.valMaxRatioLettersSpace) {
-      lineChangedIdData.lineChangedBinaryEncoded.clear();
-      lineChangedIdData.lineChangedBinaryEncoded = lineReadBinary;
-      lineChangedIdData.lineChangedBinaryDecoded.clear();
-      lineChangedIdData.lineChangedBinaryDecoded = xorTest;
-      lineChangedIdData.lineChangedBinaryDecodedString.clear();
-      convertVectorBytesToString(
-          lineChangedIdData.lineChangedBinaryDecoded,
-          lineChangedIdData.lineChangedBinaryDecodedString);
-      lineChangedIdData.charId.valMinDeviation = deviation;
-      lineChangedIdData.charId.charMinDeviation = i;
-      lineChangedIdData.charId.valMaxRatioLettersSpace = ratioLetters;
-    }
-  }
-  /* free memory */
-  memset(freqXorChar, 0, numberEnglishLetters * sizeof(int));
-  free(freqXorChar);
-  freqXorChar = nullptr;
+  unsigned int histogram[numberByteValues];
+  unsigned char key;
+  double score;
+  /* every key is scored against the histogram of the line */
+  calcByteHistogram(lineReadBinary, histogram);
+  key = getBestXorKey(histogram, logLikelihood, &score);
+  lineChangedIdData.lineChangedBinaryEncoded.clear();
+  lineChangedIdData.lineChangedBinaryEncoded = lineReadBinary;
+  /* only the best fit is xored */
+  lineChangedIdData.lineChangedBinaryDecoded.clear();
+  xorFunction(lineReadBinary, key, lineChangedIdData.lineChangedBinaryDecoded);
+  convertVectorBytesToString(lineChangedIdData.lineChangedBinaryDecoded,
+                             lineChangedIdData.lineChangedBinaryDecodedString);
+  lineChangedIdData.charId.valMinDeviation = deviationCalc(histogram, key);
+  lineChangedIdData.charId.charMinDeviation = key;
+  lineChangedIdData.charId.valMaxRatioLettersSpace = ratioCalc(histogram, key);
+  lineChangedIdData.charId.valMaxLogLikelihood = score;
   /* return no error status */
   return true;
 }
@@ -704,3 +825,30 @@ bool decryptText(const std::vector<unsigned char> &encryptedBytesAsciiFullText,
   return true;
 }
 /******************************************************************************/
+/* this function makes the check that on a short text, with the search of the
+key length going up to the hundreds, the true key length of a repeating key xor
+ranks first, in the end it returns true if it does for every key tested, false
+otherwise */
+bool testKeyLengthShortText() {
+  const std::string plaintext =
+      "Burning 'em, if you ain't quick and nimble\nI go crazy when I hear a "
+      "cymbal and a hi-hat with a souped-up tempo";
+  const std::string keys[] = {"Vanil", "ICE ICE"};
+  std::vector<unsigned char> encryptedText;
+  std::vector<struct keyId> keyL;
+  std::size_t i;
+  for (const std::string &key : keys) {
+    encryptedText.clear();
+    keyL.clear();
+    for (i = 0; i < plaintext.size(); ++i) {
+      encryptedText.emplace_back(plaintext[i] ^ key[i % key.size()]);
+    }
+    if (getKeyLengthProfileSorted(encryptedText, keyL, minKeySize,
+                                  maxKeySizeShortTextCheck) == false ||
+        keyL[0].keyLength != (int)key.size()) {
+      return false;
+    }
+  }
+  return true;
+}
+/******************************************************************************/
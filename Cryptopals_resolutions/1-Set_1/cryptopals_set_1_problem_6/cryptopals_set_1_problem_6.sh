@@ -1,3 +1,3 @@
 #!/bin/bash
-g++ -Wall -std=c++17 cryptopals_set_1_problem_6.cpp -o cryptopals_set_1_problem_6 -lcrypto
+g++ -Wall -std=c++17 cryptopals_set_1_problem_6.cpp -o cryptopals_set_1_problem_6 -lcrypto -pthread
 ./cryptopals_set_1_problem_6
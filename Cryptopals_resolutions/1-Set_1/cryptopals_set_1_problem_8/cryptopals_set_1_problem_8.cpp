@@ -2,7 +2,9 @@
 #include <bits/stdc++.h>
 #include <cctype>
 #include <cstddef>
+#include <cstdint>
 #include <ctype.h>
+#include <fcntl.h>
 #include <fstream>
 #include <iostream>
 #include <math.h>
@@ -13,116 +15,121 @@
 #include <stdlib.h>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
 #include <time.h>
+#include <unistd.h>
 #include <unordered_map>
 #include <vector>
 
-const char hex_chars[16] = {'0', '1', '2', '3', '4', '5', '6', '7',
-                            '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 const bool debugFlag = false;
 const unsigned int blockSize = 16;
+const char *datasetFileName = "cryptopals_set_1_problem_8_dataset.txt";
 
+/* one block of cyphertext, seen as a 128 bit key */
 typedef struct {
-  bool foundFlag;
-  std::vector<int> lineNumberV;
-} answerId;
+  std::uint64_t low;
+  std::uint64_t high;
+} blockKeyId;
 
-/* this function makes the conversion from a string into a vector of bytes,
-in the end it just returns*/
-void convertStringToVectorBytes(const std::string &s,
-                                std::vector<unsigned char> &v);
+static_assert(sizeof(blockKeyId) == blockSize,
+              "a block must fit exactly in a 128 bit key");
 
-/* this function makes the fulling of the string s based on the content of the
-vector v */
-void convertVectorBytesToString(const std::vector<unsigned char> &v,
-                                std::string &s);
+/* open addressing set of the blocks of one record, the slots whose stamp is
+not the current one are empty, so that the set is emptied for the next record
+without touching its slots */
+typedef struct {
+  std::vector<blockKeyId> keys;
+  std::vector<unsigned int> stamps;
+  unsigned int stamp;
+  std::size_t mask; /* number of slots - 1, the number of slots is a power of
+                       2 */
+} blockSetId;
+
+typedef struct {
+  long lineNumber; /* inside its chunk until the chunks are merged */
+  unsigned int nBlocks;
+  unsigned int nRepeatedBlocks; /* blocks equal to an earlier block of the
+                                   record */
+  double repetitionRatio;       /* nRepeatedBlocks / nBlocks */
+} recordScoreId;
+
+typedef struct {
+  std::vector<recordScoreId> ecbRecords; /* records with repeated blocks */
+  long nLines;
+  long nInvalidLines;
+} chunkResultId;
+
+/* this function decodes the blockSize bytes of the 2 * blockSize hexadecimal
+characters starting at p into block, it returns true if all the characters
+are hexadecimal, false otherwise */
+bool decodeHexBlock(const char *p, unsigned char *block);
 
-/* this function does the decode from hexadecimal into bytes, returning the
-result by reference in a vector of unsigned char */
-void decodeHexToByte(std::string &s, std::vector<unsigned char> &output);
+/* this function empties the set and makes sure it has at least twice as many
+slots as the nBlocks blocks that will be inserted into it */
+void clearBlockSet(blockSetId &set, const std::size_t nBlocks);
 
-/* this function makes the test if  there is repetition of the blocks in the
-cypertext, of block size, if yes then it will return true, false otherwise,
-if there is an error in the function, flag error will be set to true, false
-otherwise */
-bool testLineForRepeatedEncryption(const std::vector<unsigned char> &asciiLineV,
-                                   const unsigned int blockSize,
-                                   bool *flagError);
+/* this function inserts the block into the set, it returns true if the block
+was already in the set, false otherwise */
+bool insertBlock(blockSetId &set, const blockKeyId &block);
 
-int main(void) {
+/* this function makes the count of the repeated blocks of the hexadecimal
+record [begin, end), with one pass over its blocks and the set, in the end it
+returns true if the record is a non empty hexadecimal string with a whole
+number of blocks, false otherwise */
+bool scoreRecord(const char *begin, const char *end, blockSetId &set,
+                 recordScoreId &record);
+
+/* this function scores every record of the chunk [begin, end) of the input,
+the chunk starts at the beginning of a line, in the end it returns the records
+with repeated blocks and the number of lines and invalid lines of the chunk in
+result */
+void scanChunk(const char *begin, const char *end, chunkResultId *result);
+
+/* this function memory maps the file fileName, splits it on line boundaries
+between the available threads and returns in ecbRecords the records of the
+whole file with repeated blocks, sorted by line number, and the number of
+lines that are not valid records by reference, it returns true if all ok or
+false otherwise */
+bool detectEcbRecords(const char *fileName,
+                      std::vector<recordScoreId> &ecbRecords,
+                      long *nInvalidLines);
+
+int main(int argc, char *argv[]) {
   clock_t start, end;
   double time;
   start = clock();
   /* work to verify */
-  std::ifstream inputFile;
-  std::string inputLineHexadecimalFormat;
-  std::vector<unsigned char> hexadecimalLineV, asciiLineV;
-  int i, lineNumber = 1;
-  bool b, ret;
-  answerId ans;
-  ans.foundFlag = 0;
+  std::vector<recordScoreId> ecbRecords;
+  long nInvalidLines;
+  std::size_t i;
+  const char *fileName = argc > 1 ? argv[1] : datasetFileName;
+  bool b;
   /* execution */
-  inputFile.open("cryptopals_set_1_problem_8_dataset.txt", std::ios::in);
-  if (!inputFile) {
+  b = detectEcbRecords(fileName, ecbRecords, &nInvalidLines);
+  if (b == false) {
     perror("File failed to be opened.");
     exit(1);
   } else if (debugFlag == true) {
-    std::cout << "The file 'cryptopals_set_1_problem_8_dataset.txt' was "
-                 "sucessfully opened."
+    std::cout << "The file '" << fileName << "' was sucessfully scanned."
               << std::endl;
   }
-  /* data read and conversion to ascii */
-  while (inputFile.good() == true) {
-    inputLineHexadecimalFormat.clear();
-    hexadecimalLineV.clear();
-    asciiLineV.clear();
-    std::getline(inputFile, inputLineHexadecimalFormat);
-    if (inputLineHexadecimalFormat.size() == 0) {
-      continue;
-    }
-    if (debugFlag == true) {
-      std::cout << "Line " << lineNumber << " read (hex): \t\t\t"
-                << inputLineHexadecimalFormat << std::endl;
-    }
-    /* string to vector conversion in hexadecimal format */
-    convertStringToVectorBytes(inputLineHexadecimalFormat, hexadecimalLineV);
-    if (debugFlag == true) {
-      std::cout << "Line " << lineNumber << " read (hex)(vector):   \t";
-      for (i = 0; i < (int)hexadecimalLineV.size(); ++i) {
-        std::cout << hexadecimalLineV[i];
-      }
-      std::cout << std::endl;
-    }
-    /* conversion from hexadecimal into string format */
-    decodeHexToByte(inputLineHexadecimalFormat, asciiLineV);
-    if (debugFlag == true) {
-      std::cout << "Line " << lineNumber
-                << " read (ascii)(vector), size = " << asciiLineV.size()
-                << ":  \t";
-      for (i = 0; i < (int)asciiLineV.size(); ++i) {
-        printf("%.2x ", asciiLineV[i]);
-      }
-      std::cout << "\n" << std::endl;
-    }
-    ret = testLineForRepeatedEncryption(asciiLineV, blockSize, &b);
-    if (b == true) {
-      perror("There was an error in the function "
-             "'testLineForRepeatedEncryption'.");
-      exit(1);
-    }
-    if (ret == true) {
-      ans.foundFlag = true;
-      ans.lineNumberV.push_back(lineNumber);
-    }
-    ++lineNumber;
+  if (nInvalidLines != 0) {
+    std::cout << nInvalidLines
+              << " lines were skipped, as they are not hexadecimal strings "
+                 "with a whole number of blocks."
+              << std::endl;
   }
-  inputFile.close();
   /* print answer to screen */
-  if (ans.foundFlag == true) {
-    for (i = 0; i < (int)ans.lineNumberV.size(); ++i) {
-      std::cout << "Line " << ans.lineNumberV[i]
+  if (ecbRecords.size() != 0) {
+    for (i = 0; i < ecbRecords.size(); ++i) {
+      std::cout << "Line " << ecbRecords[i].lineNumber
                 << " encrypted with ECB mode, detected cypertext repetition."
                 << std::endl;
+      printf("\trepetition ratio %f (%u of %u blocks repeated)\n",
+             ecbRecords[i].repetitionRatio, ecbRecords[i].nRepeatedBlocks,
+             ecbRecords[i].nBlocks);
     }
   } else {
     std::cout << "No detection of encryption with ECB mode, as no detected "
@@ -137,78 +144,195 @@ int main(void) {
   return 0;
 }
 /******************************************************************************/
-/* this function makes the conversion from a string into a vector of bytes,
-in the end it just returns*/
-void convertStringToVectorBytes(const std::string &s,
-                                std::vector<unsigned char> &v) {
-  int i, size = s.size();
-  for (i = 0; i < size; ++i) {
-    v.emplace_back(s[i]);
+/* this function decodes the blockSize bytes of the 2 * blockSize hexadecimal
+characters starting at p into block, it returns true if all the characters
+are hexadecimal, false otherwise */
+bool decodeHexBlock(const char *p, unsigned char *block) {
+  int nibble[2];
+  unsigned int i, j;
+  for (i = 0; i < blockSize; ++i, p += 2) {
+    for (j = 0; j < 2; ++j) {
+      if (p[j] >= '0' && p[j] <= '9') {
+        nibble[j] = p[j] - '0';
+      } else if (p[j] >= 'a' && p[j] <= 'f') {
+        nibble[j] = 10 + p[j] - 'a';
+      } else if (p[j] >= 'A' && p[j] <= 'F') {
+        nibble[j] = 10 + p[j] - 'A';
+      } else {
+        return false;
+      }
+    }
+    block[i] = nibble[0] * 16 + nibble[1];
   }
-  return;
+  return true;
 }
 /******************************************************************************/
-/* this function makes the fulling of the string s based on the content of the
-vector v */
-void convertVectorBytesToString(const std::vector<unsigned char> &v,
-                                std::string &s) {
-  int i, size = v.size();
-  for (i = 0; i < size; ++i) {
-    s += v[i];
+/* this function empties the set and makes sure it has at least twice as many
+slots as the nBlocks blocks that will be inserted into it */
+void clearBlockSet(blockSetId &set, const std::size_t nBlocks) {
+  std::size_t nSlots = std::max<std::size_t>(set.keys.size(), 16);
+  while (nSlots < 2 * nBlocks) {
+    nSlots *= 2;
+  }
+  ++set.stamp;
+  if (nSlots != set.keys.size() || set.stamp == 0) {
+    /* new slots, or the stamps wrapped around, every slot is made empty */
+    set.keys.resize(nSlots);
+    set.stamps.assign(nSlots, 0);
+    set.stamp = 1;
+    set.mask = nSlots - 1;
   }
   return;
 }
 /******************************************************************************/
-/* this function does the decode from hexadecimal into bytes, returning the
-result by reference in a vector of unsigned char */
-void decodeHexToByte(std::string &s, std::vector<unsigned char> &output) {
-  if (s.size() % 2 != 0) {
-    /* zero padding */
-    s.push_back('0');
-  }
-  output.clear();
-  unsigned char c;
-  std::string binary;
-  size_t size = s.size(), i;
-  for (i = 0; i < size; i += 2) {
-    /* extract two characters from hex string */
-    binary.clear();
-    binary = s.substr(i, 2);
-    /* change it into base 16 and typecast as the character */
-    c = stoul(binary, nullptr, 16);
-    output.emplace_back(c);
+/* this function inserts the block into the set, it returns true if the block
+was already in the set, false otherwise */
+bool insertBlock(blockSetId &set, const blockKeyId &block) {
+  /* the blocks of plaintext records are far from random, so both halves of
+  the key are mixed into the slot */
+  std::uint64_t h = (block.low ^ (block.high * 0x9e3779b97f4a7c15ULL)) *
+                    0xff51afd7ed558ccdULL;
+  std::size_t slot = (h ^ (h >> 32)) & set.mask;
+  while (set.stamps[slot] == set.stamp) {
+    if (set.keys[slot].low == block.low && set.keys[slot].high == block.high) {
+      return true;
+    }
+    slot = (slot + 1) & set.mask;
   }
-  return;
+  set.stamps[slot] = set.stamp;
+  set.keys[slot] = block;
+  return false;
 }
 /******************************************************************************/
-/* this function makes the test if  there is repetition of the blocks in the
-cypertext, of block size, if yes then it will return true, false otherwise,
-if there is an error in the function, flag error will be set to true, false
-otherwise */
-bool testLineForRepeatedEncryption(const std::vector<unsigned char> &asciiLineV,
-                                   const unsigned int blockSize,
-                                   bool *flagError) {
-  if (blockSize == 0 || asciiLineV.size() % blockSize != 0) {
-    *flagError = true;
+/* this function makes the count of the repeated blocks of the hexadecimal
+record [begin, end), with one pass over its blocks and the set, in the end it
+returns true if the record is a non empty hexadecimal string with a whole
+number of blocks, false otherwise */
+bool scoreRecord(const char *begin, const char *end, blockSetId &set,
+                 recordScoreId &record) {
+  unsigned char bytes[blockSize];
+  blockKeyId block;
+  std::size_t size, i;
+  /* lines written on windows end in "\r\n" */
+  if (begin != end && *(end - 1) == '\r') {
+    --end;
+  }
+  size = end - begin;
+  if (size == 0 || size % (2 * blockSize) != 0) {
     return false;
   }
-  int i, j, size = asciiLineV.size(), nBlocks;
-  nBlocks = size / blockSize;
-  std::set<std::string> s;
-  std::string aux;
-  for (i = 0; i < nBlocks; ++i) {
-    for (j = 0; j < (int)blockSize; ++j) {
-      aux.push_back(asciiLineV[i * blockSize + j]);
+  record.nBlocks = size / (2 * blockSize);
+  record.nRepeatedBlocks = 0;
+  clearBlockSet(set, record.nBlocks);
+  for (i = 0; i < record.nBlocks; ++i) {
+    if (decodeHexBlock(begin + i * 2 * blockSize, bytes) == false) {
+      return false;
+    }
+    memcpy(&block, bytes, blockSize);
+    if (insertBlock(set, block) == true) {
+      ++record.nRepeatedBlocks;
+    }
+  }
+  record.repetitionRatio =
+      static_cast<double>(record.nRepeatedBlocks) / record.nBlocks;
+  return true;
+}
+/******************************************************************************/
+/* this function scores every record of the chunk [begin, end) of the input,
+the chunk starts at the beginning of a line, in the end it returns the records
+with repeated blocks and the number of lines and invalid lines of the chunk in
+result */
+void scanChunk(const char *begin, const char *end, chunkResultId *result) {
+  blockSetId set = {};
+  recordScoreId record;
+  const char *lineEnd;
+  long lineNumber = 0;
+  result->nInvalidLines = 0;
+  while (begin < end) {
+    lineEnd = static_cast<const char *>(memchr(begin, '\n', end - begin));
+    if (lineEnd == nullptr) {
+      lineEnd = end;
+    }
+    /* empty lines are not records, but they still count as lines */
+    if (lineEnd != begin && !(lineEnd - begin == 1 && *begin == '\r')) {
+      if (scoreRecord(begin, lineEnd, set, record) == false) {
+        ++result->nInvalidLines;
+      } else if (record.nRepeatedBlocks != 0) {
+        record.lineNumber = lineNumber;
+        result->ecbRecords.emplace_back(record);
+      }
     }
-    s.insert(aux);
-    aux.clear();
+    ++lineNumber;
+    begin = lineEnd + 1;
+  }
+  result->nLines = lineNumber;
+  return;
+}
+/******************************************************************************/
+/* this function memory maps the file fileName, splits it on line boundaries
+between the available threads and returns in ecbRecords the records of the
+whole file with repeated blocks, sorted by line number, and the number of
+lines that are not valid records by reference, it returns true if all ok or
+false otherwise */
+bool detectEcbRecords(const char *fileName,
+                      std::vector<recordScoreId> &ecbRecords,
+                      long *nInvalidLines) {
+  struct stat fileStat;
+  int fd = open(fileName, O_RDONLY), i, nChunks;
+  long firstLine = 1;
+  ecbRecords.clear();
+  *nInvalidLines = 0;
+  if (fd < 0) {
+    return false;
   }
-  /* return value calculation */
-  *flagError = false;
-  if ((int)s.size() == nBlocks) {
+  if (fstat(fd, &fileStat) != 0) {
+    close(fd);
     return false;
-  } else {
+  }
+  std::size_t size = fileStat.st_size, position;
+  if (size == 0) {
+    close(fd);
     return true;
   }
+  void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  madvise(map, size, MADV_SEQUENTIAL);
+  const char *data = static_cast<const char *>(map), *next;
+  nChunks = std::max(1u, std::thread::hardware_concurrency());
+  /* every chunk ends right after a new line, or at the end of the file */
+  std::vector<const char *> boundaries(nChunks + 1, data + size);
+  boundaries[0] = data;
+  for (i = 1; i < nChunks; ++i) {
+    position = std::max(size * i / nChunks,
+                        static_cast<std::size_t>(boundaries[i - 1] - data));
+    next = static_cast<const char *>(
+        memchr(data + position, '\n', size - position));
+    boundaries[i] = next == nullptr ? data + size : next + 1;
+  }
+  std::vector<chunkResultId> results(nChunks);
+  std::vector<std::thread> workers;
+  for (i = 0; i < nChunks; ++i) {
+    workers.emplace_back(scanChunk, boundaries[i], boundaries[i + 1],
+                         &results[i]);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  munmap(map, size);
+  /* the chunks are in file order, so the records stay sorted by line number
+  once the line numbers of every chunk start after the lines of the previous
+  chunks */
+  for (i = 0; i < nChunks; ++i) {
+    for (recordScoreId &record : results[i].ecbRecords) {
+      record.lineNumber += firstLine;
+      ecbRecords.emplace_back(record);
+    }
+    firstLine += results[i].nLines;
+    *nInvalidLines += results[i].nInvalidLines;
+  }
+  return true;
 }
 /******************************************************************************/
@@ -1,3 +1,3 @@
 #!/bin/bash
-g++ -Wall -std=c++17 cryptopals_set_1_problem_8.cpp -o cryptopals_set_1_problem_8 -lcrypto
+g++ -Wall -O2 -std=c++17 cryptopals_set_1_problem_8.cpp -o cryptopals_set_1_problem_8 -lcrypto -pthread
 ./cryptopals_set_1_problem_8
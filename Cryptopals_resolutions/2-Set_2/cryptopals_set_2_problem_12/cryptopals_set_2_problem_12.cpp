@@ -3,6 +3,7 @@
 #include <bits/stdc++.h>
 #include <cctype>
 #include <cstddef>
+#include <cstdint>
 #include <ctype.h>
 #include <fstream>
 #include <iostream>
@@ -12,6 +13,7 @@
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <random>
+#include <stdexcept>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,6 +32,46 @@ typedef struct {
   std::string encryptionMode; /* 'ECB' or 'CBC' */
 } oracleID;
 
+const unsigned int nCandidateBlocks = 256; /* one candidate per last byte */
+
+/* flat open addressing hash table keyed on a cyphertext block of blockSize
+bytes, it maps the encryption of every candidate block into the value of the
+last byte of that candidate, the same structure as in problem 14 */
+class BlockDictionary {
+public:
+  /* constructor / destructor, capacity is the maximum number of entries that
+  the dictionary can hold */
+  BlockDictionary(unsigned int blockSize, unsigned int capacity);
+  ~BlockDictionary();
+
+  /* this function removes every entry of the dictionary, keeping the memory
+  allocated */
+  void clear();
+
+  /* this function inserts the block with the given value, replacing the value
+  if the block is already present, it returns true if all ok or false if the
+  dictionary is full */
+  bool insert(const unsigned char *block, unsigned char value);
+
+  /* this function looks up the block, it returns true and its value by
+  reference if the block is present, false otherwise */
+  bool find(const unsigned char *block, unsigned char &value) const;
+
+  /* getters */
+  unsigned int getSize() const;
+
+private:
+  /* this function returns the first slot to probe for the block */
+  std::size_t slotOf(const unsigned char *block) const;
+
+  unsigned int _blockSize, _capacity, _size;
+  unsigned int _shift; // 64 - log2(number of slots)
+  std::size_t _mask;
+  std::vector<unsigned char> _keys; // number of slots * _blockSize bytes
+  std::vector<unsigned char> _values;
+  std::vector<bool> _used;
+};
+
 /* this field contains the alphabet of the base64 format */
 const std::string base64CharsDecoder =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -66,9 +108,10 @@ bool getBlockCypherSize(int &blockCypherSize);
 end it returns true if all ok or false otherwise */
 bool plaintextFilling(std::vector<unsigned char> &v, const int size);
 
-/* this function makes the population of the dictionary, and in the end it
-returns true if no error or false otherwise */
-bool populateDictionary(std::map<std::string, int> &dictionary,
+/* this function makes the population of the dictionary, all the candidate
+blocks 'knownStringV || c' are laid out in a single buffer and encrypted with
+one EVP call, and in the end it returns true if no error or false otherwise */
+bool populateDictionary(BlockDictionary &dictionary,
                         const std::vector<unsigned char> &knownStringV,
                         const int blockSize, unsigned char *key,
                         unsigned char *iv);
@@ -113,6 +156,14 @@ bool xorFunction(const std::vector<unsigned char> &vS1,
 
 void handleErrors(void);
 
+/* this function does the encryption of nBlocks contiguous blocks, already
+padded, in aes-ecb mode with a single cipher context and a single
+EVP_EncryptUpdate call, in the end it returns true if all ok or false
+otherwise */
+bool aesEcbEncryptBlocks(const unsigned char *plaintext, int nBlocks,
+                         const int blockSize, const unsigned char *key,
+                         unsigned char *cyphertext);
+
 int aesEcbEncryptWorker(unsigned char *plaintext, int plaintextLen,
                         const unsigned char *key, const unsigned char *iv,
                         unsigned char *cyphertext);
@@ -478,9 +529,10 @@ bool plaintextFilling(std::vector<unsigned char> &v, const int size) {
   return true;
 }
 /******************************************************************************/
-/* this function makes the population of the dictionary, and in the end it
-returns true if no error or false otherwise */
-bool populateDictionary(std::map<std::string, unsigned char> &dictionary,
+/* this function makes the population of the dictionary, all the candidate
+blocks 'knownStringV || c' are laid out in a single buffer and encrypted with
+one EVP call, and in the end it returns true if no error or false otherwise */
+bool populateDictionary(BlockDictionary &dictionary,
                         const std::vector<unsigned char> &knownStringV,
                         const int blockSize, unsigned char *key,
                         unsigned char *iv) {
@@ -488,39 +540,30 @@ bool populateDictionary(std::map<std::string, unsigned char> &dictionary,
       key == nullptr || iv == nullptr) {
     return false;
   }
-  int i, j;
+  int i;
   bool b;
-  std::string encryptedText, encryptedTextNotPadded;
-  std::vector<unsigned char> plaintextV, plaintextVPadded;
-  /* clear dictionary */
+  std::vector<unsigned char> candidateBlocksV(nCandidateBlocks * blockSize);
+  std::vector<unsigned char> encryptedBlocksV(nCandidateBlocks * blockSize);
+  /* candidateBlocksV fulling, one block per value of the last byte */
+  for (i = 0; i < (int)nCandidateBlocks; ++i) {
+    copy(knownStringV.begin(), knownStringV.end(),
+         candidateBlocksV.begin() + i * blockSize);
+    candidateBlocksV[i * blockSize + blockSize - 1] = (unsigned char)i;
+  }
+  b = aesEcbEncryptBlocks(candidateBlocksV.data(), nCandidateBlocks, blockSize,
+                          key, encryptedBlocksV.data());
+  if (b == false) {
+    perror("There was a problem in the function 'aesEcbEncryptBlocks'.");
+    return false;
+  }
+  /* update dictionary with the encrypted blocks and the last byte */
   dictionary.clear();
-  /* plaintextV fulling */
-  for (i = 0; i < (int)knownStringV.size(); ++i) {
-    plaintextV.push_back(knownStringV[i]);
-  }
-  /* last byte fulling */
-  plaintextV.push_back(0);
-  for (i = 0; i < 255; ++i) {
-    plaintextV[blockSize - 1] = i;
-    /* pass vector to padd afterwars */
-    plaintextVPadded.clear();
-    copy(plaintextV.begin(), plaintextV.end(), back_inserter(plaintextVPadded));
-    b = padPKCS_7(plaintextVPadded, blockSize);
+  for (i = 0; i < (int)nCandidateBlocks; ++i) {
+    b = dictionary.insert(&encryptedBlocksV[i * blockSize], (unsigned char)i);
     if (b == false) {
-      perror("There was a problem in the function 'padPKCS_7'");
+      perror("There was a problem in the function 'BlockDictionary::insert'.");
       return false;
     }
-    encryptedText = aesEcbEncryption(plaintextVPadded, blockSize, key, iv, &b);
-    if (b == false) {
-      perror("There was a problem in the function 'aesEcbEncryption'.");
-      return false;
-    }
-    /* update dictionary with the encrypted text and the last byte */
-    encryptedTextNotPadded.clear();
-    for (j = 0; j < blockSize; ++j) {
-      encryptedTextNotPadded += encryptedText[j];
-    }
-    dictionary[encryptedTextNotPadded] = (unsigned char)i;
   }
   return true;
 }
@@ -640,28 +683,25 @@ bool decryptTextRound(const std::vector<unsigned char> &knownStringV,
   if (blockSize < 1 || keyV == nullptr || iv == nullptr) {
     return false;
   }
-  int i;
-  std::vector<unsigned char> previousVectorKnow;
-  std::map<std::string, unsigned char> dictionary;
-  std::string keyD;
-  bool flag;
-  for (i = 0; i < (int)knownStringV.size(); ++i) {
-    previousVectorKnow.push_back(knownStringV[i]);
+  if ((int)encryptedTextV.size() < blockSize) {
+    return false;
   }
+  BlockDictionary dictionary(blockSize, nCandidateBlocks);
+  unsigned char byteFound;
+  bool flag;
   /* dictionary calculation */
-  flag =
-      populateDictionary(dictionary, previousVectorKnow, blockSize, keyV, iv);
+  flag = populateDictionary(dictionary, knownStringV, blockSize, keyV, iv);
   if (flag == false) {
     perror("There was a problem in the function 'populateDictionary'.");
     return false;
   }
-  /* key calculation */
-  keyD.clear();
-  for (i = 0; i < blockSize; ++i) {
-    keyD += encryptedTextV[i];
+  /* lookup of the first cyphertext block */
+  flag = dictionary.find(&encryptedTextV[0], byteFound);
+  if (flag == false) {
+    perror("The cyphertext block was not found in the dictionary.");
+    return false;
   }
-  decryptedText += dictionary[keyD];
-  previousVectorKnow.push_back(dictionary[keyD]);
+  decryptedText += byteFound;
   return true;
 }
 /*******************************************************************************/
@@ -726,6 +766,87 @@ bool xorFunction(const std::vector<unsigned char> &vS1,
   return true;
 }
 /******************************************************************************/
+/* BlockDictionary constructor / destructor */
+BlockDictionary::BlockDictionary(unsigned int blockSize, unsigned int capacity)
+    : _blockSize(blockSize), _capacity(capacity), _size(0) {
+  if (blockSize < 1) {
+    throw std::invalid_argument("block size must be positive.");
+  } else if (capacity < 1) {
+    throw std::invalid_argument("capacity must be positive.");
+  }
+  std::size_t nSlots = 1;
+  _shift = 64;
+  /* keep the load factor at or below 1/2 so that probe chains stay short */
+  while (nSlots < 2 * (std::size_t)capacity) {
+    nSlots <<= 1;
+    --_shift;
+  }
+  _mask = nSlots - 1;
+  _keys.resize(nSlots * _blockSize);
+  _values.resize(nSlots);
+  _used.resize(nSlots, false);
+}
+/******************************************************************************/
+BlockDictionary::~BlockDictionary() {}
+/******************************************************************************/
+/* this function removes every entry of the dictionary, keeping the memory
+allocated */
+void BlockDictionary::clear() {
+  std::fill(_used.begin(), _used.end(), false);
+  _size = 0;
+}
+/******************************************************************************/
+/* this function inserts the block with the given value, replacing the value
+if the block is already present, it returns true if all ok or false if the
+dictionary is full */
+bool BlockDictionary::insert(const unsigned char *block, unsigned char value) {
+  std::size_t slot = BlockDictionary::slotOf(block);
+  while (_used[slot]) {
+    if (memcmp(&_keys[slot * _blockSize], block, _blockSize) == 0) {
+      _values[slot] = value;
+      return true;
+    }
+    slot = (slot + 1) & _mask;
+  }
+  if (_size == _capacity) {
+    return false;
+  }
+  memcpy(&_keys[slot * _blockSize], block, _blockSize);
+  _values[slot] = value;
+  _used[slot] = true;
+  ++_size;
+  return true;
+}
+/******************************************************************************/
+/* this function looks up the block, it returns true and its value by
+reference if the block is present, false otherwise */
+bool BlockDictionary::find(const unsigned char *block,
+                           unsigned char &value) const {
+  std::size_t slot = BlockDictionary::slotOf(block);
+  while (_used[slot]) {
+    if (memcmp(&_keys[slot * _blockSize], block, _blockSize) == 0) {
+      value = _values[slot];
+      return true;
+    }
+    slot = (slot + 1) & _mask;
+  }
+  return false;
+}
+/******************************************************************************/
+/* getters */
+unsigned int BlockDictionary::getSize() const { return _size; }
+/******************************************************************************/
+/* this function returns the first slot to probe for the block, hashing its
+first 8 bytes with a multiplicative (fibonacci) hash */
+std::size_t BlockDictionary::slotOf(const unsigned char *block) const {
+  std::uint64_t h = 0;
+  memcpy(&h, block, std::min<std::size_t>(sizeof(h), _blockSize));
+  if (_shift == 64) {
+    return 0;
+  }
+  return (std::size_t)((h * 0x9E3779B97F4A7C15ULL) >> _shift) & _mask;
+}
+/******************************************************************************/
 void handleErrors(void) {
   ERR_print_errors_fp(stderr);
   abort();
@@ -772,6 +893,39 @@ int aesEcbEncryptWorker(unsigned char *plaintext, int plaintextLen,
   return cyphertextLen;
 }
 /******************************************************************************/
+/* this function does the encryption of nBlocks contiguous blocks, already
+padded, in aes-ecb mode with a single cipher context and a single
+EVP_EncryptUpdate call, in the end it returns true if all ok or false
+otherwise */
+bool aesEcbEncryptBlocks(const unsigned char *plaintext, int nBlocks,
+                         const int blockSize, const unsigned char *key,
+                         unsigned char *cyphertext) {
+  if (plaintext == nullptr || key == nullptr || cyphertext == nullptr ||
+      nBlocks < 0 || blockSize != EVP_CIPHER_block_size(EVP_aes_128_ecb())) {
+    return false;
+  } else if (nBlocks == 0) {
+    return true;
+  }
+  EVP_CIPHER_CTX *ctx;
+  int len = 0;
+  /* Create and initialise the context */
+  if (!(ctx = EVP_CIPHER_CTX_new())) {
+    handleErrors();
+  }
+  if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_128_ecb(), NULL, key, NULL)) {
+    handleErrors();
+  }
+  /* the plaintext is already padded, every block is encrypted as is */
+  EVP_CIPHER_CTX_set_padding(ctx, 0);
+  if (1 != EVP_EncryptUpdate(ctx, cyphertext, &len, plaintext,
+                             nBlocks * blockSize)) {
+    handleErrors();
+  }
+  /* Clean up */
+  EVP_CIPHER_CTX_free(ctx);
+  return len == nBlocks * blockSize;
+}
+/******************************************************************************/
 /* this function makes the padding using PKCS#7 format, in the end it will
 return the padding result by reference in the v vector and by value true if all
 ok or false otherwise */
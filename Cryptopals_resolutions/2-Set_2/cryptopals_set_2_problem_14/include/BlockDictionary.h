@@ -0,0 +1,46 @@
+#ifndef BLOCK_DICTIONARY_H
+#define BLOCK_DICTIONARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* flat open addressing hash table keyed on a cyphertext block of blockSize
+bytes, it maps the encryption of every candidate block into the value of the
+last byte of that candidate */
+class BlockDictionary {
+public:
+  /* constructor / destructor, capacity is the maximum number of entries that
+  the dictionary can hold */
+  BlockDictionary(unsigned int blockSize, unsigned int capacity);
+  ~BlockDictionary();
+
+  /* this function removes every entry of the dictionary, keeping the memory
+  allocated */
+  void clear();
+
+  /* this function inserts the block with the given value, replacing the value
+  if the block is already present, it returns true if all ok or false if the
+  dictionary is full */
+  bool insert(const unsigned char *block, unsigned char value);
+
+  /* this function looks up the block, it returns true and its value by
+  reference if the block is present, false otherwise */
+  bool find(const unsigned char *block, unsigned char &value) const;
+
+  /* getters */
+  unsigned int getSize() const;
+
+private:
+  /* this function returns the first slot to probe for the block */
+  std::size_t slotOf(const unsigned char *block) const;
+
+  unsigned int _blockSize, _capacity, _size;
+  unsigned int _shift; // 64 - log2(number of slots)
+  std::size_t _mask;
+  std::vector<unsigned char> _keys; // number of slots * _blockSize bytes
+  std::vector<unsigned char> _values;
+  std::vector<bool> _used;
+};
+
+#endif
@@ -25,6 +25,7 @@
 #include <iterator> // for back_inserter
 #include <memory>
 
+#include "./../include/BlockDictionary.h"
 #include "./../include/RandomPrefixWorker.h"
 
 typedef struct {
@@ -39,6 +40,7 @@ const unsigned int blockSize = 16; /* AES block size: 16 bytes = 128 bits */
 const unsigned int maxBlockSize = 40;
 const unsigned int appendBytesNumber = 5; /* number of bytes to add at the beggining and at the end, 'x|Message|x' */
 const bool debugFlag = false, debugFlagExtreme = false;
+const unsigned int nCandidateBlocks = 256; /* one candidate per last byte value */
 
 namespace Function {
 
@@ -67,9 +69,11 @@ namespace Function {
   end it returns true if all ok or false otherwise */
   bool plaintextFilling(std::vector<unsigned char> &v, const int size);
 
-  /* this function makes the population of the dictionary, and in the end it
-  returns true if no error or false otherwise */
-  bool populateDictionary(std::map<std::string, unsigned char> &dictionary,
+  /* this function makes the population of the dictionary, all the candidate
+  blocks 'knownStringV || c' are laid out in a single buffer and encrypted with
+  one query to the oracle, and in the end it returns true if no error or false
+  otherwise */
+  bool populateDictionary(BlockDictionary &dictionary,
     const std::vector<unsigned char> &knownStringV, const int blockSize,
     const std::shared_ptr<RandomPrefixWorker>&randomPrefixWork,
     const int sizeRandomPrefixGuess);
@@ -114,6 +118,13 @@ namespace Function {
   int aesEcbEncryptWorker(unsigned char *plaintext, int plaintextLen, unsigned char *key,
               unsigned char *iv, unsigned char *cyphertext);
 
+  /* this function does the encryption of nBlocks contiguous blocks, already
+  padded, in aes-ecb mode with a single cipher context and a single
+  EVP_EncryptUpdate call, in the end it returns true if all ok or false
+  otherwise */
+  bool aesEcbEncryptBlocks(const unsigned char *plaintext, int nBlocks,
+    const int blockSize, const unsigned char *key, unsigned char *cyphertext);
+
   /* this function makes the padding using PKCS#7 format, in the end it will return
   the padding result by reference in the v vector and by value true if all ok or
   false otherwise */
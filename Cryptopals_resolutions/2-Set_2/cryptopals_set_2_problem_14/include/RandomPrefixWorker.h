@@ -36,9 +36,10 @@ public:
     is equal to the randomPrefixSize, false otherwise */
     bool testRandomPrefixSize(int randomPrefixSizeGuess);
 
-    /* this function does the encryption of aes-cbc mode using the iv and key values,
-    in the end it returns the decrypted text and sets flag b by reference to true if
-    no errors or to false otherwise */
+    /* this function does the encryption of aes-ecb mode using the key value,
+    the random prefix is added and the whole padded plaintext is encrypted with a
+    single EVP call, in the end it returns the encrypted text and sets flag b by
+    reference to true if no errors or to false otherwise */
     std::string aesEcbEncryption(const std::vector<unsigned char> &plainTextBytesAsciiFullText, bool *b);
 
     /* getters */
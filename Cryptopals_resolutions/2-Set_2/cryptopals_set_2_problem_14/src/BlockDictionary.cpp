@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+#include "./../include/BlockDictionary.h"
+
+/* constructor / destructor */
+BlockDictionary::BlockDictionary(unsigned int blockSize, unsigned int capacity)
+    : _blockSize(blockSize), _capacity(capacity), _size(0) {
+  if (blockSize < 1) {
+    throw std::invalid_argument("block size must be positive.");
+  } else if (capacity < 1) {
+    throw std::invalid_argument("capacity must be positive.");
+  }
+  std::size_t nSlots = 1;
+  _shift = 64;
+  /* keep the load factor at or below 1/2 so that probe chains stay short */
+  while (nSlots < 2 * (std::size_t)capacity) {
+    nSlots <<= 1;
+    --_shift;
+  }
+  _mask = nSlots - 1;
+  _keys.resize(nSlots * _blockSize);
+  _values.resize(nSlots);
+  _used.resize(nSlots, false);
+}
+/******************************************************************************/
+BlockDictionary::~BlockDictionary() {}
+/******************************************************************************/
+/* this function removes every entry of the dictionary, keeping the memory
+allocated */
+void BlockDictionary::clear() {
+  std::fill(_used.begin(), _used.end(), false);
+  _size = 0;
+}
+/******************************************************************************/
+/* this function inserts the block with the given value, replacing the value
+if the block is already present, it returns true if all ok or false if the
+dictionary is full */
+bool BlockDictionary::insert(const unsigned char *block, unsigned char value) {
+  std::size_t slot = BlockDictionary::slotOf(block);
+  while (_used[slot]) {
+    if (memcmp(&_keys[slot * _blockSize], block, _blockSize) == 0) {
+      _values[slot] = value;
+      return true;
+    }
+    slot = (slot + 1) & _mask;
+  }
+  if (_size == _capacity) {
+    return false;
+  }
+  memcpy(&_keys[slot * _blockSize], block, _blockSize);
+  _values[slot] = value;
+  _used[slot] = true;
+  ++_size;
+  return true;
+}
+/******************************************************************************/
+/* this function looks up the block, it returns true and its value by
+reference if the block is present, false otherwise */
+bool BlockDictionary::find(const unsigned char *block,
+                           unsigned char &value) const {
+  std::size_t slot = BlockDictionary::slotOf(block);
+  while (_used[slot]) {
+    if (memcmp(&_keys[slot * _blockSize], block, _blockSize) == 0) {
+      value = _values[slot];
+      return true;
+    }
+    slot = (slot + 1) & _mask;
+  }
+  return false;
+}
+/******************************************************************************/
+/* getters */
+unsigned int BlockDictionary::getSize() const { return _size; }
+/******************************************************************************/
+/* this function returns the first slot to probe for the block, hashing its
+first 8 bytes with a multiplicative (fibonacci) hash */
+std::size_t BlockDictionary::slotOf(const unsigned char *block) const {
+  std::uint64_t h = 0;
+  memcpy(&h, block, std::min<std::size_t>(sizeof(h), _blockSize));
+  if (_shift == 64) {
+    return 0;
+  }
+  return (std::size_t)((h * 0x9E3779B97F4A7C15ULL) >> _shift) & _mask;
+}
+/******************************************************************************/
@@ -235,58 +235,52 @@ bool Function::plaintextFilling(std::vector<unsigned char> &v, const int size) {
   return true;
 }
 /******************************************************************************/
-/* this function makes the population of the dictionary, and in the end it
-returns true if no error or false otherwise */
+/* this function makes the population of the dictionary, all the candidate
+blocks 'knownStringV || c' are laid out in a single buffer and encrypted with
+one query to the oracle, and in the end it returns true if no error or false
+otherwise */
 bool Function::populateDictionary(
-    std::map<std::string, unsigned char> &dictionary,
-    const std::vector<unsigned char> &knownStringV, const int blockSize,
+    BlockDictionary &dictionary, const std::vector<unsigned char> &knownStringV,
+    const int blockSize,
     const std::shared_ptr<RandomPrefixWorker> &randomPrefixWork,
     const int sizeRandomPrefixGuess) {
-  if (blockSize < 1 || randomPrefixWork.get() == nullptr) {
+  if (blockSize < 1 || (int)knownStringV.size() != blockSize - 1 ||
+      sizeRandomPrefixGuess < 0 || sizeRandomPrefixGuess > blockSize ||
+      randomPrefixWork.get() == nullptr) {
     return false;
   }
-  int i, j;
+  int i, nDummyBytes = blockSize - sizeRandomPrefixGuess;
   bool b;
-  std::string encryptedText, encryptedTextNotPadded;
-  std::vector<unsigned char> plaintextV, plaintextVPadded, encryptedTextV;
-  /* clear dictionary */
+  std::string encryptedText;
+  /* dummy bytes to fill the first block of the cyphertext, followed by the
+  candidate blocks */
+  std::vector<unsigned char> candidateBlocksV(
+      nDummyBytes + nCandidateBlocks * blockSize, 0);
+  unsigned char *candidateBlock;
+  for (i = 0; i < (int)nCandidateBlocks; ++i) {
+    candidateBlock = &candidateBlocksV[nDummyBytes + i * blockSize];
+    std::copy(knownStringV.begin(), knownStringV.end(), candidateBlock);
+    candidateBlock[blockSize - 1] = (unsigned char)i;
+  }
+  encryptedText = randomPrefixWork->aesEcbEncryption(candidateBlocksV, &b);
+  if (b == false) {
+    perror("There was a problem in the function 'aesEcbEncryption'.");
+    return false;
+  } else if (encryptedText.size() < (nCandidateBlocks + 1) * blockSize) {
+    perror("The oracle returned less blocks than the candidate blocks sent.");
+    return false;
+  }
+  /* update dictionary with the encrypted blocks, skipping the first block
+  that holds the random prefix */
   dictionary.clear();
-  /* plaintextV fulling */
-  for (i = 0; i < (int)knownStringV.size(); ++i) {
-    plaintextV.push_back(knownStringV[i]);
-  }
-  /* last byte fulling */
-  plaintextV.push_back(0);
-  for (i = 0; i < 255; ++i) {
-    plaintextV[blockSize - 1] = i;
-    /* pass vector to padd afterwars */
-    plaintextVPadded.clear();
-    copy(plaintextV.begin(), plaintextV.end(), back_inserter(plaintextVPadded));
-    /* padd plaintext before encryption */
-    b = Function::padPKCS_7(plaintextVPadded, blockSize);
-    if (b == false) {
-      perror("There was an error in the function 'padPKCS_7'.");
-      return false;
-    }
-    /* add dummy bytes to fill the first block of the cyphertext */
-    encryptedText.clear();
-    plaintextVPadded.insert(plaintextVPadded.begin(),
-                            blockSize - sizeRandomPrefixGuess, 0);
-    encryptedText = randomPrefixWork->aesEcbEncryption(plaintextVPadded, &b);
+  for (i = 0; i < (int)nCandidateBlocks; ++i) {
+    b = dictionary.insert(
+        (const unsigned char *)&encryptedText[(i + 1) * blockSize],
+        (unsigned char)i);
     if (b == false) {
-      perror("There was a problem in the function 'aesEcbEncryption'.");
+      perror("There was a problem in the function 'BlockDictionary::insert'.");
       return false;
     }
-    Function::convertStringToVectorBytes(encryptedText, encryptedTextV);
-    /* remove first block from the vector encryptedTextV before decryption */
-    encryptedTextV.erase(encryptedTextV.begin(),
-                         encryptedTextV.begin() + blockSize);
-    /* update dictionary with the encrypted text and the last byte */
-    encryptedTextNotPadded.clear();
-    for (j = 0; j < blockSize; ++j) {
-      encryptedTextNotPadded += encryptedTextV[j];
-    }
-    dictionary[encryptedTextNotPadded] = (unsigned char)i;
   }
   return true;
 }
@@ -422,28 +416,26 @@ bool Function::decryptTextRound(
       sizeRandomPrefixGuess > blockSize || randomPrefixWork.get() == nullptr) {
     return false;
   }
-  int i;
-  std::vector<unsigned char> previousVectorKnow;
-  std::map<std::string, unsigned char> dictionary;
-  std::string keyD;
-  bool flag;
-  for (i = 0; i < (int)knownStringV.size(); ++i) {
-    previousVectorKnow.push_back(knownStringV[i]);
+  if ((int)encryptedTextV.size() < blockSize) {
+    return false;
   }
+  BlockDictionary dictionary(blockSize, nCandidateBlocks);
+  unsigned char byteFound;
+  bool flag;
   /* dictionary calculation */
-  flag = Function::populateDictionary(dictionary, previousVectorKnow, blockSize,
+  flag = Function::populateDictionary(dictionary, knownStringV, blockSize,
                                       randomPrefixWork, sizeRandomPrefixGuess);
   if (flag == false) {
     perror("There was a problem in the function 'populateDictionary'.");
     return false;
   }
-  /* key calculation */
-  keyD.clear();
-  for (i = 0; i < blockSize; ++i) {
-    keyD += encryptedTextV[i];
+  /* lookup of the first cyphertext block */
+  flag = dictionary.find(&encryptedTextV[0], byteFound);
+  if (flag == false) {
+    perror("The cyphertext block was not found in the dictionary.");
+    return false;
   }
-  decryptedText += dictionary[keyD];
-  previousVectorKnow.push_back(dictionary[keyD]);
+  decryptedText += byteFound;
   return true;
 }
 /*******************************************************************************/
@@ -555,6 +547,40 @@ int Function::aesEcbEncryptWorker(unsigned char *plaintext, int plaintextLen,
   return cyphertextLen;
 }
 /******************************************************************************/
+/* this function does the encryption of nBlocks contiguous blocks, already
+padded, in aes-ecb mode with a single cipher context and a single
+EVP_EncryptUpdate call, in the end it returns true if all ok or false
+otherwise */
+bool Function::aesEcbEncryptBlocks(const unsigned char *plaintext, int nBlocks,
+                                   const int blockSize,
+                                   const unsigned char *key,
+                                   unsigned char *cyphertext) {
+  if (plaintext == nullptr || key == nullptr || cyphertext == nullptr ||
+      nBlocks < 0 || blockSize != EVP_CIPHER_block_size(EVP_aes_128_ecb())) {
+    return false;
+  } else if (nBlocks == 0) {
+    return true;
+  }
+  EVP_CIPHER_CTX *ctx;
+  int len = 0;
+  /* Create and initialise the context */
+  if (!(ctx = EVP_CIPHER_CTX_new())) {
+    Function::handleErrors();
+  }
+  if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_128_ecb(), NULL, key, NULL)) {
+    Function::handleErrors();
+  }
+  /* the plaintext is already padded, every block is encrypted as is */
+  EVP_CIPHER_CTX_set_padding(ctx, 0);
+  if (1 != EVP_EncryptUpdate(ctx, cyphertext, &len, plaintext,
+                             nBlocks * blockSize)) {
+    Function::handleErrors();
+  }
+  /* Clean up */
+  EVP_CIPHER_CTX_free(ctx);
+  return len == nBlocks * blockSize;
+}
+/******************************************************************************/
 /* this function makes the padding using PKCS#7 format, in the end it will
 return the padding result by reference in the v vector and by value true if all
 ok or false otherwise */
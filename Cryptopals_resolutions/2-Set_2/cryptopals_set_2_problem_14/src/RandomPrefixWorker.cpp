@@ -18,6 +18,7 @@ RandomPrefixWorker::RandomPrefixWorker(int blockSize, bool debugFlag,
   }
   _blockSize = blockSize;
   RandomPrefixWorker::setDebugFlag(debugFlag);
+  RandomPrefixWorker::setDebugFlagExtreme(debugFlagExtreme);
   RandomPrefixWorker::setRandomPrefixSize();
   RandomPrefixWorker::setKey(key);
   RandomPrefixWorker::setIV(iv);
@@ -107,9 +108,10 @@ bool RandomPrefixWorker::getDebugFlag() { return _debugFlag; }
 /******************************************************************************/
 bool RandomPrefixWorker::getDebugFlagExtreme() { return _debugFlagExtreme; }
 /******************************************************************************/
-/* this function does the encryption of aes-cbc mode using the iv and key
-values, in the end it returns the decrypted text and sets flag b by reference to
-true if no errors or to false otherwise */
+/* this function does the encryption of aes-ecb mode using the key value,
+the random prefix is added and the whole padded plaintext is encrypted with a
+single EVP call, in the end it returns the encrypted text and sets flag b by
+reference to true if no errors or to false otherwise */
 std::string RandomPrefixWorker::aesEcbEncryption(
     const std::vector<unsigned char> &plainTextBytesAsciiFullText, bool *b) {
   std::string encryptedText;
@@ -119,92 +121,35 @@ std::string RandomPrefixWorker::aesEcbEncryption(
     *b = true;
     return encryptedText;
   }
-  std::vector<unsigned char> plainTextBytesAsciiFullTextCopy;
-  std::vector<unsigned char> plainTextVector, cypherTextVector, randomPrefix;
-  unsigned char *plainTextPointer, *encryptedTextPointer;
+  std::vector<unsigned char> plainTextV, cypherTextV;
   bool flag;
-  int nCycles, size, i, j, encryptedTextLen;
-  for (i = 0; i < plainTextBytesAsciiFullText.size(); ++i) {
-    plainTextBytesAsciiFullTextCopy.push_back(plainTextBytesAsciiFullText[i]);
-  }
-  /* work to be done */
-  plainTextPointer =
-      (unsigned char *)calloc(2 * _blockSize + 1, sizeof(unsigned char));
-  if (plainTextPointer == nullptr) {
-    perror("There was a problem in the memory allocation of the "
-           "'plainTextPointer'.");
-    *b = false;
-    return encryptedText;
-  }
-  encryptedTextPointer =
-      (unsigned char *)calloc(2 * _blockSize + 1, sizeof(unsigned char));
-  if (encryptedTextPointer == nullptr) {
-    perror("There was a problem in the memory allocation of the "
-           "'encryptedTextPointer'.");
-    *b = false;
-    return encryptedText;
-  }
   /* add random prefix into plaintext */
-  randomPrefix = RandomPrefixWorker::generateRandomPrefix();
-  for (i = 0; i < plainTextBytesAsciiFullTextCopy.size(); ++i) {
-    randomPrefix.push_back(plainTextBytesAsciiFullTextCopy[i]);
-  }
-  plainTextBytesAsciiFullTextCopy.clear();
-  for (i = 0; i < randomPrefix.size(); ++i) {
-    plainTextBytesAsciiFullTextCopy.push_back(randomPrefix[i]);
-  }
+  plainTextV = RandomPrefixWorker::generateRandomPrefix();
+  plainTextV.insert(plainTextV.end(), plainTextBytesAsciiFullText.begin(),
+                    plainTextBytesAsciiFullText.end());
   /* padd plaintext before encryption */
-  flag = Function::padPKCS_7(plainTextBytesAsciiFullTextCopy, _blockSize);
+  flag = Function::padPKCS_7(plainTextV, _blockSize);
   if (flag == false) {
     perror("There was an error in the function 'padPKCS_7'.");
     *b = false;
     return encryptedText;
   }
-  size = plainTextBytesAsciiFullTextCopy.size();
-  nCycles = size / _blockSize;
-  for (i = 0; i < nCycles; ++i) {
-    /* fill plainTextPointer */
-    plainTextVector.clear();
-    for (j = 0; j < (int)_blockSize; ++j) {
-      plainTextVector.push_back(
-          plainTextBytesAsciiFullTextCopy[_blockSize * i + j]);
-    }
-    /* copy content of plainTextVector into plainTextPointer */
-    for (j = 0; j < (int)_blockSize; ++j) {
-      plainTextPointer[j] = plainTextVector[j];
-    }
-    memset(encryptedTextPointer, 0, 2 * _blockSize + 1);
-    /* Decrypt the ciphertext */
-    encryptedTextLen = Function::aesEcbEncryptWorker(
-        plainTextPointer, _blockSize, _key, _iv, encryptedTextPointer);
-    if (debugFlagExtreme == true) {
-      std::cout << "Full Decrypted ECB text size = " << encryptedTextLen
-                << std::endl;
-      BIO_dump_fp(stdout, (const char *)encryptedTextPointer, encryptedTextLen);
-    }
-    /* Add a NULL terminator. We are expecting printable text */
-    encryptedTextPointer[encryptedTextLen] = '\0';
-    /* fill cyphertext vector */
-    flag = Function::fillVectorFromPointerArray(
-        cypherTextVector, encryptedTextPointer, encryptedTextLen);
-    if (flag == false) {
-      perror(
-          "\nThere was an error in the function 'fillVectorFromPointerArray'.");
-      *b = false;
-      return encryptedText;
-    }
-    /* add cyphertext encrypted to the result */
-    for (j = 0; j < encryptedTextLen; ++j) {
-      encryptedText.push_back(cypherTextVector[j]);
-    }
+  cypherTextV.resize(plainTextV.size());
+  flag = Function::aesEcbEncryptBlocks(plainTextV.data(),
+                                       plainTextV.size() / _blockSize,
+                                       _blockSize, _key, cypherTextV.data());
+  if (flag == false) {
+    perror("There was an error in the function 'aesEcbEncryptBlocks'.");
+    *b = false;
+    return encryptedText;
   }
-  /* free memory */
-  free(plainTextPointer);
-  free(encryptedTextPointer);
-  if (debugFlagExtreme == true) {
-    std::cout << "Full Encrypted text size = " << encryptedText.size()
+  if (_debugFlagExtreme == true) {
+    std::cout << "Full Encrypted text size = " << cypherTextV.size()
               << std::endl;
+    BIO_dump_fp(stdout, (const char *)cypherTextV.data(), cypherTextV.size());
   }
+  encryptedText.assign(cypherTextV.begin(), cypherTextV.end());
+  *b = true;
   return encryptedText;
 }
 /******************************************************************************/
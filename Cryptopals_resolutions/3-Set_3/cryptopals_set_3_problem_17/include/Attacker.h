@@ -26,6 +26,8 @@
 #include <string.h>
 #include <string>
 #include <memory>
+#include <atomic>
+#include <thread>
 
 #include "./../include/Server.h"
 
@@ -36,9 +38,11 @@ public:
     ~Attacker();
 
     /* this function tries to interact with the server by his interface and it
-    will then try to decrypt the session token, if sucessfull it will return the
-    session token by reference and set returnValue to true, false otherwise, it
-    will also return true if all went without errors, false otherwise */
+    will then try to decrypt the session token, every ciphertext block is
+    recovered independently of the others in a pool of worker threads, if
+    sucessfull it will return the session token by reference and set returnValue
+    to true, false otherwise, it will also return true if all went without
+    errors, false otherwise */
     bool attackCbcBlockCypherMode(std::string &possibleSessionTokenObtained, bool *returnValue);
 
 private:
@@ -47,12 +51,20 @@ private:
   void setServer(std::shared_ptr<Server>& server);
   void setIV(std::vector<unsigned char> ivV);
 
+  /* this function recovers the plaintext of one ciphertext block, querying the
+  padding oracle with the two block ciphertexts 'forged previous block || block'
+  in batches of _guessesPerQuery guesses and stopping at the first confirmed
+  valid padding of every byte, in the end it returns the plaintext block by
+  reference in plaintextBlock and true if all went ok or false otherwise */
+  bool recoverBlock(const unsigned char *previousBlock,
+    const unsigned char *block, unsigned char *plaintextBlock);
 
 private:
   int _blockSize;
   std::shared_ptr<Server> _server;
   std::vector<unsigned char> _ivV;
   const int numberOfBitsInOneByte=8;
+  static constexpr int _guessesPerQuery = 16; // guesses sent in each oracle call
 };
 
 #endif
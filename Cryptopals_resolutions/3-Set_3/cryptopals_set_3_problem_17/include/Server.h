@@ -66,6 +66,16 @@ public:
     in the returnValue, and should return true if all when ok or false otherwise */
     bool decryptAndCheckPaddingInSessionTokenAesCbcMode(const std::vector<unsigned char> ciphertextV, bool *returnValue);
 
+    /* this function is the batched version of the function
+    'decryptAndCheckPaddingInSessionTokenAesCbcMode', it consumes the
+    ciphertexts of ciphertextSize bytes laid out one after the other in
+    ciphertextsV, decrypts all of them with a single cipher context and returns
+    the padding veredict of each one by reference in returnValues, it should
+    return true if all went ok or false otherwise, it can be called from several
+    threads at the same time */
+    bool decryptAndCheckPaddingInSessionTokenAesCbcModeBatch(const std::vector<unsigned char> &ciphertextsV,
+      const std::size_t ciphertextSize, std::vector<bool> &returnValues);
+
     /* this function makes the test if a possibleSessionToken is in fact present
     in the server, if yes then this function will return true, false otherwise */
     bool checkPresenceOfValidSessionToken(const std::string &possibleSessionToken);
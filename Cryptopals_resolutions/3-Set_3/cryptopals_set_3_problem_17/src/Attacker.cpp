@@ -29,21 +29,24 @@ void Attacker::setIV(std::vector<unsigned char> ivV) {
 }
 /******************************************************************************/
 /* this function tries to interact with the server by his interface and it
-will then try to decrypt the session token, if sucessfull it will return the
-session token by reference and set returnValue to true, false otherwise, it
-will also return true if all went without errors, false otherwise */
+will then try to decrypt the session token, every ciphertext block is recovered
+independently of the others in a pool of worker threads, if sucessfull it will
+return the session token by reference and set returnValue to true, false
+otherwise, it will also return true if all went without errors, false
+otherwise */
 bool Attacker::attackCbcBlockCypherMode(
     std::string &possibleSessionTokenObtained, bool *returnValue) {
   if (returnValue == nullptr) {
     return false;
   }
-  std::vector<unsigned char> ciphertextV, auxCiphertextV, auxCiphertextVMem,
-      ivV, decryptedPlaintextVector;
-  bool flag, retVal;
-  int nBlocks, i, j, k, w, index, testValidPad,
-      maxTest = pow(2, numberOfBitsInOneByte), count = 0;
-  unsigned char paddingNumber, decryptedPlaintextChar, c;
-  std::string plaintext;
+  std::vector<unsigned char> ciphertextV, ivV, blocksV,
+      decryptedPlaintextVector;
+  std::vector<std::thread> workers;
+  std::atomic<int> nextBlock(0);
+  std::atomic<bool> errorFlag(false);
+  bool flag;
+  int nBlocks, nThreads, i;
+  *returnValue = false;
   /* work */
   flag = _server->encryptionSessionTokenAesCbcMode(ciphertextV, ivV);
   if (flag == false) {
@@ -53,7 +56,8 @@ bool Attacker::attackCbcBlockCypherMode(
   }
   Attacker::setIV(ivV);
   /* test cipher size */
-  if (ciphertextV.size() % _blockSize != 0) {
+  if (ciphertextV.size() == 0 || ciphertextV.size() % _blockSize != 0 ||
+      (int)_ivV.size() != _blockSize) {
     perror("Bad Session token size | session token size must be a multiple of "
            "blockSize after padding.");
     return false;
@@ -64,97 +68,43 @@ bool Attacker::attackCbcBlockCypherMode(
               << ciphertextV.size() << " bytes.\n"
               << std::endl;
   }
-  /* insert int auxCiphertextV all blocks except last block */
-  copy(ciphertextV.begin(), ciphertextV.end(), back_inserter(auxCiphertextV));
-  /* copy auxCiphertextV into auxCiphertextVMem */
-  copy(auxCiphertextV.begin(), auxCiphertextV.end(),
-       back_inserter(auxCiphertextVMem));
-  /* decrypt ciphertext one byte at a time */
-  for (i = 0; i < nBlocks; ++i) {
-    for (j = 0; j < _blockSize; ++j) {
-      paddingNumber = j + 1;
-      index = auxCiphertextV.size() - j - _blockSize - 1;
-      printf("\n---> Index = %d | Decryption = %d \n", index,
-             index + _blockSize);
-      /* update auxCiphertextV to the right: Ci-blockSize XOR Ci'-blockSize = Pi
-       * XOR paddingNumber */
-      for (k = index + 1, w = 0; k < auxCiphertextV.size() - _blockSize;
-           ++k, ++w) {
-        auxCiphertextV[k] =
-            auxCiphertextVMem[k] ^ decryptedPlaintextVector[w] ^ paddingNumber;
-      }
-      for (testValidPad = 0; testValidPad < maxTest; ++testValidPad) {
-        /* get valid Ci-blockSize' */
-        auxCiphertextV[index] = auxCiphertextVMem[index] ^ testValidPad;
-        flag = _server->decryptAndCheckPaddingInSessionTokenAesCbcMode(
-            auxCiphertextV, &retVal);
-        if (flag == false) {
-          perror("There was an error in the function "
-                 "'decryptAndCheckPaddingInSessionTokenAesCbcMode'.");
-          return false;
-        }
-        /* test last byte, exclude last bytes as: x02 | x02 as false positive */
-        if (j == 0 && retVal == true) {
-          auxCiphertextV[index - 1] = auxCiphertextVMem[index - 1] ^ 0x1;
-          flag = _server->decryptAndCheckPaddingInSessionTokenAesCbcMode(
-              auxCiphertextV, &retVal);
-          if (flag == false) {
-            perror("There was an error in the function "
-                   "'decryptAndCheckPaddingInSessionTokenAesCbcMode'.");
-            return false;
-          }
-          if (retVal == false) {
-            /* in this case we got a false positive, do nothing in this case */
-            continue;
-          }
-        }
-        if (retVal == true && debugFlag == true) {
-          std::cout << "We got a valid tampered ciphertext at block "
-                    << nBlocks - i << ", byte " << _blockSize - j
-                    << " with a delta tampered value of " << testValidPad;
-          printf(" | delta tampered value = x%.2x | auxCiphertextV = x%.2x.\n",
-                 (unsigned char)testValidPad, auxCiphertextV[index]);
-        }
-        if (retVal == true) {
-          /* perform rest of the decryption action, insert decrypted plaintext
-           */
-          /* pi = paddingNumber XOR Ci-blockSize XOR Ci'-blockSize */
-          decryptedPlaintextChar = paddingNumber ^ testValidPad;
-          if (debugFlag == true) {
-            printf("Decrypted plaintext: (hex)'%.2x' | (char)'%c'.\n\n",
-                   decryptedPlaintextChar, decryptedPlaintextChar);
-          }
+  /* blocksV = IV || ciphertext, so that block i of the ciphertext is preceded
+  by the block i of blocksV */
+  blocksV.reserve(_ivV.size() + ciphertextV.size());
+  blocksV.insert(blocksV.end(), _ivV.begin(), _ivV.end());
+  blocksV.insert(blocksV.end(), ciphertextV.begin(), ciphertextV.end());
+  decryptedPlaintextVector.resize(ciphertextV.size());
+  /* decrypt every block in parallel, each one is written into its own slice of
+  decryptedPlaintextVector */
+  nThreads = std::min<int>(
+      nBlocks, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  for (i = 0; i < nThreads; ++i) {
+    workers.emplace_back([&]() {
+      int block;
+      while (errorFlag.load() == false &&
+             (block = nextBlock.fetch_add(1)) < nBlocks) {
+        if (Attacker::recoverBlock(&blocksV[block * _blockSize],
+                                   &blocksV[(block + 1) * _blockSize],
+                                   &decryptedPlaintextVector[block *
+                                                             _blockSize]) ==
+            false) {
+          errorFlag.store(true);
         }
       }
-      decryptedPlaintextVector.insert(decryptedPlaintextVector.begin(),
-                                      decryptedPlaintextChar);
-    }
-    /* extract right most block from the auxCiphertextV and auxCiphertextVMem */
-    for (j = 0; j < _blockSize; ++j) {
-      auxCiphertextV.pop_back();
-      auxCiphertextVMem.pop_back();
-    }
-    /* reset the state of the current last block in auxCiphertextV vector */
-    for (j = 0; j < _blockSize; ++j) {
-      auxCiphertextV[auxCiphertextV.size() - 1 - j] =
-          auxCiphertextVMem[auxCiphertextV.size() - 1 - j];
-    }
-    if (debugFlag == true) {
-      std::cout << "Size of 'auxCiphertextV' after block round number " << i + 1
-                << ": " << auxCiphertextV.size() << " bytes." << std::endl;
-    }
-    /* if auxCiphertextV already with only 1 block, add IV vector to the
-     * beginning */
-    if (auxCiphertextV.size() == _blockSize) {
-      /* prepend IV into auxCiphertextV */
-      auxCiphertextV.clear();
-      copy(_ivV.begin(), _ivV.end(), std::back_inserter(auxCiphertextV));
-      copy(auxCiphertextVMem.begin(), auxCiphertextVMem.end(),
-           std::back_inserter(auxCiphertextV));
-      /* copy new auxCiphertextV into auxCiphertextVMem */
-      auxCiphertextVMem.clear();
-      copy(auxCiphertextV.begin(), auxCiphertextV.end(),
-           std::back_inserter(auxCiphertextVMem));
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  if (errorFlag.load() == true) {
+    perror("There was an error in the function 'recoverBlock'.");
+    return false;
+  }
+  if (debugFlag == true) {
+    for (i = 0; i < nBlocks; ++i) {
+      printf("Decrypted plaintext block %d: ", i + 1);
+      fwrite(&decryptedPlaintextVector[i * _blockSize], 1, _blockSize, stdout);
+      printf("\n");
     }
   }
   /* prepare output */
@@ -170,6 +120,88 @@ bool Attacker::attackCbcBlockCypherMode(
   }
   Function::convertVectorBytesToString(decryptedPlaintextVector,
                                        possibleSessionTokenObtained);
+  *returnValue = true;
+  return true;
+}
+/******************************************************************************/
+/* this function recovers the plaintext of one ciphertext block, querying the
+padding oracle with the two block ciphertexts 'forged previous block || block'
+in batches of _guessesPerQuery guesses and stopping at the first confirmed
+valid padding of every byte, in the end it returns the plaintext block by
+reference in plaintextBlock and true if all went ok or false otherwise */
+bool Attacker::recoverBlock(const unsigned char *previousBlock,
+                            const unsigned char *block,
+                            unsigned char *plaintextBlock) {
+  const int maxTest = pow(2, numberOfBitsInOneByte),
+            querySize = 2 * _blockSize;
+  /* intermediateV = block decrypted by the raw block cypher */
+  std::vector<unsigned char> intermediateV(_blockSize), forgedV(querySize, 0),
+      queriesV;
+  std::vector<bool> returnValues;
+  bool flag, found, retVal;
+  int j, k, index, guess, firstGuess, nGuesses;
+  unsigned char paddingNumber;
+  /* the second block of every query is the block under attack */
+  copy(block, block + _blockSize, forgedV.begin() + _blockSize);
+  queriesV.reserve(_guessesPerQuery * querySize);
+  for (j = 0; j < _blockSize; ++j) {
+    paddingNumber = j + 1;
+    index = _blockSize - j - 1;
+    /* Ci-blockSize' = Ii XOR paddingNumber for the bytes already recovered */
+    for (k = index + 1; k < _blockSize; ++k) {
+      forgedV[k] = intermediateV[k] ^ paddingNumber;
+    }
+    found = false;
+    for (firstGuess = 0; firstGuess < maxTest && found == false;
+         firstGuess += _guessesPerQuery) {
+      nGuesses = std::min(_guessesPerQuery, maxTest - firstGuess);
+      queriesV.clear();
+      for (guess = firstGuess; guess < firstGuess + nGuesses; ++guess) {
+        forgedV[index] = guess;
+        queriesV.insert(queriesV.end(), forgedV.begin(), forgedV.end());
+      }
+      flag = _server->decryptAndCheckPaddingInSessionTokenAesCbcModeBatch(
+          queriesV, querySize, returnValues);
+      if (flag == false) {
+        perror("There was an error in the function "
+               "'decryptAndCheckPaddingInSessionTokenAesCbcModeBatch'.");
+        return false;
+      }
+      for (guess = 0; guess < nGuesses && found == false; ++guess) {
+        if (returnValues[guess] == false) {
+          continue;
+        }
+        forgedV[index] = firstGuess + guess;
+        /* test last byte, exclude last bytes as: x02 | x02 as false positive */
+        if (j == 0) {
+          forgedV[index - 1] ^= 0x1;
+          flag = _server->decryptAndCheckPaddingInSessionTokenAesCbcMode(
+              forgedV, &retVal);
+          forgedV[index - 1] ^= 0x1;
+          if (flag == false) {
+            perror("There was an error in the function "
+                   "'decryptAndCheckPaddingInSessionTokenAesCbcMode'.");
+            return false;
+          } else if (retVal == false) {
+            /* in this case we got a false positive, keep searching */
+            continue;
+          }
+        }
+        /* Ii = paddingNumber XOR Ci-blockSize' */
+        intermediateV[index] = paddingNumber ^ forgedV[index];
+        found = true;
+      }
+    }
+    if (found == false) {
+      printf("No valid padding was found for the byte %d of the block.\n",
+             index + 1);
+      return false;
+    }
+  }
+  /* Pi = Ii XOR Ci-blockSize */
+  for (k = 0; k < _blockSize; ++k) {
+    plaintextBlock[k] = intermediateV[k] ^ previousBlock[k];
+  }
   return true;
 }
 /******************************************************************************/
@@ -456,6 +456,46 @@ bool Server::decryptAndCheckPaddingInSessionTokenAesCbcMode(
   return true;
 }
 /******************************************************************************/
+/* this function is the batched version of the function
+'decryptAndCheckPaddingInSessionTokenAesCbcMode', it consumes the ciphertexts of
+ciphertextSize bytes laid out one after the other in ciphertextsV, decrypts all
+of them with a single cipher context and returns the padding veredict of each
+one by reference in returnValues, it should return true if all went ok or false
+otherwise, it can be called from several threads at the same time */
+bool Server::decryptAndCheckPaddingInSessionTokenAesCbcModeBatch(
+    const std::vector<unsigned char> &ciphertextsV,
+    const std::size_t ciphertextSize, std::vector<bool> &returnValues) {
+  if (ciphertextSize == 0 || ciphertextSize % _blockSize != 0 ||
+      ciphertextsV.size() % ciphertextSize != 0) {
+    return false;
+  }
+  std::size_t i, nCiphertexts = ciphertextsV.size() / ciphertextSize;
+  std::vector<unsigned char> plaintextV(ciphertextSize);
+  EVP_CIPHER_CTX *ctx;
+  int len;
+  returnValues.assign(nCiphertexts, false);
+  if (!(ctx = EVP_CIPHER_CTX_new())) {
+    Server::handleErrors();
+  }
+  for (i = 0; i < nCiphertexts; ++i) {
+    /* the context is only reset with the key and the iv, not reallocated */
+    if (1 != EVP_DecryptInit_ex(ctx, EVP_aes_128_cbc(), NULL, _key, _iv)) {
+      Server::handleErrors();
+    }
+    EVP_CIPHER_CTX_set_padding(ctx, 0);
+    if (1 != EVP_DecryptUpdate(ctx, plaintextV.data(), &len,
+                               &ciphertextsV[i * ciphertextSize],
+                               ciphertextSize)) {
+      Server::handleErrors();
+    }
+    returnValues[i] = _pad->testPadding(plaintextV);
+  }
+  /* Clean up */
+  memset(plaintextV.data(), 0, plaintextV.size());
+  EVP_CIPHER_CTX_free(ctx);
+  return true;
+}
+/******************************************************************************/
 /* this function makes the test if a possibleSessionToken is in fact present
 in the server, if yes then this function will return true, false otherwise */
 bool Server::checkPresenceOfValidSessionToken(
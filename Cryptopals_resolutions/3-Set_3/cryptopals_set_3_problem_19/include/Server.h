@@ -74,8 +74,10 @@ public:
 
     /* this function will test if the vector decryptedTextV contains the same
     content up to strings of size sizeMaxString, having as reference the vector
-    _stringsAscii, it will return true if they have the same content or false
-    otherwise */
+    _stringsAscii, the letters are compared without their case, every string
+    that differs in that prefix is printed, together with the number of bytes
+    right over the full strings, it will return true if they have the same
+    content or false otherwise */
     bool testDecryptedVectorString(std::vector<std::string> decryptedTextV, const int sizeMaxString);
 
     /* getter */
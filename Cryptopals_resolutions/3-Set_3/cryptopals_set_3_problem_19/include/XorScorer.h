@@ -0,0 +1,54 @@
+#ifndef XOR_SCORER_H
+#define XOR_SCORER_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class XorScorer {
+public:
+  static const int numberByteValues = 256;
+  static const int numberEnglishLetters = 26;
+
+  /* number of occurrences of every byte value in a column of ciphertext */
+  typedef std::array<unsigned int, numberByteValues> ByteHistogram;
+
+  /* score of the best single byte key of a column */
+  typedef struct {
+    unsigned char key;
+    double logLikelihood; /* sum of the log probability of every decrypted byte
+                             as english text */
+  } keyScore;
+
+  /* constructor / destructor, the constructor builds the log-likelihood tables
+  of every byte value and of every pair of byte values */
+  XorScorer();
+  ~XorScorer();
+
+  /* this function will score all the single byte keys against the histogram,
+  the score of the key k is the sum over every byte value b of
+  histogram[b] * logLikelihood[b ^ k], so no xored copy of the column is ever
+  built, scores must have room for numberByteValues values */
+  void scoreAllKeys(const ByteHistogram &histogram, double *scores) const;
+
+  /* this function will return the key with the highest log-likelihood for the
+  histogram, together with that log-likelihood */
+  keyScore getBestKey(const ByteHistogram &histogram) const;
+
+  /* this function returns the log probability of the byte c following the
+  byte previous in english text, the first byte of a line follows a '\n' */
+  double getBigramLogLikelihood(unsigned char previous, unsigned char c) const;
+
+private:
+  /* this function returns how much more likely the byte c is to follow the
+  byte previous in english text than if the two bytes were independent */
+  static double bigramAffinity(unsigned char previous, unsigned char c);
+
+  std::array<double, numberByteValues> _logLikelihood;
+  std::vector<double> _bigramLogLikelihood; /* numberByteValues rows, one per
+                                               previous byte */
+
+  static const double _englishLetterFrequency[numberEnglishLetters];
+};
+
+#endif
@@ -575,25 +575,46 @@ void Server::resetIVCtrMode() {
 /******************************************************************************/
 /* this function will test if the vector decryptedTextV contains the same
 content up to strings of size sizeMaxString, having as reference the vector
-_stringsAscii, it will return true if they have the same content or false
-otherwise */
+_stringsAscii, the letters are compared without their case, every string that
+differs in that prefix is printed, together with the number of bytes right
+over the full strings, it will return true if they have the same content or
+false otherwise */
 bool Server::testDecryptedVectorString(std::vector<std::string> decryptedTextV,
                                        const int sizeMaxString) {
-  int i, j, size = _stringsAscii.size();
-  std::string aux;
+  int i, j, size = _stringsAscii.size(), nBytes = 0, nBytesRight = 0;
+  std::string reference;
+  bool sameContent = true;
+  if ((int)decryptedTextV.size() != size) {
+    std::cout << "\nMismatch between the number of strings: [S]" << size
+              << " and [A]" << decryptedTextV.size() << "." << std::endl;
+    return false;
+  }
   for (i = 0; i < size; ++i) {
-    aux.clear();
-    aux = decryptedTextV[i].substr(0, sizeMaxString);
-    for (j = 0; j < aux.size(); ++j) {
-      aux[j] = tolower(aux[j]);
+    reference = _stringsAscii[i];
+    for (j = 0; j < (int)reference.size(); ++j) {
+      reference[j] = tolower(reference[j]);
+    }
+    for (j = 0; j < (int)decryptedTextV[i].size(); ++j) {
       decryptedTextV[i][j] = tolower(decryptedTextV[i][j]);
     }
-    if (aux != decryptedTextV[i]) {
-      std::cout << "\nMismatch between: [S]'" << aux << "' and [A]'"
-                << decryptedTextV[i] << "'." << std::endl;
-      return false;
+    nBytes += reference.size();
+    for (j = 0; j < (int)reference.size() && j < (int)decryptedTextV[i].size();
+         ++j) {
+      if (reference[j] == decryptedTextV[i][j]) {
+        ++nBytesRight;
+      }
+    }
+    if (reference.substr(0, sizeMaxString) !=
+        decryptedTextV[i].substr(0, sizeMaxString)) {
+      std::cout << "\nMismatch between: [S]'"
+                << reference.substr(0, sizeMaxString) << "' and [A]'"
+                << decryptedTextV[i].substr(0, sizeMaxString) << "'."
+                << std::endl;
+      sameContent = false;
     }
   }
-  return true;
+  std::cout << "\n" << nBytesRight << " of " << nBytes
+            << " bytes were decrypted right." << std::endl;
+  return sameContent;
 }
 /******************************************************************************/
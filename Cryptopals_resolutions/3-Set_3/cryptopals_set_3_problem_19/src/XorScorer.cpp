@@ -0,0 +1,153 @@
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#include "./../include/XorScorer.h"
+
+const double XorScorer::_englishLetterFrequency[numberEnglishLetters] = {
+    8.2e-2,  1.5e-2,  2.8e-2,   4.3e-2,  13.0e-2, 2.2e-2,  2.0e-2,
+    6.1e-2,  7.0e-2,  0.15e-2,  0.77e-2, 4.0e-2,  2.4e-2,  6.7e-2,
+    7.5e-2,  1.9e-2,  0.095e-2, 6.0e-2,  6.3e-2,  9.1e-2,  2.8e-2,
+    0.98e-2, 2.4e-2,  0.15e-2,  2.0e-2,  0.074e-2};
+
+/* constructor / destructor */
+XorScorer::XorScorer()
+    : _bigramLogLikelihood(numberByteValues * numberByteValues) {
+  /* share of every class of byte in english text, the letters are split
+  according to the english letter frequency */
+  const double lowercaseShare = 0.74, uppercaseShare = 0.04, spaceShare = 0.15,
+               punctuationShare = 0.05, digitShare = 0.01, newlineShare = 0.005,
+               otherPrintableShare = 1e-4, nonPrintableShare = 1e-6;
+  const char *punctuation = ".,;:!?'\"-";
+  std::array<double, numberByteValues> probability, weights;
+  double sum = 0;
+  int i, j;
+  for (i = 0; i < numberByteValues; ++i) {
+    if (i >= 'a' && i <= 'z') {
+      probability[i] = lowercaseShare * _englishLetterFrequency[i - 'a'];
+    } else if (i >= 'A' && i <= 'Z') {
+      probability[i] = uppercaseShare * _englishLetterFrequency[i - 'A'];
+    } else if (i == ' ') {
+      probability[i] = spaceShare;
+    } else if (i != 0 && strchr(punctuation, i) != nullptr) {
+      probability[i] = punctuationShare / strlen(punctuation);
+    } else if (i >= '0' && i <= '9') {
+      probability[i] = digitShare / 10;
+    } else if (i == '\n') {
+      probability[i] = newlineShare;
+    } else if (i > ' ' && i < 0x7f) {
+      probability[i] = otherPrintableShare;
+    } else {
+      probability[i] = nonPrintableShare;
+    }
+    sum += probability[i];
+  }
+  for (i = 0; i < numberByteValues; ++i) {
+    _logLikelihood[i] = log(probability[i] / sum);
+  }
+  /* every row of the bigram table is the distribution of the byte that
+  follows the byte i */
+  for (i = 0; i < numberByteValues; ++i) {
+    sum = 0;
+    for (j = 0; j < numberByteValues; ++j) {
+      weights[j] = probability[j] * XorScorer::bigramAffinity(i, j);
+      sum += weights[j];
+    }
+    for (j = 0; j < numberByteValues; ++j) {
+      _bigramLogLikelihood[i * numberByteValues + j] = log(weights[j] / sum);
+    }
+  }
+}
+/******************************************************************************/
+XorScorer::~XorScorer() {}
+/******************************************************************************/
+/* this function will score all the single byte keys against the histogram,
+the score of the key k is the sum over every byte value b of
+histogram[b] * logLikelihood[b ^ k], so no xored copy of the column is ever
+built, scores must have room for numberByteValues values */
+void XorScorer::scoreAllKeys(const ByteHistogram &histogram,
+                             double *scores) const {
+  double count;
+  int i, key;
+  for (key = 0; key < numberByteValues; ++key) {
+    scores[key] = 0;
+  }
+  /* only the byte values present in the column take part in the score, the
+  keys are the inner loop so that their sums do not wait on each other */
+  for (i = 0; i < numberByteValues; ++i) {
+    if (histogram[i] != 0) {
+      count = histogram[i];
+      for (key = 0; key < numberByteValues; ++key) {
+        scores[key] += count * _logLikelihood[i ^ key];
+      }
+    }
+  }
+}
+/******************************************************************************/
+/* this function will return the key with the highest log-likelihood for the
+histogram, together with that log-likelihood */
+XorScorer::keyScore
+XorScorer::getBestKey(const ByteHistogram &histogram) const {
+  double scores[numberByteValues];
+  keyScore best = {};
+  int key;
+  XorScorer::scoreAllKeys(histogram, scores);
+  for (key = 1; key < numberByteValues; ++key) {
+    if (scores[key] > scores[best.key]) {
+      best.key = key;
+    }
+  }
+  best.logLikelihood = scores[best.key];
+  return best;
+}
+/******************************************************************************/
+/* this function returns the log probability of the byte c following the byte
+previous in english text, the first byte of a line follows a '\n' */
+double XorScorer::getBigramLogLikelihood(unsigned char previous,
+                                         unsigned char c) const {
+  return _bigramLogLikelihood[previous * numberByteValues + c];
+}
+/******************************************************************************/
+/* this function returns how much more likely the byte c is to follow the byte
+previous in english text than if the two bytes were independent */
+double XorScorer::bigramAffinity(unsigned char previous, unsigned char c) {
+  /* the most frequent letter pairs of english text, two letters each */
+  const char *commonBigrams = "thheineranndreonenatedesoritistinttehasetong"
+                              "oualarhiasveleofmerocoderaicnestea";
+  const char *stops = ".,;:!?";
+  std::size_t i;
+  if (previous == '\n') {
+    /* lines start with a capital letter */
+    return isupper(c) ? 50 : (c == '\n' ? 0.1 : 1);
+  }
+  if (isalpha(previous) && isalpha(c)) {
+    if (islower(previous) && isupper(c)) {
+      return 0.02;
+    }
+    if (isupper(previous) && isupper(c)) {
+      return 0.3;
+    }
+    for (i = 0; commonBigrams[i] != 0; i += 2) {
+      if (tolower(previous) == commonBigrams[i] &&
+          tolower(c) == commonBigrams[i + 1]) {
+        return 3;
+      }
+    }
+    return 1;
+  }
+  if (previous == ' ') {
+    /* no double spaces, nor spaces at the end of a line */
+    if (c == ' ' || c == '\n') {
+      return 0.01;
+    }
+    return (c != 0 && strchr(stops, c) != nullptr) ? 0.05 : 1;
+  }
+  if (previous != 0 && strchr(stops, previous) != nullptr) {
+    if (c == ' ' || c == '\n') {
+      return 5;
+    }
+    return isalpha(c) ? 0.2 : 1;
+  }
+  return 1;
+}
+/******************************************************************************/
@@ -33,25 +33,30 @@ int main(void) {
   /* work to verify */
   std::shared_ptr<Server> server =
       std::make_shared<Server>("input/serverInput.txt");
-  std::shared_ptr<Attacker> attacker =
-      std::make_shared<Attacker>(server, blockSize);
+  std::shared_ptr<Attacker> attacker = std::make_shared<Attacker>(server);
   std::vector<std::string> decryptedStrings;
   std::string resS;
-  int sizeKey;
+  int sizeKeystream, sizeRecoverable;
   bool b;
   int i;
   server->encryptInputs();
-  b = attacker->decryptMinSizeEncryptedStrings(decryptedStrings, &sizeKey);
+  b = attacker->decryptEncryptedStrings(decryptedStrings, &sizeKeystream,
+                                        &sizeRecoverable);
   if (b == false) {
     perror(
-        "There was an error in the function 'decryptMinSizeEncryptedStrings'.");
+        "There was an error in the function 'decryptEncryptedStrings'.");
     return false;
   }
   std::cout << "\n\nDecrypted strings by the attacker: " << std::endl;
   for (i = 0; i < (int)decryptedStrings.size(); ++i) {
     std::cout << decryptedStrings[i] << std::endl;
   }
-  b = server->testDecryptedVectorString(decryptedStrings, sizeKey);
+  /* the columns covered by too few ciphertexts cannot be told apart from
+  other english text, so the verdict only judges the recoverable prefix */
+  std::cout << "\nKeystream of " << sizeKeystream << " bytes, the first "
+            << sizeRecoverable << " of them covered by at least "
+            << minRowsRecoverableColumn << " ciphertexts." << std::endl;
+  b = server->testDecryptedVectorString(decryptedStrings, sizeRecoverable);
   resS = (b == true) ? "true" : "false";
   std::cout << "\n\n####  Server veredict on the presence of this strings at "
                "the server: "
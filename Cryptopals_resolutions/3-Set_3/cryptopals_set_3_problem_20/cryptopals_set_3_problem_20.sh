@@ -7,6 +7,7 @@ fi
 
 g++ -c ./src/Function.cpp -o ./build/Function.o
 g++ -c ./src/Server.cpp -o ./build/Server.o
+g++ -c ./src/XorScorer.cpp -o ./build/XorScorer.o
 g++ -c ./src/Attacker.cpp -o ./build/Attacker.o
-g++ -Wall -std=c++17 ./src/cryptopals_set_3_problem_20.cpp  ./build/Function.o ./build/Server.o ./build/Attacker.o -o ./build/cryptopals_set_3_problem_20.exe -lcrypto
+g++ -Wall -std=c++17 ./src/cryptopals_set_3_problem_20.cpp  ./build/Function.o ./build/Server.o ./build/XorScorer.o ./build/Attacker.o -o ./build/cryptopals_set_3_problem_20.exe -lcrypto -pthread
 ./build/cryptopals_set_3_problem_20.exe
@@ -6,7 +6,7 @@ then
 fi
 
 g++ -c ./src/Server.cpp -o ./build/Server.o
-g++ -c ./src/MT19937.cpp -o ./build/MT19937.o
-g++ -c ./src/Attacker.cpp -o ./build/Attacker.o
+g++ -c -O2 ./src/MT19937.cpp -o ./build/MT19937.o
+g++ -c -O2 ./src/Attacker.cpp -o ./build/Attacker.o
 g++ -Wall -std=c++17 ./src/cryptopals_set_3_problem_22.cpp ./build/Server.o ./build/MT19937.o ./build/Attacker.o -o ./build/cryptopals_set_3_problem_22.exe -lcrypto
 ./build/cryptopals_set_3_problem_22.exe
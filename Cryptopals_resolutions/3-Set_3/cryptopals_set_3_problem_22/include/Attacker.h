@@ -40,11 +40,24 @@ public:
   otherwise */
   bool crackMt19937(std::time_t& seedCracked);
 
+  /* this function will try to crack the seed of the MT19937 rng testing only
+  the timestamps of the window [lo, hi], if it can it will return true and the
+  seedCracked by reference, false otherwise */
+  bool crackMt19937(std::time_t& seedCracked, std::time_t lo, std::time_t hi);
+
+  /* this function will scan the candidate seeds of the window [lo, hi], from
+  the most recent to the oldest, comparing the first numbers.size() values each
+  candidate would produce against numbers, if one matches it will return true
+  and the seedCracked by reference, false otherwise */
+  bool scanSeedWindow(const std::vector<std::uint32_t> &numbers, std::time_t lo,
+    std::time_t hi, std::time_t& seedCracked);
+
   /* setter */
   void setServer(std::shared_ptr<Server>& server);
 
 private:
   std::shared_ptr<Server> _server;
+  const std::time_t _defaultSeedWindow = 24 * 60 * 60; // seconds looked back
 };
 
 #endif
@@ -26,6 +26,11 @@
 #include <iterator> // for back_inserter
 #include <memory>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MT19937_X86
+#endif
+
 const bool debugFlag = true;
 
 class MT19937 {
@@ -41,11 +46,52 @@ public:
     /* Extract a tempered value based on MT[index] calling twist() every n numbers */
     unsigned int extractNumber();
 
+    /* this function will fill numbers with the next count tempered values, the
+    same values that count calls to extractNumber() would return */
+    void generate(std::uint32_t *numbers, std::size_t count);
+
+    /* this function will compute only the first k tempered values that a
+    generator seeded with seed would extract, running the seeding recurrence
+    just up to MT[m + k - 1] and twisting just MT[0..k - 1], the internal state
+    of the generator is left untouched, k cannot be greater than n - m */
+    void extractFirstNumbers(std::uint32_t seed, std::uint32_t *numbers,
+      std::size_t k);
+
+    /* this function will compute the first tempered value for _seedLanes
+    seeds at once, interleaving their seeding recurrences so that they do not
+    wait on each other, the internal state of the generator is left untouched */
+    void extractFirstNumberLanes(const std::uint32_t *seeds,
+      std::uint32_t *numbers);
+
+    /* number of seeds handled by each call to extractFirstNumberLanes */
+    static const std::size_t _seedLanes = 8;
 
 private:
     /* Generate the next n values from the series x_i */
     void twist();
 
+    /* this function will twist the words MT[begin..end - 1] in order, without
+    modulo or branches on the low bit, it is the scalar kernel and the tail of
+    the vector ones */
+    void twistWords(std::size_t begin, std::size_t end);
+
+    /* this function will temper count values of the state starting at
+    MT[_index] into numbers, advancing _index */
+    void temperBlock(std::uint32_t *numbers, std::size_t count);
+
+#if defined(MT19937_X86)
+    /* vector twist kernels, twist() picks one at runtime */
+    void twistSse2();
+    void twistAvx2();
+
+    /* vector tempering kernels, they return how many values were tempered */
+    std::size_t temperBlockSse2(std::uint32_t *numbers, std::size_t count);
+    std::size_t temperBlockAvx2(std::uint32_t *numbers, std::size_t count);
+#endif
+
+    /* apply the tempering transform to a value of the state */
+    std::uint32_t temper(std::uint32_t y);
+
 private:
     const unsigned int _w = 32;
     static const unsigned int _n = 624;
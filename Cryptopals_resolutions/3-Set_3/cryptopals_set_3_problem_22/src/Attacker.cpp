@@ -17,17 +17,57 @@ void Attacker::setServer(std::shared_ptr<Server> &server) { _server = server; }
 if it can it will return true and the seedCracked by reference, false
 otherwise */
 bool Attacker::crackMt19937(std::time_t &seedCracked) {
-  unsigned int firstNumber = _server->returnFirst32BitsOfRNG();
+  std::vector<std::uint32_t> numbers{_server->returnFirst32BitsOfRNG()};
   auto now = std::chrono::system_clock::now();
   std::time_t timeNow = std::chrono::system_clock::to_time_t(now) + 1;
-  while (timeNow >= 0) {
-    std::shared_ptr<MT19937> mt19937_homeMade =
-        std::make_shared<MT19937>(timeNow);
-    if (firstNumber == mt19937_homeMade->extractNumber()) {
-      seedCracked = timeNow;
-      return true;
+  return Attacker::scanSeedWindow(numbers, timeNow - _defaultSeedWindow,
+                                  timeNow, seedCracked);
+}
+/******************************************************************************/
+/* this function will try to crack the seed of the MT19937 rng testing only
+the timestamps of the window [lo, hi], if it can it will return true and the
+seedCracked by reference, false otherwise */
+bool Attacker::crackMt19937(std::time_t &seedCracked, std::time_t lo,
+                            std::time_t hi) {
+  std::vector<std::uint32_t> numbers{_server->returnFirst32BitsOfRNG()};
+  return Attacker::scanSeedWindow(numbers, lo, hi, seedCracked);
+}
+/******************************************************************************/
+/* this function will scan the candidate seeds of the window [lo, hi], from the
+most recent to the oldest, comparing the first numbers.size() values each
+candidate would produce against numbers, if one matches it will return true
+and the seedCracked by reference, false otherwise */
+bool Attacker::scanSeedWindow(const std::vector<std::uint32_t> &numbers,
+                              std::time_t lo, std::time_t hi,
+                              std::time_t &seedCracked) {
+  if (numbers.empty() || lo > hi) {
+    return false;
+  }
+  const std::size_t lanes = MT19937::_seedLanes;
+  MT19937 mt19937_homeMade(0);
+  std::vector<std::uint32_t> candidateNumbers(numbers.size());
+  std::uint32_t seeds[lanes], firstNumbers[lanes];
+  std::time_t seed;
+  std::size_t l;
+  for (seed = hi; seed >= lo; seed -= lanes) {
+    /* the first value filters _seedLanes candidates at a time, lanes past lo
+    just repeat lo */
+    for (l = 0; l < lanes; ++l) {
+      seeds[l] = static_cast<std::uint32_t>(
+          seed - lo >= static_cast<std::time_t>(l) ? seed - l : lo);
+    }
+    mt19937_homeMade.extractFirstNumberLanes(seeds, firstNumbers);
+    for (l = 0; l < lanes; ++l) {
+      if (firstNumbers[l] != numbers[0]) {
+        continue;
+      }
+      mt19937_homeMade.extractFirstNumbers(seeds[l], candidateNumbers.data(),
+                                           candidateNumbers.size());
+      if (candidateNumbers == numbers) {
+        seedCracked = seed - lo >= static_cast<std::time_t>(l) ? seed - l : lo;
+        return true;
+      }
     }
-    --timeNow;
   }
   return false;
 }
@@ -26,6 +26,11 @@
 #include <iterator> // for back_inserter
 #include <memory>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MT19937_X86
+#endif
+
 const bool debugFlag = true;
 const int maxSizeDebug = 10;
 
@@ -45,6 +50,10 @@ public:
     /* Extract a tempered value based on MT[index] calling twist() every n numbers */
     unsigned int extractNumber();
 
+    /* this function will fill numbers with the next count tempered values, the
+    same values that count calls to extractNumber() would return */
+    void generate(std::uint32_t *numbers, std::size_t count);
+
     /* this function will return true if the vector _mt19937StateVector has the
     same value as the internal state of MT19937 or false otherwise */
     bool checkEqualVectorState(const std::vector<std::uint32_t> &_mt19937StateVector);
@@ -53,6 +62,25 @@ private:
     /* Generate the next n values from the series x_i */
     void twist();
 
+    /* this function will twist the words MT[begin..end - 1] in order, without
+    modulo or branches on the low bit, it is the scalar kernel and the tail of
+    the vector ones */
+    void twistWords(std::size_t begin, std::size_t end);
+
+    /* this function will temper count values of the state starting at
+    MT[_index] into numbers, advancing _index */
+    void temperBlock(std::uint32_t *numbers, std::size_t count);
+
+#if defined(MT19937_X86)
+    /* vector twist kernels, twist() picks one at runtime */
+    void twistSse2();
+    void twistAvx2();
+
+    /* vector tempering kernels, they return how many values were tempered */
+    std::size_t temperBlockSse2(std::uint32_t *numbers, std::size_t count);
+    std::size_t temperBlockAvx2(std::uint32_t *numbers, std::size_t count);
+#endif
+
 private:
     const unsigned int _w = 32;
     static const unsigned int _n = 624;
@@ -7,7 +7,8 @@ fi
 
 g++ -c ./src/Server.cpp -o ./build/Server.o
 g++ -c ./src/MT19937.cpp -o ./build/MT19937.o
+g++ -c ./src/MT19937SeedSearch.cpp -o ./build/MT19937SeedSearch.o
 g++ -c ./src/Attacker.cpp -o ./build/Attacker.o
 g++ -c ./src/Function.cpp -o ./build/Function.o
-g++ -Wall -std=c++17 ./src/cryptopals_set_3_problem_24.cpp ./build/Server.o ./build/MT19937.o ./build/Attacker.o ./build/Function.o -o ./build/cryptopals_set_3_problem_24.exe -lcrypto
+g++ -Wall -std=c++17 ./src/cryptopals_set_3_problem_24.cpp ./build/Server.o ./build/MT19937.o ./build/MT19937SeedSearch.o ./build/Attacker.o ./build/Function.o -o ./build/cryptopals_set_3_problem_24.exe -lcrypto -pthread
 ./build/cryptopals_set_3_problem_24.exe
@@ -28,6 +28,7 @@
 #include <memory>
 #include <array>
 
+#include "./../include/MT19937SeedSearch.h"
 #include "./../include/Server.h"
 
 class Attacker {
@@ -69,7 +70,7 @@ public:
 
 private:
   std::shared_ptr<Server> _server;
-  std::shared_ptr<MT19937> _mt19937Attacker;
+  std::shared_ptr<MT19937SeedSearch> _seedSearch; // parallel seed search engine
   const unsigned int _maxLengthTry = 624; // more than this value is enougth for the attacker to clone the MT19937 PRNG
   const unsigned int _maxSeed = INT_MAX;
   const unsigned int _lengthStringsA = 14;
@@ -0,0 +1,69 @@
+#ifndef MT19937_SEED_SEARCH_H
+#define MT19937_SEED_SEARCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./../include/MT19937.h"
+
+class MT19937SeedSearch {
+public:
+  /* predicate that receives the keystream produced by a candidate seed and
+  returns true if that seed is a match */
+  typedef std::function<bool(const unsigned char *keystream)> KeystreamMatcher;
+
+  /* constructor / destructor, nThreads equal to 0 uses the number of hardware
+  threads available */
+  MT19937SeedSearch(unsigned int nThreads = 0);
+  ~MT19937SeedSearch();
+
+  /* this function will search the seed space [minSeed, maxSeed] across the
+  worker threads, producing keystreamLength keystream bytes for every seed and
+  testing them with the matcher, the search is cancelled as soon as no smaller
+  seed can match, it returns true and the smallest matching seed by reference
+  if a match was found, false otherwise */
+  bool search(std::uint32_t minSeed, std::uint32_t maxSeed,
+              std::size_t keystreamLength, const KeystreamMatcher &matcher,
+              unsigned int &seed);
+
+  /* this function will convert a 32 bit number extracted from the mt19937 PRNG
+  into a keystream byte, xoring its 4 bytes together */
+  static unsigned char getKeyStreamByte(std::uint32_t n);
+
+private:
+  /* body of every worker thread, it waits for a new job and runs it */
+  void workerLoop();
+
+  /* this function will pull chunks of seeds from the current job until the
+  seed space is exhausted or a smaller seed has already matched, reusing the
+  generator, the numbers and the keystream buffers of the calling worker */
+  void runJob(MT19937 &mt19937, std::vector<std::uint32_t> &numbers,
+              std::vector<unsigned char> &keystream);
+
+private:
+  std::vector<std::thread> _workers;
+  std::mutex _searchMutex; // only one search runs at a time
+  std::mutex _jobMutex;
+  std::condition_variable _jobCondition;
+  std::condition_variable _doneCondition;
+  unsigned long long _jobGeneration = 0;
+  unsigned int _activeWorkers = 0;
+  bool _stop = false;
+
+  /* current job */
+  const KeystreamMatcher *_matcher = nullptr;
+  unsigned long long _maxSeed = 0;
+  std::size_t _keystreamLength = 0;
+  std::atomic<unsigned long long> _nextSeed{0};
+  std::atomic<unsigned long long> _bestSeed{0};
+
+  static const unsigned int _chunkSize = 256; // seeds handed out per pull
+};
+
+#endif
@@ -7,7 +7,8 @@
 #include "./../include/Server.h"
 
 /* constructor / destructor */
-Attacker::Attacker(std::shared_ptr<Server> &server) {
+Attacker::Attacker(std::shared_ptr<Server> &server)
+    : _seedSearch(std::make_shared<MT19937SeedSearch>()) {
   Attacker::setServer(server);
 }
 /******************************************************************************/
@@ -48,38 +49,32 @@ mt19937 stream cipher, having as input the vector ciphertext, returning true if
 all went ok or false otherwise */
 bool Attacker::recoverTheKey(const std::vector<unsigned char> &ciphertext,
                              unsigned int &seed) {
-  if (ciphertext.size() < _lengthStringsA) {
+  const std::size_t size = ciphertext.size();
+  if (size < _lengthStringsA || size > _maxLengthTry) {
     return false;
   }
-  seed = 0;
-  bool found = false;
-  int i, j, size = ciphertext.size();
-  unsigned char c;
-  while (found == false && seed < _maxSeed) {
-    MT19937 mt19937Attacker(seed);
-    /* test maxLengthTry times */
-    j = 0;
-    while (j + size <= _maxLengthTry) {
-      for (i = 0, found = true; i < size; ++i) {
-        c = (unsigned char)Attacker::getNextKeyStream(mt19937Attacker) ^
-            ciphertext[i];
-        if (i >= size - _lengthStringsA && i <= size - 1 && c != 'A') {
-          found = false;
+  /* the ciphertext may sit at any multiple of its own size in the keystream,
+  only the trailing A's of every such window are known */
+  const std::size_t keystreamLength = (_maxLengthTry / size) * size;
+  const unsigned char *ciphertextPointer = ciphertext.data();
+  const unsigned int lengthStringsA = _lengthStringsA;
+  MT19937SeedSearch::KeystreamMatcher matcher =
+      [ciphertextPointer, size, keystreamLength,
+       lengthStringsA](const unsigned char *keystream) {
+        std::size_t i, j;
+        bool found;
+        for (j = 0; j + size <= keystreamLength; j += size) {
+          for (i = size - lengthStringsA, found = true; i < size && found;
+               ++i) {
+            found = (keystream[j + i] ^ ciphertextPointer[i]) == 'A';
+          }
+          if (found == true) {
+            return true;
+          }
         }
-      } // for
-      if (found == true) {
-        break;
-      }
-      j += size;
-    } // while
-    if (found == true) {
-      break;
-    }
-    /* advance the seed to the next value */
-    ++seed;
-  } // while
-  /* return output value */
-  return found;
+        return false;
+      };
+  return _seedSearch->search(0, _maxSeed - 1, keystreamLength, matcher, seed);
 }
 /******************************************************************************/
 /* this function will recover the key by reference used by the server in the
@@ -138,37 +133,38 @@ PRNG MT19937 or not, and if yes, what was the seed that was used, returning that
 information at the structure idPossiblePasswordToken */
 idPossiblePasswordToken Attacker::calculatePossiblePasswordResetTokenVeredict(
     const std::string &possiblePasswordResetToken) {
-  idPossiblePasswordToken idAnswer;
-  int size = possiblePasswordResetToken.size();
+  const std::size_t size = possiblePasswordResetToken.size();
   const unsigned int maxSeed =
       USHRT_MAX & 0x0000ffff; // maxSeed truncated to 16 bits
-  unsigned int seed, i;
-  std::string sTest;
+  const unsigned char *tokenPointer =
+      reinterpret_cast<const unsigned char *>(possiblePasswordResetToken.data());
+  const std::size_t maxLengthTry = _maxLengthTry;
+  unsigned int seed;
   idPossiblePasswordToken idAttacker;
   /* fill out default configuration into idAttacker */
   idAttacker.useMt19937Flag = false;
   idAttacker.seedMt19937 = 0;
+  if (size >= _maxLengthTry) {
+    return idAttacker;
+  }
+  // test the token against every window of the keystream, in place
+  MT19937SeedSearch::KeystreamMatcher matcher =
+      [tokenPointer, size, maxLengthTry](const unsigned char *keystream) {
+        std::size_t i;
+        for (i = 0; i + size < maxLengthTry; ++i) {
+          if (std::memcmp(keystream + i, tokenPointer, size) == 0) {
+            return true;
+          }
+        }
+        return false;
+      };
   // carry out the test regarding all the seeds up to 16 bits inclusive
-  for (seed = 0; seed <= maxSeed; ++seed) {
-    _mt19937Attacker = std::make_shared<MT19937>(seed);
-    sTest.clear();
-    // load characters into the string
-    for (i = 0; i < _maxLengthTry; ++i) {
-      sTest.push_back(Attacker::getNextKeyStream(_mt19937Attacker));
-    }
-    // test substrings
-    for (i = 0; i + size < _maxLengthTry; ++i) {
-      if (sTest.substr(i, size) == possiblePasswordResetToken) {
-        /* we have found a match, possiblePasswordResetToken is a product of
-        MT19937 PRNG, with a seed of seed value */
-        idAttacker.useMt19937Flag = true;
-        idAttacker.seedMt19937 = seed;
-        return idAttacker;
-      }
-    }
+  if (_seedSearch->search(0, maxSeed, _maxLengthTry, matcher, seed) == true) {
+    /* we have found a match, possiblePasswordResetToken is a product of
+    MT19937 PRNG, with a seed of seed value */
+    idAttacker.useMt19937Flag = true;
+    idAttacker.seedMt19937 = seed;
   }
-  /* if it reaches here then we have not found a valid seed to have the same
-  possiblePasswordResetToken */
-  return idAnswer;
+  return idAttacker;
 }
 /******************************************************************************/
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <stdexcept>
 
 #include "./../include/MT19937.h"
@@ -18,6 +19,7 @@ MT19937::~MT19937() {}
 void MT19937::seedMt(unsigned int seed) {
   std::size_t i;
   _index = _n;
+  _mt[0] = static_cast<std::uint32_t>(seed);
   for (i = 1; i < _n; ++i) {
     _mt[i] = _f * (_mt[i - 1] ^ (_mt[i - 1] >> (_w - 2))) + i;
   }
@@ -43,21 +45,187 @@ std::uint32_t MT19937::extractNumber() {
   return y;
 }
 /******************************************************************************/
-/* Generate the next n values from the series x_i */
+/* Generate the next n values from the series x_i, dispatching to the widest
+twist kernel the cpu supports */
 void MT19937::twist() {
-  unsigned int x, xA;
-  for (std::size_t i = 0; i < _n; ++i) {
-    x = (_mt[i] & _upperMask) | (_mt[(i + 1) % _n] & _lowerMask);
-    xA = x >> 1;
-    /* lowest bit of x is 1 */
-    if (x % 2 != 0) {
-      xA ^= _a;
+#if defined(MT19937_X86)
+  static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+  if (hasAvx2) {
+    MT19937::twistAvx2();
+    return;
+  }
+  MT19937::twistSse2();
+#else
+  MT19937::twistWords(0, _n);
+  _index = 0;
+#endif
+}
+/******************************************************************************/
+/* this function will fill numbers with the next count tempered values, the
+same values that count calls to extractNumber() would return */
+void MT19937::generate(std::uint32_t *numbers, std::size_t count) {
+  std::size_t chunk;
+  if (_index > _n) {
+    throw std::invalid_argument("Generator was never seeded");
+  }
+  while (count > 0) {
+    if (_index >= _n) {
+      MT19937::twist();
     }
-    _mt[i] = _mt[(i + _m) % _n] ^ xA;
+    chunk = std::min(count, _n - _index);
+    MT19937::temperBlock(numbers, chunk);
+    numbers += chunk;
+    count -= chunk;
+  }
+}
+/******************************************************************************/
+/* this function will twist the words MT[begin..end - 1] in order, without
+modulo or branches on the low bit, it is the scalar kernel and the tail of the
+vector ones */
+void MT19937::twistWords(std::size_t begin, std::size_t end) {
+  std::size_t i;
+  std::uint32_t x;
+  for (i = begin; i < end; ++i) {
+    x = (_mt[i] & _upperMask) | (_mt[i + 1 < _n ? i + 1 : 0] & _lowerMask);
+    _mt[i] = _mt[i < _n - _m ? i + _m : i + _m - _n] ^ (x >> 1) ^
+             ((0u - (x & 1u)) & _a);
+  }
+}
+/******************************************************************************/
+/* this function will temper count values of the state starting at MT[_index]
+into numbers, advancing _index */
+void MT19937::temperBlock(std::uint32_t *numbers, std::size_t count) {
+  std::size_t i = 0;
+  std::uint32_t y;
+#if defined(MT19937_X86)
+  static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+  if (hasAvx2) {
+    i = MT19937::temperBlockAvx2(numbers, count);
+  } else {
+    i = MT19937::temperBlockSse2(numbers, count);
+  }
+#endif
+  for (; i < count; ++i) {
+    y = _mt[_index + i];
+    y ^= ((y >> _u) & _d);
+    y ^= ((y << _s) & _b);
+    y ^= ((y << _t) & _c);
+    y ^= (y >> _l);
+    numbers[i] = y;
   }
+  _index += count;
+}
+/******************************************************************************/
+#if defined(MT19937_X86)
+/* SSE2 twist kernel, 4 words per step, the words read from MT[i + m - n] in
+the second half are always already twisted as in the scalar order */
+void MT19937::twistSse2() {
+  const __m128i upper = _mm_set1_epi32(_upperMask);
+  const __m128i lower = _mm_set1_epi32(_lowerMask);
+  const __m128i matrixA = _mm_set1_epi32(_a);
+  const __m128i one = _mm_set1_epi32(1);
+  const __m128i zero = _mm_setzero_si128();
+  std::uint32_t *mt = _mt.data();
+  __m128i x, mag;
+  std::size_t i = 0, j;
+  for (int half = 0; half < 2; ++half) {
+    const std::size_t end = half == 0 ? _n - _m : _n - 1;
+    for (; i + 4 <= end; i += 4) {
+      j = half == 0 ? i + _m : i + _m - _n;
+      x = _mm_or_si128(
+          _mm_and_si128(_mm_loadu_si128((const __m128i *)(mt + i)), upper),
+          _mm_and_si128(_mm_loadu_si128((const __m128i *)(mt + i + 1)),
+                        lower));
+      mag = _mm_and_si128(_mm_sub_epi32(zero, _mm_and_si128(x, one)), matrixA);
+      _mm_storeu_si128(
+          (__m128i *)(mt + i),
+          _mm_xor_si128(_mm_xor_si128(_mm_loadu_si128((const __m128i *)(mt + j)),
+                                      _mm_srli_epi32(x, 1)),
+                        mag));
+    }
+    MT19937::twistWords(i, end);
+    i = end;
+  }
+  MT19937::twistWords(_n - 1, _n);
+  _index = 0;
+}
+/******************************************************************************/
+/* AVX2 twist kernel, 8 words per step */
+__attribute__((target("avx2"))) void MT19937::twistAvx2() {
+  const __m256i upper = _mm256_set1_epi32(_upperMask);
+  const __m256i lower = _mm256_set1_epi32(_lowerMask);
+  const __m256i matrixA = _mm256_set1_epi32(_a);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i zero = _mm256_setzero_si256();
+  std::uint32_t *mt = _mt.data();
+  __m256i x, mag;
+  std::size_t i = 0, j;
+  for (int half = 0; half < 2; ++half) {
+    const std::size_t end = half == 0 ? _n - _m : _n - 1;
+    for (; i + 8 <= end; i += 8) {
+      j = half == 0 ? i + _m : i + _m - _n;
+      x = _mm256_or_si256(
+          _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(mt + i)),
+                           upper),
+          _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(mt + i + 1)),
+                           lower));
+      mag = _mm256_and_si256(_mm256_sub_epi32(zero, _mm256_and_si256(x, one)),
+                             matrixA);
+      _mm256_storeu_si256(
+          (__m256i *)(mt + i),
+          _mm256_xor_si256(
+              _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(mt + j)),
+                               _mm256_srli_epi32(x, 1)),
+              mag));
+    }
+    MT19937::twistWords(i, end);
+    i = end;
+  }
+  MT19937::twistWords(_n - 1, _n);
   _index = 0;
 }
 /******************************************************************************/
+/* SSE2 tempering kernel, it returns how many values were tempered */
+std::size_t MT19937::temperBlockSse2(std::uint32_t *numbers,
+                                     std::size_t count) {
+  const __m128i d = _mm_set1_epi32(_d);
+  const __m128i b = _mm_set1_epi32(_b);
+  const __m128i c = _mm_set1_epi32(_c);
+  const std::uint32_t *mt = _mt.data() + _index;
+  __m128i y;
+  std::size_t i;
+  for (i = 0; i + 4 <= count; i += 4) {
+    y = _mm_loadu_si128((const __m128i *)(mt + i));
+    y = _mm_xor_si128(y, _mm_and_si128(_mm_srli_epi32(y, _u), d));
+    y = _mm_xor_si128(y, _mm_and_si128(_mm_slli_epi32(y, _s), b));
+    y = _mm_xor_si128(y, _mm_and_si128(_mm_slli_epi32(y, _t), c));
+    y = _mm_xor_si128(y, _mm_srli_epi32(y, _l));
+    _mm_storeu_si128((__m128i *)(numbers + i), y);
+  }
+  return i;
+}
+/******************************************************************************/
+/* AVX2 tempering kernel, it returns how many values were tempered */
+__attribute__((target("avx2"))) std::size_t
+MT19937::temperBlockAvx2(std::uint32_t *numbers, std::size_t count) {
+  const __m256i d = _mm256_set1_epi32(_d);
+  const __m256i b = _mm256_set1_epi32(_b);
+  const __m256i c = _mm256_set1_epi32(_c);
+  const std::uint32_t *mt = _mt.data() + _index;
+  __m256i y;
+  std::size_t i;
+  for (i = 0; i + 8 <= count; i += 8) {
+    y = _mm256_loadu_si256((const __m256i *)(mt + i));
+    y = _mm256_xor_si256(y, _mm256_and_si256(_mm256_srli_epi32(y, _u), d));
+    y = _mm256_xor_si256(y, _mm256_and_si256(_mm256_slli_epi32(y, _s), b));
+    y = _mm256_xor_si256(y, _mm256_and_si256(_mm256_slli_epi32(y, _t), c));
+    y = _mm256_xor_si256(y, _mm256_srli_epi32(y, _l));
+    _mm256_storeu_si256((__m256i *)(numbers + i), y);
+  }
+  return i;
+}
+/******************************************************************************/
+#endif
 /* this function will return true if the vector _mt19937StateVector has the
 same value as the internal state of MT19937 or false otherwise */
 bool MT19937::checkEqualVectorState(
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "./../include/MT19937SeedSearch.h"
+
+/* constructor / destructor */
+MT19937SeedSearch::MT19937SeedSearch(unsigned int nThreads) {
+  unsigned int i;
+  if (nThreads == 0) {
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (i = 0; i < nThreads; ++i) {
+    _workers.emplace_back(&MT19937SeedSearch::workerLoop, this);
+  }
+}
+/******************************************************************************/
+MT19937SeedSearch::~MT19937SeedSearch() {
+  {
+    std::lock_guard<std::mutex> lock(_jobMutex);
+    _stop = true;
+  }
+  _jobCondition.notify_all();
+  for (std::thread &worker : _workers) {
+    worker.join();
+  }
+}
+/******************************************************************************/
+/* this function will search the seed space [minSeed, maxSeed] across the
+worker threads, producing keystreamLength keystream bytes for every seed and
+testing them with the matcher, the search is cancelled as soon as no smaller
+seed can match, it returns true and the smallest matching seed by reference
+if a match was found, false otherwise */
+bool MT19937SeedSearch::search(std::uint32_t minSeed, std::uint32_t maxSeed,
+                               std::size_t keystreamLength,
+                               const KeystreamMatcher &matcher,
+                               unsigned int &seed) {
+  if (minSeed > maxSeed) {
+    throw std::invalid_argument(
+        "Bad seed range | minSeed cannot be greater than maxSeed");
+  }
+  std::lock_guard<std::mutex> searchLock(_searchMutex);
+  const unsigned long long notFound =
+      static_cast<unsigned long long>(maxSeed) + 1;
+  _matcher = &matcher;
+  _maxSeed = maxSeed;
+  _keystreamLength = keystreamLength;
+  _nextSeed.store(minSeed);
+  _bestSeed.store(notFound);
+  {
+    std::unique_lock<std::mutex> lock(_jobMutex);
+    _activeWorkers = _workers.size();
+    ++_jobGeneration;
+    _jobCondition.notify_all();
+    _doneCondition.wait(lock, [this]() { return _activeWorkers == 0; });
+  }
+  _matcher = nullptr;
+  if (_bestSeed.load() == notFound) {
+    return false;
+  }
+  seed = static_cast<unsigned int>(_bestSeed.load());
+  return true;
+}
+/******************************************************************************/
+/* this function will convert a 32 bit number extracted from the mt19937 PRNG
+into a keystream byte, xoring its 4 bytes together */
+unsigned char MT19937SeedSearch::getKeyStreamByte(std::uint32_t n) {
+  n ^= n >> 16;
+  n ^= n >> 8;
+  return static_cast<unsigned char>(n);
+}
+/******************************************************************************/
+/* body of every worker thread, it waits for a new job and runs it */
+void MT19937SeedSearch::workerLoop() {
+  MT19937 mt19937(0);
+  std::vector<std::uint32_t> numbers;
+  std::vector<unsigned char> keystream;
+  unsigned long long jobGenerationDone = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_jobMutex);
+      _jobCondition.wait(lock, [this, jobGenerationDone]() {
+        return _stop || _jobGeneration != jobGenerationDone;
+      });
+      if (_stop) {
+        return;
+      }
+      jobGenerationDone = _jobGeneration;
+    }
+    numbers.resize(_keystreamLength);
+    keystream.resize(_keystreamLength);
+    MT19937SeedSearch::runJob(mt19937, numbers, keystream);
+    {
+      std::lock_guard<std::mutex> lock(_jobMutex);
+      if (--_activeWorkers == 0) {
+        _doneCondition.notify_one();
+      }
+    }
+  }
+}
+/******************************************************************************/
+/* this function will pull chunks of seeds from the current job until the
+seed space is exhausted or a smaller seed has already matched, reusing the
+generator, the numbers and the keystream buffers of the calling worker */
+void MT19937SeedSearch::runJob(MT19937 &mt19937,
+                               std::vector<std::uint32_t> &numbers,
+                               std::vector<unsigned char> &keystream) {
+  unsigned long long start, end, seed, best;
+  std::size_t i;
+  while (true) {
+    start = _nextSeed.fetch_add(_chunkSize);
+    if (start > _maxSeed || start >= _bestSeed.load()) {
+      return;
+    }
+    end = std::min(start + _chunkSize - 1, _maxSeed);
+    for (seed = start; seed <= end; ++seed) {
+      if (seed >= _bestSeed.load(std::memory_order_relaxed)) {
+        break;
+      }
+      mt19937.seedMt(static_cast<unsigned int>(seed));
+      mt19937.generate(numbers.data(), numbers.size());
+      for (i = 0; i < keystream.size(); ++i) {
+        keystream[i] = getKeyStreamByte(numbers[i]);
+      }
+      if ((*_matcher)(keystream.data())) {
+        /* keep the smallest matching seed, as a serial search would */
+        best = _bestSeed.load();
+        while (seed < best && !_bestSeed.compare_exchange_weak(best, seed)) {
+        }
+        break;
+      }
+    }
+  }
+}
+/******************************************************************************/
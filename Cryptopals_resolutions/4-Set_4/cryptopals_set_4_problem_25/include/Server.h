@@ -47,10 +47,11 @@ public:
     server, and it will return if matches, false otherwise */
     bool testRecoveredPlaintext(const std::vector<unsigned char> &plaintextV);
 
-    /* this function will decrypt the ciphertext, replace the plaintext by the
-    newText starting at the offset position, and then encrypt again, returning
-    the new ciphertext by reference in the same vector ciphertext, if all went
-    ok it will return true, false otherwise */
+    /* this function will replace the plaintext under the ciphertext by the
+    newText starting at the offset position, seeking straight to the counter
+    blocks that cover the edit and patching only those bytes of ciphertextV in
+    place (growing it if the edit runs past the end), if all went ok it will
+    return true, false otherwise */
     bool editCiphertextAPI(std::vector<unsigned char> &ciphertextV, unsigned int
       offset, const std::vector<unsigned char> &newTextV);
 
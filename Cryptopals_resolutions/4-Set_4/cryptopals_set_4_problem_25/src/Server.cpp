@@ -53,38 +53,30 @@ bool Server::testRecoveredPlaintext(
   return true;
 }
 /******************************************************************************/
-/* this function will decrypt the ciphertext, replace the plaintext by the
-newText starting at the offset position, and then encrypt again, returning
-the new ciphertext by reference in the same vector ciphertext, if all went
-ok it will return true, false otherwise */
+/* this function will replace the plaintext under the ciphertext by the
+newText starting at the offset position, seeking straight to the counter
+blocks that cover the edit and patching only those bytes of ciphertextV in
+place (growing it if the edit runs past the end), if all went ok it will
+return true, false otherwise */
 bool Server::editCiphertextAPI(std::vector<unsigned char> &ciphertextV,
                                unsigned int offset,
                                const std::vector<unsigned char> &newTextV) {
-  std::string plaintext, ciphertext;
   bool b;
-  std::vector<unsigned char> plaintextV;
-  unsigned int i, size = newTextV.size();
-  _aesCtrMachine->restoreIVCtrMode();
-  plaintext = _aesCtrMachine->decryption(_ciphertextV, &b);
-  if (b == false) {
-    perror("Error at the function 'AesCtrMachine::aesCtrDecryption'");
+  std::size_t size = newTextV.size();
+  if (offset > ciphertextV.size()) {
+    perror("Error at the function 'Server::editCiphertextAPI', offset past "
+           "the end of the ciphertext");
+    return false;
+  } else if (size == 0) {
     return true;
   }
-  /* fill content before offset */
-  plaintextV.clear();
-  for (i = 0; i < offset; ++i) {
-    plaintextV.push_back(plaintext[i]);
+  if (offset + size > ciphertextV.size()) {
+    ciphertextV.resize(offset + size);
   }
-  /* fill content after offset */
-  for (i = 0; i < size; ++i) {
-    plaintextV.push_back(newTextV[i]);
-  }
-  _aesCtrMachine->restoreIVCtrMode();
-  /* encrypt again the new plaintext */
-  ciphertext = _aesCtrMachine->encryption(plaintextV, &b);
-  Function::convertStringToVectorBytes(ciphertext, ciphertextV);
+  b = _aesCtrMachine->applyKeystreamAt(ciphertextV.data() + offset,
+                                       newTextV.data(), size, offset);
   if (b == false) {
-    perror("Error at the function 'AesCtrMachine::encryption'");
+    perror("Error at the function 'AesCtrMachine::applyKeystreamAt'");
     return false;
   }
   return true;
@@ -85,13 +85,26 @@ private:
   std::string aesCtrDecryption(const std::vector<unsigned char> &encryptedBytesAsciiFullText,
     bool *b);
 
-  void handleErrors(void);
+  /* this function xors the inputV with the keystream starting at the current
+  counter, producing the keystream in batches of _keystreamBatchBlocks blocks,
+  in the end it returns the resulting text and sets flag b by reference to true
+  if no errors or to false otherwise */
+  std::string aesCtrApplyKeystream(const std::vector<unsigned char> &inputV,
+    bool *b);
 
-  int aesCtrEncryptWorker(unsigned char *plaintext, int plaintext_len, unsigned char *key,
-              unsigned char *iv, unsigned char *ciphertext);
+  /* this function writes nBlocks consecutive keystream blocks into keystream,
+  laying out the counter blocks exactly as updateIVCtrMode does and encrypting
+  all of them with a single call over the reused _ecbCtx context, the counter
+  is advanced by nBlocks in the end */
+  void generateKeystream(unsigned char *keystream, unsigned int nBlocks);
 
-  int aesCtrDecryptWorker(unsigned char *ciphertext, int ciphertext_len, unsigned char *key,
-              unsigned char *iv, unsigned char *plaintext);
+  /* this function xors size bytes of src with the keystream into dst, using
+  wide loads for the bulk of the data and a byte loop for the tail, dst may
+  alias src */
+  static void xorKeystream(unsigned char *dst, const unsigned char *src,
+    const unsigned char *keystream, std::size_t size);
+
+  void handleErrors(void);
 
   /* setter */
   void setBlockSize(int blockSize);
@@ -115,6 +128,11 @@ private:
   unsigned long long int _ctrCounter=0;
   unsigned long long int _savedCtrCounter=0;
   std::vector<unsigned char> _nonceV;
+  /* number of counter blocks encrypted per EVP call by the keystream engine */
+  static const unsigned int _keystreamBatchBlocks = 256;
+  EVP_CIPHER_CTX *_ecbCtx = nullptr;
+  std::vector<unsigned char> _counterBlocksV;
+  std::vector<unsigned char> _keystreamV;
   std::vector<unsigned char> _nonceSaved;
 
 };
@@ -2,6 +2,12 @@
 #include <stdexcept>
 #include <thread>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "./../include/AesCtrMachine.h"
 #include "./../include/Function.h"
 
@@ -11,9 +17,24 @@ AesCtrMachine::AesCtrMachine(const unsigned int blockSize) {
   AesCtrMachine::setBlockSize(blockSize);
   AesCtrMachine::setKey(_blockSize);
   AesCtrMachine::setIV(_blockSize);
+  /* the keystream engine reuses a single ECB context for the lifetime of the
+  machine, the key never changes after construction */
+  if (!(_ecbCtx = EVP_CIPHER_CTX_new())) {
+    AesCtrMachine::handleErrors();
+  }
+  if (1 != EVP_EncryptInit_ex(_ecbCtx, EVP_aes_128_ecb(), NULL, _key, NULL)) {
+    AesCtrMachine::handleErrors();
+  }
+  EVP_CIPHER_CTX_set_padding(_ecbCtx, 0);
+  _counterBlocksV.resize(_keystreamBatchBlocks * _blockSize);
+  _keystreamV.resize(_keystreamBatchBlocks * _blockSize);
 }
 /******************************************************************************/
 AesCtrMachine::~AesCtrMachine() {
+  EVP_CIPHER_CTX_free(_ecbCtx);
+  _ecbCtx = nullptr;
+  memset(_counterBlocksV.data(), 0, _counterBlocksV.size());
+  memset(_keystreamV.data(), 0, _keystreamV.size());
   memset(_key, 0, 2 * _blockSize + 1);
   memset(_iv, 0, 2 * _blockSize + 1);
   free(_key);
@@ -70,79 +91,7 @@ values, in the end it returns the encrypted text and sets flag b by reference to
 true if no errors or to false otherwise */
 std::string AesCtrMachine::aesCtrEncryption(
     const std::vector<unsigned char> &plainTextBytesAsciiFullText, bool *b) {
-  std::string encryptedText;
-  if (plainTextBytesAsciiFullText.size() == 0) {
-    *b = false;
-    return encryptedText;
-  }
-  std::vector<unsigned char> cypherText, decryptedTextVector;
-  unsigned char *plaintextPointer, *cyphertextPointer;
-  bool flag;
-  unsigned int size, i, j, k = 0, encryptedTextLen, nBlocks, nPop;
-  /* work to be done */
-  size = plainTextBytesAsciiFullText.size();
-  plaintextPointer =
-      (unsigned char *)calloc(_blockSize + 1, sizeof(unsigned char));
-  if (plaintextPointer == nullptr) {
-    perror("There was a problem in the memory allocation of the "
-           "'cyperTextPointer'.");
-    *b = false;
-    return encryptedText;
-  }
-  cyphertextPointer =
-      (unsigned char *)calloc(_blockSize + 1, sizeof(unsigned char));
-  if (cyphertextPointer == nullptr) {
-    perror("There was a problem in the memory allocation of the "
-           "'cypherTextPointer'.");
-    *b = false;
-    return encryptedText;
-  }
-  /* nBlocks calc */
-  if (size % _blockSize == 0) {
-    nBlocks = size / _blockSize;
-  } else {
-    nBlocks = size / _blockSize + 1;
-  }
-  for (j = 0; j < nBlocks; ++j, AesCtrMachine::updateIVCtrMode()) {
-    /* fill plaintextPointer */
-    for (i = 0; i < _blockSize && k < size; ++i, ++k) {
-      plaintextPointer[i] = plainTextBytesAsciiFullText[i + j * _blockSize];
-    }
-    /* Encrypt the plaintext */
-    encryptedTextLen = AesCtrMachine::aesCtrEncryptWorker(
-        _iv, _blockSize, _key, _iv, cyphertextPointer);
-    if (debugFlagExtreme == true) {
-      std::cout << "AesCtrMachine log | full decrypted text size = "
-                << encryptedTextLen << " bytes." << std::endl;
-      BIO_dump_fp(stdout, (const char *)cyphertextPointer, encryptedTextLen);
-    }
-    for (i = 0; i < _blockSize; ++i) {
-      cyphertextPointer[i] ^= plaintextPointer[i];
-    }
-    /* Add a NULL terminator. We are expecting printable text */
-    cyphertextPointer[encryptedTextLen] = '\0';
-    /* fill cyphertext vector */
-    flag = Function::appendToVectorFromPointerArray(
-        decryptedTextVector, cyphertextPointer, encryptedTextLen);
-    if (flag == false) {
-      perror(
-          "\nThere was an error in the function 'fillVectorFromPointerArray'.");
-      *b = false;
-      return encryptedText;
-    }
-  }
-  nPop = decryptedTextVector.size() - size;
-  for (j = 0; j < nPop; ++j) {
-    decryptedTextVector.pop_back();
-  }
-  Function::convertVectorBytesToString(decryptedTextVector, encryptedText);
-  /* free memory */
-  memset(plaintextPointer, 0, _blockSize + 1);
-  memset(cyphertextPointer, 0, _blockSize + 1);
-  free(plaintextPointer);
-  free(cyphertextPointer);
-  *b = true;
-  return encryptedText;
+  return AesCtrMachine::aesCtrApplyKeystream(plainTextBytesAsciiFullText, b);
 }
 /******************************************************************************/
 /* this function does the decryption of aes-cbc mode using the iv and key
@@ -150,167 +99,109 @@ values, in the end it returns the decrypted text and sets flag b by reference to
 true if no errors or to false otherwise */
 std::string AesCtrMachine::aesCtrDecryption(
     const std::vector<unsigned char> &encryptedBytesAsciiFullText, bool *b) {
-  std::string decryptedText;
-  if (encryptedBytesAsciiFullText.size() == 0) {
+  return AesCtrMachine::aesCtrApplyKeystream(encryptedBytesAsciiFullText, b);
+}
+/******************************************************************************/
+/* this function xors the inputV with the keystream starting at the current
+counter, producing the keystream in batches of _keystreamBatchBlocks blocks,
+in the end it returns the resulting text and sets flag b by reference to true
+if no errors or to false otherwise */
+std::string AesCtrMachine::aesCtrApplyKeystream(
+    const std::vector<unsigned char> &inputV, bool *b) {
+  std::string outputText;
+  if (inputV.size() == 0) {
     *b = false;
-    return decryptedText;
+    return outputText;
   }
-  std::vector<unsigned char> cypherText, decryptedTextVector;
-  unsigned char *cypherTextPointer, *cypherTextDecryptedPointer;
-  bool flag;
-  unsigned int size, i, j, k = 0, decryptedTextLen, nBlocks, nPop;
+  std::size_t size = inputV.size(), offset, chunkSize;
+  const std::size_t batchSize = _keystreamBatchBlocks * _blockSize;
+  unsigned int nBlocks;
+  unsigned char *outputPointer;
   /* work to be done */
-  size = encryptedBytesAsciiFullText.size();
-  cypherTextPointer =
-      (unsigned char *)calloc(_blockSize + 1, sizeof(unsigned char));
-  if (cypherTextPointer == nullptr) {
-    perror("There was a problem in the memory allocation of the "
-           "'cyperTextPointer'.");
-    *b = false;
-    return decryptedText;
+  outputText.resize(size);
+  outputPointer = reinterpret_cast<unsigned char *>(&outputText[0]);
+  for (offset = 0; offset < size; offset += chunkSize) {
+    chunkSize = std::min(size - offset, batchSize);
+    /* a trailing partial block still consumes a full counter value */
+    nBlocks = (chunkSize + _blockSize - 1) / _blockSize;
+    AesCtrMachine::generateKeystream(_keystreamV.data(), nBlocks);
+    AesCtrMachine::xorKeystream(outputPointer + offset, inputV.data() + offset,
+                                _keystreamV.data(), chunkSize);
   }
-  cypherTextDecryptedPointer =
-      (unsigned char *)calloc(_blockSize + 1, sizeof(unsigned char));
-  if (cypherTextDecryptedPointer == nullptr) {
-    perror("There was a problem in the memory allocation of the "
-           "'cypherTextDecryptedPointer'.");
-    *b = false;
-    return decryptedText;
-  }
-  /* nBlocks calc */
-  if (size % _blockSize == 0) {
-    nBlocks = size / _blockSize;
-  } else {
-    nBlocks = size / _blockSize + 1;
-  }
-  for (j = 0; j < nBlocks; ++j, AesCtrMachine::updateIVCtrMode()) {
-    /* fill cyperTextPointer */
-    for (i = 0; i < _blockSize && k < size; ++i, ++k) {
-      cypherTextPointer[i] = encryptedBytesAsciiFullText[i + j * _blockSize];
-    }
-    /* Decrypt the ciphertext */
-    decryptedTextLen = AesCtrMachine::aesCtrDecryptWorker(
-        _iv, _blockSize, _key, _iv, cypherTextDecryptedPointer);
-    if (debugFlagExtreme == true) {
-      std::cout << "AesCtrMachine log | full decrypted text size = "
-                << decryptedTextLen << " bytes." << std::endl;
-      BIO_dump_fp(stdout, (const char *)cypherTextDecryptedPointer,
-                  decryptedTextLen);
-    }
-    for (i = 0; i < _blockSize; ++i) {
-      cypherTextDecryptedPointer[i] ^= cypherTextPointer[i];
-    }
-    /* Add a NULL terminator. We are expecting printable text */
-    cypherTextDecryptedPointer[decryptedTextLen] = '\0';
-    /* fill cyphertext vector */
-    flag = Function::appendToVectorFromPointerArray(
-        decryptedTextVector, cypherTextDecryptedPointer, decryptedTextLen);
-    if (flag == false) {
-      perror(
-          "\nThere was an error in the function 'fillVectorFromPointerArray'.");
-      *b = false;
-      return decryptedText;
-    }
-  }
-  nPop = decryptedTextVector.size() - size;
-  for (j = 0; j < nPop; ++j) {
-    decryptedTextVector.pop_back();
+  if (debugFlagExtreme == true) {
+    std::cout << "AesCtrMachine log | full processed text size = " << size
+              << " bytes." << std::endl;
+    BIO_dump_fp(stdout, (const char *)outputPointer, size);
   }
-  Function::convertVectorBytesToString(decryptedTextVector, decryptedText);
-  /* free memory */
-  memset(cypherTextPointer, 0, _blockSize + 1);
-  memset(cypherTextDecryptedPointer, 0, _blockSize + 1);
-  free(cypherTextPointer);
-  free(cypherTextDecryptedPointer);
   *b = true;
-  return decryptedText;
-}
-/******************************************************************************/
-void AesCtrMachine::handleErrors(void) {
-  ERR_print_errors_fp(stderr);
-  abort();
+  return outputText;
 }
 /******************************************************************************/
-int AesCtrMachine::aesCtrEncryptWorker(unsigned char *plaintext,
-                                       int plaintextLen, unsigned char *key,
-                                       unsigned char *iv,
-                                       unsigned char *cyphertext) {
-  EVP_CIPHER_CTX *ctx;
+/* this function writes nBlocks consecutive keystream blocks into keystream,
+laying out the counter blocks exactly as updateIVCtrMode does and encrypting
+all of them with a single call over the reused _ecbCtx context, the counter
+is advanced by nBlocks in the end */
+void AesCtrMachine::generateKeystream(unsigned char *keystream,
+                                      unsigned int nBlocks) {
+  unsigned char *counterBlocks = _counterBlocksV.data();
+  const unsigned int counterSize = _blockSize / 2;
+  unsigned int j;
   int len = 0;
-  int cyphertextLen = 0;
-  /* Create and initialise the context */
-  if (!(ctx = EVP_CIPHER_CTX_new())) {
-    AesCtrMachine::handleErrors();
-  }
-  /*
-   * Initialise the encryption operation. IMPORTANT - ensure you use a key
-   * and IV size appropriate for your cipher
-   * In this example we are using 128 bit AES (i.e. a 128 bit key). The
-   * IV size for *most* modes is the same as the block size. For AES this
-   * is 128 bits
-   */
-  if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_128_ctr(), NULL, key, iv)) {
-    AesCtrMachine::handleErrors();
+  if (nBlocks > _keystreamBatchBlocks) {
+    throw std::invalid_argument(
+        "Bad nBlocks | nBlocks cannot exceed the keystream batch size");
+  }
+  for (j = 0; j < nBlocks; ++j) {
+    memcpy(counterBlocks + j * _blockSize, _iv, _blockSize);
+    if (_ctrCounter == ULLONG_MAX) {
+      /* counter wrap around, a new nonce is needed */
+      AesCtrMachine::updateIVCtrMode();
+    } else {
+      ++_ctrCounter;
+      memcpy(_iv + counterSize, &_ctrCounter, counterSize);
+    }
   }
-  // EVP_CIPHER_CTX_set_padding(ctx, 0);
-  /*
-   * Provide the message to be encrypted, and obtain the encrypted output.
-   * EVP_EncryptUpdate can be called multiple times if necessary
-   */
-  if (1 != EVP_EncryptUpdate(ctx, cyphertext, &len, plaintext, plaintextLen)) {
+  std::copy(_iv, _iv + _blockSize, _ivV.begin());
+  if (1 != EVP_EncryptUpdate(_ecbCtx, keystream, &len, counterBlocks,
+                             nBlocks * _blockSize)) {
     AesCtrMachine::handleErrors();
   }
-  cyphertextLen = len;
-  /*
-   * Finalise the encryption. Further ciphertext bytes may be written at
-   * this stage.
-   */
-  if (1 != EVP_EncryptFinal_ex(ctx, cyphertext + len, &len)) {
-    AesCtrMachine::handleErrors();
+  /* each keystream block is the counter block xored with its encryption, as
+  produced by the previous single block EVP_aes_128_ctr call over the counter
+  block itself */
+  AesCtrMachine::xorKeystream(keystream, keystream, counterBlocks,
+                              nBlocks * _blockSize);
+}
+/******************************************************************************/
+/* this function xors size bytes of src with the keystream into dst, using
+wide loads for the bulk of the data and a byte loop for the tail, dst may
+alias src */
+void AesCtrMachine::xorKeystream(unsigned char *dst, const unsigned char *src,
+                                 const unsigned char *keystream,
+                                 std::size_t size) {
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 32 <= size; i += 32) {
+    __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+    __m256i k = _mm256_loadu_si256((const __m256i *)(keystream + i));
+    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_xor_si256(s, k));
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 <= size; i += 16) {
+    __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+    __m128i k = _mm_loadu_si128((const __m128i *)(keystream + i));
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(s, k));
+  }
+#endif
+  for (; i < size; ++i) {
+    dst[i] = src[i] ^ keystream[i];
   }
-  cyphertextLen += len;
-  /* Clean up */
-  EVP_CIPHER_CTX_free(ctx);
-  return cyphertextLen;
 }
 /******************************************************************************/
-int AesCtrMachine::aesCtrDecryptWorker(unsigned char *cyphertext,
-                                       int cypherTextLen, unsigned char *key,
-                                       unsigned char *iv,
-                                       unsigned char *plaintext) {
-  EVP_CIPHER_CTX *ctx;
-  int len;
-  int plaintextLen;
-  /* Create and initialise the context */
-  if (!(ctx = EVP_CIPHER_CTX_new()))
-    AesCtrMachine::handleErrors();
-  /*
-   * Initialise the decryption operation. IMPORTANT - ensure you use a key
-   * and IV size appropriate for your cipher
-   * In this example we are using 128 bit AES (i.e. a 128 bit key). The
-   * IV size for *most* modes is the same as the block size. For AES this
-   * is 128 bits
-   */
-  if (1 != EVP_DecryptInit_ex(ctx, EVP_aes_128_ctr(), NULL, key, iv))
-    AesCtrMachine::handleErrors();
-  EVP_CIPHER_CTX_set_padding(ctx, 0);
-  /*
-   * Provide the message to be decrypted, and obtain the plaintext output.
-   * EVP_DecryptUpdate can be called multiple times if necessary.
-   */
-  if (1 != EVP_DecryptUpdate(ctx, plaintext, &len, cyphertext, cypherTextLen))
-    AesCtrMachine::handleErrors();
-  plaintextLen = len;
-  /*
-   * Finalise the decryption. Further plaintext bytes may be written at
-   * this stage.
-   */
-  if (1 != EVP_DecryptFinal_ex(ctx, plaintext + len, &len))
-    AesCtrMachine::handleErrors();
-  plaintextLen += len;
-  /* Clean up */
-  EVP_CIPHER_CTX_free(ctx);
-  return plaintextLen;
+void AesCtrMachine::handleErrors(void) {
+  ERR_print_errors_fp(stderr);
+  abort();
 }
 /******************************************************************************/
 /* this function will update the iv vector in the counter mode encryption mode,
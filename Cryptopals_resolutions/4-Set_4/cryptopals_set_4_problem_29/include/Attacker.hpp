@@ -5,6 +5,7 @@
 #include "./../include/SHA.hpp"
 #include "./../include/SHA1.hpp"
 #include "./../include/SHA1InternalState.hpp"
+#include "./../include/SHA1MultiBuffer.hpp"
 #include "./../include/Server.hpp"
 
 class Attacker {
@@ -64,7 +65,10 @@ private:
    *
    * This method will try to tamper a message intercepted and
    * deceive the server with another message authentication
-   * code (MAC)
+   * code (MAC). The forged message and MAC of every key length up to
+   * _maxKeySize are built at once, hashing all the MACs together from the
+   * internal state of the intercepted MAC, and they are sent to the server in
+   * a single batch
    *
    * @param messageParsed The content of the message intercepted, parsed already
    * @return A bool value, true if the attack was successful, false otherwise
@@ -75,7 +79,9 @@ private:
   const bool _debugFlagExtreme{false};
   static const int _sha1DigestLength{SHA_DIGEST_LENGTH};
   const std::string _messageLocation{"./../input/intercepted_url.txt"};
-  std::shared_ptr<MyCryptoLibrary::SHA1> _sha1;
+  // the server key_creation.py script creates keys of 999 bytes
+  const unsigned int _maxKeySize{1024};
+  std::shared_ptr<MyCryptoLibrary::SHA1MultiBuffer> _sha1MultiBuffer;
   std::shared_ptr<Server> _server;
   MessageFormat::MessageParsed _msgParsed;
 };
@@ -1,6 +1,9 @@
 #ifndef SHA1_HPP
 #define SHA1_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 #include "./../include/SHA.hpp"
 
 // Define SHA_DIGEST_LENGTH if it is not defined elsewhere.
@@ -9,12 +12,29 @@
 #define SHA_DIGEST_LENGTH 20
 #endif
 
+#if defined(__x86_64__) || defined(__i386__)
+#define SHA1_SHA_NI_X86
+#endif
+
 namespace MyCryptoLibrary {
 
 class SHA1 : public SHA {
 public:
-  /// Constructor.
-  SHA1();
+  /// Compression function used on the 512-bit blocks.
+  enum class Backend {
+    Auto,     // SHA-NI if the cpu supports it, portable otherwise
+    Portable, // 80 rounds in plain C++
+    ShaNi     // x86 SHA extensions
+  };
+
+  /**
+   * @brief Constructor
+   *
+   * @param backend The compression function to use
+   *
+   * @throw std::invalid_argument if the cpu does not support the backend asked
+   */
+  explicit SHA1(Backend backend = Backend::Auto);
 
   /// Destructor.
   ~SHA1();
@@ -52,6 +72,16 @@ public:
                                   uint32_t h3, uint32_t h4,
                                   std::size_t messageSize);
 
+  /* getters */
+  Backend getBackend() const;
+
+  /**
+   * @brief Checks, with CPUID, if the cpu supports the SHA extensions
+   *
+   * @return true if the ShaNi backend can be used
+   */
+  static bool shaNiSupported();
+
 private:
   /**
    * Initializes internal state based on the input length
@@ -76,14 +106,42 @@ private:
 
   /**
    * Preprocesses the input data (padding, appending length) as required by the
-   * SHA-1 algorithm.
+   * SHA-1 algorithm. Only the last incomplete block of the input is copied, the
+   * full blocks are read in place by processing().
    *
    * @param inputV The input data as a vector of unsigned char.
    */
   void preProcessing(const std::vector<unsigned char> &inputV);
 
-  /// Processes the padded message in 512-bit blocks.
-  void processing();
+  /**
+   * Processes the full blocks of the input and then the padded tail in 512-bit
+   * blocks.
+   *
+   * @param inputV The input data as a vector of unsigned char.
+   */
+  void processing(const std::vector<unsigned char> &inputV);
+
+  /**
+   * Compresses consecutive 512-bit blocks with the portable code.
+   *
+   * @param state The five working variables, updated in place.
+   * @param blocks The blocks to compress.
+   * @param nBlocks The number of blocks.
+   */
+  static void compressPortable(uint32_t state[5], const unsigned char *blocks,
+                               std::size_t nBlocks);
+
+#if defined(SHA1_SHA_NI_X86)
+  /**
+   * Compresses consecutive 512-bit blocks with the SHA extensions.
+   *
+   * @param state The five working variables, updated in place.
+   * @param blocks The blocks to compress.
+   * @param nBlocks The number of blocks.
+   */
+  static void compressShaNi(uint32_t state[5], const unsigned char *blocks,
+                            std::size_t nBlocks);
+#endif
 
   /**
    * Performs a left-rotation (circular shift) on a 32-bit integer.
@@ -99,7 +157,13 @@ private:
   /// Expected output hash size in bytes.
   std::size_t _sizeOutputHash{};
 
-  /// Padded input vector.
+  /// Compression function in use, never Auto.
+  Backend _backend;
+
+  /// Size of a block in bytes.
+  static constexpr std::size_t _blockSize{64};
+
+  /// Last incomplete block of the input, padded.
   std::vector<unsigned char> _inputVpadded{};
 
   // The five working variables (initialized in `initialization`)
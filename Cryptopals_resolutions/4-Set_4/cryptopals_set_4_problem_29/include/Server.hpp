@@ -1,7 +1,12 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 #include "./../include/SHA.hpp"
 #include "./../include/SHA1.hpp"
+#include "./../include/SHA1MultiBuffer.hpp"
 
 // Define SHA_DIGEST_LENGTH if it is not defined elsewhere.
 // SHA-1 produces a 160-bit (20-byte) digest.
@@ -33,11 +38,36 @@ public:
   bool validateMac(const std::vector<unsigned char> &msg,
                    const std::vector<unsigned char> &mac);
 
+  /**
+   * @brief This method will validate a batch of messages and their message
+   * authentication codes (MAC)
+   *
+   * This method will validate if msgs[i] produces macs[i] for every i, as
+   * validateMac does, spreading the messages over a pool of threads that hash
+   * a chunk of messages at a time with the multi buffer SHA1. Once a valid
+   * MAC is found no new chunk is started.
+   *
+   * @param msgs The messages to be authenticated
+   * @param macs The message authentication codes (mac) to be validated in
+   * binary format
+   *
+   * @return valid[i] is true if macs[i] matches the mac produced by the
+   * server for msgs[i], the messages left unvalidated after a valid MAC was
+   * found are reported as false
+   */
+  std::vector<bool>
+  validateMacs(const std::vector<std::vector<unsigned char>> &msgs,
+               const std::vector<std::vector<unsigned char>> &macs) const;
+
 private:
   const bool _debugFlag;
   bool _debugFlagExtreme{false};
   std::vector<unsigned char> _keyServer{};
   std::shared_ptr<MyCryptoLibrary::SHA> _sha;
+  std::shared_ptr<MyCryptoLibrary::SHA1MultiBuffer> _shaMultiBuffer;
+  const std::size_t _validationThreads;
+  // messages hashed together by a thread, per lane of the multi buffer SHA1
+  static constexpr std::size_t _messagesPerLane{4};
 };
 
 #endif // SERVER_HPP
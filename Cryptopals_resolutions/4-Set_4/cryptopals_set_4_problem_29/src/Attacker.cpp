@@ -9,7 +9,8 @@
 
 /* constructor / destructor */
 Attacker::Attacker(const std::shared_ptr<Server> &server, bool debugFlag)
-    : _debugFlag{debugFlag}, _sha1{std::make_shared<MyCryptoLibrary::SHA1>()},
+    : _debugFlag{debugFlag},
+      _sha1MultiBuffer{std::make_shared<MyCryptoLibrary::SHA1MultiBuffer>()},
       _server{server} {}
 /******************************************************************************/
 Attacker::~Attacker() {}
@@ -105,7 +106,10 @@ Attacker::computeSHA1padding(const std::string &message) const {
  *
  * This method will try to tamper a message intercepted and
  * deceive the server with another message authentication
- * code (MAC)
+ * code (MAC). The forged message and MAC of every key length up to
+ * _maxKeySize are built at once, hashing all the MACs together from the
+ * internal state of the intercepted MAC, and they are sent to the server in
+ * a single batch
  *
  * @param messageParsed The content of the message intercepted, parsed already
  * @return A bool value, true if the attack was successful, false otherwise
@@ -119,12 +123,14 @@ bool Attacker::tamperMessageTry(
         "Attacker::tamperMessageTry";
     throw std::invalid_argument(errorMessage);
   }
-  const unsigned int maxKeySize{64};
   unsigned int keyLength, keyLengthFixed{0};
   const std::string appendMessageGoal{"&admin=true"};
   const std::vector<unsigned char> appendMessageGoalV(appendMessageGoal.begin(),
                                                       appendMessageGoal.end());
   std::vector<unsigned char> messagePadded, newMessage, macByteFormat, newMac;
+  std::vector<std::vector<unsigned char>> newMessages, newMacs;
+  std::vector<std::size_t> messageSizes;
+  std::size_t messagePaddedSize{0};
   std::string tamperedMessage{};
   const char dummyChar = '#';
   SHA1InternalState::SHA1InternalState sha1InternalState;
@@ -137,39 +143,43 @@ bool Attacker::tamperMessageTry(
   }
   // extraction of the internal state of the SHA1 of the current mac
   sha1InternalState = Attacker::extractionSHA1InternalState(macByteFormat);
-  // Trial and error to find the length of private key of the server
-  for (keyLength = 1; keyLength <= maxKeySize; ++keyLength) {
+  // construction of the forged message for every length of the private key of
+  // the server
+  for (keyLength = 1; keyLength <= Attacker::_maxKeySize; ++keyLength) {
     std::string keyAndMessage(keyLength, dummyChar);
-    bool serverReply{false};
     keyAndMessage += messageParsed._msg;
     messagePadded = Attacker::computeSHA1padding(keyAndMessage);
-    // Computation of the new MAC using SHA-1’s state from the intercepted
-    // message
-    newMac =
-        _sha1->hash(appendMessageGoalV, sha1InternalState._internalState[0],
-                    sha1InternalState._internalState[1],
-                    sha1InternalState._internalState[2],
-                    sha1InternalState._internalState[3],
-                    sha1InternalState._internalState[4],
-                    messagePadded.size() + appendMessageGoalV.size());
     // construction of new forged message:   msg || padding || forged msg
-    newMessage.clear();
     newMessage.assign(messagePadded.begin() + keyLength, messagePadded.end());
     newMessage.insert(newMessage.end(), appendMessageGoalV.begin(),
                       appendMessageGoalV.end());
-    // Test the keyLength in the server
-    serverReply = Attacker::_server->validateMac(newMessage, newMac);
-    if (Attacker::_debugFlag) {
+    newMessages.push_back(newMessage);
+    messageSizes.push_back(messagePadded.size() + appendMessageGoalV.size());
+  }
+  // Computation of the new MACs using SHA-1’s state from the intercepted
+  // message, the same state and appended message for every key length
+  newMacs = Attacker::_sha1MultiBuffer->hash(
+      std::vector<std::vector<unsigned char>>(newMessages.size(),
+                                              appendMessageGoalV),
+      std::vector<SHA1InternalState::SHA1InternalState>(newMessages.size(),
+                                                        sha1InternalState),
+      messageSizes);
+  // Test all the key lengths in the server
+  std::vector<bool> serverReplies =
+      Attacker::_server->validateMacs(newMessages, newMacs);
+  for (keyLength = 1; keyLength <= Attacker::_maxKeySize; ++keyLength) {
+    if (Attacker::_debugFlagExtreme) {
       std::cout << "For key length: " << keyLength
-                << " server reply: " << serverReply << std::endl;
+                << " server reply: " << serverReplies[keyLength - 1]
+                << std::endl;
     }
-    if (serverReply) {
-      if (Attacker::_debugFlag) {
-        std::cout << "\nAttacker log | Size of the server key = " << keyLength
-                  << " bytes" << std::endl;
-      }
+    if (serverReplies[keyLength - 1]) {
       keyLengthFixed = keyLength;
-      tamperedMessage.assign(newMessage.begin(), newMessage.end());
+      tamperedMessage.assign(newMessages[keyLength - 1].begin(),
+                             newMessages[keyLength - 1].end());
+      newMac = newMacs[keyLength - 1];
+      messagePaddedSize =
+          messageSizes[keyLength - 1] - appendMessageGoalV.size();
       break;
     }
   }
@@ -179,9 +189,9 @@ bool Attacker::tamperMessageTry(
                 << " bytes" << " |\nTampered message: '";
       for (std::size_t i = 0; i < tamperedMessage.size(); ++i) {
         if (i < messageParsed._msg.size() ||
-            i > messagePadded.size() - keyLengthFixed - 1) {
+            i > messagePaddedSize - keyLengthFixed - 1) {
           printf("%c", static_cast<unsigned char>(tamperedMessage[i]));
-        } else if (i == messagePadded.size() - keyLengthFixed - 1) {
+        } else if (i == messagePaddedSize - keyLengthFixed - 1) {
           printf(" x%02x ", static_cast<unsigned char>(tamperedMessage[i]));
         } else {
           printf(" x%02x", static_cast<unsigned char>(tamperedMessage[i]));
@@ -1,11 +1,67 @@
+#include <climits>
 #include <openssl/conf.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <stdexcept>
 
 #include "./../include/SHA1.hpp"
 
+#if defined(SHA1_SHA_NI_X86)
+#include <cpuid.h>
+#include <immintrin.h>
+
+namespace {
+
+/**
+ * @brief Runs the rounds 4G to 4G+3 of a block with the SHA extensions, and
+ * then the following groups up to the round 79
+ *
+ * The message schedule is kept in msg, four words per register, and the E
+ * value of the group alternates between two registers: eCurrent holds the one
+ * of this group and eNext receives the one of the next group.
+ *
+ * @param abcd The working variables a, b, c and d
+ * @param eCurrent The E value of this group
+ * @param eNext The E value of the next group
+ * @param msg The last 16 words of the message schedule
+ */
+template <int G>
+__attribute__((target("sha,sse4.1,ssse3"), always_inline)) inline void
+shaNiRounds(__m128i &abcd, __m128i &eCurrent, __m128i &eNext, __m128i *msg) {
+  if constexpr (G == 0) {
+    eCurrent = _mm_add_epi32(eCurrent, msg[0]);
+  } else {
+    eCurrent = _mm_sha1nexte_epu32(eCurrent, msg[G % 4]);
+  }
+  eNext = abcd;
+  if constexpr (G >= 3 && G <= 18) {
+    msg[(G + 1) % 4] = _mm_sha1msg2_epu32(msg[(G + 1) % 4], msg[G % 4]);
+  }
+  abcd = _mm_sha1rnds4_epu32(abcd, eCurrent, G / 5);
+  if constexpr (G >= 1 && G <= 16) {
+    msg[(G + 3) % 4] = _mm_sha1msg1_epu32(msg[(G + 3) % 4], msg[G % 4]);
+  }
+  if constexpr (G >= 2 && G <= 17) {
+    msg[(G + 2) % 4] = _mm_xor_si128(msg[(G + 2) % 4], msg[G % 4]);
+  }
+  if constexpr (G < 19) {
+    shaNiRounds<G + 1>(abcd, eNext, eCurrent, msg);
+  }
+}
+
+} // namespace
+#endif
+
 /* constructor / destructor */
-MyCryptoLibrary::SHA1::SHA1() : _sizeOutputHash{SHA_DIGEST_LENGTH} {}
+MyCryptoLibrary::SHA1::SHA1(Backend backend)
+    : _sizeOutputHash{SHA_DIGEST_LENGTH}, _backend{backend} {
+  if (_backend == Backend::Auto) {
+    _backend = SHA1::shaNiSupported() ? Backend::ShaNi : Backend::Portable;
+  } else if (_backend == Backend::ShaNi && !SHA1::shaNiSupported()) {
+    throw std::invalid_argument(
+        "SHA1 log | the SHA extensions are not supported by this cpu");
+  }
+}
 /******************************************************************************/
 MyCryptoLibrary::SHA1::~SHA1() {}
 /******************************************************************************/
@@ -19,10 +75,9 @@ MyCryptoLibrary::SHA1::~SHA1() {}
  */
 std::vector<unsigned char>
 MyCryptoLibrary::SHA1::hash(const std::vector<unsigned char> &inputV) {
-  _inputVpadded.clear();
   initialization(inputV.size());
   preProcessing(inputV);
-  processing();
+  processing(inputV);
   std::vector<unsigned char> hashV;
   hashV.reserve(SHA_DIGEST_LENGTH);
 
@@ -58,10 +113,9 @@ std::vector<unsigned char>
 MyCryptoLibrary::SHA1::hash(const std::vector<unsigned char> &inputV,
                             uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3,
                             uint32_t h4, std::size_t messageSize) {
-  _inputVpadded.clear();
   initialization(messageSize, h0, h1, h2, h3, h4);
   preProcessing(inputV);
-  processing();
+  processing(inputV);
   std::vector<unsigned char> hashV;
   hashV.reserve(SHA_DIGEST_LENGTH);
 
@@ -76,6 +130,40 @@ MyCryptoLibrary::SHA1::hash(const std::vector<unsigned char> &inputV,
   return hashV;
 }
 /******************************************************************************/
+// gets the compression function in use
+MyCryptoLibrary::SHA1::Backend MyCryptoLibrary::SHA1::getBackend() const {
+  return _backend;
+}
+/******************************************************************************/
+/**
+ * @brief Checks, with CPUID, if the cpu supports the SHA extensions
+ *
+ * The SHA-NI code also needs SSSE3 and SSE4.1, which every cpu with the SHA
+ * extensions has, they are checked anyway.
+ *
+ * @return true if the ShaNi backend can be used
+ */
+bool MyCryptoLibrary::SHA1::shaNiSupported() {
+#if defined(SHA1_SHA_NI_X86)
+  static const bool supported = []() {
+    unsigned int eax{0}, ebx{0}, ecx{0}, edx{0};
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      return false;
+    }
+    const bool hasSsse3 = (ecx & bit_SSSE3) != 0;
+    const bool hasSse41 = (ecx & bit_SSE4_1) != 0;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+      return false;
+    }
+    const bool hasSha = (ebx & bit_SHA) != 0;
+    return hasSsse3 && hasSse41 && hasSha;
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+/******************************************************************************/
 /**
  * Initializes internal state based on the input length
  *
@@ -117,14 +205,17 @@ void MyCryptoLibrary::SHA1::initialization(const std::size_t sizeInputV,
 /******************************************************************************/
 /**
  * Preprocesses the input data (padding, appending length) as required by the
- * SHA-1 algorithm.
+ * SHA-1 algorithm. Only the last incomplete block of the input is copied, the
+ * full blocks are read in place by processing().
  *
  * @param inputV The input data as a vector of unsigned char.
  */
 void MyCryptoLibrary::SHA1::preProcessing(
     const std::vector<unsigned char> &inputV) {
-  // Initialize padded input vector with original message
-  _inputVpadded = inputV;
+  // Initialize padded input vector with the last incomplete block
+  const std::size_t fullBlocksSize =
+      inputV.size() - inputV.size() % SHA1::_blockSize;
+  _inputVpadded.assign(inputV.begin() + fullBlocksSize, inputV.end());
 
   // Step 1: Append the bit '1' (equivalent to adding 0x80)
   _inputVpadded.push_back(0x80);
@@ -143,12 +234,47 @@ void MyCryptoLibrary::SHA1::preProcessing(
   }
 }
 /******************************************************************************/
-/// Processes the padded message in 512-bit blocks.
-void MyCryptoLibrary::SHA1::processing() {
-  // Process the padded input in 512-bit blocks
-  for (std::size_t i = 0; i < _inputVpadded.size(); i += 64) {
-    std::vector<unsigned char> block(_inputVpadded.begin() + i,
-                                     _inputVpadded.begin() + i + 64);
+/**
+ * Processes the full blocks of the input and then the padded tail in 512-bit
+ * blocks.
+ *
+ * @param inputV The input data as a vector of unsigned char.
+ */
+void MyCryptoLibrary::SHA1::processing(
+    const std::vector<unsigned char> &inputV) {
+  uint32_t state[5] = {_h0, _h1, _h2, _h3, _h4};
+  const std::size_t fullBlocks = inputV.size() / SHA1::_blockSize;
+  const std::size_t tailBlocks = _inputVpadded.size() / SHA1::_blockSize;
+#if defined(SHA1_SHA_NI_X86)
+  if (_backend == Backend::ShaNi) {
+    SHA1::compressShaNi(state, inputV.data(), fullBlocks);
+    SHA1::compressShaNi(state, _inputVpadded.data(), tailBlocks);
+  } else
+#endif
+  {
+    SHA1::compressPortable(state, inputV.data(), fullBlocks);
+    SHA1::compressPortable(state, _inputVpadded.data(), tailBlocks);
+  }
+  // Update the hash values
+  _h0 = state[0];
+  _h1 = state[1];
+  _h2 = state[2];
+  _h3 = state[3];
+  _h4 = state[4];
+}
+/******************************************************************************/
+/**
+ * Compresses consecutive 512-bit blocks with the portable code.
+ *
+ * @param state The five working variables, updated in place.
+ * @param blocks The blocks to compress.
+ * @param nBlocks The number of blocks.
+ */
+void MyCryptoLibrary::SHA1::compressPortable(uint32_t state[5],
+                                             const unsigned char *blocks,
+                                             std::size_t nBlocks) {
+  for (std::size_t i = 0; i < nBlocks; ++i) {
+    const unsigned char *block = blocks + i * SHA1::_blockSize;
     // Prepare the message schedule (W)
     uint32_t W[80];
 
@@ -164,45 +290,81 @@ void MyCryptoLibrary::SHA1::processing() {
     }
 
     // Initialize hash values
-    uint32_t a = _h0;
-    uint32_t b = _h1;
-    uint32_t c = _h2;
-    uint32_t d = _h3;
-    uint32_t e = _h4;
-
-    // Main loop
-    for (int t = 0; t < 80; ++t) {
-      uint32_t f, k;
-      if (t < 20) {
-        f = (b & c) | (~b & d);
-        k = 0x5A827999;
-      } else if (t < 40) {
-        f = b ^ c ^ d;
-        k = 0x6ED9EBA1;
-      } else if (t < 60) {
-        f = (b & c) | (b & d) | (c & d);
-        k = 0x8F1BBCDC;
-      } else {
-        f = b ^ c ^ d;
-        k = 0xCA62C1D6;
-      }
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
 
+    // Main loop, one loop per round function so that f and k are fixed
+    auto step = [&](uint32_t f, uint32_t k, int t) {
       uint32_t temp = leftRotate(a, 5) + f + e + W[t] + k;
       e = d;
       d = c;
       c = leftRotate(b, 30);
       b = a;
       a = temp;
+    };
+    for (int t = 0; t < 20; ++t) {
+      step((b & c) | (~b & d), 0x5A827999, t);
+    }
+    for (int t = 20; t < 40; ++t) {
+      step(b ^ c ^ d, 0x6ED9EBA1, t);
+    }
+    for (int t = 40; t < 60; ++t) {
+      step((b & c) | (b & d) | (c & d), 0x8F1BBCDC, t);
+    }
+    for (int t = 60; t < 80; ++t) {
+      step(b ^ c ^ d, 0xCA62C1D6, t);
     }
 
     // Update the hash values
-    _h0 += a;
-    _h1 += b;
-    _h2 += c;
-    _h3 += d;
-    _h4 += e;
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+  }
+}
+/******************************************************************************/
+#if defined(SHA1_SHA_NI_X86)
+/**
+ * Compresses consecutive 512-bit blocks with the SHA extensions.
+ *
+ * The words are loaded in place and byte swapped to big-endian, a, b, c and d
+ * are kept in one register in reverse order, as the instructions expect them.
+ *
+ * @param state The five working variables, updated in place.
+ * @param blocks The blocks to compress.
+ * @param nBlocks The number of blocks.
+ */
+__attribute__((target("sha,sse4.1,ssse3"))) void
+MyCryptoLibrary::SHA1::compressShaNi(uint32_t state[5],
+                                     const unsigned char *blocks,
+                                     std::size_t nBlocks) {
+  const __m128i byteSwap =
+      _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+  __m128i abcd = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1B);
+  __m128i e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+  __m128i e1, msg[4];
+  for (std::size_t i = 0; i < nBlocks; ++i) {
+    const __m128i *block =
+        reinterpret_cast<const __m128i *>(blocks + i * SHA1::_blockSize);
+    const __m128i abcdSaved = abcd, e0Saved = e0;
+    for (int k = 0; k < 4; ++k) {
+      msg[k] = _mm_shuffle_epi8(_mm_loadu_si128(block + k), byteSwap);
+    }
+    shaNiRounds<0>(abcd, e0, e1, msg);
+    // after the 80 rounds e0 holds the E value of the next block
+    e0 = _mm_sha1nexte_epu32(e0, e0Saved);
+    abcd = _mm_add_epi32(abcd, abcdSaved);
   }
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(state),
+                   _mm_shuffle_epi32(abcd, 0x1B));
+  state[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
 }
+#endif
 /******************************************************************************/
 /**
  * Performs a left-rotation (circular shift) on a 32-bit integer.
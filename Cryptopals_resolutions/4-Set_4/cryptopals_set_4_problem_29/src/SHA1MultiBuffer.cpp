@@ -0,0 +1,355 @@
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "./../include/SHA1MultiBuffer.hpp"
+
+namespace {
+
+const std::size_t blockSize{64}; // bytes
+
+#define SHA1_MB_ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+/* one SHA-1 step, the same for all the lanes */
+#define SHA1_MB_STEP(f, k)                                                     \
+  temp = SHA1_MB_ROTL(a, 5) + (f) + e + w[t & 15] + (k);                       \
+  e = d;                                                                       \
+  d = c;                                                                       \
+  c = SHA1_MB_ROTL(b, 30);                                                     \
+  b = a;                                                                       \
+  a = temp;
+
+/**
+ * @brief Compresses one block of L messages at once
+ *
+ * The lanes are the elements of a gcc vector, so that the same code becomes
+ * SSE2, AVX2 or AVX-512 code depending on the target of the function it is
+ * inlined in.
+ *
+ * @param state The five registers of every lane, state[k * L + lane]
+ * @param block The 16 big-endian words of every lane, block[t * L + lane]
+ */
+template <std::size_t L>
+__attribute__((always_inline)) inline void compressLanes(uint32_t *state,
+                                                         const uint32_t *block) {
+  typedef uint32_t V __attribute__((vector_size(sizeof(uint32_t) * L)));
+  V w[16], a, b, c, d, e, temp;
+  std::memcpy(w, block, sizeof(w));
+  std::memcpy(&a, state + 0 * L, sizeof(V));
+  std::memcpy(&b, state + 1 * L, sizeof(V));
+  std::memcpy(&c, state + 2 * L, sizeof(V));
+  std::memcpy(&d, state + 3 * L, sizeof(V));
+  std::memcpy(&e, state + 4 * L, sizeof(V));
+  const V a0 = a, b0 = b, c0 = c, d0 = d, e0 = e;
+  int t = 0;
+  // the message schedule is kept in a window of 16 words
+  for (; t < 16; ++t) {
+    SHA1_MB_STEP((b & c) | (~b & d), 0x5A827999u);
+  }
+  for (; t < 80; ++t) {
+    w[t & 15] = SHA1_MB_ROTL(w[(t + 13) & 15] ^ w[(t + 8) & 15] ^
+                                 w[(t + 2) & 15] ^ w[t & 15],
+                             1);
+    if (t < 20) {
+      SHA1_MB_STEP((b & c) | (~b & d), 0x5A827999u);
+    } else if (t < 40) {
+      SHA1_MB_STEP(b ^ c ^ d, 0x6ED9EBA1u);
+    } else if (t < 60) {
+      SHA1_MB_STEP((b & c) | (b & d) | (c & d), 0x8F1BBCDCu);
+    } else {
+      SHA1_MB_STEP(b ^ c ^ d, 0xCA62C1D6u);
+    }
+  }
+  a += a0;
+  b += b0;
+  c += c0;
+  d += d0;
+  e += e0;
+  std::memcpy(state + 0 * L, &a, sizeof(V));
+  std::memcpy(state + 1 * L, &b, sizeof(V));
+  std::memcpy(state + 2 * L, &c, sizeof(V));
+  std::memcpy(state + 3 * L, &d, sizeof(V));
+  std::memcpy(state + 4 * L, &e, sizeof(V));
+}
+
+#undef SHA1_MB_STEP
+#undef SHA1_MB_ROTL
+
+/* the kernels, the dispatch picks one of them at runtime */
+#if defined(SHA1_MULTI_BUFFER_X86)
+__attribute__((target("avx512f"))) void compress16(uint32_t *state,
+                                                   const uint32_t *block) {
+  compressLanes<16>(state, block);
+}
+
+__attribute__((target("avx2"))) void compress8(uint32_t *state,
+                                               const uint32_t *block) {
+  compressLanes<8>(state, block);
+}
+#endif
+
+void compress4(uint32_t *state, const uint32_t *block) {
+  compressLanes<4>(state, block);
+}
+
+void compress1(uint32_t *state, const uint32_t *block) {
+  compressLanes<1>(state, block);
+}
+
+/**
+ * @brief Hashes the messages, L at a time
+ *
+ * Every lane hashes one message block by block, as soon as a message is done
+ * its lane is given the next one, so that messages of different lengths keep
+ * all the lanes busy. Lanes left without a message compress a zero block whose
+ * result is thrown away.
+ *
+ * @param messages The messages, their state is updated in place
+ * @param n The number of messages
+ * @param compress The kernel for L lanes
+ */
+template <std::size_t L, typename Message>
+void hashLanes(Message *messages, std::size_t n,
+               void (*compress)(uint32_t *, const uint32_t *)) {
+  alignas(64) uint32_t state[5 * L];
+  alignas(64) uint32_t block[16 * L];
+  static const unsigned char zeroBlock[blockSize] = {};
+  Message *lanes[L];
+  std::size_t blocks[L];
+  std::size_t lane, k, t, next{0}, active{0};
+  const unsigned char *p;
+  uint32_t word;
+
+  auto assignMessage = [&](std::size_t laneIndex) {
+    lanes[laneIndex] = nullptr;
+    if (next < n) {
+      lanes[laneIndex] = &messages[next++];
+      blocks[laneIndex] = 0;
+      for (k = 0; k < 5; ++k) {
+        state[k * L + laneIndex] = lanes[laneIndex]->state[k];
+      }
+      ++active;
+    }
+  };
+
+  for (lane = 0; lane < L; ++lane) {
+    assignMessage(lane);
+  }
+  while (active > 0) {
+    for (lane = 0; lane < L; ++lane) {
+      p = zeroBlock;
+      if (lanes[lane] != nullptr) {
+        const Message &m = *lanes[lane];
+        p = blocks[lane] < m.fullBlocks
+                ? m.data + blocks[lane] * blockSize
+                : m.tail + (blocks[lane] - m.fullBlocks) * blockSize;
+      }
+      for (t = 0; t < 16; ++t) {
+        std::memcpy(&word, p + t * 4, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap32(word);
+#endif
+        block[t * L + lane] = word;
+      }
+    }
+    compress(state, block);
+    for (lane = 0; lane < L; ++lane) {
+      if (lanes[lane] != nullptr &&
+          ++blocks[lane] == lanes[lane]->fullBlocks + lanes[lane]->tailBlocks) {
+        for (k = 0; k < 5; ++k) {
+          lanes[lane]->state[k] = state[k * L + lane];
+        }
+        --active;
+        assignMessage(lane);
+      }
+    }
+  }
+}
+
+/* this function tells if the cpu can run the kernel with the given lanes */
+bool lanesSupported(std::size_t lanes) {
+  switch (lanes) {
+  case 1:
+  case 4:
+    return true;
+#if defined(SHA1_MULTI_BUFFER_X86)
+  case 8:
+    return __builtin_cpu_supports("avx2");
+  case 16:
+    return __builtin_cpu_supports("avx512f");
+#endif
+  default:
+    return false;
+  }
+}
+
+} // namespace
+
+/* constructor / destructor */
+MyCryptoLibrary::SHA1MultiBuffer::SHA1MultiBuffer(std::size_t lanes)
+    : _lanes{lanes == 0 ? SHA1MultiBuffer::widestLanes() : lanes} {
+  if (!lanesSupported(_lanes)) {
+    const std::string errorMessage{
+        "SHA1MultiBuffer log | a kernel with " + std::to_string(_lanes) +
+        " lanes is not supported by this cpu"};
+    throw std::invalid_argument(errorMessage);
+  }
+}
+/******************************************************************************/
+MyCryptoLibrary::SHA1MultiBuffer::~SHA1MultiBuffer() {}
+/******************************************************************************/
+/**
+ * @brief Computes the SHA-1 hash values of several messages
+ *
+ * Computes the SHA-1 hash of every input vector, compressing one block of
+ * up to getLanes() different messages at once
+ *
+ * @param inputsV The input messages
+ * @return The hash of inputsV[i] at the position i
+ */
+std::vector<std::vector<unsigned char>> MyCryptoLibrary::SHA1MultiBuffer::hash(
+    const std::vector<std::vector<unsigned char>> &inputsV) const {
+  std::vector<Message> messages(inputsV.size());
+  for (std::size_t i = 0; i < inputsV.size(); ++i) {
+    messages[i].state[0] = 0x67452301;
+    messages[i].state[1] = 0xEFCDAB89;
+    messages[i].state[2] = 0x98BADCFE;
+    messages[i].state[3] = 0x10325476;
+    messages[i].state[4] = 0xC3D2E1F0;
+    SHA1MultiBuffer::prepareMessage(messages[i], inputsV[i],
+                                    inputsV[i].size());
+  }
+  return SHA1MultiBuffer::hashMessages(messages);
+}
+/******************************************************************************/
+/**
+ * @brief Computes the SHA-1 hash values of several messages
+ *
+ * Computes the SHA-1 hash of every input vector from its own predefined
+ * internal state, as SHA1::hash does for a single message
+ *
+ * @param inputsV The input messages
+ * @param internalStates The internal state of the SHA1 for each message
+ * @param messageSizes Size of the entire message that was intended to hash
+ * from the start, for each message
+ *
+ * @return The hash of inputsV[i] at the position i
+ *
+ * @throw std::invalid_argument if the three vectors differ in size or if an
+ * internal state does not hold 5 registers
+ */
+std::vector<std::vector<unsigned char>> MyCryptoLibrary::SHA1MultiBuffer::hash(
+    const std::vector<std::vector<unsigned char>> &inputsV,
+    const std::vector<SHA1InternalState::SHA1InternalState> &internalStates,
+    const std::vector<std::size_t> &messageSizes) const {
+  if (internalStates.size() != inputsV.size() ||
+      messageSizes.size() != inputsV.size()) {
+    const std::string errorMessage{
+        "SHA1MultiBuffer log | inputsV, internalStates and messageSizes must "
+        "have the same size at the method SHA1MultiBuffer::hash"};
+    throw std::invalid_argument(errorMessage);
+  }
+  std::vector<Message> messages(inputsV.size());
+  for (std::size_t i = 0; i < inputsV.size(); ++i) {
+    if (internalStates[i]._internalState.size() != 5) {
+      const std::string errorMessage{
+          "SHA1MultiBuffer log | the internal state " + std::to_string(i) +
+          " does not hold 5 registers"};
+      throw std::invalid_argument(errorMessage);
+    }
+    std::memcpy(messages[i].state, internalStates[i]._internalState.data(),
+                sizeof(messages[i].state));
+    SHA1MultiBuffer::prepareMessage(messages[i], inputsV[i], messageSizes[i]);
+  }
+  return SHA1MultiBuffer::hashMessages(messages);
+}
+/******************************************************************************/
+/* getters */
+std::size_t MyCryptoLibrary::SHA1MultiBuffer::getLanes() const {
+  return _lanes;
+}
+/******************************************************************************/
+/**
+ * @brief Finds the widest kernel supported by the cpu
+ *
+ * @return The number of lanes of that kernel
+ */
+std::size_t MyCryptoLibrary::SHA1MultiBuffer::widestLanes() {
+  for (std::size_t lanes : {16, 8, 4}) {
+    if (lanesSupported(lanes)) {
+      return lanes;
+    }
+  }
+  return 1;
+}
+/******************************************************************************/
+/**
+ * @brief Prepares a message for hashing
+ *
+ * @param message The message to prepare, its state must be already set
+ * @param inputV The message bytes
+ * @param messageSize The size written in the padding, in bytes
+ */
+void MyCryptoLibrary::SHA1MultiBuffer::prepareMessage(
+    Message &message, const std::vector<unsigned char> &inputV,
+    std::size_t messageSize) {
+  const std::size_t remainder{inputV.size() % blockSize};
+  // message length in bits (always a multiple of the number of bits in a
+  // character)
+  const uint64_t ml{static_cast<uint64_t>(messageSize) * CHAR_BIT};
+  message.data = inputV.data();
+  message.fullBlocks = inputV.size() / blockSize;
+  // the bit '1', the '0' bits and the 64-bit length take one more block when
+  // they do not fit after the remainder
+  message.tailBlocks = remainder + 1 + 8 <= blockSize ? 1 : 2;
+  if (remainder > 0) {
+    std::memcpy(message.tail, message.data + message.fullBlocks * blockSize,
+                remainder);
+  }
+  message.tail[remainder] = 0x80;
+  std::memset(message.tail + remainder + 1, 0x00,
+              message.tailBlocks * blockSize - remainder - 1 - 8);
+  for (int i = 0; i < 8; ++i) {
+    message.tail[message.tailBlocks * blockSize - 8 + i] =
+        static_cast<unsigned char>((ml >> ((7 - i) * 8)) & 0xFF);
+  }
+}
+/******************************************************************************/
+/**
+ * @brief Hashes all the messages with the kernel of the instance
+ *
+ * @return The digests of the messages, in the same order
+ */
+std::vector<std::vector<unsigned char>>
+MyCryptoLibrary::SHA1MultiBuffer::hashMessages(
+    std::vector<Message> &messages) const {
+  switch (_lanes) {
+#if defined(SHA1_MULTI_BUFFER_X86)
+  case 16:
+    hashLanes<16>(messages.data(), messages.size(), compress16);
+    break;
+  case 8:
+    hashLanes<8>(messages.data(), messages.size(), compress8);
+    break;
+#endif
+  case 4:
+    hashLanes<4>(messages.data(), messages.size(), compress4);
+    break;
+  default:
+    hashLanes<1>(messages.data(), messages.size(), compress1);
+    break;
+  }
+  std::vector<std::vector<unsigned char>> hashesV(
+      messages.size(), std::vector<unsigned char>(SHA_DIGEST_LENGTH));
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    for (int k = 0; k < 5; ++k) {
+      hashesV[i][k * 4] = (messages[i].state[k] >> 24) & 0xFF;
+      hashesV[i][k * 4 + 1] = (messages[i].state[k] >> 16) & 0xFF;
+      hashesV[i][k * 4 + 2] = (messages[i].state[k] >> 8) & 0xFF;
+      hashesV[i][k * 4 + 3] = messages[i].state[k] & 0xFF;
+    }
+  }
+  return hashesV;
+}
+/******************************************************************************/
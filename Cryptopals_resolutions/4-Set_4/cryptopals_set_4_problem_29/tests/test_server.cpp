@@ -86,3 +86,27 @@ TEST_F(ServerTest, validateMac_InvalidMacSize_ShouldThrowAnException) {
     FAIL() << "Expected std::invalid_argument, but got a different exception";
   }
 }
+
+/**
+ * @test Test that the server can validate a batch of messages with their macs
+ * @brief Test that the server validates every message of a batch as
+ * validateMac does, performing the test SHA1(key server || msg) == mac
+ *
+ * Should flag only the matching mac, and throw an invalid argument exception
+ * when the batch is malformed
+ */
+TEST_F(ServerTest, validateMacs_BatchWithOneValidMac_ShouldFlagOnlyIt) {
+  std::string msgS{"user=bob&amount=1000&timestamp=1700000000"};
+  std::vector<unsigned char> msg(msgS.begin(), msgS.end());
+  std::string macHexS{"b240077242795755b85fa52c89c9806e0d68c277"};
+  std::vector<unsigned char> macBin;
+  macBin = MessageExtractionFacility::hexToBytes(macHexS);
+  std::vector<unsigned char> macBinFlipped{macBin};
+  macBinFlipped[0] ^= 0x01; // flip least significant bit
+  std::vector<std::vector<unsigned char>> msgs(3, msg), macs(3, macBinFlipped);
+  macs[1] = macBin;
+  std::vector<bool> valid = _server->validateMacs(msgs, macs);
+  ASSERT_EQ(valid, std::vector<bool>({false, true, false}));
+  macs.pop_back();
+  EXPECT_THROW(_server->validateMacs(msgs, macs), std::invalid_argument);
+}
@@ -111,3 +111,30 @@ TEST_F(SHA1Test, Hash_EmptyInputWithInternalRegisters_ShouldMatchReference) {
   ASSERT_EQ(_hash.size(), SHA_DIGEST_LENGTH);
   ASSERT_EQ(_hash, expected);
 }
+
+/**
+ * @test Test that the SHA-NI and the portable backends are equivalent.
+ * @brief Ensures that both backends give the same hash, for every length
+ * around the block boundaries and from a predefined internal state
+ */
+TEST_F(SHA1Test, Hash_ShaNiAndPortableBackends_ShouldMatch) {
+  if (!MyCryptoLibrary::SHA1::shaNiSupported()) {
+    GTEST_SKIP() << "The SHA extensions are not supported by this cpu";
+  }
+  MyCryptoLibrary::SHA1 portable(MyCryptoLibrary::SHA1::Backend::Portable);
+  MyCryptoLibrary::SHA1 shaNi(MyCryptoLibrary::SHA1::Backend::ShaNi);
+  ASSERT_EQ(shaNi.getBackend(), MyCryptoLibrary::SHA1::Backend::ShaNi);
+  for (std::size_t size = 0; size <= 300; ++size) {
+    _input.assign(size, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+      _input[i] = static_cast<unsigned char>(i * 31 + size);
+    }
+    ASSERT_EQ(shaNi.hash(_input), portable.hash(_input)) << "size " << size;
+    ASSERT_EQ(
+        shaNi.hash(_input, 0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210,
+                   0xF0E1D2C3, size + 128),
+        portable.hash(_input, 0x01234567, 0x89ABCDEF, 0xFEDCBA98, 0x76543210,
+                      0xF0E1D2C3, size + 128))
+        << "size " << size;
+  }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../include/SHA1.hpp"
+#include "../include/SHA1InternalState.hpp"
+#include "../include/SHA1MultiBuffer.hpp"
+
+class SHA1MultiBufferTest : public ::testing::Test {
+protected:
+  // cppcheck-suppress unusedFunction
+  void SetUp() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    _sha1 = std::make_unique<MyCryptoLibrary::SHA1>(); // Shared setup
+    // messages of every length up to three blocks, so that every lane gets
+    // messages that end at different blocks
+    for (std::size_t size = 0; size <= 3 * 64; ++size) {
+      std::vector<unsigned char> input(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        input[i] = static_cast<unsigned char>(size * 7 + i * 31);
+      }
+      _inputs.push_back(input);
+    }
+    for (std::size_t lanes : {1, 4, 8, 16}) {
+      try {
+        _lanesSupported.push_back(
+            MyCryptoLibrary::SHA1MultiBuffer(lanes).getLanes());
+      } catch (const std::invalid_argument &) {
+        // kernel not supported by this cpu
+      }
+    }
+  }
+
+  // cppcheck-suppress unusedFunction
+  void TearDown() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    // Cleanup (if needed)
+  }
+
+  // cppcheck-suppress unusedStructMember
+  std::unique_ptr<MyCryptoLibrary::SHA1> _sha1;
+  std::vector<std::vector<unsigned char>> _inputs;
+  std::vector<std::size_t> _lanesSupported;
+};
+
+/**
+ * @test Test the correctness of the multi buffer hash function.
+ * @brief Ensures that every kernel supported by the cpu matches the single
+ * message SHA1 for messages of many lengths hashed together
+ */
+TEST_F(SHA1MultiBufferTest, Hash_ManyLengths_ShouldMatchSingleMessageHash) {
+  ASSERT_FALSE(_lanesSupported.empty());
+  for (std::size_t lanes : _lanesSupported) {
+    MyCryptoLibrary::SHA1MultiBuffer sha1MultiBuffer(lanes);
+    std::vector<std::vector<unsigned char>> hashes =
+        sha1MultiBuffer.hash(_inputs);
+    ASSERT_EQ(hashes.size(), _inputs.size());
+    for (std::size_t i = 0; i < _inputs.size(); ++i) {
+      ASSERT_EQ(hashes[i], _sha1->hash(_inputs[i]))
+          << "lanes " << lanes << ", message size " << _inputs[i].size();
+    }
+  }
+}
+
+/**
+ * @test Test the correctness of the multi buffer hash function from
+ * predefined internal states.
+ * @brief Ensures that every kernel supported by the cpu matches the single
+ * message SHA1 when each message starts from its own internal state and
+ * message size, as in a length extension
+ */
+TEST_F(SHA1MultiBufferTest,
+       Hash_WithInternalStates_ShouldMatchSingleMessageHash) {
+  std::vector<SHA1InternalState::SHA1InternalState> internalStates;
+  std::vector<std::size_t> messageSizes;
+  for (std::size_t i = 0; i < _inputs.size(); ++i) {
+    SHA1InternalState::SHA1InternalState internalState;
+    for (uint32_t k = 0; k < 5; ++k) {
+      internalState._internalState.push_back(0x01234567u * (k + 1) + i);
+    }
+    internalStates.push_back(internalState);
+    messageSizes.push_back(64 * (i % 5) + _inputs[i].size());
+  }
+  for (std::size_t lanes : _lanesSupported) {
+    MyCryptoLibrary::SHA1MultiBuffer sha1MultiBuffer(lanes);
+    std::vector<std::vector<unsigned char>> hashes =
+        sha1MultiBuffer.hash(_inputs, internalStates, messageSizes);
+    for (std::size_t i = 0; i < _inputs.size(); ++i) {
+      const std::vector<uint32_t> &h = internalStates[i]._internalState;
+      ASSERT_EQ(hashes[i], _sha1->hash(_inputs[i], h[0], h[1], h[2], h[3],
+                                       h[4], messageSizes[i]))
+          << "lanes " << lanes << ", message size " << _inputs[i].size();
+    }
+  }
+}
+
+/**
+ * @test Test the validation of the inputs of the multi buffer hash function.
+ * @brief Ensures that an exception is thrown when the internal states do not
+ * match the messages
+ */
+TEST_F(SHA1MultiBufferTest, Hash_InvalidInternalStates_ShouldThrowAnException) {
+  MyCryptoLibrary::SHA1MultiBuffer sha1MultiBuffer;
+  std::vector<SHA1InternalState::SHA1InternalState> internalStates(1);
+  std::vector<std::size_t> messageSizes{0};
+  EXPECT_THROW(sha1MultiBuffer.hash({{}}, internalStates, messageSizes),
+               std::invalid_argument);
+  EXPECT_THROW(sha1MultiBuffer.hash({{}, {}}, internalStates, messageSizes),
+               std::invalid_argument);
+  EXPECT_TRUE(sha1MultiBuffer.hash({}).empty());
+}
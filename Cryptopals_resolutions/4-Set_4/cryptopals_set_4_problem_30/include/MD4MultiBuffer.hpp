@@ -0,0 +1,116 @@
+#ifndef MD4_MULTI_BUFFER_HPP
+#define MD4_MULTI_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "./../include/MD4.hpp"
+#include "./../include/MD4InternalState.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define MD4_MULTI_BUFFER_X86
+#endif
+
+namespace MyCryptoLibrary {
+
+class MD4MultiBuffer {
+public:
+  /**
+   * @brief Constructor
+   *
+   * @param lanes The number of messages compressed at once, 16 (AVX-512), 8
+   * (AVX2), 4 (SSE2) or 1 (scalar), 0 picks the widest kernel the cpu
+   * supports
+   *
+   * @throw std::invalid_argument if the cpu does not support the kernel asked
+   */
+  explicit MD4MultiBuffer(std::size_t lanes = 0);
+
+  /// Destructor.
+  ~MD4MultiBuffer();
+
+  /**
+   * @brief Computes the MD4 hash values of several messages
+   *
+   * Computes the MD4 hash of every input vector, compressing one block of
+   * up to getLanes() different messages at once
+   *
+   * @param inputsV The input messages
+   * @return The hash of inputsV[i] at the position i
+   */
+  std::vector<std::vector<unsigned char>>
+  hash(const std::vector<std::vector<unsigned char>> &inputsV) const;
+
+  /**
+   * @brief Computes the MD4 hash values of several messages
+   *
+   * Computes the MD4 hash of every input vector from its own predefined
+   * internal state, as MD4::hash does for a single message
+   *
+   * @param inputsV The input messages
+   * @param internalStates The internal state of the MD4 for each message
+   * @param messageSizes Size of the entire message that was intended to hash
+   * from the start, for each message
+   *
+   * @return The hash of inputsV[i] at the position i
+   *
+   * @throw std::invalid_argument if the three vectors differ in size or if an
+   * internal state does not hold 4 registers
+   */
+  std::vector<std::vector<unsigned char>>
+  hash(const std::vector<std::vector<unsigned char>> &inputsV,
+       const std::vector<MD4InternalState::MD4InternalState> &internalStates,
+       const std::vector<std::size_t> &messageSizes) const;
+
+  /* getters */
+  std::size_t getLanes() const;
+
+  /**
+   * @brief Finds the widest kernel supported by the cpu
+   *
+   * @return The number of lanes of that kernel
+   */
+  static std::size_t widestLanes();
+
+private:
+  /**
+   * @brief One message being hashed
+   *
+   * The full blocks are read in place from data, the last one or two blocks,
+   * with the padding and the length, are built in tail
+   */
+  struct Message {
+    const unsigned char *data;
+    std::size_t fullBlocks;
+    unsigned char tail[2 * 64];
+    std::size_t tailBlocks;
+    uint32_t state[4];
+  };
+
+  /**
+   * @brief Prepares a message for hashing
+   *
+   * @param message The message to prepare, its state must be already set
+   * @param inputV The message bytes
+   * @param messageSize The size written in the padding, in bytes
+   */
+  static void prepareMessage(Message &message,
+                             const std::vector<unsigned char> &inputV,
+                             std::size_t messageSize);
+
+  /**
+   * @brief Hashes all the messages with the kernel of the instance
+   *
+   * @return The digests of the messages, in the same order
+   */
+  std::vector<std::vector<unsigned char>>
+  hashMessages(std::vector<Message> &messages) const;
+
+  /// Number of messages compressed at once.
+  const std::size_t _lanes;
+};
+
+} // namespace MyCryptoLibrary
+
+#endif // MD4_MULTI_BUFFER_HPP
@@ -3,6 +3,8 @@
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -10,6 +12,7 @@
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include "./../include/MD4.hpp"
 #include "./../include/MessageExtractionFacility.hpp"
@@ -17,7 +20,10 @@
 
 /* constructor / destructor */
 Server::Server(const bool debugFlag)
-    : _debugFlag(debugFlag), _md(std::make_shared<MyCryptoLibrary::MD4>()) {
+    : _debugFlag(debugFlag), _md(std::make_shared<MyCryptoLibrary::MD4>()),
+      _mdMultiBuffer(std::make_shared<MyCryptoLibrary::MD4MultiBuffer>()),
+      _validationThreads{
+          std::max<std::size_t>(1, std::thread::hardware_concurrency())} {
   std::string hexServerKey{};
   if (std::getenv("KEY_SERVER_SET_4_PROBLEM_30") != nullptr) {
     hexServerKey = std::getenv("KEY_SERVER_SET_4_PROBLEM_30");
@@ -66,3 +72,82 @@ bool Server::validateMac(const std::vector<unsigned char> &msg,
   return macServer == mac;
 }
 /******************************************************************************/
+/**
+ * @brief This method will validate a batch of messages and their message
+ * authentication codes (MAC)
+ *
+ * This method will validate if msgs[i] produces macs[i] for every i, as
+ * validateMac does, spreading the messages over a pool of threads that hash
+ * a chunk of messages at a time with the multi buffer MD4. Once a valid
+ * MAC is found no new chunk is started.
+ *
+ * @param msgs The messages to be authenticated
+ * @param macs The message authentication codes (mac) to be validated in
+ * binary format
+ *
+ * @return valid[i] is true if macs[i] matches the mac produced by the
+ * server for msgs[i], the messages left unvalidated after a valid MAC was
+ * found are reported as false
+ */
+std::vector<bool> Server::validateMacs(
+    const std::vector<std::vector<unsigned char>> &msgs,
+    const std::vector<std::vector<unsigned char>> &macs) const {
+  if (msgs.size() != macs.size()) {
+    const std::string errorMessage =
+        "Server log | msgs and macs received in the method "
+        "Server::validateMacs do not have the same size.";
+    throw std::invalid_argument(errorMessage);
+  }
+  for (const std::vector<unsigned char> &mac : macs) {
+    if (mac.size() != MD4_DIGEST_LENGTH) {
+      const std::string errorMessage =
+          "Server log | mac received in the method "
+          "Server::validateMacs does not match the " +
+          std::to_string(MD4_DIGEST_LENGTH) + std::string(" length in bytes.");
+      throw std::invalid_argument(errorMessage);
+    }
+  }
+  if (Server::_keyServer.empty()) {
+    throw std::runtime_error("Server log | Server::_keyServer is empty!");
+  }
+  const std::size_t nMsgs{msgs.size()};
+  const std::size_t chunkSize{_mdMultiBuffer->getLanes() * _messagesPerLane};
+  const std::size_t nChunks{(nMsgs + chunkSize - 1) / chunkSize};
+  // one byte per message, std::vector<bool> cannot be written concurrently
+  std::vector<unsigned char> valid(nMsgs, 0);
+  std::atomic<std::size_t> nextChunk{0};
+  std::atomic<bool> found{false};
+
+  auto validateChunks = [&]() {
+    std::vector<std::vector<unsigned char>> msgsToValidateV;
+    std::size_t chunk, begin, end, i;
+    while (!found.load() && (chunk = nextChunk.fetch_add(1)) < nChunks) {
+      begin = chunk * chunkSize;
+      end = std::min(nMsgs, begin + chunkSize);
+      msgsToValidateV.assign(end - begin, Server::_keyServer);
+      for (i = begin; i < end; ++i) {
+        msgsToValidateV[i - begin].insert(msgsToValidateV[i - begin].end(),
+                                          msgs[i].begin(), msgs[i].end());
+      }
+      std::vector<std::vector<unsigned char>> macsServer =
+          _mdMultiBuffer->hash(msgsToValidateV);
+      for (i = begin; i < end; ++i) {
+        if (macsServer[i - begin] == macs[i]) {
+          valid[i] = 1;
+          found.store(true);
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (std::size_t t = 1; t < std::min(_validationThreads, nChunks); ++t) {
+    workers.emplace_back(validateChunks);
+  }
+  validateChunks();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  return std::vector<bool>(valid.begin(), valid.end());
+}
+/******************************************************************************/
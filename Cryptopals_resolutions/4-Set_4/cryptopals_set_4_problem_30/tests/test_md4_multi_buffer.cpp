@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../include/MD4.hpp"
+#include "../include/MD4InternalState.hpp"
+#include "../include/MD4MultiBuffer.hpp"
+
+class MD4MultiBufferTest : public ::testing::Test {
+protected:
+  // cppcheck-suppress unusedFunction
+  void SetUp() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    _md4 = std::make_unique<MyCryptoLibrary::MD4>(); // Shared setup
+    // messages of every length up to three blocks, so that every lane gets
+    // messages that end at different blocks
+    for (std::size_t size = 0; size <= 3 * 64; ++size) {
+      std::vector<unsigned char> input(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        input[i] = static_cast<unsigned char>(size * 7 + i * 31);
+      }
+      _inputs.push_back(input);
+    }
+    for (std::size_t lanes : {1, 4, 8, 16}) {
+      try {
+        _lanesSupported.push_back(
+            MyCryptoLibrary::MD4MultiBuffer(lanes).getLanes());
+      } catch (const std::invalid_argument &) {
+        // kernel not supported by this cpu
+      }
+    }
+  }
+
+  // cppcheck-suppress unusedFunction
+  void TearDown() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    // Cleanup (if needed)
+  }
+
+  // cppcheck-suppress unusedStructMember
+  std::unique_ptr<MyCryptoLibrary::MD4> _md4;
+  std::vector<std::vector<unsigned char>> _inputs;
+  std::vector<std::size_t> _lanesSupported;
+};
+
+/**
+ * @test Test the correctness of the multi buffer hash function.
+ * @brief Ensures that every kernel supported by the cpu matches the single
+ * message MD4 for messages of many lengths hashed together
+ */
+TEST_F(MD4MultiBufferTest, Hash_ManyLengths_ShouldMatchSingleMessageHash) {
+  ASSERT_FALSE(_lanesSupported.empty());
+  for (std::size_t lanes : _lanesSupported) {
+    MyCryptoLibrary::MD4MultiBuffer md4MultiBuffer(lanes);
+    std::vector<std::vector<unsigned char>> hashes =
+        md4MultiBuffer.hash(_inputs);
+    ASSERT_EQ(hashes.size(), _inputs.size());
+    for (std::size_t i = 0; i < _inputs.size(); ++i) {
+      ASSERT_EQ(hashes[i], _md4->hash(_inputs[i]))
+          << "lanes " << lanes << ", message size " << _inputs[i].size();
+    }
+  }
+}
+
+/**
+ * @test Test the correctness of the multi buffer hash function from
+ * predefined internal states.
+ * @brief Ensures that every kernel supported by the cpu matches the single
+ * message MD4 when each message starts from its own internal state and
+ * message size, as in a length extension
+ */
+TEST_F(MD4MultiBufferTest,
+       Hash_WithInternalStates_ShouldMatchSingleMessageHash) {
+  std::vector<MD4InternalState::MD4InternalState> internalStates;
+  std::vector<std::size_t> messageSizes;
+  for (std::size_t i = 0; i < _inputs.size(); ++i) {
+    MD4InternalState::MD4InternalState internalState;
+    for (uint32_t k = 0; k < 4; ++k) {
+      internalState._internalState.push_back(0x01234567u * (k + 1) + i);
+    }
+    internalStates.push_back(internalState);
+    messageSizes.push_back(64 * (i % 5) + _inputs[i].size());
+  }
+  for (std::size_t lanes : _lanesSupported) {
+    MyCryptoLibrary::MD4MultiBuffer md4MultiBuffer(lanes);
+    std::vector<std::vector<unsigned char>> hashes =
+        md4MultiBuffer.hash(_inputs, internalStates, messageSizes);
+    for (std::size_t i = 0; i < _inputs.size(); ++i) {
+      const std::vector<uint32_t> &h = internalStates[i]._internalState;
+      ASSERT_EQ(hashes[i], _md4->hash(_inputs[i], h[0], h[1], h[2], h[3],
+                                      messageSizes[i]))
+          << "lanes " << lanes << ", message size " << _inputs[i].size();
+    }
+  }
+}
+
+/**
+ * @test Test the validation of the inputs of the multi buffer hash function.
+ * @brief Ensures that an exception is thrown when the internal states do not
+ * match the messages
+ */
+TEST_F(MD4MultiBufferTest, Hash_InvalidInternalStates_ShouldThrowAnException) {
+  MyCryptoLibrary::MD4MultiBuffer md4MultiBuffer;
+  std::vector<MD4InternalState::MD4InternalState> internalStates(1);
+  std::vector<std::size_t> messageSizes{0};
+  EXPECT_THROW(md4MultiBuffer.hash({{}}, internalStates, messageSizes),
+               std::invalid_argument);
+  EXPECT_THROW(md4MultiBuffer.hash({{}, {}}, internalStates, messageSizes),
+               std::invalid_argument);
+  EXPECT_TRUE(md4MultiBuffer.hash({}).empty());
+}
@@ -0,0 +1,115 @@
+#ifndef ADAPTIVE_SAMPLER_HPP
+#define ADAPTIVE_SAMPLER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+class AdaptiveSampler {
+public:
+  /* robust location estimator used to rank the candidates */
+  enum class Estimator { Median, TrimmedMean };
+
+  /**
+   * @brief Source of timing samples
+   *
+   * It receives the indexes of the candidates to sample and the number of
+   * samples wanted for each one, and it returns samples[i][k], the k-th
+   * latency sample (in microseconds) of candidates[i]
+   */
+  using SampleSource = std::function<std::vector<std::vector<double>>(
+      const std::vector<std::size_t> &candidates,
+      std::size_t samplesPerCandidate)>;
+
+  /**
+   * @brief Outcome of a selection
+   *
+   * confident is true if the leader was separated from every other candidate
+   * at the confidence level of the sampler, baselineEstimate is the median of
+   * the estimates of all the candidates after the first round, which is the
+   * latency of a wrong guess
+   */
+  struct Result {
+    bool confident{false};
+    std::size_t leader{0};
+    double leaderEstimate{0.0};
+    double baselineEstimate{0.0};
+    std::size_t requests{0};
+  };
+
+  /* constructor / destructor*/
+  AdaptiveSampler(Estimator estimator = Estimator::Median,
+                  double confidenceZ = 3.0, std::size_t initialSamples = 5,
+                  std::size_t maxSamples = 160, std::size_t maxRetries = 2,
+                  std::chrono::milliseconds backoff = std::chrono::milliseconds{
+                      100});
+  ~AdaptiveSampler();
+
+  /**
+   * @brief This method will find the candidate with the largest latency.
+   *
+   * This method will find, among nCandidates candidates, the one with the
+   * largest latency, eliminating candidates in rounds. Every candidate gets
+   * the initial samples, then each round keeps at most the upper half of the
+   * candidates, drops the ones whose confidence interval falls below the one
+   * of the leader, and doubles the samples of the survivors, so that the extra
+   * samples only go to the leading candidates. If the survivors cannot be told
+   * apart after maxSamples samples, their samples are discarded and, after a
+   * back off, they are sampled again from scratch, up to maxRetries times.
+   *
+   * @param nCandidates the number of candidates, they are indexed from 0
+   * @param source the source of the timing samples
+   *
+   * @return the leader and the statistics of the selection
+   */
+  Result selectLeader(std::size_t nCandidates, const SampleSource &source);
+
+  /**
+   * @brief This method computes the location and the standard error.
+   *
+   * This method computes the location of the samples with the estimator of the
+   * sampler and the robust spread of the samples, scaled so that the standard
+   * error of the location is spread / sqrt(number of samples).
+   *
+   * @return double: the location of the samples
+   * @return double: the robust spread of the samples
+   */
+  std::tuple<double, double> estimate(const std::vector<double> &samples) const;
+
+  /**
+   * @brief This method computes the median of the samples.
+   */
+  static double median(std::vector<double> samples);
+
+  /**
+   * @brief This method computes the mean of the samples after dropping the
+   * fraction trim of the samples from each end.
+   */
+  static double trimmedMean(std::vector<double> samples, double trim);
+
+private:
+  /**
+   * @brief This method asks the source for more samples of the candidates.
+   *
+   * @return the number of requests issued
+   */
+  static std::size_t addSamples(const SampleSource &source,
+                                const std::vector<std::size_t> &candidates,
+                                std::size_t samplesPerCandidate,
+                                std::vector<std::vector<double>> &samples);
+
+  const Estimator _estimator;
+  const double _confidenceZ;
+  const std::size_t _initialSamples;
+  const std::size_t _maxSamples;
+  const std::size_t _maxRetries;
+  const std::chrono::milliseconds _backoff;
+  const double _trim{0.2}; // fraction dropped from each end by TrimmedMean
+  // below this number of samples per candidate the rounds only keep the upper
+  // half, the confidence intervals are not trusted yet
+  const std::size_t _minIntervalSamples{10};
+};
+
+#endif // ADAPTIVE_SAMPLER_HPP
@@ -2,8 +2,12 @@
 #define ATTACKER_HPP
 
 #include <cpr/cpr.h>
+#include <memory>
 #include <tuple>
 
+#include "./../include/AdaptiveSampler.hpp"
+#include "./../include/TimingProbeClient.hpp"
+
 class Attacker {
 public:
   /* constructor / destructor*/
@@ -15,7 +19,13 @@ public:
    * file.
    *
    * This method will try to break HMAC SHA1 signature for any given
-   * file, the signature will be validated on the server side.
+   * file, the signature will be validated on the server side. For every byte
+   * of the signature the 256 candidates are timed through the pool of
+   * keep-alive connections of the probe client, and the adaptive sampler picks
+   * the candidate with the largest server side latency. Every byte also
+   * re-verifies the previous one: if the previous byte was right, the wrong
+   * guesses of the current byte are as slow as the leader of the previous byte,
+   * otherwise the attack backs off and recovers the previous byte again.
    *
    * @param fileName the file that the attacker is trying to find the signature
    *
@@ -48,7 +58,10 @@ private:
 
   const int _portServerProduction{18080};
   const int _portServerTest{18081};
-  const int _attackSamples{10};
+  const std::size_t _probeConnections{4};
+  const std::size_t _maxBacktracks{5};
+  std::shared_ptr<TimingProbeClient> _probeClient;
+  AdaptiveSampler _sampler;
 };
 
 #endif // ATTACKER_HPP
@@ -11,6 +11,18 @@ namespace MyCryptoLibrary {
 
 class HMAC_SHA1 : public HMAC {
 public:
+  /**
+   * @brief Precomputed key of HMAC-SHA1
+   *
+   * It holds the SHA-1 midstates after compressing the block sized key xored
+   * with the ipad and with the opad, so that a MAC under the same key only
+   * costs the message blocks plus one outer block
+   */
+  struct KeySchedule {
+    SHA1::Context inner;
+    SHA1::Context outer;
+  };
+
   /* constructor / destructor*/
   HMAC_SHA1();
   virtual ~HMAC_SHA1();
@@ -30,6 +42,34 @@ public:
   hmac(const std::vector<unsigned char> &key,
        const std::vector<unsigned char> &message) override;
 
+  /**
+   * @brief Calculates a given hmac-sha1(k, m) from a precomputed key
+   *
+   * This method calculates a given hmac(k, m) resuming from the midstates of
+   * the key schedule, it does not modify the instance, so that it can be
+   * called concurrently
+   *
+   * @param keySchedule The key schedule of the key to be used in the hmac-sha1
+   * @param msg The message to be used in the hmac-sha1
+   *
+   * @return The hmac-sha1(k, m) in a vector format
+   */
+  std::vector<unsigned char>
+  hmac(const KeySchedule &keySchedule,
+       const std::vector<unsigned char> &message) const;
+
+  /**
+   * @brief Calculates the key schedule of a key
+   *
+   * This method compresses the ipad and the opad blocks of the key once, to
+   * be reused by every hmac-sha1 computed under that key
+   *
+   * @param key The key to be used in the hmac-sha1
+   *
+   * @return The key schedule of the key
+   */
+  KeySchedule computeKeySchedule(const std::vector<unsigned char> &key);
+
 private:
   /**
    * @brief Calculates a block sized key
@@ -46,7 +86,8 @@ private:
                        const std::size_t blockSize) override;
 
   const std::size_t _blockSize{64}; // bytes
-  std::vector<unsigned char> _opadV, _ipadV, _keyBlock;
+  // only read by hmac, so that one instance can be shared between threads
+  const std::vector<unsigned char> _opadV, _ipadV;
 };
 
 } // namespace MyCryptoLibrary
@@ -3,6 +3,9 @@
 
 #include "./../include/SHA.hpp"
 
+#include <cstddef>
+#include <cstdint>
+
 #include <openssl/conf.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
@@ -23,6 +26,21 @@ namespace MyCryptoLibrary {
 
 class SHA1 : public SHA {
 public:
+  /**
+   * @brief Running state of one SHA-1 computation
+   *
+   * It holds the five chaining words, the number of bytes absorbed so far and
+   * the bytes of the last incomplete block, so that a message can be hashed in
+   * pieces without copying it. Every computation owns its context, which makes
+   * concurrent hashes independent of each other.
+   */
+  struct Context {
+    uint32_t state[5];
+    uint64_t length;                       // bytes absorbed so far
+    unsigned char buffer[SHA1_BLOCK_SIZE]; // incomplete block
+    std::size_t bufferSize;                // bytes used in buffer
+  };
+
   /// Constructor.
   SHA1();
 
@@ -62,41 +80,65 @@ public:
                                   uint32_t h3, uint32_t h4,
                                   std::size_t messageSize);
 
-private:
   /**
-   * Initializes internal state based on the input length
+   * @brief Starts a SHA-1 computation
+   *
+   * Sets the context to the standard initial state, with no bytes absorbed
    *
-   * @param sizeInputV The size of the original message in bytes
+   * @param ctx The context of the computation
    */
-  void initialization(const std::size_t sizeInputV);
+  static void init(Context &ctx);
 
   /**
-   * Initializes internal state based on the input length and predefined input
-   * state
+   * @brief Starts a SHA-1 computation from a predefined internal state
+   *
+   * Sets the context to the given internal state, as if processedBytes bytes
+   * had already been absorbed, which is how a length extension resumes a
+   * known digest
    *
-   * @param sizeInputV The size of the original message in bytes
+   * @param ctx The context of the computation
    * @param h0 Internal state of the SHA1
    * @param h1 Internal state of the SHA1
    * @param h2 Internal state of the SHA1
    * @param h3 Internal state of the SHA1
    * @param h4 Internal state of the SHA1
+   * @param processedBytes Number of bytes already hashed into the state
    */
-  void initialization(const std::size_t sizeInputV, uint32_t h0, uint32_t h1,
-                      uint32_t h2, uint32_t h3, uint32_t h4);
+  static void init(Context &ctx, uint32_t h0, uint32_t h1, uint32_t h2,
+                   uint32_t h3, uint32_t h4, uint64_t processedBytes);
 
   /**
-   * Preprocesses the input data (padding, appending length) as required by the
-   * SHA-1 algorithm.
+   * @brief Absorbs more bytes into a SHA-1 computation
    *
-   * @param inputV The input data as a vector of unsigned char.
+   * Full blocks are compressed straight from the caller's memory, only the
+   * tail of an incomplete block is copied into the context
+   *
+   * @param ctx The context of the computation
+   * @param data The bytes to hash
+   * @param size The number of bytes to hash
    */
-  void preProcessing(const std::vector<unsigned char> &inputV);
+  static void update(Context &ctx, const unsigned char *data,
+                     std::size_t size);
 
   /**
-   * Processes the padded message in 512-bit blocks
+   * @brief Finishes a SHA-1 computation
+   *
+   * Appends the padding and the message length and writes the digest
+   *
+   * @param ctx The context of the computation, it must be initialized again
+   * before being reused
+   * @param digest The output buffer, SHA1_DIGEST_LENGTH bytes long
    */
-  /// Processes the padded message in 512-bit blocks.
-  void processing();
+  static void final(Context &ctx, unsigned char *digest);
+
+private:
+  /**
+   * Processes one 512-bit block, updating the internal state
+   *
+   * @param state The five chaining words of the SHA1
+   * @param block The 64 bytes of the block
+   */
+  static void compress(uint32_t *state, const unsigned char *block);
 
   /**
    * Performs a left-rotation (circular shift) on a 32-bit integer.
@@ -109,15 +151,6 @@ private:
 
   /// Expected output hash size in bytes.
   std::size_t _sizeOutputHash{};
-
-  /// Padded input vector.
-  std::vector<unsigned char> _inputVpadded{};
-
-  // The five working variables (initialized in `initialization`)
-  uint32_t _h0{}, _h1{}, _h2{}, _h3{}, _h4{};
-
-  /// Message length in bits.
-  uint64_t _ml{};
 };
 
 } // namespace MyCryptoLibrary
@@ -73,7 +73,9 @@ private:
 
   std::vector<unsigned char> _keyServer{};
   crow::SimpleApp _app;
-  std::shared_ptr<MyCryptoLibrary::HMAC> _hmac;
+  std::shared_ptr<MyCryptoLibrary::HMAC_SHA1> _hmac;
+  // midstates of _keyServer, computed once since the key never changes
+  MyCryptoLibrary::HMAC_SHA1::KeySchedule _keySchedule{};
 
   const int _portProduction{18080};
   const int _portTest{18081};
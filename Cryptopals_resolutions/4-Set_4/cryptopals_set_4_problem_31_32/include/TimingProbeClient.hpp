@@ -0,0 +1,79 @@
+#ifndef TIMING_PROBE_CLIENT_HPP
+#define TIMING_PROBE_CLIENT_HPP
+
+#include <chrono>
+#include <cpr/cpr.h>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class TimingProbeClient {
+public:
+  /**
+   * @brief Timing of one request sent to the server
+   *
+   * latency is the server side latency measured at the socket level, from the
+   * moment the request was fully sent until the first byte of the response
+   * arrived, wallTime is the steady_clock time of the whole transfer
+   */
+  struct TimingSample {
+    bool accepted{false};
+    std::chrono::microseconds latency{0};
+    std::chrono::microseconds wallTime{0};
+  };
+
+  /* constructor / destructor*/
+  TimingProbeClient(const std::string &url, std::size_t nConnections);
+  ~TimingProbeClient();
+
+  /**
+   * @brief This method will time samplesPerSignature requests for every
+   * signature.
+   *
+   * This method will send samplesPerSignature requests for every signature in
+   * signatures, asking for the file fileName. The requests are spread over the
+   * pool of keep-alive connections, one thread per connection, and the
+   * signatures are interleaved so that every candidate is sampled on every
+   * connection and along the whole duration of the call.
+   *
+   * @param fileName the file the requests are asking for
+   * @param signatures the candidate signatures to time
+   * @param samplesPerSignature the number of requests sent for every signature
+   *
+   * @return samples[i][k] holds the k-th sample of signatures[i]
+   */
+  std::vector<std::vector<TimingSample>>
+  probe(const std::string &fileName, const std::vector<std::string> &signatures,
+        std::size_t samplesPerSignature);
+
+  /**
+   * @brief This method will time a single request.
+   *
+   * This method will send a single request for the signature and the file
+   * fileName through the first connection of the pool.
+   *
+   * @return the timing of the request and the server response
+   */
+  std::tuple<TimingSample, cpr::Response>
+  probeOnce(const std::string &fileName, const std::string &signature);
+
+  /* getters */
+  std::size_t getNumberConnections() const;
+
+private:
+  /**
+   * @brief This method will send one request through the session and time it.
+   *
+   * @return the timing of the request and the server response
+   */
+  static std::tuple<TimingSample, cpr::Response>
+  timedGet(cpr::Session &session, const std::string &fileName,
+           const std::string &signature);
+
+  const std::string _url;
+  // one session per connection, cpr keeps the connection of a session alive
+  std::vector<std::unique_ptr<cpr::Session>> _sessions;
+};
+
+#endif // TIMING_PROBE_CLIENT_HPP
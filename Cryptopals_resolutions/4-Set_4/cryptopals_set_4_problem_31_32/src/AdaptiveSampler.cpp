@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+#include "./../include/AdaptiveSampler.hpp"
+
+/* constructor / destructor */
+AdaptiveSampler::AdaptiveSampler(Estimator estimator, double confidenceZ,
+                                 std::size_t initialSamples,
+                                 std::size_t maxSamples, std::size_t maxRetries,
+                                 std::chrono::milliseconds backoff)
+    : _estimator{estimator}, _confidenceZ{confidenceZ},
+      _initialSamples{initialSamples}, _maxSamples{maxSamples},
+      _maxRetries{maxRetries}, _backoff{backoff} {
+  if (initialSamples < 2 || maxSamples < initialSamples) {
+    throw std::invalid_argument(
+        "AdaptiveSampler log | initialSamples must be at least 2 and "
+        "maxSamples at least initialSamples");
+  }
+}
+/******************************************************************************/
+AdaptiveSampler::~AdaptiveSampler() {}
+/******************************************************************************/
+/**
+ * @brief This method will find the candidate with the largest latency.
+ *
+ * This method will find, among nCandidates candidates, the one with the
+ * largest latency, eliminating candidates in rounds. Every candidate gets
+ * the initial samples, then each round keeps at most the upper half of the
+ * candidates, drops the ones whose confidence interval falls below the one of
+ * the leader, and doubles the samples of the survivors, so that the extra
+ * samples only go to the leading candidates. If the survivors cannot be told
+ * apart after maxSamples samples, their samples are discarded and, after a
+ * back off, they are sampled again from scratch, up to maxRetries times.
+ *
+ * @param nCandidates the number of candidates, they are indexed from 0
+ * @param source the source of the timing samples
+ *
+ * @return the leader and the statistics of the selection
+ */
+AdaptiveSampler::Result
+AdaptiveSampler::selectLeader(std::size_t nCandidates,
+                              const SampleSource &source) {
+  if (nCandidates == 0) {
+    throw std::invalid_argument(
+        "AdaptiveSampler log | there must be at least one candidate");
+  }
+  Result result;
+  std::vector<std::vector<double>> samples(nCandidates);
+  std::vector<double> location(nCandidates), spread(nCandidates),
+      pooledSamples;
+  std::vector<std::size_t> active(nCandidates), survivors;
+  std::size_t retries{0}, samplesPerCandidate{_initialSamples};
+  std::iota(active.begin(), active.end(), 0);
+  result.requests += AdaptiveSampler::addSamples(source, active,
+                                                 samplesPerCandidate, samples);
+  for (std::size_t c : active) {
+    std::tie(location[c], spread[c]) = AdaptiveSampler::estimate(samples[c]);
+    pooledSamples.insert(pooledSamples.end(), samples[c].begin(),
+                         samples[c].end());
+  }
+  result.baselineEstimate = AdaptiveSampler::median(location);
+  // almost every candidate is a wrong guess with the same latency
+  // distribution, so the spread is estimated once from all the samples of the
+  // first round, a candidate with a few lucky samples cannot shrink its
+  // interval
+  const double pooledSpread{
+      std::get<1>(AdaptiveSampler::estimate(pooledSamples))};
+  while (active.size() > 1) {
+    std::sort(active.begin(), active.end(),
+              [&location](std::size_t a, std::size_t b) {
+                return location[a] > location[b];
+              });
+    const std::size_t leader{active[0]};
+    const double halfInterval{_confidenceZ * pooledSpread /
+                              std::sqrt(static_cast<double>(
+                                  samplesPerCandidate))};
+    const bool useInterval{samplesPerCandidate >= _minIntervalSamples};
+    survivors.assign(1, leader);
+    for (std::size_t r = 1; r < (active.size() + 1) / 2 || r < 2; ++r) {
+      const std::size_t c{active[r]};
+      if (useInterval &&
+          location[c] + halfInterval < location[leader] - halfInterval) {
+        break;
+      }
+      survivors.push_back(c);
+    }
+    active = survivors;
+    if (active.size() == 1) {
+      break;
+    }
+    if (samplesPerCandidate >= _maxSamples) {
+      if (retries == _maxRetries) {
+        break;
+      }
+      // the leading candidates cannot be told apart, a burst of noise may have
+      // polluted their samples: back off and re-verify them from scratch
+      std::this_thread::sleep_for(_backoff * (1 << retries));
+      ++retries;
+      for (std::size_t c : active) {
+        samples[c].clear();
+      }
+      samplesPerCandidate = _initialSamples;
+      result.requests += AdaptiveSampler::addSamples(
+          source, active, samplesPerCandidate, samples);
+    } else {
+      const std::size_t extraSamples{
+          std::min(samplesPerCandidate, _maxSamples - samplesPerCandidate)};
+      samplesPerCandidate += extraSamples;
+      result.requests +=
+          AdaptiveSampler::addSamples(source, active, extraSamples, samples);
+    }
+    for (std::size_t c : active) {
+      std::tie(location[c], spread[c]) = AdaptiveSampler::estimate(samples[c]);
+    }
+  }
+  result.confident = (active.size() == 1);
+  result.leader = active[0];
+  result.leaderEstimate = location[result.leader];
+  return result;
+}
+/******************************************************************************/
+/**
+ * @brief This method computes the location and the standard error.
+ *
+ * This method computes the location of the samples with the estimator of the
+ * sampler and the robust spread of the samples, scaled so that the standard
+ * error of the location is spread / sqrt(number of samples).
+ *
+ * @return double: the location of the samples
+ * @return double: the robust spread of the samples
+ */
+std::tuple<double, double>
+AdaptiveSampler::estimate(const std::vector<double> &samples) const {
+  if (samples.empty()) {
+    throw std::invalid_argument("AdaptiveSampler log | no samples to estimate");
+  }
+  const double center{AdaptiveSampler::median(samples)};
+  if (_estimator == Estimator::Median) {
+    // median absolute deviation scaled to a standard deviation, and the
+    // asymptotic efficiency of the median under normal noise
+    std::vector<double> deviations(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+      deviations[i] = std::fabs(samples[i] - center);
+    }
+    const double sigma{1.4826 * AdaptiveSampler::median(deviations)};
+    return std::make_tuple(center, 1.2533 * sigma);
+  }
+  // winsorized standard deviation of the trimmed mean
+  std::vector<double> sorted(samples);
+  std::sort(sorted.begin(), sorted.end());
+  const std::size_t n{sorted.size()};
+  const std::size_t g{static_cast<std::size_t>(_trim * n)};
+  for (std::size_t i = 0; i < g; ++i) {
+    sorted[i] = sorted[g];
+    sorted[n - 1 - i] = sorted[n - 1 - g];
+  }
+  const double mean{std::accumulate(sorted.begin(), sorted.end(), 0.0) / n};
+  double variance{0.0};
+  for (double value : sorted) {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= (n > 1 ? n - 1 : 1);
+  return std::make_tuple(AdaptiveSampler::trimmedMean(samples, _trim),
+                         std::sqrt(variance) / (1.0 - 2.0 * _trim));
+}
+/******************************************************************************/
+/**
+ * @brief This method computes the median of the samples.
+ */
+double AdaptiveSampler::median(std::vector<double> samples) {
+  if (samples.empty()) {
+    throw std::invalid_argument("AdaptiveSampler log | median of no samples");
+  }
+  const std::size_t half{samples.size() / 2};
+  std::nth_element(samples.begin(), samples.begin() + half, samples.end());
+  if (samples.size() % 2 == 1) {
+    return samples[half];
+  }
+  const double upper{samples[half]};
+  const double lower{
+      *std::max_element(samples.begin(), samples.begin() + half)};
+  return (lower + upper) / 2.0;
+}
+/******************************************************************************/
+/**
+ * @brief This method computes the mean of the samples after dropping the
+ * fraction trim of the samples from each end.
+ */
+double AdaptiveSampler::trimmedMean(std::vector<double> samples, double trim) {
+  if (samples.empty() || trim < 0.0 || trim >= 0.5) {
+    throw std::invalid_argument(
+        "AdaptiveSampler log | trimmed mean needs samples and trim in [0, 0.5)");
+  }
+  std::sort(samples.begin(), samples.end());
+  const std::size_t g{static_cast<std::size_t>(trim * samples.size())};
+  return std::accumulate(samples.begin() + g, samples.end() - g, 0.0) /
+         static_cast<double>(samples.size() - 2 * g);
+}
+/******************************************************************************/
+/**
+ * @brief This method asks the source for more samples of the candidates.
+ *
+ * @return the number of requests issued
+ */
+std::size_t
+AdaptiveSampler::addSamples(const SampleSource &source,
+                            const std::vector<std::size_t> &candidates,
+                            std::size_t samplesPerCandidate,
+                            std::vector<std::vector<double>> &samples) {
+  const std::vector<std::vector<double>> newSamples{
+      source(candidates, samplesPerCandidate)};
+  if (newSamples.size() != candidates.size()) {
+    throw std::runtime_error(
+        "AdaptiveSampler log | the sample source must return the samples of "
+        "every candidate asked");
+  }
+  std::size_t requests{0};
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    std::vector<double> &candidateSamples{samples[candidates[i]]};
+    candidateSamples.insert(candidateSamples.end(), newSamples[i].begin(),
+                            newSamples[i].end());
+    requests += newSamples[i].size();
+  }
+  return requests;
+}
+/******************************************************************************/
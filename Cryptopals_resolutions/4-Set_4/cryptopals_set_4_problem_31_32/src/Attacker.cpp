@@ -6,7 +6,11 @@
 #include "./../include/MessageExtractionFacility.hpp"
 
 /* constructor / destructor */
-Attacker::Attacker() {}
+Attacker::Attacker()
+    : _probeClient{std::make_shared<TimingProbeClient>(
+          std::string("http://localhost:") +
+              std::to_string(_portServerProduction) + std::string("/test"),
+          _probeConnections)} {}
 /******************************************************************************/
 Attacker::~Attacker() {}
 /******************************************************************************/
@@ -15,7 +19,13 @@ Attacker::~Attacker() {}
  * file.
  *
  * This method will try to break HMAC SHA1 signature for any given
- * file, the signature will be validated on the server side.
+ * file, the signature will be validated on the server side. For every byte
+ * of the signature the 256 candidates are timed through the pool of
+ * keep-alive connections of the probe client, and the adaptive sampler picks
+ * the candidate with the largest server side latency. Every byte also
+ * re-verifies the previous one: if the previous byte was right, the wrong
+ * guesses of the current byte are as slow as the leader of the previous byte,
+ * otherwise the attack backs off and recovers the previous byte again.
  *
  * @param fileName the file that the attacker is trying to find the signature
  *
@@ -26,32 +36,53 @@ std::tuple<bool, std::string>
 Attacker::breakHmacSHA1(const std::string &fileName) {
   const std::size_t sizeBytesHmacSHA1{20};
   const std::size_t sizeByte{256};
-  std::tuple<bool, cpr::Response> serverResponse;
   std::vector<unsigned char> signatureV(sizeBytesHmacSHA1, 0);
+  std::vector<double> baselines(sizeBytesHmacSHA1, 0.0),
+      leaders(sizeBytesHmacSHA1, 0.0);
   std::string signature;
-  for (std::size_t i = 0; i < sizeBytesHmacSHA1; ++i) {
-    unsigned char byteGuess = 0;
-    std::chrono::microseconds longestTime{0};
-    for (std::size_t j = 0; j < sizeByte; ++j) {
-      std::chrono::microseconds timeAverage{0};
-      signatureV[i] = j;
-      signature = MessageExtractionFacility::toHexString(signatureV);
-      for (std::size_t k = 0; k < _attackSamples; ++k) {
-        auto start = std::chrono::high_resolution_clock::now();
-        serverResponse = Attacker::sendRequest(signature, fileName);
-        auto end = std::chrono::high_resolution_clock::now();
-        auto time =
-            std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        timeAverage += time;
-      }
-      timeAverage /= _attackSamples;
-      if (timeAverage > longestTime) {
-        longestTime = timeAverage;
-        byteGuess = j;
-      }
+  std::size_t i{0}, backtracks{0};
+  // samples the candidates of the byte i of the signature
+  const AdaptiveSampler::SampleSource source =
+      [&](const std::vector<std::size_t> &candidates,
+          std::size_t samplesPerCandidate) {
+        std::vector<std::string> signatures;
+        for (std::size_t candidate : candidates) {
+          signatureV[i] = candidate;
+          signatures.push_back(
+              MessageExtractionFacility::toHexString(signatureV));
+        }
+        const auto timings =
+            _probeClient->probe(fileName, signatures, samplesPerCandidate);
+        std::vector<std::vector<double>> samples(timings.size());
+        for (std::size_t j = 0; j < timings.size(); ++j) {
+          for (const TimingProbeClient::TimingSample &timing : timings[j]) {
+            samples[j].push_back(static_cast<double>(timing.latency.count()));
+          }
+        }
+        return samples;
+      };
+  while (i < sizeBytesHmacSHA1) {
+    const AdaptiveSampler::Result result =
+        _sampler.selectLeader(sizeByte, source);
+    signatureV[i] = 0;
+    // a wrong guess at byte i takes as long as the right guess at byte i - 1,
+    // if it is clearly faster the byte i - 1 was wrong and is recovered again
+    if (i > 0 && backtracks < _maxBacktracks &&
+        result.baselineEstimate < (baselines[i - 1] + leaders[i - 1]) / 2.0) {
+      std::cout << "Attacker log | byte " << i - 1
+                << " failed the re-verification, recovering it again\n";
+      ++backtracks;
+      --i;
+      continue;
     }
+    baselines[i] = result.baselineEstimate;
+    leaders[i] = result.leaderEstimate;
     // update signature at index i with the best guess
-    signatureV[i] = byteGuess;
+    signatureV[i] = static_cast<unsigned char>(result.leader);
+    std::cout << "Attacker log | byte " << i << " = " << result.leader
+              << " | requests " << result.requests << " | confident "
+              << (result.confident ? "yes" : "no") << "\n";
+    ++i;
   }
   // send to the server the signature able to be constructed with the timing
   // leak
@@ -74,14 +105,8 @@ Attacker::breakHmacSHA1(const std::string &fileName) {
 std::tuple<bool, cpr::Response>
 Attacker::sendRequest(const std::string &signature,
                       const std::string &fileName) const {
-  cpr::Response response = cpr::Get(
-      cpr::Url{std::string("http://localhost:") +
-               std::to_string(_portServerProduction) + std::string("/test")},
-      cpr::Parameters{{"file", fileName}, {"signature", signature}});
-  if (response.status_code == 200) {
-    return std::make_tuple(true, response);
-  }
-  return std::make_tuple(false, response);
+  auto [sample, response] = _probeClient->probeOnce(fileName, signature);
+  return std::make_tuple(sample.accepted, response);
 }
 /******************************************************************************/
 /**
@@ -23,20 +23,63 @@ MyCryptoLibrary::HMAC_SHA1::~HMAC_SHA1() {}
 std::vector<unsigned char>
 MyCryptoLibrary::HMAC_SHA1::hmac(const std::vector<unsigned char> &key,
                                  const std::vector<unsigned char> &message) {
-  _keyBlock = computeBlockSizedKey(key, SHA1_BLOCK_SIZE);
-  std::vector<unsigned char> o_key_pad, i_key_pad;
+  return hmac(computeKeySchedule(key), message);
+}
+/******************************************************************************/
+/**
+ * @brief Calculates a given hmac-sha1(k, m) from a precomputed key
+ *
+ * This method calculates a given hmac(k, m) resuming from the midstates of
+ * the key schedule, it does not modify the instance, so that it can be
+ * called concurrently
+ *
+ * @param keySchedule The key schedule of the key to be used in the hmac-sha1
+ * @param msg The message to be used in the hmac-sha1
+ *
+ * @return The hmac-sha1(k, m) in a vector format
+ */
+std::vector<unsigned char> MyCryptoLibrary::HMAC_SHA1::hmac(
+    const KeySchedule &keySchedule,
+    const std::vector<unsigned char> &message) const {
+  // H((K ^ opad) || H((K ^ ipad) || m)), both pad blocks are already in the
+  // midstates
+  MyCryptoLibrary::SHA1::Context ctx{keySchedule.inner};
+  unsigned char innerHash[SHA1_DIGEST_LENGTH];
+  MyCryptoLibrary::SHA1::update(ctx, message.data(), message.size());
+  MyCryptoLibrary::SHA1::final(ctx, innerHash);
+  std::vector<unsigned char> hmacV(SHA1_DIGEST_LENGTH);
+  ctx = keySchedule.outer;
+  MyCryptoLibrary::SHA1::update(ctx, innerHash, SHA1_DIGEST_LENGTH);
+  MyCryptoLibrary::SHA1::final(ctx, hmacV.data());
+  return hmacV;
+}
+/******************************************************************************/
+/**
+ * @brief Calculates the key schedule of a key
+ *
+ * This method compresses the ipad and the opad blocks of the key once, to
+ * be reused by every hmac-sha1 computed under that key
+ *
+ * @param key The key to be used in the hmac-sha1
+ *
+ * @return The key schedule of the key
+ */
+MyCryptoLibrary::HMAC_SHA1::KeySchedule
+MyCryptoLibrary::HMAC_SHA1::computeKeySchedule(
+    const std::vector<unsigned char> &key) {
+  const std::vector<unsigned char> keyBlock =
+      computeBlockSizedKey(key, SHA1_BLOCK_SIZE);
+  unsigned char o_key_pad[SHA1_BLOCK_SIZE], i_key_pad[SHA1_BLOCK_SIZE];
   for (std::size_t i = 0; i < SHA1_BLOCK_SIZE; ++i) {
-    o_key_pad.push_back(_keyBlock[i] ^ _opadV[i]);
-    i_key_pad.push_back(_keyBlock[i] ^ _ipadV[i]);
+    o_key_pad[i] = keyBlock[i] ^ _opadV[i];
+    i_key_pad[i] = keyBlock[i] ^ _ipadV[i];
   }
-  std::vector<unsigned char> innerHashContent = i_key_pad;
-  innerHashContent.insert(innerHashContent.end(), message.begin(),
-                          message.end());
-  std::vector<unsigned char> innerHash = _sha->hash(innerHashContent);
-  std::vector<unsigned char> hmacHashContent = o_key_pad;
-  hmacHashContent.insert(hmacHashContent.end(), innerHash.begin(),
-                         innerHash.end());
-  return _sha->hash(hmacHashContent);
+  KeySchedule keySchedule;
+  MyCryptoLibrary::SHA1::init(keySchedule.inner);
+  MyCryptoLibrary::SHA1::update(keySchedule.inner, i_key_pad, SHA1_BLOCK_SIZE);
+  MyCryptoLibrary::SHA1::init(keySchedule.outer);
+  MyCryptoLibrary::SHA1::update(keySchedule.outer, o_key_pad, SHA1_BLOCK_SIZE);
+  return keySchedule;
 }
 /******************************************************************************/
 /**
@@ -51,13 +94,13 @@ MyCryptoLibrary::HMAC_SHA1::hmac(const std::vector<unsigned char> &key,
  */
 std::vector<unsigned char> MyCryptoLibrary::HMAC_SHA1::computeBlockSizedKey(
     const std::vector<unsigned char> &key, const std::size_t blockSize) {
-  _keyBlock = key;
-  if (_keyBlock.size() > SHA1_BLOCK_SIZE) {
-    _keyBlock = _sha->hash(key);
+  std::vector<unsigned char> keyBlock = key;
+  if (keyBlock.size() > SHA1_BLOCK_SIZE) {
+    keyBlock = _sha->hash(key);
   }
-  if (_keyBlock.size() < SHA1_BLOCK_SIZE) {
-    _keyBlock.resize(SHA1_BLOCK_SIZE, 0);
+  if (keyBlock.size() < SHA1_BLOCK_SIZE) {
+    keyBlock.resize(SHA1_BLOCK_SIZE, 0);
   }
-  return _keyBlock;
+  return keyBlock;
 }
 /******************************************************************************/
\ No newline at end of file
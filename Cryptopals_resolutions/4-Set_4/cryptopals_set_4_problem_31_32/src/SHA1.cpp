@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
 #include "./../include/SHA1.hpp"
 
 /* constructor / destructor */
@@ -15,21 +19,11 @@ MyCryptoLibrary::SHA1::~SHA1() {}
  */
 std::vector<unsigned char>
 MyCryptoLibrary::SHA1::hash(const std::vector<unsigned char> &inputV) {
-  _inputVpadded.clear();
-  initialization(inputV.size());
-  preProcessing(inputV);
-  processing();
-  std::vector<unsigned char> hashV;
-  hashV.reserve(SHA1_DIGEST_LENGTH);
-
-  const uint32_t hashParts[] = {_h0, _h1, _h2, _h3, _h4};
-
-  for (uint32_t part : hashParts) {
-    hashV.push_back((part >> 24) & 0xFF);
-    hashV.push_back((part >> 16) & 0xFF);
-    hashV.push_back((part >> 8) & 0xFF);
-    hashV.push_back(part & 0xFF);
-  }
+  Context ctx;
+  std::vector<unsigned char> hashV(SHA1_DIGEST_LENGTH);
+  MyCryptoLibrary::SHA1::init(ctx);
+  MyCryptoLibrary::SHA1::update(ctx, inputV.data(), inputV.size());
+  MyCryptoLibrary::SHA1::final(ctx, hashV.data());
   return hashV;
 }
 /******************************************************************************/
@@ -54,150 +48,199 @@ std::vector<unsigned char>
 MyCryptoLibrary::SHA1::hash(const std::vector<unsigned char> &inputV,
                             uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3,
                             uint32_t h4, std::size_t messageSize) {
-  _inputVpadded.clear();
-  initialization(messageSize, h0, h1, h2, h3, h4);
-  preProcessing(inputV);
-  processing();
-  std::vector<unsigned char> hashV;
-  hashV.reserve(SHA1_DIGEST_LENGTH);
-
-  const uint32_t hashParts[] = {_h0, _h1, _h2, _h3, _h4};
-
-  for (uint32_t part : hashParts) {
-    hashV.push_back((part >> 24) & 0xFF);
-    hashV.push_back((part >> 16) & 0xFF);
-    hashV.push_back((part >> 8) & 0xFF);
-    hashV.push_back(part & 0xFF);
-  }
+  Context ctx;
+  std::vector<unsigned char> hashV(SHA1_DIGEST_LENGTH);
+  // the bytes before inputV were already hashed into h0..h4, so that the
+  // length appended by final is messageSize
+  MyCryptoLibrary::SHA1::init(ctx, h0, h1, h2, h3, h4,
+                              static_cast<uint64_t>(messageSize) -
+                                  static_cast<uint64_t>(inputV.size()));
+  MyCryptoLibrary::SHA1::update(ctx, inputV.data(), inputV.size());
+  MyCryptoLibrary::SHA1::final(ctx, hashV.data());
   return hashV;
 }
 /******************************************************************************/
 /**
- * Initializes internal state based on the input length
+ * @brief Starts a SHA-1 computation
  *
- * @param sizeInputV The size of the original message in bytes
+ * Sets the context to the standard initial state, with no bytes absorbed
+ *
+ * @param ctx The context of the computation
  */
-void MyCryptoLibrary::SHA1::initialization(const std::size_t sizeInputV) {
-  _h0 = 0x67452301;
-  _h1 = 0xEFCDAB89;
-  _h2 = 0x98BADCFE;
-  _h3 = 0x10325476;
-  _h4 = 0xC3D2E1F0;
-  _ml = sizeInputV * CHAR_BIT; // message length in bits (always a multiple of
-                               // the number of bits in a character)
+void MyCryptoLibrary::SHA1::init(Context &ctx) {
+  MyCryptoLibrary::SHA1::init(ctx, 0x67452301, 0xEFCDAB89, 0x98BADCFE,
+                              0x10325476, 0xC3D2E1F0, 0);
 }
 /******************************************************************************/
 /**
- * Initializes internal state based on the input length and predefined input
- * state
+ * @brief Starts a SHA-1 computation from a predefined internal state
  *
- * @param sizeInputV The size of the original message in bytes
+ * Sets the context to the given internal state, as if processedBytes bytes
+ * had already been absorbed, which is how a length extension resumes a
+ * known digest
+ *
+ * @param ctx The context of the computation
  * @param h0 Internal state of the SHA1
  * @param h1 Internal state of the SHA1
  * @param h2 Internal state of the SHA1
  * @param h3 Internal state of the SHA1
  * @param h4 Internal state of the SHA1
+ * @param processedBytes Number of bytes already hashed into the state
  */
-void MyCryptoLibrary::SHA1::initialization(const std::size_t sizeInputV,
-                                           uint32_t h0, uint32_t h1,
-                                           uint32_t h2, uint32_t h3,
-                                           uint32_t h4) {
-  _h0 = h0;
-  _h1 = h1;
-  _h2 = h2;
-  _h3 = h3;
-  _h4 = h4;
-  _ml = sizeInputV * CHAR_BIT; // message length in bits (always a multiple of
-                               // the number of bits in a character)
+void MyCryptoLibrary::SHA1::init(Context &ctx, uint32_t h0, uint32_t h1,
+                                 uint32_t h2, uint32_t h3, uint32_t h4,
+                                 uint64_t processedBytes) {
+  ctx.state[0] = h0;
+  ctx.state[1] = h1;
+  ctx.state[2] = h2;
+  ctx.state[3] = h3;
+  ctx.state[4] = h4;
+  ctx.length = processedBytes;
+  ctx.bufferSize = 0;
 }
 /******************************************************************************/
 /**
- * Preprocesses the input data (padding, appending length) as required by the
- * SHA-1 algorithm.
+ * @brief Absorbs more bytes into a SHA-1 computation
+ *
+ * Full blocks are compressed straight from the caller's memory, only the
+ * tail of an incomplete block is copied into the context
  *
- * @param inputV The input data as a vector of unsigned char.
+ * @param ctx The context of the computation
+ * @param data The bytes to hash
+ * @param size The number of bytes to hash
  */
-void MyCryptoLibrary::SHA1::preProcessing(
-    const std::vector<unsigned char> &inputV) {
-  // Initialize padded input vector with original message
-  _inputVpadded = inputV;
+void MyCryptoLibrary::SHA1::update(Context &ctx, const unsigned char *data,
+                                   std::size_t size) {
+  ctx.length += size;
+  // complete the block left over by the previous update first
+  if (ctx.bufferSize > 0) {
+    const std::size_t n{std::min(size, SHA1_BLOCK_SIZE - ctx.bufferSize)};
+    std::memcpy(ctx.buffer + ctx.bufferSize, data, n);
+    ctx.bufferSize += n;
+    data += n;
+    size -= n;
+    if (ctx.bufferSize < SHA1_BLOCK_SIZE) {
+      return;
+    }
+    MyCryptoLibrary::SHA1::compress(ctx.state, ctx.buffer);
+    ctx.bufferSize = 0;
+  }
+  for (; size >= SHA1_BLOCK_SIZE; data += SHA1_BLOCK_SIZE,
+                                  size -= SHA1_BLOCK_SIZE) {
+    MyCryptoLibrary::SHA1::compress(ctx.state, data);
+  }
+  if (size > 0) {
+    std::memcpy(ctx.buffer, data, size);
+    ctx.bufferSize = size;
+  }
+}
+/******************************************************************************/
+/**
+ * @brief Finishes a SHA-1 computation
+ *
+ * Appends the padding and the message length and writes the digest
+ *
+ * @param ctx The context of the computation, it must be initialized again
+ * before being reused
+ * @param digest The output buffer, SHA1_DIGEST_LENGTH bytes long
+ */
+void MyCryptoLibrary::SHA1::final(Context &ctx, unsigned char *digest) {
+  // message length in bits (always a multiple of the number of bits in a
+  // character)
+  const uint64_t ml{ctx.length * CHAR_BIT};
 
   // Step 1: Append the bit '1' (equivalent to adding 0x80)
-  _inputVpadded.push_back(0x80);
+  ctx.buffer[ctx.bufferSize++] = 0x80;
 
   // Step 2: Append '0' bits until the length of the message (in bits) is
-  // congruent to 448 mod 512
-  while ((_inputVpadded.size() * 8) % 512 != 448) {
-    _inputVpadded.push_back(0x00);
+  // congruent to 448 mod 512, this takes an extra block if the length does
+  // not fit in the current one
+  if (ctx.bufferSize > SHA1_BLOCK_SIZE - 8) {
+    std::memset(ctx.buffer + ctx.bufferSize, 0x00,
+                SHA1_BLOCK_SIZE - ctx.bufferSize);
+    MyCryptoLibrary::SHA1::compress(ctx.state, ctx.buffer);
+    ctx.bufferSize = 0;
   }
+  std::memset(ctx.buffer + ctx.bufferSize, 0x00,
+              SHA1_BLOCK_SIZE - 8 - ctx.bufferSize);
 
   // Step 3: Append the original message length (ml) as a 64-bit big-endian
-  // integer _ml is already in bits
-  for (int i = 7; i >= 0; --i) {
-    _inputVpadded.push_back(
-        static_cast<unsigned char>((_ml >> (i * 8)) & 0xFF));
+  // integer
+  for (int i = 0; i < 8; ++i) {
+    ctx.buffer[SHA1_BLOCK_SIZE - 8 + i] =
+        static_cast<unsigned char>((ml >> ((7 - i) * 8)) & 0xFF);
   }
+  MyCryptoLibrary::SHA1::compress(ctx.state, ctx.buffer);
+
+  for (int i = 0; i < 5; ++i) {
+    digest[i * 4] = (ctx.state[i] >> 24) & 0xFF;
+    digest[i * 4 + 1] = (ctx.state[i] >> 16) & 0xFF;
+    digest[i * 4 + 2] = (ctx.state[i] >> 8) & 0xFF;
+    digest[i * 4 + 3] = ctx.state[i] & 0xFF;
+  }
+  ctx.bufferSize = 0;
 }
 /******************************************************************************/
-/// Processes the padded message in 512-bit blocks.
-void MyCryptoLibrary::SHA1::processing() {
-  // Process the padded input in 512-bit blocks
-  for (std::size_t i = 0; i < _inputVpadded.size(); i += SHA1_BLOCK_SIZE) {
-    std::vector<unsigned char> block(
-        _inputVpadded.begin() + i, _inputVpadded.begin() + i + SHA1_BLOCK_SIZE);
-    // Prepare the message schedule (W)
-    uint32_t W[80];
-
-    for (int t = 0; t < 16; ++t) {
-      W[t] = (static_cast<uint32_t>(block[t * 4]) << 24) |
-             (static_cast<uint32_t>(block[t * 4 + 1]) << 16) |
-             (static_cast<uint32_t>(block[t * 4 + 2]) << 8) |
-             (static_cast<uint32_t>(block[t * 4 + 3]));
-    }
+/**
+ * Processes one 512-bit block, updating the internal state
+ *
+ * @param state The five chaining words of the SHA1
+ * @param block The 64 bytes of the block
+ */
+void MyCryptoLibrary::SHA1::compress(uint32_t *state,
+                                     const unsigned char *block) {
+  // Prepare the message schedule (W)
+  uint32_t W[80];
 
-    for (int t = 16; t < 80; ++t) {
-      W[t] = leftRotate(W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16], 1);
-    }
+  for (int t = 0; t < 16; ++t) {
+    W[t] = (static_cast<uint32_t>(block[t * 4]) << 24) |
+           (static_cast<uint32_t>(block[t * 4 + 1]) << 16) |
+           (static_cast<uint32_t>(block[t * 4 + 2]) << 8) |
+           (static_cast<uint32_t>(block[t * 4 + 3]));
+  }
 
-    // Initialize hash values
-    uint32_t a = _h0;
-    uint32_t b = _h1;
-    uint32_t c = _h2;
-    uint32_t d = _h3;
-    uint32_t e = _h4;
+  for (int t = 16; t < 80; ++t) {
+    W[t] = leftRotate(W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16], 1);
+  }
 
-    // Main loop
-    for (int t = 0; t < 80; ++t) {
-      uint32_t f, k;
-      if (t < 20) {
-        f = (b & c) | (~b & d);
-        k = 0x5A827999;
-      } else if (t < 40) {
-        f = b ^ c ^ d;
-        k = 0x6ED9EBA1;
-      } else if (t < 60) {
-        f = (b & c) | (b & d) | (c & d);
-        k = 0x8F1BBCDC;
-      } else {
-        f = b ^ c ^ d;
-        k = 0xCA62C1D6;
-      }
+  // Initialize hash values
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
 
-      uint32_t temp = leftRotate(a, 5) + f + e + W[t] + k;
-      e = d;
-      d = c;
-      c = leftRotate(b, 30);
-      b = a;
-      a = temp;
+  // Main loop
+  for (int t = 0; t < 80; ++t) {
+    uint32_t f, k;
+    if (t < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    } else if (t < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    } else if (t < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
     }
 
-    // Update the hash values
-    _h0 += a;
-    _h1 += b;
-    _h2 += c;
-    _h3 += d;
-    _h4 += e;
+    uint32_t temp = leftRotate(a, 5) + f + e + W[t] + k;
+    e = d;
+    d = c;
+    c = leftRotate(b, 30);
+    b = a;
+    a = temp;
   }
+
+  // Update the hash values
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
 }
 /******************************************************************************/
 /**
@@ -210,4 +253,4 @@ void MyCryptoLibrary::SHA1::processing() {
 uint32_t MyCryptoLibrary::SHA1::leftRotate(uint32_t value, int bits) {
   return (value << bits) | (value >> (32 - bits));
 }
-/******************************************************************************/
\ No newline at end of file
+/******************************************************************************/
@@ -18,6 +18,7 @@ Server::Server() : _hmac(std::make_shared<MyCryptoLibrary::HMAC_SHA1>()) {
     throw std::invalid_argument(errorMessage);
   }
   Server::_keyServer = MessageExtractionFacility::hexToBytes(hexServerKey);
+  Server::_keySchedule = _hmac->computeKeySchedule(_keyServer);
 }
 /******************************************************************************/
 Server::~Server() {
@@ -58,7 +59,7 @@ void Server::signatureVerificationEndpoint() {
           std::string signature = req.url_params.get("signature");
           std::vector<unsigned char> byteMessage(file.begin(), file.end());
           std::vector<unsigned char> signatureExpectedV =
-              _hmac->hmac(_keyServer, byteMessage);
+              _hmac->hmac(_keySchedule, byteMessage);
           std::vector<unsigned char> signatureV =
               MessageExtractionFacility::hexToBytes(signature);
 
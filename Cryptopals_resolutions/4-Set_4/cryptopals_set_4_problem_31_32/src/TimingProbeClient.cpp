@@ -0,0 +1,123 @@
+#include <curl/curl.h>
+#include <stdexcept>
+#include <thread>
+
+#include "./../include/TimingProbeClient.hpp"
+
+/* constructor / destructor */
+TimingProbeClient::TimingProbeClient(const std::string &url,
+                                     std::size_t nConnections)
+    : _url{url} {
+  if (nConnections == 0) {
+    throw std::invalid_argument(
+        "TimingProbeClient log | the number of connections must be positive");
+  }
+  for (std::size_t i = 0; i < nConnections; ++i) {
+    auto session = std::make_unique<cpr::Session>();
+    session->SetUrl(cpr::Url{_url});
+    _sessions.emplace_back(std::move(session));
+  }
+}
+/******************************************************************************/
+TimingProbeClient::~TimingProbeClient() {}
+/******************************************************************************/
+/**
+ * @brief This method will time samplesPerSignature requests for every
+ * signature.
+ *
+ * This method will send samplesPerSignature requests for every signature in
+ * signatures, asking for the file fileName. The requests are spread over the
+ * pool of keep-alive connections, one thread per connection, and the
+ * signatures are interleaved so that every candidate is sampled on every
+ * connection and along the whole duration of the call.
+ *
+ * @param fileName the file the requests are asking for
+ * @param signatures the candidate signatures to time
+ * @param samplesPerSignature the number of requests sent for every signature
+ *
+ * @return samples[i][k] holds the k-th sample of signatures[i]
+ */
+std::vector<std::vector<TimingProbeClient::TimingSample>>
+TimingProbeClient::probe(const std::string &fileName,
+                         const std::vector<std::string> &signatures,
+                         std::size_t samplesPerSignature) {
+  const std::size_t nSignatures{signatures.size()};
+  const std::size_t nConnections{_sessions.size()};
+  const std::size_t nRequests{nSignatures * samplesPerSignature};
+  std::vector<std::vector<TimingSample>> samples(
+      nSignatures, std::vector<TimingSample>(samplesPerSignature));
+  std::vector<std::thread> workers;
+  for (std::size_t c = 0; c < nConnections && c < nRequests; ++c) {
+    workers.emplace_back([&, c]() {
+      // request r is sample r / nSignatures of the signature r % nSignatures,
+      // the sample index is skewed per round so that a signature does not
+      // stick to the same connection
+      for (std::size_t r = c; r < nRequests; r += nConnections) {
+        const std::size_t k{r / nSignatures};
+        const std::size_t i{(r + k) % nSignatures};
+        samples[i][k] = std::get<TimingSample>(
+            TimingProbeClient::timedGet(*_sessions[c], fileName, signatures[i]));
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  return samples;
+}
+/******************************************************************************/
+/**
+ * @brief This method will time a single request.
+ *
+ * This method will send a single request for the signature and the file
+ * fileName through the first connection of the pool.
+ *
+ * @return the timing of the request and the server response
+ */
+std::tuple<TimingProbeClient::TimingSample, cpr::Response>
+TimingProbeClient::probeOnce(const std::string &fileName,
+                             const std::string &signature) {
+  return TimingProbeClient::timedGet(*_sessions[0], fileName, signature);
+}
+/******************************************************************************/
+/* getters */
+std::size_t TimingProbeClient::getNumberConnections() const {
+  return _sessions.size();
+}
+/******************************************************************************/
+/**
+ * @brief This method will send one request through the session and time it.
+ *
+ * The latency is taken from the curl transfer timers of the handle, the time
+ * between the request being fully written to the socket (pretransfer) and the
+ * first byte of the response being read (starttransfer), so that neither the
+ * connection setup nor the client side scheduling is accounted for.
+ *
+ * @return the timing of the request and the server response
+ */
+std::tuple<TimingProbeClient::TimingSample, cpr::Response>
+TimingProbeClient::timedGet(cpr::Session &session, const std::string &fileName,
+                            const std::string &signature) {
+  TimingSample sample;
+  session.SetParameters(
+      cpr::Parameters{{"file", fileName}, {"signature", signature}});
+  const auto start = std::chrono::steady_clock::now();
+  cpr::Response response = session.Get();
+  const auto end = std::chrono::steady_clock::now();
+  sample.accepted = (response.status_code == 200);
+  sample.wallTime =
+      std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+  curl_off_t preTransfer{0}, startTransfer{0};
+  CURL *handle = session.GetCurlHolder()->handle;
+  if (curl_easy_getinfo(handle, CURLINFO_PRETRANSFER_TIME_T, &preTransfer) ==
+          CURLE_OK &&
+      curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME_T,
+                        &startTransfer) == CURLE_OK &&
+      startTransfer >= preTransfer) {
+    sample.latency = std::chrono::microseconds{startTransfer - preTransfer};
+  } else {
+    sample.latency = sample.wallTime;
+  }
+  return std::make_tuple(sample, response);
+}
+/******************************************************************************/
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../include/AdaptiveSampler.hpp"
+
+class AdaptiveSamplerTest : public ::testing::Test {
+protected:
+  // cppcheck-suppress unusedFunction
+  void SetUp() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    _generator.seed(_seed);
+  }
+
+  // cppcheck-suppress unusedFunction
+  void TearDown() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    // Cleanup (if needed)
+  }
+
+  /**
+   * @brief Simulated server: every candidate answers in baseLatency plus
+   * gaussian jitter, 5% of the requests get a long exponential delay, and the
+   * candidate correctCandidate leaks an extra leak microseconds
+   */
+  AdaptiveSampler::SampleSource simulatedSource(std::size_t correctCandidate,
+                                                double leak) {
+    return [this, correctCandidate,
+            leak](const std::vector<std::size_t> &candidates,
+                  std::size_t samplesPerCandidate) {
+      std::normal_distribution<double> jitter(0.0, _jitter);
+      std::bernoulli_distribution outlier(0.05);
+      std::exponential_distribution<double> outlierDelay(1.0 / _outlierDelay);
+      std::vector<std::vector<double>> samples(candidates.size());
+      for (std::size_t i = 0; i < candidates.size(); ++i) {
+        for (std::size_t k = 0; k < samplesPerCandidate; ++k) {
+          double latency{_baseLatency + jitter(_generator)};
+          if (outlier(_generator)) {
+            latency += outlierDelay(_generator);
+          }
+          if (candidates[i] == correctCandidate) {
+            latency += leak;
+          }
+          samples[i].push_back(latency);
+        }
+      }
+      return samples;
+    };
+  }
+
+  const unsigned int _seed{12345};
+  const std::size_t _nCandidates{256};
+  const double _baseLatency{1000.0}, _jitter{300.0}, _outlierDelay{5000.0};
+  std::mt19937 _generator;
+};
+
+/**
+ * @test Test the median and the trimmed mean estimators.
+ * @brief Ensures that both estimators ignore a single large outlier
+ */
+TEST_F(AdaptiveSamplerTest, Estimators_SingleOutlier_ShouldBeIgnored) {
+  const std::vector<double> samples{10.0, 11.0, 12.0, 13.0, 1000.0};
+  EXPECT_DOUBLE_EQ(AdaptiveSampler::median(samples), 12.0);
+  EXPECT_DOUBLE_EQ(AdaptiveSampler::median({1.0, 2.0, 3.0, 4.0}), 2.5);
+  EXPECT_DOUBLE_EQ(AdaptiveSampler::trimmedMean(samples, 0.2), 12.0);
+}
+
+/**
+ * @test Test the selection of the leader with a large timing leak.
+ * @brief Ensures that the leaking candidate is selected with confidence and
+ * with less requests than 10 fixed samples per candidate
+ */
+TEST_F(AdaptiveSamplerTest, SelectLeader_LargeLeak_ShouldFindLeakingCandidate) {
+  AdaptiveSampler sampler(AdaptiveSampler::Estimator::Median, 3.0, 5, 160, 2,
+                          std::chrono::milliseconds{0});
+  const std::size_t correctCandidate{173};
+  AdaptiveSampler::Result result = sampler.selectLeader(
+      _nCandidates, simulatedSource(correctCandidate, 5000.0));
+  EXPECT_TRUE(result.confident);
+  EXPECT_EQ(result.leader, correctCandidate);
+  EXPECT_LT(result.requests, 10 * _nCandidates);
+  EXPECT_GT(result.leaderEstimate, result.baselineEstimate + 2500.0);
+}
+
+/**
+ * @test Test the selection of the leader with a small timing leak.
+ * @brief Ensures that a leak close to the jitter is still found, for both
+ * estimators, within a budget of 20 requests per candidate
+ */
+TEST_F(AdaptiveSamplerTest, SelectLeader_SmallLeak_ShouldFindLeakingCandidate) {
+  for (AdaptiveSampler::Estimator estimator :
+       {AdaptiveSampler::Estimator::Median,
+        AdaptiveSampler::Estimator::TrimmedMean}) {
+    AdaptiveSampler sampler(estimator, 3.0, 5, 160, 2,
+                            std::chrono::milliseconds{0});
+    for (std::size_t correctCandidate : {0, 42, 255}) {
+      AdaptiveSampler::Result result = sampler.selectLeader(
+          _nCandidates, simulatedSource(correctCandidate, 400.0));
+      EXPECT_EQ(result.leader, correctCandidate);
+      EXPECT_LT(result.requests, 20 * _nCandidates);
+    }
+  }
+}
+
+/**
+ * @test Test the selection of the leader without any timing leak.
+ * @brief Ensures that when no candidate can be told apart the sampler gives
+ * up after its retries and reports the result as not confident
+ */
+TEST_F(AdaptiveSamplerTest, SelectLeader_NoLeak_ShouldNotBeConfident) {
+  AdaptiveSampler sampler(AdaptiveSampler::Estimator::Median, 3.0, 5, 40, 2,
+                          std::chrono::milliseconds{0});
+  AdaptiveSampler::Result result =
+      sampler.selectLeader(_nCandidates, simulatedSource(0, 0.0));
+  EXPECT_FALSE(result.confident);
+  EXPECT_LT(result.leader, _nCandidates);
+}
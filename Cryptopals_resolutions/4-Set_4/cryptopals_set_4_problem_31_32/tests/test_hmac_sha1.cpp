@@ -213,3 +213,32 @@ TEST_F(HMAC_SHA1_Test, HMACSHA1_NegativeTest2_ShouldMatchReference) {
   std::string hmacSha1S = MessageExtractionFacility::toHexString(hmacSha1);
   ASSERT_NE(hmacSha1S, expected);
 }
+
+/**
+ * @test Test the correctness of the hash function from a key schedule.
+ * @brief Ensures that one key schedule, reused for several messages, gives
+ * the RFC2202 references for a key longer than the block size
+ */
+TEST_F(HMAC_SHA1_Test, HMACSHA1_KeyScheduleReused_ShouldMatchReference) {
+  MyCryptoLibrary::HMAC_SHA1 hmacSha1;
+  const std::size_t keyLengthRFC2202Test6{80};
+  std::vector<unsigned char> keyV(keyLengthRFC2202Test6, 0xaa);
+  const MyCryptoLibrary::HMAC_SHA1::KeySchedule keySchedule =
+      hmacSha1.computeKeySchedule(keyV);
+  const std::vector<std::string> messages{
+      "Test Using Larger Than Block-Size Key - Hash Key First",
+      "Test Using Larger Than Block-Size Key and Larger Than One Block-Size "
+      "Data"};
+  const std::vector<std::string> expected{
+      "aa4ae5e15272d00e95705637ce8a3b55ed402112",
+      "e8e99d0f45237d786d6bbaa7965c7808bbff1a91"};
+  for (int round = 0; round < 2; ++round) {
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+      std::vector<unsigned char> messageV(messages[i].begin(),
+                                          messages[i].end());
+      std::vector<unsigned char> mac = hmacSha1.hmac(keySchedule, messageV);
+      ASSERT_EQ(MessageExtractionFacility::toHexString(mac), expected[i]);
+      ASSERT_EQ(mac, _hmacSha1->hmac(keyV, messageV));
+    }
+  }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -106,3 +107,71 @@ TEST_F(SHA1Test, Hash_EmptyInputWithInternalRegisters_ShouldMatchReference) {
   ASSERT_EQ(_hash.size(), SHA1_DIGEST_LENGTH);
   ASSERT_EQ(_hash, expected);
 }
+
+/**
+ * @test Test the correctness of the streaming hash function.
+ * @brief Ensures that a message whose padding needs an extra block, hashed in
+ * pieces through init/update/final, matches the reference
+ */
+TEST_F(SHA1Test, Update_TwoBlockPaddingInPieces_ShouldMatchReference) {
+  _testInput = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  _input.insert(_input.end(), _testInput.begin(), _testInput.end());
+  MyCryptoLibrary::SHA1::Context ctx;
+  _hash.resize(SHA1_DIGEST_LENGTH);
+  MyCryptoLibrary::SHA1::init(ctx);
+  MyCryptoLibrary::SHA1::update(ctx, _input.data(), 7);
+  MyCryptoLibrary::SHA1::update(ctx, _input.data() + 7, 0);
+  MyCryptoLibrary::SHA1::update(ctx, _input.data() + 7, _input.size() - 7);
+  MyCryptoLibrary::SHA1::final(ctx, _hash.data());
+
+  std::vector<unsigned char> expected = {
+      0x84, 0x98, 0x3E, 0x44, 0x1C, 0x3B, 0xD2, 0x6E, 0xBA, 0xAE,
+      0x4A, 0xA1, 0xF9, 0x51, 0x29, 0xE5, 0xE5, 0x46, 0x70, 0xF1};
+  ASSERT_EQ(_hash, expected);
+  ASSERT_EQ(_sha1->hash(_input), expected);
+}
+
+/**
+ * @test Test the consistency of the streaming hash function.
+ * @brief Ensures that, for lengths around the block boundaries, hashing in
+ * pieces of any size gives the same digest as hashing in one call
+ */
+TEST_F(SHA1Test, Update_AnySplit_ShouldMatchSingleCall) {
+  for (std::size_t size = 0; size <= 3 * SHA1_BLOCK_SIZE; ++size) {
+    _input.assign(size, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+      _input[i] = static_cast<unsigned char>(i * 31 + 7);
+    }
+    const std::vector<unsigned char> expected = _sha1->hash(_input);
+    for (std::size_t piece : {1, 3, 63, 64, 65}) {
+      MyCryptoLibrary::SHA1::Context ctx;
+      _hash.assign(SHA1_DIGEST_LENGTH, 0);
+      MyCryptoLibrary::SHA1::init(ctx);
+      for (std::size_t i = 0; i < size; i += piece) {
+        MyCryptoLibrary::SHA1::update(ctx, _input.data() + i,
+                                      std::min(piece, size - i));
+      }
+      MyCryptoLibrary::SHA1::final(ctx, _hash.data());
+      ASSERT_EQ(_hash, expected) << "size " << size << ", piece " << piece;
+    }
+  }
+}
+
+/**
+ * @test Test the streaming hash function from a predefined internal state.
+ * @brief Ensures that resuming from the state after the first block gives the
+ * digest of the whole message, as a length extension does
+ */
+TEST_F(SHA1Test, Init_ResumedFromInternalState_ShouldMatchWholeMessage) {
+  _input.assign(2 * SHA1_BLOCK_SIZE + 10, 'x');
+  const std::vector<unsigned char> expected = _sha1->hash(_input);
+
+  MyCryptoLibrary::SHA1::Context ctx;
+  MyCryptoLibrary::SHA1::init(ctx);
+  MyCryptoLibrary::SHA1::update(ctx, _input.data(), SHA1_BLOCK_SIZE);
+  const std::vector<unsigned char> tail(_input.begin() + SHA1_BLOCK_SIZE,
+                                        _input.end());
+  _hash = _sha1->hash(tail, ctx.state[0], ctx.state[1], ctx.state[2],
+                      ctx.state[3], ctx.state[4], _input.size());
+  ASSERT_EQ(_hash, expected);
+}
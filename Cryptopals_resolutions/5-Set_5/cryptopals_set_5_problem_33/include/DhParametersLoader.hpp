@@ -2,9 +2,14 @@
 #define DH_PARAMETERS_LOADER_HPP
 
 #include <map>
+#include <memory>
+#include <openssl/bn.h>
 #include <string>
 #include <vector>
 
+#include "FixedBaseExponentiation.hpp"
+#include "MessageExtractionFacility.hpp"
+
 namespace DhParametersLoader {
 
 struct DhParameters {
@@ -15,6 +20,28 @@ struct DhParameters {
   std::string _notes;
 };
 
+struct BN_MONT_CTX_deleter {
+  void operator()(BN_MONT_CTX *mont) const { BN_MONT_CTX_free(mont); }
+};
+
+/**
+ * @brief This structure holds a Diffie Hellman group ready to be used.
+ *
+ * @param _parameters The public configuration of the group.
+ * @param _p The prime p.
+ * @param _g The generator g.
+ * @param _montgomeryContext The Montgomery context of p, null if p is even.
+ * @param _fixedBaseExponentiation The precomputed powers of g, null if the
+ * group was not taken from the registry.
+ */
+struct DhGroup {
+  DhParameters _parameters;
+  MessageExtractionFacility::UniqueBIGNUM _p, _g;
+  std::unique_ptr<BN_MONT_CTX, BN_MONT_CTX_deleter> _montgomeryContext;
+  std::shared_ptr<const MyCryptoLibrary::FixedBaseExponentiation>
+      _fixedBaseExponentiation;
+};
+
 /**
  * @brief This method extracts the content of a given file.
  *
@@ -29,6 +56,50 @@ struct DhParameters {
 std::map<std::string, DhParameters>
 loadDhParameters(const std::string &filename);
 
+/**
+ * @brief This method returns the public configurations of a given file.
+ *
+ * The file is only read and parsed the first time it is requested, the
+ * result is kept for the lifetime of the process. It is safe to call this
+ * method from several threads.
+ *
+ * @param filename The file address where the public configurations of
+ * the Diffie Hellman key Exchange protocol are.
+ *
+ * @return The file content in a structured dictionary.
+ */
+const std::map<std::string, DhParameters> &
+getDhParameters(const std::string &filename);
+
+/**
+ * @brief This method builds a Diffie Hellman group from its public
+ * configuration.
+ *
+ * @param parameters The public configuration of the group.
+ *
+ * @return The group, without the precomputed powers of g.
+ * @throw std::runtime_error if an OpenSSL operation fails.
+ */
+std::shared_ptr<DhGroup> makeDhGroup(const DhParameters &parameters);
+
+/**
+ * @brief This method returns the shared read only view of a Diffie Hellman
+ * group.
+ *
+ * The group is built the first time it is requested, together with the
+ * Montgomery context of p and the precomputed powers of g, and then kept for
+ * the lifetime of the process. It is safe to call this method from several
+ * threads.
+ *
+ * @param filename The file address where the public configurations of
+ * the Diffie Hellman key Exchange protocol are.
+ * @param groupName The name of the group.
+ *
+ * @return The group, or nullptr if the group is not in the file.
+ */
+std::shared_ptr<const DhGroup> getDhGroup(const std::string &filename,
+                                          const std::string &groupName);
+
 }; // namespace DhParametersLoader
 
 #endif // DH_PARAMETERS_LOADER_HPP
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "DhParametersLoader.hpp"
+#include "FixedBaseExponentiation.hpp"
 #include "MessageExtractionFacility.hpp"
 
 namespace MyCryptoLibrary {
@@ -106,8 +107,9 @@ private:
 
   /* private members */
   const std::string _dhParametersFilename{"../input/DhParameters.json"};
-  DhParametersLoader::DhParameters _dhParameter;
-  MessageExtractionFacility::UniqueBIGNUM _p, _g, _privateKey, _publicKey,
+  // p, g and their precomputed values, shared by every key exchange
+  std::shared_ptr<const DhParametersLoader::DhGroup> _group;
+  MessageExtractionFacility::UniqueBIGNUM _privateKey, _publicKey,
       _sharedSecret;
   bool _debugFlag;
   std::vector<uint8_t> _derivedSymmetricKey;
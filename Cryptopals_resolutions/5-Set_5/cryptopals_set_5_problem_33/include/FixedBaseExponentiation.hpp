@@ -0,0 +1,120 @@
+#ifndef FIXED_BASE_EXPONENTIATION_HPP
+#define FIXED_BASE_EXPONENTIATION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <openssl/bn.h>
+#include <string>
+#include <vector>
+
+#include "MessageExtractionFacility.hpp"
+
+namespace MyCryptoLibrary {
+
+class FixedBaseExponentiation {
+public:
+  /* constructor / destructor*/
+
+  /**
+   * @brief This method will execute the constructor of the
+   * FixedBaseExponentiation object.
+   *
+   * This method precomputes, in Montgomery form, every power
+   * base^(j * 2^(windowBits * i)) mod modulus with 0 <= j < 2^windowBits, for
+   * all the windows of an exponent with as many bits as the modulus.
+   *
+   * @param modulusHex The odd modulus, in hexadecimal format.
+   * @param baseHex The fixed base, in hexadecimal format.
+   *
+   * @throws std::invalid_argument if the modulus is not odd or greater than
+   * one, or if the base is not in [2, modulus - 1].
+   * @throws std::runtime_error if an OpenSSL operation fails.
+   */
+  explicit FixedBaseExponentiation(const std::string &modulusHex,
+                                   const std::string &baseHex);
+  ~FixedBaseExponentiation();
+
+  /* public methods */
+
+  /**
+   * @brief This method calculates base^exponent mod modulus.
+   *
+   * Each window of the exponent selects one precomputed power, so the
+   * calculation only needs one Montgomery multiplication per window and no
+   * squarings. The whole table row of each window is read, so the memory
+   * accesses do not depend on the exponent. Exponents with more bits than the
+   * table covers fall back to BN_mod_exp.
+   *
+   * @param exponent The non negative exponent.
+   *
+   * @return base^exponent mod modulus.
+   * @throws std::invalid_argument if the exponent is null or negative.
+   * @throws std::runtime_error if an OpenSSL operation fails.
+   */
+  MessageExtractionFacility::UniqueBIGNUM
+  exponentiate(const BIGNUM *exponent) const;
+
+  /**
+   * @brief This method returns the largest exponent size covered by the
+   * precomputed table.
+   *
+   * @return The maximum number of bits of the exponent.
+   */
+  unsigned int getMaxExponentBits() const;
+
+  /**
+   * @brief This method returns the shared exponentiation engine of a group.
+   *
+   * The table of a group is built the first time the group is requested and
+   * then kept for the lifetime of the process, it is safe to call this method
+   * from several threads. The tables of different groups are built
+   * concurrently, the callers of a group whose table is being built wait for
+   * it.
+   *
+   * @param modulusHex The odd modulus of the group, in hexadecimal format.
+   * @param baseHex The generator of the group, in hexadecimal format.
+   *
+   * @return The exponentiation engine of the group.
+   */
+  static std::shared_ptr<const FixedBaseExponentiation>
+  getInstance(const std::string &modulusHex, const std::string &baseHex);
+
+private:
+  /* private structures */
+  struct BN_MONT_CTX_deleter {
+    void operator()(BN_MONT_CTX *mont) const { BN_MONT_CTX_free(mont); }
+  };
+  struct BN_CTX_deleter {
+    void operator()(BN_CTX *ctx) const { BN_CTX_free(ctx); }
+  };
+
+  /* private methods */
+
+  /**
+   * @brief This method returns the digit of a window of the exponent.
+   *
+   * @param exponent The exponent.
+   * @param window The index of the window, starting at the least significant
+   * bits.
+   *
+   * @return The value of the windowBits bits of the window.
+   */
+  static unsigned int windowDigit(const BIGNUM *exponent,
+                                  const unsigned int window);
+
+  /* private fields */
+  static constexpr unsigned int _windowBits{4};
+  static constexpr unsigned int _entriesPerWindow{1u << _windowBits};
+
+  MessageExtractionFacility::UniqueBIGNUM _modulus, _base;
+  std::unique_ptr<BN_MONT_CTX, BN_MONT_CTX_deleter> _montgomeryContext;
+  unsigned int _windows;
+  std::size_t _entryWords; // 64-bit words per table entry
+  // Entry j of window i holds base^(j * 2^(windowBits * i)) * R mod modulus,
+  // little endian
+  std::vector<uint64_t> _table;
+};
+
+} // namespace MyCryptoLibrary
+
+#endif // FIXED_BASE_EXPONENTIATION_HPP
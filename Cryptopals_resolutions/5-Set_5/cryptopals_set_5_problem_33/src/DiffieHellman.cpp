@@ -12,23 +12,23 @@ MyCryptoLibrary::DiffieHellman::DiffieHellman(const bool debugFlag)
       _publicKey{MessageExtractionFacility::UniqueBIGNUM(BN_new())},
       _sharedSecret{MessageExtractionFacility::UniqueBIGNUM(BN_new())},
       _debugFlag{debugFlag} {
-  std::map<std::string, DhParametersLoader::DhParameters> dhParametersMap =
-      DhParametersLoader::loadDhParameters(getDhParametersFilenameLocation());
-  if (dhParametersMap.find("rfc3526-group-17") != dhParametersMap.end()) {
-    _dhParameter = dhParametersMap["rfc3526-group-17"];
-    _p = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._pHex);
-    _g = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._gHex);
-    if (_debugFlag) {
-      std::cout << "Diffie Hellman log | p (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_p.get())
-                << std::endl;
-      std::cout << "Diffie Hellman log | g (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_g.get())
-                << std::endl;
-    }
-    generatePrivateKey();
-    generatePublicKey();
+  // the file is parsed and the group is built only once per process
+  _group = DhParametersLoader::getDhGroup(getDhParametersFilenameLocation(),
+                                          "rfc3526-group-17");
+  if (!_group) {
+    throw std::runtime_error("Diffie Hellman log | constructor(): "
+                             "Group name is invalid");
   }
+  if (_debugFlag) {
+    std::cout << "Diffie Hellman log | p (decimal) = "
+              << MessageExtractionFacility::BIGNUMToDec(_group->_p.get())
+              << std::endl;
+    std::cout << "Diffie Hellman log | g (decimal) = "
+              << MessageExtractionFacility::BIGNUMToDec(_group->_g.get())
+              << std::endl;
+  }
+  generatePrivateKey();
+  generatePublicKey();
 }
 /******************************************************************************/
 MyCryptoLibrary::DiffieHellman::~DiffieHellman() {}
@@ -54,7 +54,7 @@ const std::string MyCryptoLibrary::DiffieHellman::getPublicKey() const {
  * @return The group name in a string format.
  */
 const std::string &MyCryptoLibrary::DiffieHellman::getGroupName() const {
-  return _dhParameter._groupName;
+  return _group->_parameters._groupName;
 }
 /******************************************************************************/
 /**
@@ -123,7 +123,7 @@ void MyCryptoLibrary::DiffieHellman::generatePrivateKey() {
   // So, we need to generate a random number 'x' such that 0 <= x < (p-2).
   // Then, set 'a = x + 2'. This ensures 'a' is in the range [2, p-1).
   MessageExtractionFacility::UniqueBIGNUM rangeForRand =
-      MessageExtractionFacility::UniqueBIGNUM(BN_dup(_p.get()));
+      MessageExtractionFacility::UniqueBIGNUM(BN_dup(_group->_p.get()));
   // Subtract: p(copy) - 2
   if (!BN_sub_word(rangeForRand.get(), 2)) {
     // BN_sub_word returns 0 if subtraction causes negative result or fails
@@ -177,33 +177,18 @@ void MyCryptoLibrary::DiffieHellman::generatePublicKey() {
         "Diffie Hellman log | generatePublicKey(): Private key has not been "
         "generated. Call generatePrivateKey() first.");
   }
-  if (!_g || BN_is_zero(_g.get())) {
+  if (!_group || BN_is_zero(_group->_g.get())) {
     throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
                              "Generator 'g' is not initialized.");
   }
-  if (!_p || BN_is_zero(_p.get())) {
+  if (!_group || BN_is_zero(_group->_p.get())) {
     throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
                              "Modulus 'p' is not initialized.");
   }
-  BN_CTX *ctx = BN_CTX_new();
-  if (!ctx) {
-    throw std::runtime_error(
-        "Diffie Hellman log | generatePublicKey(): Failed to create BIGNUM "
-        "context for public key calculation.");
-  }
-  // Compute _publicKey = (_g ^ _privateKey) % _p
-  // BN_mod_exp(result, base, exponent, modulus, context)
-  if (!BN_mod_exp(_publicKey.get(), _g.get(), _privateKey.get(), _p.get(),
-                  ctx)) {
-    // Handle error from OpenSSL
-    char errorBuffer[256];
-    ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
-    BN_CTX_free(ctx); // Free context on error
-    throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
-                             "Failed to calculate public key (BN_mod_exp): " +
-                             std::string(errorBuffer));
-  }
-  BN_CTX_free(ctx);
+  // Compute _publicKey = (_g ^ _privateKey) % _p from the precomputed powers
+  // of g, the table of the group is shared by every key exchange
+  _publicKey =
+      _group->_fixedBaseExponentiation->exponentiate(_privateKey.get());
   if (_debugFlag) {
     std::cout << "\nDiffie Hellman log | Generated public key (hex): "
               << MessageExtractionFacility::BIGNUMToHex(_publicKey.get())
@@ -237,12 +222,12 @@ const std::string MyCryptoLibrary::DiffieHellman::deriveSharedSecret(
                              "Private key has not been generated for the "
                              "derivation of the shared secret");
   }
-  if (!_g || BN_is_zero(_g.get())) {
+  if (!_group || BN_is_zero(_group->_g.get())) {
     throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                              "Generator 'g' is not initialized for the "
                              "derivation of the shared secret");
   }
-  if (!_p || BN_is_zero(_p.get())) {
+  if (!_group || BN_is_zero(_group->_p.get())) {
     throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                              "Modulus 'p' is not initialized for the "
                              "derivation of the shared secret");
@@ -260,17 +245,18 @@ const std::string MyCryptoLibrary::DiffieHellman::deriveSharedSecret(
         "Diffie Hellman log | deriveSharedSecret(): Failed to create BIGNUM "
         "context for public key calculation.");
   }
-  // Compute _sharedSecret = (peerPublicKey ^ _privateKey) % _p
-  // BN_mod_exp(result, base, exponent, modulus, context)
-  if (!BN_mod_exp(_sharedSecret.get(), peerPublicKey.get(), _privateKey.get(),
-                  _p.get(), ctx)) {
+  // Compute _sharedSecret = (peerPublicKey ^ _privateKey) % _p, reusing the
+  // Montgomery context of the group instead of building one per call
+  if (!BN_mod_exp_mont(_sharedSecret.get(), peerPublicKey.get(),
+                       _privateKey.get(), _group->_p.get(), ctx,
+                       _group->_montgomeryContext.get())) {
     // Handle error from OpenSSL
     char errorBuffer[256];
     ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
     BN_CTX_free(ctx); // Free context on error
     throw std::runtime_error(
         "Diffie Hellman log | deriveSharedSecret(): Failed to calculate shared "
-        "secret (BN_mod_exp): " +
+        "secret (BN_mod_exp_mont): " +
         std::string(errorBuffer));
   }
   BN_CTX_free(ctx);
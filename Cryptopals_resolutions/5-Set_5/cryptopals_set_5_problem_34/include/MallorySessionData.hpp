@@ -1,6 +1,8 @@
 #ifndef MALLORY_SESSION_DATA_HPP
 #define MALLORY_SESSION_DATA_HPP
 
+#include <mutex>
+
 #include "Client.hpp"
 #include "DhParametersLoader.hpp"
 #include "DiffieHellman.hpp"
@@ -33,6 +35,10 @@ struct MallorySessionData {
   std::string _sessionIdMS;
   std::unique_ptr<Client> _fakeClientMS;
   bool _parameterInjection{false};
+
+  // Guards the IVs of both channels once the session is shared, the keys and
+  // the session IDs are set before it is published and only read afterwards
+  mutable std::mutex _mutex;
 };
 
 #endif // MALLORY_SESSION_DATA_HPP
\ No newline at end of file
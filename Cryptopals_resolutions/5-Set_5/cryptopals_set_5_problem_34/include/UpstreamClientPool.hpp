@@ -0,0 +1,76 @@
+#ifndef UPSTREAM_CLIENT_POOL_HPP
+#define UPSTREAM_CLIENT_POOL_HPP
+
+#include <cpr/cpr.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class UpstreamClientPool {
+public:
+  /* constructor / destructor */
+
+  /**
+   * @brief This method will execute the constructor of the UpstreamClientPool
+   * object.
+   *
+   * @param baseUrl The URL of the upstream server, without the path (e.g.
+   * "http://localhost:18082").
+   * @param maxIdleSessions The maximum number of idle keep-alive sessions kept
+   * in the pool, the pool grows beyond it while more requests are in flight.
+   *
+   * @throw std::invalid_argument if maxIdleSessions is zero.
+   */
+  explicit UpstreamClientPool(const std::string &baseUrl,
+                              const std::size_t maxIdleSessions);
+  ~UpstreamClientPool();
+
+  /**
+   * @brief This method will send a JSON POST request to the upstream server.
+   *
+   * This method will take an idle session from the pool, or open a new one if
+   * all of them are in use, send the request through it and give the session
+   * back to the pool, so that its connection is kept alive for the next
+   * request. It is safe to call this method from several threads, every
+   * request in flight has its own session.
+   *
+   * @param path The path of the endpoint (e.g. "/messageExchange").
+   * @param body The JSON body of the request.
+   *
+   * @return The response of the upstream server.
+   */
+  cpr::Response post(const std::string &path, const std::string &body);
+
+  /* getters */
+  std::size_t getNumberIdleSessions() const;
+
+private:
+  /* private methods */
+
+  /**
+   * @brief This method will take an idle session from the pool.
+   *
+   * @return An idle session, or a new one if the pool is empty.
+   */
+  std::unique_ptr<cpr::Session> acquireSession();
+
+  /**
+   * @brief This method will give a session back to the pool.
+   *
+   * The session is dropped if the pool already holds maxIdleSessions idle
+   * sessions.
+   *
+   * @param session The session to give back.
+   */
+  void releaseSession(std::unique_ptr<cpr::Session> session);
+
+  /* private fields */
+  const std::string _baseUrl;
+  const std::size_t _maxIdleSessions;
+  // Only guards the idle sessions, never held during a request
+  mutable std::mutex _idleSessionsMutex;
+  std::vector<std::unique_ptr<cpr::Session>> _idleSessions;
+};
+
+#endif // UPSTREAM_CLIENT_POOL_HPP
@@ -17,18 +17,16 @@ MyCryptoLibrary::DiffieHellman::DiffieHellman(const bool debugFlag,
     throw std::runtime_error("Diffie Hellman log | constructor(): "
                              "Group name is null");
   }
-  std::map<std::string, DhParametersLoader::DhParameters> dhParametersMap =
-      DhParametersLoader::loadDhParameters(getDhParametersFilenameLocation());
-  if (dhParametersMap.find(groupName) != dhParametersMap.end()) {
-    _dhParameter = dhParametersMap[groupName];
-    _p = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._pHex);
-    _g = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._gHex);
+  // the file is parsed and the group is built only once per process
+  _group = DhParametersLoader::getDhGroup(getDhParametersFilenameLocation(),
+                                          groupName);
+  if (_group) {
     if (_debugFlag) {
       std::cout << "Diffie Hellman log | p (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_p.get())
+                << MessageExtractionFacility::BIGNUMToDec(_group->_p.get())
                 << std::endl;
       std::cout << "Diffie Hellman log | g (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_g.get())
+                << MessageExtractionFacility::BIGNUMToDec(_group->_g.get())
                 << std::endl;
     }
     generatePrivateKey();
@@ -51,24 +49,22 @@ MyCryptoLibrary::DiffieHellman::DiffieHellman(const bool debugFlag,
     throw std::runtime_error("Diffie Hellman log | constructor(): "
                              "Group name is null");
   }
-  std::map<std::string, DhParametersLoader::DhParameters> dhParametersMap =
-      DhParametersLoader::loadDhParameters(getDhParametersFilenameLocation());
-  if (dhParametersMap.find(groupName) != dhParametersMap.end()) {
-    _dhParameter = dhParametersMap[groupName];
-    _p = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._pHex);
-    _g = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._gHex);
+  // the file is parsed and the group is built only once per process
+  _group = DhParametersLoader::getDhGroup(getDhParametersFilenameLocation(),
+                                          groupName);
+  if (_group) {
     if (_debugFlag) {
       std::cout << "Diffie Hellman log | p (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_p.get())
+                << MessageExtractionFacility::BIGNUMToDec(_group->_p.get())
                 << std::endl;
       std::cout << "Diffie Hellman log | g (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_g.get())
+                << MessageExtractionFacility::BIGNUMToDec(_group->_g.get())
                 << std::endl;
       std::cout << "Diffie Hellman log | p (hex) = "
-                << MessageExtractionFacility::BIGNUMToHex(_p.get())
+                << MessageExtractionFacility::BIGNUMToHex(_group->_p.get())
                 << std::endl;
       std::cout << "Diffie Hellman log | g (hex) = "
-                << MessageExtractionFacility::BIGNUMToHex(_g.get())
+                << MessageExtractionFacility::BIGNUMToHex(_group->_g.get())
                 << std::endl;
     }
     generatePrivateKey();
@@ -102,7 +98,7 @@ const std::string MyCryptoLibrary::DiffieHellman::getPublicKey() const {
  * @return The group name in a string format.
  */
 const std::string &MyCryptoLibrary::DiffieHellman::getGroupName() const {
-  return _dhParameter._groupName;
+  return _group->_parameters._groupName;
 }
 /******************************************************************************/
 /**
@@ -130,12 +126,12 @@ const std::string MyCryptoLibrary::DiffieHellman::deriveSharedSecret(
                                "Private key has not been generated for the "
                                "derivation of the shared secret");
     }
-    if (!_g || BN_is_zero(_g.get())) {
+    if (!_group || BN_is_zero(_group->_g.get())) {
       throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                                "Generator 'g' is not initialized for the "
                                "derivation of the shared secret");
     }
-    if (!_p || BN_is_zero(_p.get())) {
+    if (!_group || BN_is_zero(_group->_p.get())) {
       throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                                "Modulus 'p' is not initialized for the "
                                "derivation of the shared secret");
@@ -153,17 +149,18 @@ const std::string MyCryptoLibrary::DiffieHellman::deriveSharedSecret(
           "Diffie Hellman log | deriveSharedSecret(): Failed to create BIGNUM "
           "context for public key calculation.");
     }
-    // Compute _sharedSecret = (peerPublicKey ^ _privateKey) % _p
-    // BN_mod_exp(result, base, exponent, modulus, context)
-    if (!BN_mod_exp(_sharedSecret.get(), peerPublicKey.get(), _privateKey.get(),
-                    _p.get(), ctx)) {
+    // Compute _sharedSecret = (peerPublicKey ^ _privateKey) % _p, reusing the
+    // Montgomery context of the group instead of building one per call
+    if (!BN_mod_exp_mont(_sharedSecret.get(), peerPublicKey.get(),
+                         _privateKey.get(), _group->_p.get(), ctx,
+                         _group->_montgomeryContext.get())) {
       // Handle error from OpenSSL
       char errorBuffer[256];
       ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
       BN_CTX_free(ctx); // Free context on error
       throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                                "Failed to calculate shared "
-                               "secret (BN_mod_exp): " +
+                               "secret (BN_mod_exp_mont): " +
                                std::string(errorBuffer));
     }
     BN_CTX_free(ctx);
@@ -295,7 +292,7 @@ void MyCryptoLibrary::DiffieHellman::generatePrivateKey() {
   // So, we need to generate a random number 'x' such that 0 <= x < (p-2).
   // Then, set 'a = x + 2'. This ensures 'a' is in the range [2, p-1).
   MessageExtractionFacility::UniqueBIGNUM rangeForRand =
-      MessageExtractionFacility::UniqueBIGNUM(BN_dup(_p.get()));
+      MessageExtractionFacility::UniqueBIGNUM(BN_dup(_group->_p.get()));
   // Subtract: p(copy) - 2
   if (!BN_sub_word(rangeForRand.get(), 2)) {
     // BN_sub_word returns 0 if subtraction causes negative result or fails
@@ -348,7 +345,8 @@ void MyCryptoLibrary::DiffieHellman::generatePrivateKey() {
  */
 void MyCryptoLibrary::DiffieHellman::generatePublicKey() {
   if (_publicKeyDeterministic) {
-    _publicKey = MessageExtractionFacility::UniqueBIGNUM(BN_dup(_p.get()));
+    _publicKey =
+        MessageExtractionFacility::UniqueBIGNUM(BN_dup(_group->_p.get()));
     std::cout << "Diffie Hellman log parameter injection." << std::endl;
   } else {
     if (!_privateKey || BN_is_zero(_privateKey.get())) {
@@ -356,33 +354,18 @@ void MyCryptoLibrary::DiffieHellman::generatePublicKey() {
           "Diffie Hellman log | generatePublicKey(): Private key has not been "
           "generated. Call generatePrivateKey() first.");
     }
-    if (!_g || BN_is_zero(_g.get())) {
+    if (!_group || BN_is_zero(_group->_g.get())) {
       throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
                                "Generator 'g' is not initialized.");
     }
-    if (!_p || BN_is_zero(_p.get())) {
+    if (!_group || BN_is_zero(_group->_p.get())) {
       throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
                                "Modulus 'p' is not initialized.");
     }
-    BN_CTX *ctx = BN_CTX_new();
-    if (!ctx) {
-      throw std::runtime_error(
-          "Diffie Hellman log | generatePublicKey(): Failed to create BIGNUM "
-          "context for public key calculation.");
-    }
-    // Compute _publicKey = (_g ^ _privateKey) % _p
-    // BN_mod_exp(result, base, exponent, modulus, context)
-    if (!BN_mod_exp(_publicKey.get(), _g.get(), _privateKey.get(), _p.get(),
-                    ctx)) {
-      // Handle error from OpenSSL
-      char errorBuffer[256];
-      ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
-      BN_CTX_free(ctx); // Free context on error
-      throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
-                               "Failed to calculate public key (BN_mod_exp): " +
-                               std::string(errorBuffer));
-    }
-    BN_CTX_free(ctx);
+    // Compute _publicKey = (_g ^ _privateKey) % _p from the precomputed powers
+    // of g, the table of the group is shared by every key exchange
+    _publicKey =
+        _group->_fixedBaseExponentiation->exponentiate(_privateKey.get());
   }
   if (_debugFlag) {
     std::cout << "\nDiffie Hellman log | Generated public key (hex): "
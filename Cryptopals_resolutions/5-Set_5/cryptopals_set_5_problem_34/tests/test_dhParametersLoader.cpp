@@ -165,3 +165,27 @@ TEST_F(DhParametersLoaderTest,
     FAIL() << "Expected std::invalid_argument, but got a different exception";
   }
 }
+
+/**
+ * @test Test the correctness of the method getDhGroup
+ * @brief Ensures that a group is built only once, is shared by every caller
+ * and holds the values of the input file.
+ */
+TEST_F(DhParametersLoaderTest, getDhGroup_SameGroup_ShouldBeShared) {
+  const std::string &filename{
+      _diffieHellman->getDhParametersFilenameLocation()};
+  std::shared_ptr<const DhParametersLoader::DhGroup> group{
+      DhParametersLoader::getDhGroup(filename, "cryptopals-group-33-small")};
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(DhParametersLoader::getDhGroup(filename,
+                                           "cryptopals-group-33-small"),
+            group);
+  EXPECT_EQ(&DhParametersLoader::getDhParameters(filename),
+            &DhParametersLoader::getDhParameters(filename));
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(group->_p.get()), "25");
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(group->_g.get()), "05");
+  EXPECT_NE(group->_montgomeryContext, nullptr);
+  EXPECT_NE(group->_fixedBaseExponentiation, nullptr);
+  EXPECT_EQ(DhParametersLoader::getDhGroup(filename, "unknown-group"),
+            nullptr);
+}
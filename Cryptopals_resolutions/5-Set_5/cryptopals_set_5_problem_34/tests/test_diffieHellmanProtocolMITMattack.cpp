@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "../include/Client.hpp"
@@ -479,3 +480,41 @@ TEST_F(
   }
   EXPECT_EQ(numbersSessionsCreated, numberSessionsFound);
 }
+
+/**
+ * @test Test the message exchange with concurrent clients during a MITM
+ * attack.
+ * @brief Ensures that the fake server forwards the messages of several
+ * clients sending at the same time, each client with its own session.
+ */
+TEST_F(
+    DiffieHellmanKeyExchangeProtocolMITMattackTest,
+    MessageExchange_WithMalloryServerRunningConcurrentUsers_ShouldForwardAllMessages) {
+  const std::vector<std::string> clientIds{_clientId1, _clientId2,
+                                           _clientId3};
+  const int messagesPerClient{8};
+  std::vector<int> messagesForwarded(clientIds.size(), 0);
+  std::vector<std::thread> clients;
+  for (std::size_t i = 0; i < clientIds.size(); ++i) {
+    clients.emplace_back([&, i]() {
+      Client &client{*_mapUsers[clientIds[i]]};
+      const std::tuple<bool, std::string, std::string> keyExchangeResult =
+          client.diffieHellmanKeyExchange(client.getTestPort());
+      if (!std::get<0>(keyExchangeResult)) {
+        return;
+      }
+      for (int k = 0; k < messagesPerClient; ++k) {
+        if (client.messageExchange(client.getTestPort(),
+                                   std::get<2>(keyExchangeResult))) {
+          ++messagesForwarded[i];
+        }
+      }
+    });
+  }
+  for (std::thread &client : clients) {
+    client.join();
+  }
+  for (const int forwarded : messagesForwarded) {
+    EXPECT_EQ(forwarded, messagesPerClient);
+  }
+}
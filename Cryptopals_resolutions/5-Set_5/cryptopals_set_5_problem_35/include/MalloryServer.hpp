@@ -5,7 +5,9 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <memory>
 #include <openssl/aes.h>
+#include <unordered_map>
 #include <vector>
 
 #include "DhParametersLoader.hpp"
@@ -14,6 +16,7 @@
 #include "MallorySessionData.hpp"
 #include "MessageExtractionFacility.hpp"
 #include "SessionData.hpp"
+#include "UpstreamClientPool.hpp"
 
 /**
  * @brief Enum class that defines the g parameter replacement strategy used
@@ -140,7 +143,7 @@ public:
    *
    * @return The fake server's DH map.
    */
-  std::map<boost::uuids::uuid, std::unique_ptr<MallorySessionData>> &
+  std::map<boost::uuids::uuid, std::shared_ptr<MallorySessionData>> &
   getDiffieHellmanMap();
 
 private:
@@ -216,6 +219,22 @@ private:
    */
   boost::uuids::uuid generateUniqueSessionId();
 
+  /**
+   * @brief This method returns the session of a real server's session ID.
+   *
+   * This method returns the session whose Mallory -> Server session ID is
+   * sessionIdMS, the session map lock is only held during the lookup. The
+   * session returned stays valid even if it is removed from the maps
+   * afterwards.
+   *
+   * @param sessionIdMS The session ID given by the real server, which is also
+   * the one used by the client.
+   *
+   * @return The session, or nullptr if there is none.
+   */
+  std::shared_ptr<MallorySessionData>
+  findSessionByIdMS(const std::string &sessionIdMS) const;
+
   /**
    * @brief This method will generate a new g parameter according to the attack
    * strategy.
@@ -239,9 +258,16 @@ private:
       const gReplacementAttackStrategy &gReplacementAttackStrategy) const;
 
   /* private fields */
+  // Only guards the lookups and the insertions in the maps, each session has
+  // its own mutex for its data
   mutable std::mutex _diffieHellmanMapMutex;
-  std::map<boost::uuids::uuid, std::unique_ptr<MallorySessionData>>
+  // Sessions indexed by Mallory's session ID (Alice -> Mallory)
+  std::map<boost::uuids::uuid, std::shared_ptr<MallorySessionData>>
       _diffieHellmanMap;
+  // The same sessions indexed by the real server's session ID
+  // (Mallory -> Server)
+  std::unordered_map<std::string, std::shared_ptr<MallorySessionData>>
+      _diffieHellmanMapMS;
   const std::size_t _nonceSize{16}; // bytes
   crow::SimpleApp _app;
   const int _portProduction{18080};
@@ -249,6 +275,8 @@ private:
   const int _portRealServerProduction{18082};
   const int _portRealServerTest{18083};
   int _portRealServerInUse;
+  // Keep-alive connections to the real server, used to forward the messages
+  UpstreamClientPool _upstreamClientPool;
   std::thread _serverThread;
   const bool _debugFlag;
   const bool _testFlag;
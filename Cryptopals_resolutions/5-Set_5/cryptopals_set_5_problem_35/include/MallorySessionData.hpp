@@ -1,6 +1,8 @@
 #ifndef MALLORY_SESSION_DATA_HPP
 #define MALLORY_SESSION_DATA_HPP
 
+#include <mutex>
+
 #include "Client.hpp"
 #include "DhParametersLoader.hpp"
 #include "DiffieHellman.hpp"
@@ -52,6 +54,10 @@ struct MallorySessionData {
   // Client (Mallory) - Server channel
   std::string _sessionIdMS;
   std::unique_ptr<Client> _fakeClientMS;
+
+  // Guards the IVs of both channels once the session is shared, the keys and
+  // the session IDs are set before it is published and only read afterwards
+  mutable std::mutex _mutex;
 };
 
 #endif // MALLORY_SESSION_DATA_HPP
\ No newline at end of file
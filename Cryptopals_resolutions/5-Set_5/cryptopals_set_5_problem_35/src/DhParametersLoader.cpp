@@ -1,8 +1,10 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
+#include <utility>
 
 #include "./../include/DhParametersLoader.hpp"
 
@@ -74,3 +76,126 @@ DhParametersLoader::loadDhParameters(const std::string &filename) {
   }
   return paramsMap;
 }
+/******************************************************************************/
+/**
+ * @brief This method returns the public configurations of a given file.
+ *
+ * The file is only read and parsed the first time it is requested, the
+ * result is kept for the lifetime of the process. It is safe to call this
+ * method from several threads.
+ *
+ * @param filename The file address where the public configurations of
+ * the Diffie Hellman key Exchange protocol are.
+ *
+ * @return The file content in a structured dictionary.
+ *
+ * @throw runtime_error if it was not possible to open the file or the JSON
+ * parsing failed.
+ */
+const std::map<std::string, DhParametersLoader::DhParameters> &
+DhParametersLoader::getDhParameters(const std::string &filename) {
+  static std::mutex filesMutex;
+  static std::map<std::string, std::map<std::string, DhParameters>> files;
+  std::lock_guard<std::mutex> lock(filesMutex);
+  auto it = files.find(filename);
+  if (it == files.end()) {
+    // the entries are never erased, so the returned reference stays valid
+    it = files.emplace(filename, loadDhParameters(filename)).first;
+  }
+  return it->second;
+}
+/******************************************************************************/
+/**
+ * @brief This method builds a Diffie Hellman group from its public
+ * configuration.
+ *
+ * @param parameters The public configuration of the group.
+ *
+ * @return The group, without the precomputed powers of g.
+ * @throw std::runtime_error if an OpenSSL operation fails.
+ */
+std::shared_ptr<DhParametersLoader::DhGroup>
+DhParametersLoader::makeDhGroup(const DhParameters &parameters) {
+  std::shared_ptr<DhGroup> group{std::make_shared<DhGroup>()};
+  group->_parameters = parameters;
+  group->_p = MessageExtractionFacility::hexToUniqueBIGNUM(parameters._pHex);
+  group->_g = MessageExtractionFacility::hexToUniqueBIGNUM(parameters._gHex);
+  if (BN_is_odd(group->_p.get())) {
+    BN_CTX *ctx = BN_CTX_new();
+    group->_montgomeryContext.reset(BN_MONT_CTX_new());
+    if (!ctx || !group->_montgomeryContext ||
+        !BN_MONT_CTX_set(group->_montgomeryContext.get(), group->_p.get(),
+                         ctx)) {
+      BN_CTX_free(ctx);
+      throw std::runtime_error("DhParametersLoader log | makeDhGroup(): "
+                               "Failed to create the Montgomery context.");
+    }
+    BN_CTX_free(ctx);
+  }
+  return group;
+}
+/******************************************************************************/
+/**
+ * @brief This method returns the shared read only view of a Diffie Hellman
+ * group.
+ *
+ * The group is built the first time it is requested, together with the
+ * Montgomery context of p and the precomputed powers of g, and then kept for
+ * the lifetime of the process. It is safe to call this method from several
+ * threads.
+ *
+ * @param filename The file address where the public configurations of
+ * the Diffie Hellman key Exchange protocol are.
+ * @param groupName The name of the group.
+ *
+ * @return The group, or nullptr if the group is not in the file.
+ */
+std::shared_ptr<const DhParametersLoader::DhGroup>
+DhParametersLoader::getDhGroup(const std::string &filename,
+                               const std::string &groupName) {
+  static std::mutex groupsMutex;
+  static std::map<std::pair<std::string, std::string>,
+                  std::shared_ptr<const DhGroup>>
+      groups;
+  const std::map<std::string, DhParameters> &dhParametersMap{
+      getDhParameters(filename)};
+  const auto parametersIt = dhParametersMap.find(groupName);
+  if (parametersIt == dhParametersMap.end()) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(groupsMutex);
+  std::shared_ptr<const DhGroup> &instance = groups[{filename, groupName}];
+  if (!instance) {
+    std::shared_ptr<DhGroup> group{makeDhGroup(parametersIt->second)};
+    group->_fixedBaseExponentiation =
+        MyCryptoLibrary::FixedBaseExponentiation::getInstance(
+            parametersIt->second._pHex, parametersIt->second._gHex);
+    instance = std::move(group);
+  }
+  return instance;
+}
+/******************************************************************************/
+/**
+ * @brief This method returns the shared read only view of the Diffie Hellman
+ * group with the given prime and generator.
+ *
+ * @param filename The file address where the public configurations of
+ * the Diffie Hellman key Exchange protocol are.
+ * @param pHex The prime p, in hexadecimal format.
+ * @param gHex The generator g, in hexadecimal format.
+ *
+ * @return The group, or nullptr if no group of the file has this prime and
+ * generator.
+ */
+std::shared_ptr<const DhParametersLoader::DhGroup>
+DhParametersLoader::findDhGroup(const std::string &filename,
+                                const std::string &pHex,
+                                const std::string &gHex) {
+  for (const auto &[groupName, parameters] : getDhParameters(filename)) {
+    if (parameters._pHex == pHex && parameters._gHex == gHex) {
+      return getDhGroup(filename, groupName);
+    }
+  }
+  return nullptr;
+}
+/******************************************************************************/
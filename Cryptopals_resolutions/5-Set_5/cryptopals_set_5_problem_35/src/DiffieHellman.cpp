@@ -31,18 +31,16 @@ MyCryptoLibrary::DiffieHellman::DiffieHellman(const bool debugFlag,
     throw std::runtime_error("Diffie Hellman log | constructor(): "
                              "Group name is null");
   }
-  std::map<std::string, DhParametersLoader::DhParameters> dhParametersMap =
-      DhParametersLoader::loadDhParameters(getDhParametersFilenameLocation());
-  if (dhParametersMap.find(groupName) != dhParametersMap.end()) {
-    _dhParameter = dhParametersMap[groupName];
-    _p = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._pHex);
-    _g = MessageExtractionFacility::hexToUniqueBIGNUM(_dhParameter._gHex);
+  // the file is parsed and the group is built only once per process
+  _group = DhParametersLoader::getDhGroup(getDhParametersFilenameLocation(),
+                                          groupName);
+  if (_group) {
     if (_debugFlag) {
       std::cout << "Diffie Hellman log | p (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_p.get())
+                << MessageExtractionFacility::BIGNUMToDec(_group->_p.get())
                 << std::endl;
       std::cout << "Diffie Hellman log | g (decimal) = "
-                << MessageExtractionFacility::BIGNUMToDec(_g.get())
+                << MessageExtractionFacility::BIGNUMToDec(_group->_g.get())
                 << std::endl;
     }
     generatePrivateKey();
@@ -81,13 +79,23 @@ MyCryptoLibrary::DiffieHellman::DiffieHellman(const bool debugFlag,
     throw std::runtime_error("Diffie Hellman log | constructor(): "
                              "Generator g is null");
   }
-  _p = MessageExtractionFacility::hexToUniqueBIGNUM(p);
-  _g = MessageExtractionFacility::hexToUniqueBIGNUM(g);
+  // a group of DhParameters.json is shared with the other key exchanges,
+  // p and g changed by the peer get a group of their own
+  _group = DhParametersLoader::findDhGroup(getDhParametersFilenameLocation(),
+                                           p, g);
+  if (!_group) {
+    DhParametersLoader::DhParameters parameters;
+    parameters._pHex = p;
+    parameters._gHex = g;
+    _group = DhParametersLoader::makeDhGroup(parameters);
+  }
   if (_debugFlag) {
     std::cout << "Diffie Hellman log | p (decimal) = "
-              << MessageExtractionFacility::BIGNUMToDec(_p.get()) << std::endl;
+              << MessageExtractionFacility::BIGNUMToDec(_group->_p.get())
+              << std::endl;
     std::cout << "Diffie Hellman log | g (decimal) = "
-              << MessageExtractionFacility::BIGNUMToDec(_g.get()) << std::endl;
+              << MessageExtractionFacility::BIGNUMToDec(_group->_g.get())
+              << std::endl;
   }
   generatePrivateKey();
   generatePublicKey();
@@ -135,12 +143,12 @@ const std::string MyCryptoLibrary::DiffieHellman::deriveSharedSecret(
                              "Private key has not been generated for the "
                              "derivation of the shared secret");
   }
-  if (!_g || BN_is_zero(_g.get())) {
+  if (!_group || BN_is_zero(_group->_g.get())) {
     throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                              "Generator 'g' is not initialized for the "
                              "derivation of the shared secret");
   }
-  if (!_p || BN_is_zero(_p.get())) {
+  if (!_group || BN_is_zero(_group->_p.get())) {
     throw std::runtime_error("Diffie Hellman log | deriveSharedSecret(): "
                              "Modulus 'p' is not initialized for the "
                              "derivation of the shared secret");
@@ -158,10 +166,17 @@ const std::string MyCryptoLibrary::DiffieHellman::deriveSharedSecret(
         "Diffie Hellman log | deriveSharedSecret(): Failed to create BIGNUM "
         "context for public key calculation.");
   }
-  // Compute _sharedSecret = (peerPublicKey ^ _privateKey) % _p
-  // BN_mod_exp(result, base, exponent, modulus, context)
-  if (!BN_mod_exp(_sharedSecret.get(), peerPublicKey.get(), _privateKey.get(),
-                  _p.get(), ctx)) {
+  // Compute _sharedSecret = (peerPublicKey ^ _privateKey) % _p, reusing the
+  // Montgomery context of the group instead of building one per call (an
+  // even p chosen by the peer has none)
+  const int success{
+      _group->_montgomeryContext
+          ? BN_mod_exp_mont(_sharedSecret.get(), peerPublicKey.get(),
+                            _privateKey.get(), _group->_p.get(), ctx,
+                            _group->_montgomeryContext.get())
+          : BN_mod_exp(_sharedSecret.get(), peerPublicKey.get(),
+                       _privateKey.get(), _group->_p.get(), ctx)};
+  if (!success) {
     // Handle error from OpenSSL
     char errorBuffer[256];
     ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
@@ -293,11 +308,11 @@ MyCryptoLibrary::DiffieHellman::getDhParametersFilenameLocation() const {
  * @throws std::runtime_error if the prime p is not set.
  */
 const std::string MyCryptoLibrary::DiffieHellman::getPrimeP() const {
-  if (!_p) {
+  if (!_group) {
     throw std::runtime_error("Diffie Hellman log | getPrimeP(): "
                              "prime p is not set.");
   }
-  return MessageExtractionFacility::BIGNUMToHex(_p.get());
+  return MessageExtractionFacility::BIGNUMToHex(_group->_p.get());
 }
 /******************************************************************************/
 /**
@@ -308,11 +323,11 @@ const std::string MyCryptoLibrary::DiffieHellman::getPrimeP() const {
  * @throws std::runtime_error if the generator g is not set.
  */
 const std::string MyCryptoLibrary::DiffieHellman::getGeneratorG() const {
-  if (!_g) {
+  if (!_group) {
     throw std::runtime_error("Diffie Hellman log | getGeneratorG(): "
                              "generator g is not set.");
   }
-  return MessageExtractionFacility::BIGNUMToHex(_g.get());
+  return MessageExtractionFacility::BIGNUMToHex(_group->_g.get());
 };
 /******************************************************************************/
 /**
@@ -348,7 +363,7 @@ void MyCryptoLibrary::DiffieHellman::generatePrivateKey() {
   // So, we need to generate a random number 'x' such that 0 <= x < (p-2).
   // Then, set 'a = x + 2'. This ensures 'a' is in the range [2, p-1).
   MessageExtractionFacility::UniqueBIGNUM rangeForRand =
-      MessageExtractionFacility::UniqueBIGNUM(BN_dup(_p.get()));
+      MessageExtractionFacility::UniqueBIGNUM(BN_dup(_group->_p.get()));
   // Subtract: p(copy) - 2
   if (!BN_sub_word(rangeForRand.get(), 2)) {
     // BN_sub_word returns 0 if subtraction causes negative result or fails
@@ -405,33 +420,42 @@ void MyCryptoLibrary::DiffieHellman::generatePublicKey() {
         "Diffie Hellman log | generatePublicKey(): Private key has not been "
         "generated. Call generatePrivateKey() first.");
   }
-  if (!_g || BN_is_zero(_g.get())) {
+  if (!_group || BN_is_zero(_group->_g.get())) {
     throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
                              "Generator 'g' is not initialized.");
   }
-  if (!_p || BN_is_zero(_p.get())) {
+  if (!_group || BN_is_zero(_group->_p.get())) {
     throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
                              "Modulus 'p' is not initialized.");
   }
-  BN_CTX *ctx = BN_CTX_new();
-  if (!ctx) {
-    throw std::runtime_error(
-        "Diffie Hellman log | generatePublicKey(): Failed to create BIGNUM "
-        "context for public key calculation.");
-  }
-  // Compute _publicKey = (_g ^ _privateKey) % _p
-  // BN_mod_exp(result, base, exponent, modulus, context)
-  if (!BN_mod_exp(_publicKey.get(), _g.get(), _privateKey.get(), _p.get(),
-                  ctx)) {
-    // Handle error from OpenSSL
-    char errorBuffer[256];
-    ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
-    BN_CTX_free(ctx); // Free context on error
-    throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
-                             "Failed to calculate public key (BN_mod_exp): " +
-                             std::string(errorBuffer));
+  if (_group->_fixedBaseExponentiation) {
+    // Compute _publicKey = (_g ^ _privateKey) % _p from the precomputed powers
+    // of g, the table of the group is shared by every key exchange
+    _publicKey =
+        _group->_fixedBaseExponentiation->exponentiate(_privateKey.get());
+  } else {
+    // p and g chosen by the peer, only the groups of DhParameters.json get
+    // a table
+    BN_CTX *ctx = BN_CTX_new();
+    if (!ctx) {
+      throw std::runtime_error(
+          "Diffie Hellman log | generatePublicKey(): Failed to create BIGNUM "
+          "context for public key calculation.");
+    }
+    // Compute _publicKey = (_g ^ _privateKey) % _p
+    // BN_mod_exp(result, base, exponent, modulus, context)
+    if (!BN_mod_exp(_publicKey.get(), _group->_g.get(), _privateKey.get(),
+                    _group->_p.get(), ctx)) {
+      // Handle error from OpenSSL
+      char errorBuffer[256];
+      ERR_error_string_n(ERR_get_error(), errorBuffer, sizeof(errorBuffer));
+      BN_CTX_free(ctx); // Free context on error
+      throw std::runtime_error("Diffie Hellman log | generatePublicKey(): "
+                               "Failed to calculate public key (BN_mod_exp): " +
+                               std::string(errorBuffer));
+    }
+    BN_CTX_free(ctx);
   }
-  BN_CTX_free(ctx);
   if (_debugFlag) {
     std::cout << "\nDiffie Hellman log | Generated public key (hex): "
               << MessageExtractionFacility::BIGNUMToHex(_publicKey.get())
@@ -457,7 +481,7 @@ void MyCryptoLibrary::DiffieHellman::generatePublicKey() {
 bool MyCryptoLibrary::DiffieHellman::
     testValueRawSharedSecretNegativeHypothesis() {
   // The hypothesis is that the actual secret is (p-1).
-  if (!_sharedSecret || !_p) {
+  if (!_sharedSecret || !_group) {
     // Handle error: BIGNUMs not initialized
     return false;
   }
@@ -469,7 +493,7 @@ bool MyCryptoLibrary::DiffieHellman::
     return false;
   }
   // Subtract 1 from p
-  if (BN_sub(pMinus1Bn.get(), _p.get(), BN_value_one()) == 0) {
+  if (BN_sub(pMinus1Bn.get(), _group->_p.get(), BN_value_one()) == 0) {
     // Handle error: BN_sub failed
     return false;
   }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fmt/core.h>
 #include <nlohmann/json.hpp>
 #include <openssl/conf.h>
@@ -30,10 +31,13 @@
 MalloryServer::MalloryServer(
     const bool debugFlag, const bool testFlag,
     const gReplacementAttackStrategy gReplacementAttackStrategy)
-    : _debugFlag{debugFlag}, _testFlag{testFlag},
+    : _portRealServerInUse{testFlag ? _portRealServerTest
+                                    : _portRealServerProduction},
+      _upstreamClientPool{
+          "http://localhost:" + std::to_string(_portRealServerInUse),
+          std::max(1u, std::thread::hardware_concurrency())},
+      _debugFlag{debugFlag}, _testFlag{testFlag},
       _gReplacementAttackStrategy{gReplacementAttackStrategy} {
-  _portRealServerInUse =
-      (_testFlag) ? _portRealServerTest : _portRealServerProduction;
   boost::uuids::random_generator gen;
   _serverId += boost::uuids::to_string(gen());
 }
@@ -88,6 +92,7 @@ void MalloryServer::runServerTest() {
 void MalloryServer::clearDiffieHellmanSessionData() {
   std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
   _diffieHellmanMap.clear();
+  _diffieHellmanMapMS.clear();
 }
 /******************************************************************************/
 /**
@@ -171,7 +176,7 @@ void MalloryServer::setGReplacementAttackStrategy(
  *
  * @return The fake server's DH map.
  */
-std::map<boost::uuids::uuid, std::unique_ptr<MallorySessionData>> &
+std::map<boost::uuids::uuid, std::shared_ptr<MallorySessionData>> &
 MalloryServer::getDiffieHellmanMap() {
   return _diffieHellmanMap;
 }
@@ -254,26 +259,24 @@ void MalloryServer::keyExchangeRoute() {
           MessageExtractionFacility::UniqueBIGNUM peerPublicKey =
               MessageExtractionFacility::hexToUniqueBIGNUM(extractedPublicKeyA);
           boost::uuids::uuid sessionId = generateUniqueSessionId();
-          std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
-          _diffieHellmanMap[sessionId] = std::make_unique<MallorySessionData>(
-              _nonceSize, extractedNonceClient, extractedClientId, _debugFlag,
-              _ivLength, extractedPrimeP, extractedGeneratorG);
-          _diffieHellmanMap[sessionId]->_derivedKeyHexAM =
-              _diffieHellmanMap[sessionId]
-                  ->_diffieHellmanAM->deriveSharedSecret(
-                      extractedPublicKeyA,
-                      _diffieHellmanMap[sessionId]->_serverNonceHexAM,
-                      _diffieHellmanMap[sessionId]->_clientNonceHexAM);
+          // the session is built, including the key exchange of the fake
+          // client with the real server, before it is published in the maps
+          std::shared_ptr<MallorySessionData> session{
+              std::make_shared<MallorySessionData>(
+                  _nonceSize, extractedNonceClient, extractedClientId,
+                  _debugFlag, _ivLength, extractedPrimeP,
+                  extractedGeneratorG)};
+          session->_derivedKeyHexAM =
+              session->_diffieHellmanAM->deriveSharedSecret(
+                  extractedPublicKeyA, session->_serverNonceHexAM,
+                  session->_clientNonceHexAM);
           // generate fake client
-          _diffieHellmanMap[sessionId]->_fakeClientMS =
-              std::make_unique<Client>(
-                  _diffieHellmanMap[sessionId]->_clientIdAM, _debugFlag,
-                  _diffieHellmanMap[sessionId]->_diffieHellmanAM->getPrimeP(),
-                  swappedGeneratorG);
+          session->_fakeClientMS = std::make_unique<Client>(
+              session->_clientIdAM, _debugFlag,
+              session->_diffieHellmanAM->getPrimeP(), swappedGeneratorG);
           std::tuple<bool, std::string, std::string> serverResponse =
-              _diffieHellmanMap[sessionId]
-                  ->_fakeClientMS->diffieHellmanKeyExchange(
-                      _portRealServerInUse);
+              session->_fakeClientMS->diffieHellmanKeyExchange(
+                  _portRealServerInUse);
           // extract info from response of server to fake client
           if (std::get<0>(serverResponse) == false) {
             throw std::runtime_error(
@@ -296,33 +299,33 @@ void MalloryServer::keyExchangeRoute() {
           res["message"] = messageExtracted;
           res["sessionId"] = sessionIdExtracted;
           res["diffieHellman"] = {
-              {"p",
-               _diffieHellmanMap[sessionId]->_diffieHellmanAM->getPrimeP()},
-              {"g",
-               _diffieHellmanMap[sessionId]->_diffieHellmanAM->getGeneratorG()},
-              {"publicKeyB",
-               _diffieHellmanMap[sessionId]->_diffieHellmanAM->getPublicKey()}};
-          res["nonce"] = _diffieHellmanMap[sessionId]->_serverNonceHexAM;
+              {"p", session->_diffieHellmanAM->getPrimeP()},
+              {"g", session->_diffieHellmanAM->getGeneratorG()},
+              {"publicKeyB", session->_diffieHellmanAM->getPublicKey()}};
+          res["nonce"] = session->_serverNonceHexAM;
           // confirmation payload
           nlohmann::json confirmationPayload = {
               {"sessionId", sessionIdExtracted},
               {"clientId", extractedClientId},
-              {"clientNonce", _diffieHellmanMap[sessionId]->_clientNonceHexAM},
-              {"serverNonce", _diffieHellmanMap[sessionId]->_serverNonceHexAM},
+              {"clientNonce", session->_clientNonceHexAM},
+              {"serverNonce", session->_serverNonceHexAM},
               {"message", messageExtracted}};
           const std::string confirmationString = confirmationPayload.dump();
           std::string encryptedConfirmationHex =
               EncryptionUtility::encryptMessageAes256CbcMode(
                   confirmationString,
-                  _diffieHellmanMap[sessionId]
-                      ->_diffieHellmanAM->getSymmetricKey(),
-                  _diffieHellmanMap[sessionId]->_ivAM);
+                  session->_diffieHellmanAM->getSymmetricKey(),
+                  session->_ivAM);
           res["confirmation"] = {
               {"ciphertext", encryptedConfirmationHex},
-              {"iv", MessageExtractionFacility::toHexString(
-                         _diffieHellmanMap[sessionId]->_ivAM)}};
+              {"iv", MessageExtractionFacility::toHexString(session->_ivAM)}};
           // save session id with real server to future use
-          _diffieHellmanMap[sessionId]->_sessionIdMS = sessionIdExtracted;
+          session->_sessionIdMS = sessionIdExtracted;
+          {
+            std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
+            _diffieHellmanMap[sessionId] = session;
+            _diffieHellmanMapMS[sessionIdExtracted] = session;
+          }
         } catch (const nlohmann::json::exception &e) {
           crow::json::wvalue err;
           err["message"] =
@@ -367,33 +370,39 @@ void MalloryServer::messageExchangeRoute() {
           std::string extractedIv = parsedJson.at("iv").get<std::string>();
           std::string extractedCiphertext =
               parsedJson.at("ciphertext").get<std::string>();
-          boost::uuids::string_generator gen;
-          // check if session id already exists
-          std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
-          boost::uuids::uuid sessionIdASFound;
-          bool sessionIdASFoundFlag{false};
           // search real session id (M -> S)
-          for (const auto &pair : _diffieHellmanMap) {
-            if (pair.second->_sessionIdMS == extractedSessionId) {
-              sessionIdASFoundFlag = true;
-              sessionIdASFound = pair.first;
-            }
-          }
-          if (!sessionIdASFoundFlag) {
+          const std::shared_ptr<MallorySessionData> session{
+              findSessionByIdMS(extractedSessionId)};
+          if (!session) {
             throw std::runtime_error(
                 "Mallory Server log | MessageExchangeRoute(): "
                 "Session id: " +
                 extractedSessionId + " not found from Alice -> Mallory");
           }
-          // convert iv to bytes and store it
-          _diffieHellmanMap[sessionIdASFound]->_ivAM =
-              MessageExtractionFacility::hexToBytes(extractedIv);
+          // the keys are set before the session is published, the session
+          // lock is neither held during the encryption nor during the request
+          // to the real server
+          const std::vector<uint8_t> &symmetricKeyAM{
+              session->_diffieHellmanAM->getSymmetricKey()};
+          const auto fakeClientSessionIt =
+              session->_fakeClientMS->getDiffieHellmanMap().find(
+                  extractedSessionId);
+          if (fakeClientSessionIt ==
+              session->_fakeClientMS->getDiffieHellmanMap().end()) {
+            throw std::runtime_error(
+                "Mallory Server log | MessageExchangeRoute(): "
+                "Session id: " +
+                extractedSessionId + " not found from Mallory -> Server");
+          }
+          SessionData &fakeClientSession{*fakeClientSessionIt->second};
+          const std::vector<uint8_t> &symmetricKeyMS{
+              fakeClientSession._diffieHellman->getSymmetricKey()};
+          // convert iv to bytes
+          const std::vector<uint8_t> ivAM{
+              MessageExtractionFacility::hexToBytes(extractedIv)};
           const std::string plaintext =
               EncryptionUtility::decryptMessageAes256CbcMode(
-                  extractedCiphertext,
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_diffieHellmanAM->getSymmetricKey(),
-                  _diffieHellmanMap[sessionIdASFound]->_ivAM);
+                  extractedCiphertext, symmetricKeyAM, ivAM);
           if (_debugFlag) {
             std::cout << "Mallory Server log | MessageExchangeRoute() - "
                          "decrypted plaintext: "
@@ -401,19 +410,12 @@ void MalloryServer::messageExchangeRoute() {
           }
           // build fake client request to the real server
           // rotate iv
-          _diffieHellmanMap[sessionIdASFound]
-              ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-              ->_iv = EncryptionUtility::generateRandomIV(_ivLength);
+          const std::vector<uint8_t> ivMS{
+              EncryptionUtility::generateRandomIV(_ivLength)};
           // calculate ciphertext
           const std::string ciphertextMS =
               EncryptionUtility::encryptMessageAes256CbcMode(
-                  plaintext,
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-                      ->_diffieHellman->getSymmetricKey(),
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-                      ->_iv);
+                  plaintext, symmetricKeyMS, ivMS);
           // built body request MS
           std::string requestBodyMS = fmt::format(
               R"({{
@@ -423,24 +425,15 @@ void MalloryServer::messageExchangeRoute() {
             "iv": "{}",
             "ciphertext": "{}"
           }})",
-              extractedSessionId,
-              MessageExtractionFacility::toHexString(
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-                      ->_iv),
+              extractedSessionId, MessageExtractionFacility::toHexString(ivMS),
               ciphertextMS);
           cpr::Response responseMS =
-              cpr::Post(cpr::Url{std::string("http://localhost:") +
-                                 std::to_string(_portRealServerInUse) +
-                                 std::string("/messageExchange")},
-                        cpr::Header{{"Content-Type", "application/json"}},
-                        cpr::Body{requestBodyMS});
+              _upstreamClientPool.post("/messageExchange", requestBodyMS);
           if (responseMS.status_code != 201) {
             throw std::runtime_error(
                 "Mallory Server log | messageExchange(): "
                 "Message exchange failed at fake client ID: " +
-                _diffieHellmanMap[sessionIdASFound]
-                    ->_fakeClientMS->getClientId());
+                session->_fakeClientMS->getClientId());
           }
           if (_debugFlag) {
             Client::printServerResponse(responseMS);
@@ -452,8 +445,7 @@ void MalloryServer::messageExchangeRoute() {
             throw std::runtime_error(
                 "Mallory Server log | messageExchange(): "
                 "Message exchange failed at client ID: " +
-                _diffieHellmanMap[sessionIdASFound]
-                    ->_fakeClientMS->getClientId() +
+                session->_fakeClientMS->getClientId() +
                 " session ID send and received don't match.");
           }
           const std::string extractedCiphertextMS =
@@ -462,36 +454,31 @@ void MalloryServer::messageExchangeRoute() {
                   .get<std::string>();
           const std::string extractedIvHexMS =
               parsedJsonMS.at("confirmation").at("iv").get<std::string>();
-          // update iv MS
-          _diffieHellmanMap[sessionIdASFound]
-              ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-              ->_iv = MessageExtractionFacility::hexToBytes(extractedIvHexMS);
+          // iv MS of the confirmation
+          std::vector<uint8_t> confirmationIvMS{
+              MessageExtractionFacility::hexToBytes(extractedIvHexMS)};
           // decrypt received ciphertext MS
           const std::string decryptedCiphertextMS =
               EncryptionUtility::decryptMessageAes256CbcMode(
-                  extractedCiphertextMS,
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-                      ->_diffieHellman->getSymmetricKey(),
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_fakeClientMS->getDiffieHellmanMap()[extractedSessionId]
-                      ->_iv);
+                  extractedCiphertextMS, symmetricKeyMS, confirmationIvMS);
           // rotate iv AM
-          _diffieHellmanMap[sessionIdASFound]->_ivAM =
-              EncryptionUtility::generateRandomIV(_ivLength);
+          std::vector<uint8_t> confirmationIvAM{
+              EncryptionUtility::generateRandomIV(_ivLength)};
           // encrypt server's confirmation message
           std::string serverConfirmationMessageEncryptedAM =
               EncryptionUtility::encryptMessageAes256CbcMode(
-                  decryptedCiphertextMS,
-                  _diffieHellmanMap[sessionIdASFound]
-                      ->_diffieHellmanAM->getSymmetricKey(),
-                  _diffieHellmanMap[sessionIdASFound]->_ivAM);
+                  decryptedCiphertextMS, symmetricKeyAM, confirmationIvAM);
           // build confirmation response
           res["sessionId"] = extractedSessionId;
           res["confirmation"] = {
               {"ciphertext", serverConfirmationMessageEncryptedAM},
-              {"iv", MessageExtractionFacility::toHexString(
-                         _diffieHellmanMap[sessionIdASFound]->_ivAM)}};
+              {"iv", MessageExtractionFacility::toHexString(confirmationIvAM)}};
+          // publish the last iv of each channel
+          {
+            std::lock_guard<std::mutex> sessionLock(session->_mutex);
+            fakeClientSession._iv = std::move(confirmationIvMS);
+            session->_ivAM = std::move(confirmationIvAM);
+          }
         } catch (const nlohmann::json::exception &e) {
           crow::json::wvalue err;
           err["message"] =
@@ -525,12 +512,18 @@ void MalloryServer::getSessionsDataEndpoint() {
       .methods("GET"_method)([&](const crow::request &req) {
         try {
           crow::json::wvalue res;
-          std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
-          for (const auto &entry : _diffieHellmanMap) {
-            const auto &sessionId = entry.first;
-            const auto &sessionData = entry.second;
-            const std::string realSessionId =
-                _diffieHellmanMap[sessionId]->_sessionIdMS;
+          std::vector<std::shared_ptr<MallorySessionData>> sessions;
+          {
+            std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
+            sessions.reserve(_diffieHellmanMap.size());
+            for (const auto &entry : _diffieHellmanMap) {
+              sessions.emplace_back(entry.second);
+            }
+          }
+          for (const std::shared_ptr<MallorySessionData> &sessionData :
+               sessions) {
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            const std::string &realSessionId = sessionData->_sessionIdMS;
             res[realSessionId] = {
                 {"sessionId", realSessionId},
                 {"clientId", sessionData->_clientIdAM},
@@ -637,3 +630,26 @@ const std::string MalloryServer::generateGParameterByAttackStrategy(
   return newGeneratorValue;
 }
 /******************************************************************************/
+/**
+ * @brief This method returns the session of a real server's session ID.
+ *
+ * This method returns the session whose Mallory -> Server session ID is
+ * sessionIdMS, the session map lock is only held during the lookup. The
+ * session returned stays valid even if it is removed from the maps
+ * afterwards.
+ *
+ * @param sessionIdMS The session ID given by the real server, which is also
+ * the one used by the client.
+ *
+ * @return The session, or nullptr if there is none.
+ */
+std::shared_ptr<MallorySessionData>
+MalloryServer::findSessionByIdMS(const std::string &sessionIdMS) const {
+  std::lock_guard<std::mutex> lock(_diffieHellmanMapMutex);
+  const auto it = _diffieHellmanMapMS.find(sessionIdMS);
+  if (it == _diffieHellmanMapMS.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+/******************************************************************************/
@@ -0,0 +1,96 @@
+#include <stdexcept>
+#include <utility>
+
+#include "./../include/UpstreamClientPool.hpp"
+
+/* constructor / destructor */
+
+/**
+ * @brief This method will execute the constructor of the UpstreamClientPool
+ * object.
+ *
+ * @param baseUrl The URL of the upstream server, without the path (e.g.
+ * "http://localhost:18082").
+ * @param maxIdleSessions The maximum number of idle keep-alive sessions kept
+ * in the pool, the pool grows beyond it while more requests are in flight.
+ *
+ * @throw std::invalid_argument if maxIdleSessions is zero.
+ */
+UpstreamClientPool::UpstreamClientPool(const std::string &baseUrl,
+                                       const std::size_t maxIdleSessions)
+    : _baseUrl{baseUrl}, _maxIdleSessions{maxIdleSessions} {
+  if (_maxIdleSessions == 0) {
+    throw std::invalid_argument("UpstreamClientPool log | constructor(): "
+                                "the number of idle sessions must be "
+                                "positive.");
+  }
+}
+/******************************************************************************/
+UpstreamClientPool::~UpstreamClientPool() {}
+/******************************************************************************/
+/**
+ * @brief This method will send a JSON POST request to the upstream server.
+ *
+ * This method will take an idle session from the pool, or open a new one if
+ * all of them are in use, send the request through it and give the session
+ * back to the pool, so that its connection is kept alive for the next
+ * request. It is safe to call this method from several threads, every
+ * request in flight has its own session.
+ *
+ * @param path The path of the endpoint (e.g. "/messageExchange").
+ * @param body The JSON body of the request.
+ *
+ * @return The response of the upstream server.
+ */
+cpr::Response UpstreamClientPool::post(const std::string &path,
+                                       const std::string &body) {
+  std::unique_ptr<cpr::Session> session{acquireSession()};
+  session->SetUrl(cpr::Url{_baseUrl + path});
+  session->SetHeader(cpr::Header{{"Content-Type", "application/json"}});
+  session->SetBody(cpr::Body{body});
+  cpr::Response response{session->Post()};
+  // the connection of a failed transfer may be broken, it is not reused
+  if (response.error.code == cpr::ErrorCode::OK) {
+    releaseSession(std::move(session));
+  }
+  return response;
+}
+/******************************************************************************/
+/* getters */
+std::size_t UpstreamClientPool::getNumberIdleSessions() const {
+  std::lock_guard<std::mutex> lock(_idleSessionsMutex);
+  return _idleSessions.size();
+}
+/******************************************************************************/
+/**
+ * @brief This method will take an idle session from the pool.
+ *
+ * @return An idle session, or a new one if the pool is empty.
+ */
+std::unique_ptr<cpr::Session> UpstreamClientPool::acquireSession() {
+  {
+    std::lock_guard<std::mutex> lock(_idleSessionsMutex);
+    if (!_idleSessions.empty()) {
+      std::unique_ptr<cpr::Session> session{std::move(_idleSessions.back())};
+      _idleSessions.pop_back();
+      return session;
+    }
+  }
+  return std::make_unique<cpr::Session>();
+}
+/******************************************************************************/
+/**
+ * @brief This method will give a session back to the pool.
+ *
+ * The session is dropped if the pool already holds maxIdleSessions idle
+ * sessions.
+ *
+ * @param session The session to give back.
+ */
+void UpstreamClientPool::releaseSession(std::unique_ptr<cpr::Session> session) {
+  std::lock_guard<std::mutex> lock(_idleSessionsMutex);
+  if (_idleSessions.size() < _maxIdleSessions) {
+    _idleSessions.emplace_back(std::move(session));
+  }
+}
+/******************************************************************************/
@@ -165,3 +165,41 @@ TEST_F(DhParametersLoaderTest,
     FAIL() << "Expected std::invalid_argument, but got a different exception";
   }
 }
+
+/**
+ * @test Test the correctness of the method getDhGroup
+ * @brief Ensures that a group is built only once, is shared by every caller
+ * and holds the values of the input file.
+ */
+TEST_F(DhParametersLoaderTest, getDhGroup_SameGroup_ShouldBeShared) {
+  const std::string &filename{
+      _diffieHellman->getDhParametersFilenameLocation()};
+  std::shared_ptr<const DhParametersLoader::DhGroup> group{
+      DhParametersLoader::getDhGroup(filename, "cryptopals-group-33-small")};
+  ASSERT_NE(group, nullptr);
+  EXPECT_EQ(DhParametersLoader::getDhGroup(filename,
+                                           "cryptopals-group-33-small"),
+            group);
+  EXPECT_EQ(&DhParametersLoader::getDhParameters(filename),
+            &DhParametersLoader::getDhParameters(filename));
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(group->_p.get()), "25");
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(group->_g.get()), "05");
+  EXPECT_NE(group->_montgomeryContext, nullptr);
+  EXPECT_NE(group->_fixedBaseExponentiation, nullptr);
+  EXPECT_EQ(DhParametersLoader::getDhGroup(filename, "unknown-group"),
+            nullptr);
+}
+
+/**
+ * @test Test the correctness of the method findDhGroup
+ * @brief Ensures that p and g of a group of the input file give the shared
+ * group, and that a changed generator does not.
+ */
+TEST_F(DhParametersLoaderTest, findDhGroup_WithKnownAndChangedGenerator) {
+  const std::string &filename{
+      _diffieHellman->getDhParametersFilenameLocation()};
+  EXPECT_EQ(DhParametersLoader::findDhGroup(filename, "25", "05"),
+            DhParametersLoader::getDhGroup(filename,
+                                           "cryptopals-group-33-small"));
+  EXPECT_EQ(DhParametersLoader::findDhGroup(filename, "25", "01"), nullptr);
+}
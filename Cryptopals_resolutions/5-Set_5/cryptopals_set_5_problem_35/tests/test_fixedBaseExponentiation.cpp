@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/FixedBaseExponentiation.hpp"
+
+class FixedBaseExponentiationTest : public ::testing::Test {
+protected:
+  // cppcheck-suppress unusedFunction
+  void SetUp() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    _fixedBaseExponentiation =
+        MyCryptoLibrary::FixedBaseExponentiation::getInstance(_pHex, _gHex);
+  }
+
+  // cppcheck-suppress unusedFunction
+  void TearDown() override {
+    // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.VirtualCall)
+    // Cleanup (if needed)
+  }
+
+  /**
+   * @brief Reference result of g^exponent mod p, using BN_mod_exp.
+   */
+  MessageExtractionFacility::UniqueBIGNUM
+  referenceExponentiation(const BIGNUM *exponent) const {
+    MessageExtractionFacility::UniqueBIGNUM p{
+        MessageExtractionFacility::hexToUniqueBIGNUM(_pHex)};
+    MessageExtractionFacility::UniqueBIGNUM g{
+        MessageExtractionFacility::hexToUniqueBIGNUM(_gHex)};
+    MessageExtractionFacility::UniqueBIGNUM result{BN_new()};
+    BN_CTX *ctx = BN_CTX_new();
+    BN_mod_exp(result.get(), g.get(), exponent, p.get(), ctx);
+    BN_CTX_free(ctx);
+    return result;
+  }
+
+  // rfc3526-group-14
+  const std::string _pHex{
+      "FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129024E088A67CC74020BBE"
+      "A63B139B22514A08798E3404DDEF9519B3CD3A431B302B0A6DF25F14374FE1356D6D51"
+      "C245E485B576625E7EC6F44C42E9A637ED6B0BFF5CB6F406B7EDEE386BFB5A899FA5AE"
+      "9F24117C4B1FE649286651ECE45B3DC2007CB8A163BF0598DA48361C55D39A69163FA8"
+      "FD24CF5F83655D23DCA3AD961C62F356208552BB9ED529077096966D670C354E4ABC98"
+      "04F1746C08CA18217C32905E462E36CE3BE39E772C180E86039B2783A2EC07A28FB5C5"
+      "5DF06F4C52C9DE2BCBF6955817183995497CEA956AE515D2261898FA051015728E5A8A"
+      "ACAA68FFFFFFFFFFFFFFFF"};
+  const std::string _gHex{"02"};
+  std::shared_ptr<const MyCryptoLibrary::FixedBaseExponentiation>
+      _fixedBaseExponentiation;
+};
+
+/**
+ * @test Test the correctness of the method exponentiate
+ * @brief Ensures that g^x mod p calculated with the precomputed table matches
+ * BN_mod_exp for random exponents of the size of p.
+ */
+TEST_F(FixedBaseExponentiationTest,
+       exponentiate_WithRandomExponents_ShouldMatchBnModExp) {
+  MessageExtractionFacility::UniqueBIGNUM p{
+      MessageExtractionFacility::hexToUniqueBIGNUM(_pHex)};
+  MessageExtractionFacility::UniqueBIGNUM exponent{BN_new()};
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_TRUE(BN_rand_range(exponent.get(), p.get()));
+    MessageExtractionFacility::UniqueBIGNUM result{
+        _fixedBaseExponentiation->exponentiate(exponent.get())};
+    EXPECT_EQ(BN_cmp(result.get(), referenceExponentiation(exponent.get()).get()),
+              0);
+  }
+}
+
+/**
+ * @test Test the correctness of the method exponentiate at the edges of the
+ * table
+ * @brief Ensures that the exponents 0, 1 and 2^maxExponentBits - 1 give the
+ * same result as BN_mod_exp.
+ */
+TEST_F(FixedBaseExponentiationTest,
+       exponentiate_WithEdgeExponents_ShouldMatchBnModExp) {
+  MessageExtractionFacility::UniqueBIGNUM exponent{BN_new()};
+  BN_zero(exponent.get());
+  EXPECT_TRUE(BN_is_one(
+      _fixedBaseExponentiation->exponentiate(exponent.get()).get()));
+  BN_one(exponent.get());
+  EXPECT_EQ(
+      MessageExtractionFacility::BIGNUMToHex(
+          _fixedBaseExponentiation->exponentiate(exponent.get()).get()),
+      "02");
+  // all the bits of the table set
+  BN_zero(exponent.get());
+  for (unsigned int bit = 0;
+       bit < _fixedBaseExponentiation->getMaxExponentBits(); ++bit) {
+    BN_set_bit(exponent.get(), static_cast<int>(bit));
+  }
+  EXPECT_EQ(BN_cmp(_fixedBaseExponentiation->exponentiate(exponent.get()).get(),
+                   referenceExponentiation(exponent.get()).get()),
+            0);
+}
+
+/**
+ * @test Test the fallback of the method exponentiate
+ * @brief Ensures that an exponent larger than the table still gives the
+ * correct result.
+ */
+TEST_F(FixedBaseExponentiationTest,
+       exponentiate_WithExponentLargerThanTable_ShouldMatchBnModExp) {
+  MessageExtractionFacility::UniqueBIGNUM exponent{BN_new()};
+  ASSERT_TRUE(BN_rand(exponent.get(),
+                      _fixedBaseExponentiation->getMaxExponentBits() + 64,
+                      BN_RAND_TOP_ONE, BN_RAND_BOTTOM_ANY));
+  EXPECT_EQ(BN_cmp(_fixedBaseExponentiation->exponentiate(exponent.get()).get(),
+                   referenceExponentiation(exponent.get()).get()),
+            0);
+}
+
+/**
+ * @test Test the method getInstance
+ * @brief Ensures that the table of a group is only built once.
+ */
+TEST_F(FixedBaseExponentiationTest, getInstance_SameGroup_ShouldBeShared) {
+  EXPECT_EQ(MyCryptoLibrary::FixedBaseExponentiation::getInstance(_pHex, _gHex),
+            _fixedBaseExponentiation);
+}
+
+/**
+ * @test Test the method getInstance from several threads
+ * @brief Ensures that the threads asking for the same group at the same time
+ * share one table.
+ */
+TEST_F(FixedBaseExponentiationTest,
+       getInstance_SameGroupFromSeveralThreads_ShouldBeShared) {
+  const std::string modulusHex{"C5"}, baseHex{"03"};
+  std::vector<std::shared_ptr<const MyCryptoLibrary::FixedBaseExponentiation>>
+      instances(8);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < instances.size(); ++i) {
+    threads.emplace_back([&, i]() {
+      instances[i] = MyCryptoLibrary::FixedBaseExponentiation::getInstance(
+          modulusHex, baseHex);
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (const auto &instance : instances) {
+    ASSERT_NE(instance, nullptr);
+    EXPECT_EQ(instance, instances[0]);
+  }
+}
+
+/**
+ * @test Test the method getInstance with an invalid group
+ * @brief Ensures that a failed build is reported to every caller and not
+ * cached as an empty engine.
+ */
+TEST_F(FixedBaseExponentiationTest,
+       getInstance_WithInvalidGroup_ShouldThrowOnEveryCall) {
+  EXPECT_THROW(
+      MyCryptoLibrary::FixedBaseExponentiation::getInstance("24", "05"),
+      std::invalid_argument);
+  EXPECT_THROW(
+      MyCryptoLibrary::FixedBaseExponentiation::getInstance("24", "05"),
+      std::invalid_argument);
+}
+
+/**
+ * @test Test the constructor with invalid parameters
+ * @brief Ensures that an even modulus or a base out of [2, p - 1] throw an
+ * error.
+ */
+TEST_F(FixedBaseExponentiationTest,
+       Constructor_WithInvalidParameters_ShouldThrowAnError) {
+  EXPECT_THROW(MyCryptoLibrary::FixedBaseExponentiation("24", "05"),
+               std::invalid_argument);
+  EXPECT_THROW(MyCryptoLibrary::FixedBaseExponentiation("25", "01"),
+               std::invalid_argument);
+  EXPECT_THROW(MyCryptoLibrary::FixedBaseExponentiation("25", "25"),
+               std::invalid_argument);
+}
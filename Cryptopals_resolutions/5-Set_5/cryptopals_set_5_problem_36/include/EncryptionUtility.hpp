@@ -9,6 +9,8 @@
 #include <memory>
 #include <openssl/bn.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -30,6 +32,13 @@ struct BnCtxDeleter {
   void operator()(BN_CTX *ctx) const noexcept { BN_CTX_free(ctx); }
 };
 
+/**
+ * @brief BN_MONT_CTX Custom deleter
+ */
+struct BnMontCtxDeleter {
+  void operator()(BN_MONT_CTX *mont) const noexcept { BN_MONT_CTX_free(mont); }
+};
+
 /**
  * @brief OpenSSLString deleter
  */
@@ -40,6 +49,7 @@ struct OpenSSLStringDeleter {
 // Type aliases for smart pointers
 using BnPtr = std::unique_ptr<BIGNUM, BnDeleter>;
 using BnCtxPtr = std::unique_ptr<BN_CTX, BnCtxDeleter>;
+using BnMontCtxPtr = std::unique_ptr<BN_MONT_CTX, BnMontCtxDeleter>;
 using OsslStr = std::unique_ptr<char, OpenSSLStringDeleter>;
 
 /**
@@ -121,6 +131,36 @@ using HashFn = std::function<std::string(const std::string &)>;
  */
 const std::unordered_map<std::string, HashFn> &getHashMap();
 
+/**
+ * @brief Provides a lookup table mapping string names to OpenSSL message
+ * digests.
+ *
+ * Keys are the same algorithm names as the ones of getHashMap(), the digests
+ * are used to hash binary buffers without converting them to text.
+ *
+ * @return A hash map mapping the string name of the hash to the OpenSSL
+ * message digest.
+ */
+const std::unordered_map<std::string, const EVP_MD *> &getDigestMap();
+
+/**
+ * @brief This method hashes the concatenation of several byte buffers.
+ *
+ * This method hashes the concatenation of several byte buffers, the buffers
+ * are fed one after the other to the digest so that they never need to be
+ * copied into a single buffer.
+ *
+ * @param hashName The hash algorithm to use (e.g., "SHA-256").
+ * @param parts The byte buffers to hash, in order.
+ *
+ * @return The raw digest of the concatenation of the buffers.
+ * @throws std::invalid_argument if the hash algorithm is not recognized.
+ * @throws std::runtime_error if the digest calculation fails.
+ */
+std::vector<uint8_t>
+hashBytes(const std::string &hashName,
+          std::initializer_list<std::span<const uint8_t>> parts);
+
 /**
  * @brief Get a map containing the minimum required salt size for various
  * cryptographic hash functions, in bytes.
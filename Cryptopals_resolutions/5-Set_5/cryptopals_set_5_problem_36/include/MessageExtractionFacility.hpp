@@ -81,6 +81,35 @@ UniqueBIGNUM hexToUniqueBIGNUM(const std::string &hexNumber);
  */
 std::string BIGNUMToHex(BIGNUM *bn);
 
+/**
+ * @brief This method will convert a number in a BIGNUM format to its big
+ * endian bytes.
+ *
+ * This method will convert a number in a BIGNUM format to its big endian
+ * bytes, left padded with zeros up to the given size. A number that needs
+ * more bytes than the given size is returned without padding.
+ *
+ * @param bn The number in a BIGNUM format.
+ * @param size The minimum amount of bytes of the result.
+ *
+ * @return The bytes of the number, big endian.
+ * @throws std::runtime_error if conversion fails.
+ */
+std::vector<unsigned char> BIGNUMToBytes(const BIGNUM *bn,
+                                         std::size_t size = 0);
+
+/**
+ * @brief This method will convert big endian bytes to an unique big number.
+ *
+ * This method will convert big endian bytes to an unique big number.
+ *
+ * @param bytes The bytes of the number, big endian.
+ *
+ * @return The number in an UniqueBIGNUM format.
+ * @throws std::runtime_error if conversion fails.
+ */
+UniqueBIGNUM bytesToUniqueBIGNUM(const std::vector<unsigned char> &bytes);
+
 /**
  * @brief This method will convert a number in a BIGNUM format to
  * a decimal format.
@@ -4,9 +4,12 @@
 #include <boost/uuid/uuid.hpp>
 #include <memory>
 #include <openssl/sha.h>
+#include <set>
+#include <utility>
 #include <vector>
 
 #include "EncryptionUtility.hpp"
+#include "FixedBaseExponentiation.hpp"
 #include "MessageExtractionFacility.hpp"
 #include "SrpParametersLoader.hpp"
 
@@ -14,6 +17,27 @@ namespace MyCryptoLibrary {
 
 class SecureRemotePassword {
 public:
+  /* public structures */
+
+  /**
+   * @brief This structure holds a SRP group ready to be used, it is built once
+   * per process and shared read only by every session.
+   *
+   * @param _parameters The public configuration of the group.
+   * @param _N The group prime N.
+   * @param _g The generator g.
+   * @param _k The multiplier parameter k = H(N | PAD(g)).
+   * @param _montgomeryContext The Montgomery context of N.
+   * @param _NHex The prime N, key of the FixedBaseExponentiation instance.
+   * @param _gHex The generator g, key of the FixedBaseExponentiation instance.
+   */
+  struct SrpGroup {
+    SrpParametersLoader::SrpParameters _parameters;
+    MessageExtractionFacility::UniqueBIGNUM _N, _g, _k;
+    EncryptionUtility::BnMontCtxPtr _montgomeryContext;
+    std::string _NHex, _gHex;
+  };
+
   /* constructor / destructor*/
 
   /**
@@ -108,6 +132,19 @@ public:
   const std::map<unsigned int, SrpParametersLoader::SrpParameters> &
   getSrpParametersMap() const;
 
+  /**
+   * @brief Returns the shared read only view of a SRP group.
+   *
+   * The groups are built once per process from the SRP parameters file, so
+   * the sessions do not parse N, g or k again.
+   *
+   * @param groupId The ID of the group.
+   * @return A constant reference to the group.
+   * @throw std::invalid_argument if the group ID is not in the SRP parameters
+   * file.
+   */
+  static const SrpGroup &getSrpGroup(const unsigned int groupId);
+
   /**
    * @brief This method will generate a private key.
    *
@@ -338,15 +375,274 @@ public:
                                        const std::string &MHex,
                                        const std::string &KHex);
 
+  /* binary API, the values stay as BIGNUMs or raw bytes between the steps
+   * of the protocol and are only converted to hexadecimal at the JSON
+   * boundary */
+
+  /**
+   * @brief This method will generate a private key.
+   *
+   * This method will generate a private key to be used at a SRP protocol.
+   * Requirements of the private key:
+   * - should be in the range [1, N-1];
+   * - should be at least minSizeBits;
+   *
+   * @param N The group prime N.
+   * @param minSizeBits The minimum amount of bits that the private key should
+   * have.
+   *
+   * @return The private key.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  generatePrivateKey(const BIGNUM *N, const unsigned int minSizeBits);
+
+  /**
+   * @brief Calculates the SRP public key (A or B).
+   *
+   * For the client: A = g^a mod N
+   * For the server: B = (k*v + g^b) mod N
+   *
+   * @param privateKey The private key (a or b).
+   * @param N The group prime N.
+   * @param g The generator g.
+   * @param isServer If true, computes B (server); if false, computes A
+   * (client).
+   * @param k Optional: the SRP multiplier parameter (required for B).
+   * @param v Optional: the verifier v (required for B).
+   * @return The public key (A or B).
+   * @throws std::runtime_error if constraints are not met.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  calculatePublicKey(const BIGNUM *privateKey, const BIGNUM *N,
+                     const BIGNUM *g, bool isServer, const BIGNUM *k = nullptr,
+                     const BIGNUM *v = nullptr);
+
+  /**
+   * @brief This method does the validation of the public key.
+   *
+   * This method does the validation of the public key. It enforces:
+   * 1 < public key < N
+   *
+   * @param publicKey The public key (A or B).
+   * @param N The group prime N.
+   * @return True if the validation passes, false otherwise.
+   */
+  static bool validatePublicKey(const BIGNUM *publicKey, const BIGNUM *N);
+
+  /**
+   * @brief This method will perform the calculation v = g^x mod N.
+   *
+   * @param x The value of x.
+   * @param N The value of the large prime N.
+   * @param g The value of the generator g.
+   *
+   * @return The result of v = g^x mod N.
+   * @throw std::runtime_error if the calculation fails.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  calculateV(const BIGNUM *x, const BIGNUM *N, const BIGNUM *g);
+
+  /**
+   * @brief Calculates the SRP scrambling parameter u = H(PAD(A) | PAD(B))
+   * according to RFC 5054.
+   *
+   * @param hashName The hash algorithm to use (e.g., "SHA-256").
+   * @param A The client's public key A.
+   * @param B The server's public key B.
+   * @param N The group prime N.
+   * @return The computed u value.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  calculateU(const std::string &hashName, const BIGNUM *A, const BIGNUM *B,
+             const BIGNUM *N);
+
+  /**
+   * @brief Calculates the SRP private key 'x' according to RFC 5054.
+   *
+   * RFC 5054 formula:
+   *   x = H(salt | H(username | ":" | password))
+   *
+   * @param hashName The hash algorithm to use (e.g., "SHA-256").
+   * @param username The username in plaintext.
+   * @param password The password in plaintext.
+   * @param salt The salt value, as raw bytes.
+   * @return The computed 'x' value.
+   * @throws std::invalid_argument if any input is empty or unsupported hash is
+   * specified.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  calculateX(const std::string &hashName, const std::string &username,
+             const std::string &password, const std::vector<uint8_t> &salt);
+
+  /**
+   * @brief This method calculates the session key S for the client in the SRP
+   * protocol.
+   *
+   * Formula: S = (B - k * g^x) ^ (a + u * x) mod N
+   *
+   * @param B The server's public key B.
+   * @param k The SRP multiplier parameter k.
+   * @param g The SRP generator.
+   * @param x The client's private value x.
+   * @param a The client's private key a.
+   * @param u The SRP scrambling parameter u.
+   * @param N The SRP modulus N.
+   * @return The session key S.
+   * @throw std::runtime_error if any of the calculations fail.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  calculateSClient(const BIGNUM *B, const BIGNUM *k, const BIGNUM *g,
+                   const BIGNUM *x, const BIGNUM *a, const BIGNUM *u,
+                   const BIGNUM *N);
+
+  /**
+   * @brief Calculates the SRP shared secret S for the server side.
+   *
+   * Formula: S = (A * v^u) ^ b mod N
+   *
+   * @param A The client's public key A.
+   * @param v The verifier v.
+   * @param u The scrambling parameter u.
+   * @param b The server's private key b.
+   * @param N The modulus N.
+   * @return The shared secret S.
+   * @throw std::runtime_error if any of the calculations fail.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  calculateSServer(const BIGNUM *A, const BIGNUM *v, const BIGNUM *u,
+                   const BIGNUM *b, const BIGNUM *N);
+
+  /**
+   * @brief This method calculates the session key K for the client in the
+   * SRP protocol.
+   *
+   * Formula: K = H(S)
+   *
+   * @param hash The hash algorithm (e.g., "SHA-256").
+   * @param S The shared secret.
+   * @return The session key K, as raw bytes.
+   * @throw std::runtime_error if any of the calculations fail.
+   */
+  static std::vector<uint8_t> calculateK(const std::string &hash,
+                                         const BIGNUM *S);
+
+  /**
+   * @brief This method calculates the SRP M value (message authentication code)
+   * for the client.
+   *
+   * Formula: H(H(N) XOR H(g) | H(U) | s | A | B | K)
+   * The numbers N, g, A and B are hashed as their big endian bytes.
+   *
+   * @param hashName The hash algorithm to use (e.g., "SHA-256").
+   * @param N The modulus N.
+   * @param g The generator g.
+   * @param username The username.
+   * @param salt The salt, as raw bytes.
+   * @param A The client's public key A.
+   * @param B The server's public key B.
+   * @param K The session key K, as raw bytes.
+   * @return The computed M value, as raw bytes.
+   * @throw std::runtime_error if any of the calculations fail.
+   */
+  static std::vector<uint8_t>
+  calculateM(const std::string &hashName, const BIGNUM *N, const BIGNUM *g,
+             const std::string &username, const std::vector<uint8_t> &salt,
+             const BIGNUM *A, const BIGNUM *B, const std::vector<uint8_t> &K);
+
+  /**
+   * @brief Calculates the SRP server proof M2 = H(A | M | K) according to RFC
+   * 5054.
+   *
+   * @param hashName The hash algorithm to use (e.g., "SHA-256").
+   * @param A The client's public key A.
+   * @param M The client proof M, as raw bytes.
+   * @param K The session key K, as raw bytes.
+   * @return The computed M2 value, as raw bytes.
+   */
+  static std::vector<uint8_t> calculateM2(const std::string &hashName,
+                                          const BIGNUM *A,
+                                          const std::vector<uint8_t> &M,
+                                          const std::vector<uint8_t> &K);
+
 private:
+  /* private methods */
+
+  /**
+   * @brief Converts a digest kept as a BIGNUM back to hexadecimal format.
+   *
+   * The leading zero bytes of the digest are restored, so the result has the
+   * fixed size of the digests of the hash algorithm.
+   *
+   * @param hashName The hash algorithm of the digest (e.g., "SHA-256").
+   * @param digest The digest.
+   * @return The digest as an uppercase hexadecimal string.
+   */
+  static std::string digestToHex(const std::string &hashName,
+                                 const BIGNUM *digest);
+
+  /**
+   * @brief Builds the groups of the SRP parameters file.
+   *
+   * @return A map from group ID to the group, with N, g and k as BIGNUMs and
+   * the Montgomery context of N.
+   * @throw std::runtime_error if an OpenSSL operation fails.
+   */
+  static std::map<unsigned int, SrpGroup> loadSrpGroups();
+
+  /**
+   * @brief Finds the group of the SRP parameters file with a given prime.
+   *
+   * @param N The group prime N.
+   * @return The group, or nullptr if N is not the prime of any group.
+   */
+  static const SrpGroup *findSrpGroup(const BIGNUM *N);
+
+  /**
+   * @brief Calculates base^exponent mod N.
+   *
+   * The primes of the SRP parameters file reuse the Montgomery context of
+   * their group instead of building one per call.
+   *
+   * @param result The result of base^exponent mod N.
+   * @param base The base.
+   * @param exponent The exponent.
+   * @param N The modulus N.
+   * @param ctx The BIGNUM context.
+   * @return True if the calculation succeeded, false otherwise.
+   */
+  static bool modularExponentiation(BIGNUM *result, const BIGNUM *base,
+                                    const BIGNUM *exponent, const BIGNUM *N,
+                                    BN_CTX *ctx);
+
+  /**
+   * @brief Calculates g^exponent mod N.
+   *
+   * The groups of the SRP parameters file use the precomputed powers of g of
+   * FixedBaseExponentiation, shared by every call. Any other N and g, e.g.
+   * received from a peer, use BN_mod_exp so that no table is built for them.
+   *
+   * @param g The generator g.
+   * @param exponent The exponent.
+   * @param N The group prime N.
+   * @param ctx The BIGNUM context used by BN_mod_exp.
+   * @return The result of g^exponent mod N.
+   * @throw std::runtime_error if the calculation fails.
+   */
+  static MessageExtractionFacility::UniqueBIGNUM
+  powerOfGenerator(const BIGNUM *g, const BIGNUM *exponent, const BIGNUM *N,
+                   BN_CTX *ctx);
+
   bool _debugFlag;
   static const std::string _srpParametersFilename;
-  std::map<unsigned int, SrpParametersLoader::SrpParameters> _srpParametersMap;
+  // shared by every instance, the file is parsed only once per process
+  const std::map<unsigned int, SrpParametersLoader::SrpParameters>
+      &_srpParametersMap;
   unsigned int _groupId{0};
   static const unsigned int _minSizePrivateKey;
   static std::unordered_map<std::string, EncryptionUtility::HashFn> _hashMap;
   static const std::map<unsigned int, MessageExtractionFacility::UniqueBIGNUM>
       _kMap;
+  static const std::map<unsigned int, SrpGroup> _srpGroups;
 };
 
 } // namespace MyCryptoLibrary
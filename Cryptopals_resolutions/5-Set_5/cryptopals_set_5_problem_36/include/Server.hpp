@@ -5,6 +5,8 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <memory>
+#include <mutex>
 #include <openssl/aes.h>
 #include <vector>
 
@@ -164,6 +166,19 @@ private:
    */
   void handleAuthenticationComplete();
 
+  /**
+   * @brief This method returns the session of a client ID.
+   *
+   * This method returns the session of a client ID, the session map lock is
+   * only held during the lookup. The session returned stays valid even if it
+   * is removed from the map afterwards.
+   *
+   * @param clientId The client ID of the session.
+   *
+   * @return The session of the client ID, or nullptr if there is none.
+   */
+  std::shared_ptr<SessionData> findSession(const std::string &clientId) const;
+
   /**
    * @brief This method perform the validation of the extracted v parameter
    * at the registration step.
@@ -172,11 +187,13 @@ private:
    * at the registration step, it will test if v ∈ [1, N-1].
    *
    * @param clientId The clientId involved in this registration step.
-   * @param vHex The v parameter in hexadecimal format.
+   * @param v The v parameter.
+   * @param N The group prime N of the session of the client.
    *
    * @return True if the validation passes, false otherwise.
    */
-  bool vValidation(const std::string &clientId, const std::string &vHex);
+  bool vValidation(const std::string &clientId, const BIGNUM *v,
+                   const BIGNUM *N) const;
 
   /**
    * @brief This method runs the route that provides the list of registered
@@ -190,8 +207,10 @@ private:
   /* private fields */
   crow::SimpleApp _app;
 
+  // Only guards the lookups and the insertions in the map, each session has its
+  // own mutex for its data
   mutable std::mutex _secureRemotePasswordMapMutex;
-  std::map<std::string, std::unique_ptr<SessionData>> _secureRemotePasswordMap;
+  std::map<std::string, std::shared_ptr<SessionData>> _secureRemotePasswordMap;
 
   const int _portProduction{18080};
   const int _portTest{18081};
@@ -1,12 +1,30 @@
 #ifndef SESSION_DATA_HPP
 #define SESSION_DATA_HPP
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "EncryptionUtility.hpp"
+#include "MessageExtractionFacility.hpp"
 #include "SecureRemotePassword.hpp"
 #include "SrpParametersLoader.hpp"
 
 struct SessionData {
 
+  /**
+   * @brief Steps of the Secure Remote Password protocol reached by a session.
+   *
+   * A session only moves forward through these states, each step of the
+   * protocol checks the state it expects before using the session data.
+   */
+  enum class State {
+    RegistrationStarted,   // salt sent, waiting for v
+    Registered,            // v stored
+    AuthenticationStarted, // b and B generated, waiting for A and M
+    Authenticated          // M verified and M2 sent
+  };
+
   /**
    * @brief This method will execute the constructor of the SessionData
    * structure.
@@ -36,20 +54,31 @@ struct SessionData {
 
   std::unique_ptr<MyCryptoLibrary::SecureRemotePassword> _secureRemotePassword;
   unsigned int _groupId;
-  std::string _salt; // hexadecimal format
+  std::string _salt;               // hexadecimal format
+  std::vector<uint8_t> _saltBytes; // the salt as raw bytes
   std::string _hash; // (e.g., "SHA-1", "SHA-256", "SHA-384", "SHA-512").
   std::string _password;
-  std::string _vHex;                 // Store the verifier v in hex format
-  bool _registrationComplete{false}; // Indicates if registration is finished
-  std::string _privateKeyHex;
-  std::string _publicKeyHex;
-  std::string _peerPublicKeyHex;
-  std::string _uHex;
-  std::string _xHex;
-  std::string _SHex;
-  std::string _KHex;
-  std::string _MHex;
-  std::string _M2Hex;
+  // The values of the protocol are kept as BIGNUMs and raw bytes, they are
+  // only converted to hexadecimal when they are sent or received in JSON
+  MessageExtractionFacility::UniqueBIGNUM _v; // the verifier v
+  MessageExtractionFacility::UniqueBIGNUM _privateKey;
+  MessageExtractionFacility::UniqueBIGNUM _publicKey;
+  MessageExtractionFacility::UniqueBIGNUM _peerPublicKey;
+  MessageExtractionFacility::UniqueBIGNUM _u;
+  MessageExtractionFacility::UniqueBIGNUM _x;
+  MessageExtractionFacility::UniqueBIGNUM _S;
+  std::vector<uint8_t> _K;
+  std::vector<uint8_t> _M;
+  std::vector<uint8_t> _M2;
+
+  // Guards the state, the version and the fields above once the session is
+  // shared, it is only held to copy or to publish them, never while the big
+  // number calculations of a step are running
+  mutable std::mutex _mutex;
+  State _state{State::RegistrationStarted};
+  // Incremented every time a step publishes its results, a step only publishes
+  // if the version is still the one it read before its calculations
+  unsigned long _version{0};
 };
 
 #endif // SESSION_DATA_HPP
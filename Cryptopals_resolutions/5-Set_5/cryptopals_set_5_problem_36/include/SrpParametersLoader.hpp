@@ -30,6 +30,21 @@ struct SrpParameters {
 std::map<unsigned int, SrpParameters>
 loadSrpParameters(const std::string &filename);
 
+/**
+ * @brief This method returns the public configurations of a given file.
+ *
+ * The file is only read and parsed the first time it is requested, the
+ * result is kept for the lifetime of the process. It is safe to call this
+ * method from several threads.
+ *
+ * @param filename The file address where the public configurations of
+ * the Secure Remote Password protocol are.
+ *
+ * @return The file content in a structured dictionary.
+ */
+const std::map<unsigned int, SrpParameters> &
+getSrpParameters(const std::string &filename);
+
 }; // namespace SrpParametersLoader
 
 #endif // SRP_PARAMETERS_LOADER_HPP
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <fmt/core.h>
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include <openssl/crypto.h>
 #include <openssl/rand.h>
 
 #include "./../include/Client.hpp"
@@ -37,7 +38,7 @@ Client::Client(const std::string &clientId, const bool debugFlag)
                              "Client ID is null.");
   }
   _srpParametersMap =
-      SrpParametersLoader::loadSrpParameters(_srpParametersFilename);
+      SrpParametersLoader::getSrpParameters(_srpParametersFilename);
 }
 /******************************************************************************/
 Client::~Client() {}
@@ -185,7 +186,8 @@ const bool Client::authentication(const int portServerNumber) {
                                "Invalid port server number used.");
     }
     // check if the registration was already done
-    if (!_sessionData || !_sessionData->_registrationComplete) {
+    if (!_sessionData ||
+        _sessionData->_state == SessionData::State::RegistrationStarted) {
       throw std::runtime_error("Client log | authentication(): "
                                "Registration is not completed.");
     }
@@ -348,23 +350,30 @@ const bool Client::registrationComplete(const int portServerNumber,
                 << std::endl;
     }
     // x calculation
-    const std::string xHex{MyCryptoLibrary::SecureRemotePassword::calculateX(
-        _sessionData->_hash, _clientId, _sessionData->_password,
-        _sessionData->_salt)};
+    MessageExtractionFacility::UniqueBIGNUM x{
+        MyCryptoLibrary::SecureRemotePassword::calculateX(
+            _sessionData->_hash, _clientId, _sessionData->_password,
+            _sessionData->_saltBytes)};
     if (_debugFlag) {
       std::cout
           << "\n--- Client log | Password derived secret x generated at the "
              "registration phase---"
           << std::endl;
       std::cout << "\tClient ID: " << _clientId << std::endl;
-      std::cout << "\tx(hex) = H(salt | H(username |:| password)) '" << xHex
-                << "'." << std::endl;
+      std::cout << "\tx(hex) = H(salt | H(username |:| password)) '"
+                << MessageExtractionFacility::BIGNUMToHex(x.get()) << "'."
+                << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     // v calculation
-    std::string vHex = MyCryptoLibrary::SecureRemotePassword::calculateV(
-        xHex, _srpParametersMap.at(groupId)._nHex,
-        _srpParametersMap.at(groupId)._g);
+    const MyCryptoLibrary::SecureRemotePassword::SrpGroup &group{
+        MyCryptoLibrary::SecureRemotePassword::getSrpGroup(groupId)};
+    const BIGNUM *N{group._N.get()};
+    const BIGNUM *g{group._g.get()};
+    MessageExtractionFacility::UniqueBIGNUM v{
+        MyCryptoLibrary::SecureRemotePassword::calculateV(x.get(), N, g)};
+    // v is only converted to hexadecimal to be sent to the server
+    const std::string vHex{MessageExtractionFacility::BIGNUMToHex(v.get())};
     if (_debugFlag) {
       std::cout << "v(hex) = g^x mod N ='" << vHex << "'." << std::endl;
     }
@@ -406,7 +415,7 @@ const bool Client::registrationComplete(const int portServerNumber,
           _serverConfirmationMessage + "'.");
     }
     // mark the registration step as complete at this point
-    _sessionData->_registrationComplete = true;
+    _sessionData->_state = SessionData::State::Registered;
     return registrationCompleteResult;
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
@@ -474,62 +483,72 @@ const bool Client::authenticationInit(const int portServerNumber) {
       throw std::runtime_error(
           "Client log | authenticationInit(): "
           "Group ID received from the server doesn't match session's one.");
-    } else if (!MyCryptoLibrary::SecureRemotePassword::validatePublicKey(
-                   extractedBHex, _srpParametersMap[extractedGroupId]._nHex)) {
+    }
+    // the values received are converted once, the calculations below only
+    // use BIGNUMs and raw bytes
+    const MyCryptoLibrary::SecureRemotePassword::SrpGroup &group{
+        MyCryptoLibrary::SecureRemotePassword::getSrpGroup(extractedGroupId)};
+    const BIGNUM *N{group._N.get()};
+    const BIGNUM *g{group._g.get()};
+    MessageExtractionFacility::UniqueBIGNUM B{
+        MessageExtractionFacility::hexToUniqueBIGNUM(extractedBHex)};
+    if (!MyCryptoLibrary::SecureRemotePassword::validatePublicKey(B.get(), N)) {
       throw std::runtime_error("Client log | authenticationInit(): "
                                "Server public key failed the verification.");
     }
     // store of B server's public key
-    _sessionData->_peerPublicKeyHex = extractedBHex;
+    _sessionData->_peerPublicKey = std::move(B);
     // private key generation
     const unsigned int minPrivateKeyBits =
         _sessionData->_secureRemotePassword->getMinSizePrivateKey();
-    _sessionData->_privateKeyHex =
+    _sessionData->_privateKey =
         MyCryptoLibrary::SecureRemotePassword::generatePrivateKey(
-            _srpParametersMap.at(extractedGroupId)._nHex, minPrivateKeyBits);
+            N, minPrivateKeyBits);
     if (_debugFlag) {
       std::cout << "\n--- Client log | Private key generated at the "
                    "authentication phase---"
                 << std::endl;
       std::cout << "\tClient ID: " << extractedClientId << std::endl;
-      std::cout << "\tPrivate key: " << _sessionData->_privateKeyHex
+      std::cout << "\tPrivate key: "
+                << MessageExtractionFacility::BIGNUMToHex(
+                       _sessionData->_privateKey.get())
                 << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     // public key generation
-    _sessionData->_publicKeyHex =
+    _sessionData->_publicKey =
         MyCryptoLibrary::SecureRemotePassword::calculatePublicKey(
-            _sessionData->_privateKeyHex,
-            _srpParametersMap.at(extractedGroupId)._nHex,
-            MessageExtractionFacility::uintToHex(
-                _srpParametersMap[extractedGroupId]._g),
-            Client::getIsServerFlag());
+            _sessionData->_privateKey.get(), N, g, Client::getIsServerFlag());
     if (_debugFlag) {
       std::cout << "\n--- Client log | Public key generated at the "
                    "authentication phase---"
                 << std::endl;
       std::cout << "\tClient ID: " << extractedClientId << std::endl;
-      std::cout << "\tPublic key: " << _sessionData->_publicKeyHex << std::endl;
+      std::cout << "\tPublic key: "
+                << MessageExtractionFacility::BIGNUMToHex(
+                       _sessionData->_publicKey.get())
+                << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     // u calculation
-    _sessionData->_uHex = MyCryptoLibrary::SecureRemotePassword::calculateU(
-        _srpParametersMap.at(extractedGroupId)._hashName,
-        _sessionData->_publicKeyHex, _sessionData->_peerPublicKeyHex,
-        _srpParametersMap.at(extractedGroupId)._nHex);
+    _sessionData->_u = MyCryptoLibrary::SecureRemotePassword::calculateU(
+        group._parameters._hashName, _sessionData->_publicKey.get(),
+        _sessionData->_peerPublicKey.get(), N);
     if (_debugFlag) {
       std::cout << "\n--- Client log | Scrambling parameter u generated at the "
                    "authentication phase---"
                 << std::endl;
       std::cout << "\tClient ID: " << extractedClientId << std::endl;
-      std::cout << "\tu = H(PAD(A) | PAD(B)): " << _sessionData->_uHex
+      std::cout << "\tu = H(PAD(A) | PAD(B)): "
+                << MessageExtractionFacility::BIGNUMToHex(
+                       _sessionData->_u.get())
                 << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     // x calculation
-    _sessionData->_xHex = MyCryptoLibrary::SecureRemotePassword::calculateX(
+    _sessionData->_x = MyCryptoLibrary::SecureRemotePassword::calculateX(
         _sessionData->_hash, _clientId, _sessionData->_password,
-        _sessionData->_salt);
+        _sessionData->_saltBytes);
     if (_debugFlag) {
       std::cout
           << "\n--- Client log | Password derived secret x generated at the "
@@ -537,48 +556,39 @@ const bool Client::authenticationInit(const int portServerNumber) {
           << std::endl;
       std::cout << "\tClient ID: " << extractedClientId << std::endl;
       std::cout << "\tx(hex) = H(salt | H(username |:| password)) '"
-                << _sessionData->_xHex << "'." << std::endl;
+                << MessageExtractionFacility::BIGNUMToHex(
+                       _sessionData->_x.get())
+                << "'." << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     // S calculation
-    const std::string BHex{_sessionData->_peerPublicKeyHex};
-    const std::string kHex{MessageExtractionFacility::BIGNUMToHex(
-        MyCryptoLibrary::SecureRemotePassword::getKMap()
-            .at(_sessionData->_groupId)
-            .get())};
-    const unsigned int g{
-        _sessionData->_secureRemotePassword->getSrpParametersMap()
-            .at(_sessionData->_groupId)
-            ._g};
-    const std::string xHex{_sessionData->_xHex};
-    const std::string aHex{_sessionData->_privateKeyHex};
-    const std::string uHex{_sessionData->_uHex};
-    const std::string nHex{
-        _sessionData->_secureRemotePassword->getSrpParametersMap()
-            .at(_sessionData->_groupId)
-            ._nHex};
-    _sessionData->_SHex =
-        MyCryptoLibrary::SecureRemotePassword::calculateSClient(
-            BHex, kHex, g, xHex, aHex, uHex, nHex);
+    _sessionData->_S = MyCryptoLibrary::SecureRemotePassword::calculateSClient(
+        _sessionData->_peerPublicKey.get(), group._k.get(), g,
+        _sessionData->_x.get(), _sessionData->_privateKey.get(),
+        _sessionData->_u.get(), N);
     if (_debugFlag) {
       std::cout
           << "\n--- Client log | Password shared secret S generated at the "
              "authentication phase---"
           << std::endl;
       std::cout << "\tClient ID: " << extractedClientId << std::endl;
-      std::cout << "\tS(hex): '" << _sessionData->_SHex << "'." << std::endl;
+      std::cout << "\tS(hex): '"
+                << MessageExtractionFacility::BIGNUMToHex(
+                       _sessionData->_S.get())
+                << "'." << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     // K calculation
-    _sessionData->_KHex = MyCryptoLibrary::SecureRemotePassword::calculateK(
-        _sessionData->_hash, _sessionData->_SHex);
+    _sessionData->_K = MyCryptoLibrary::SecureRemotePassword::calculateK(
+        _sessionData->_hash, _sessionData->_S.get());
     if (_debugFlag) {
       std::cout << "\n--- Client log | Session key K generated at the "
                    "authentication phase---"
                 << std::endl;
       std::cout << "\tClient ID: " << extractedClientId << std::endl;
-      std::cout << "\tK(hex) = H(S): '" << _sessionData->_KHex << "'."
-                << std::endl;
+      std::cout << "\tK(hex) = H(S): '"
+                << MessageExtractionFacility::toHexString(_sessionData->_K)
+                << "'." << std::endl;
       std::cout << "----------------------" << std::endl;
     }
     return authenticationInitResult;
@@ -610,12 +620,20 @@ const bool Client::authenticationComplete(const int portServerNumber) {
   bool authenticationCompleteResult{true};
   try {
     // M calculation
-    const std::string MHex{MyCryptoLibrary::SecureRemotePassword::calculateM(
-        _sessionData->_hash, _srpParametersMap.at(_sessionData->_groupId)._nHex,
-        MessageExtractionFacility::uintToHex(
-            _srpParametersMap.at(_sessionData->_groupId)._g),
-        _clientId, _sessionData->_salt, _sessionData->_publicKeyHex,
-        _sessionData->_peerPublicKeyHex, _sessionData->_KHex)};
+    const MyCryptoLibrary::SecureRemotePassword::SrpGroup &group{
+        MyCryptoLibrary::SecureRemotePassword::getSrpGroup(
+            _sessionData->_groupId)};
+    const BIGNUM *N{group._N.get()};
+    const BIGNUM *g{group._g.get()};
+    _sessionData->_M = MyCryptoLibrary::SecureRemotePassword::calculateM(
+        _sessionData->_hash, N, g, _clientId, _sessionData->_saltBytes,
+        _sessionData->_publicKey.get(), _sessionData->_peerPublicKey.get(),
+        _sessionData->_K);
+    // M and A are only converted to hexadecimal to be sent to the server
+    const std::string MHex{
+        MessageExtractionFacility::toHexString(_sessionData->_M)};
+    const std::string AHex{
+        MessageExtractionFacility::BIGNUMToHex(_sessionData->_publicKey.get())};
     if (_debugFlag) {
       std::cout << "\n--- Client log | Verification value M generated at the "
                    "authentication phase---"
@@ -624,14 +642,13 @@ const bool Client::authenticationComplete(const int portServerNumber) {
       std::cout << "\tM(hex): '" << MHex << "'." << std::endl;
       std::cout << "----------------------" << std::endl;
     }
-    _sessionData->_MHex = MHex;
     std::string requestBody = fmt::format(
         R"({{
         "clientId": "{}",
         "M": "{}",
         "A": "{}"
     }})",
-        getClientId(), MHex, _sessionData->_publicKeyHex);
+        getClientId(), MHex, AHex);
     cpr::Response response =
         cpr::Post(cpr::Url{std::string("http://localhost:") +
                            std::to_string(portServerNumber) +
@@ -646,21 +663,27 @@ const bool Client::authenticationComplete(const int portServerNumber) {
                                "authentication failed");
     }
     nlohmann::json parsedJson = nlohmann::json::parse(response.text);
-    const std::string extractedM2Hex{parsedJson.at("M2").get<std::string>()};
+    const std::vector<uint8_t> extractedM2{
+        MessageExtractionFacility::hexToBytes(
+            parsedJson.at("M2").get<std::string>())};
     // M2 confirmation on the client side
-    _sessionData->_M2Hex = MyCryptoLibrary::SecureRemotePassword::calculateM2(
+    _sessionData->_M2 = MyCryptoLibrary::SecureRemotePassword::calculateM2(
         _sessionData->_hash,
-        _sessionData->_publicKeyHex, // A
-        _sessionData->_MHex, _sessionData->_KHex);
+        _sessionData->_publicKey.get(), // A
+        _sessionData->_M, _sessionData->_K);
     if (_debugFlag) {
       std::cout << "\n--- Client log | Verification value M2 generated at the "
                    "authentication phase---"
                 << std::endl;
       std::cout << "\tClient ID: " << _clientId << std::endl;
-      std::cout << "\tM2(hex): '" << _sessionData->_M2Hex << "'." << std::endl;
+      std::cout << "\tM2(hex): '"
+                << MessageExtractionFacility::toHexString(_sessionData->_M2)
+                << "'." << std::endl;
       std::cout << "----------------------" << std::endl;
     }
-    if (_sessionData->_M2Hex != extractedM2Hex) {
+    if (_sessionData->_M2.size() != extractedM2.size() ||
+        CRYPTO_memcmp(_sessionData->_M2.data(), extractedM2.data(),
+                      extractedM2.size()) != 0) {
       throw std::runtime_error("Client log | authenticationComplete(): "
                                "M2 from the client and server don't match");
     }
@@ -203,6 +203,71 @@ EncryptionUtility::getHashMap() {
   return table;
 }
 /******************************************************************************/
+/**
+ * @brief Provides a lookup table mapping string names to OpenSSL message
+ * digests.
+ *
+ * Keys are the same algorithm names as the ones of getHashMap(), the digests
+ * are used to hash binary buffers without converting them to text.
+ *
+ * @return A hash map mapping the string name of the hash to the OpenSSL
+ * message digest.
+ */
+const std::unordered_map<std::string, const EVP_MD *> &
+EncryptionUtility::getDigestMap() {
+  static const std::unordered_map<std::string, const EVP_MD *> table = {
+      {"SHA-1", EVP_sha1()},
+      {"SHA-256", EVP_sha256()},
+      {"SHA-384", EVP_sha384()},
+      {"SHA-512", EVP_sha512()}};
+  return table;
+}
+/******************************************************************************/
+/**
+ * @brief This method hashes the concatenation of several byte buffers.
+ *
+ * This method hashes the concatenation of several byte buffers, the buffers
+ * are fed one after the other to the digest so that they never need to be
+ * copied into a single buffer.
+ *
+ * @param hashName The hash algorithm to use (e.g., "SHA-256").
+ * @param parts The byte buffers to hash, in order.
+ *
+ * @return The raw digest of the concatenation of the buffers.
+ * @throws std::invalid_argument if the hash algorithm is not recognized.
+ * @throws std::runtime_error if the digest calculation fails.
+ */
+std::vector<uint8_t> EncryptionUtility::hashBytes(
+    const std::string &hashName,
+    std::initializer_list<std::span<const uint8_t>> parts) {
+  const auto &digestMap{getDigestMap()};
+  const auto it{digestMap.find(hashName)};
+  if (it == digestMap.end()) {
+    throw std::invalid_argument("EncryptionUtility log | hashBytes(): "
+                                "hash algorithm not recognized.");
+  }
+  std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> ctx(
+      EVP_MD_CTX_new(), EVP_MD_CTX_free);
+  if (!ctx || EVP_DigestInit_ex(ctx.get(), it->second, nullptr) != 1) {
+    throw std::runtime_error("EncryptionUtility log | hashBytes(): "
+                             "Failed to initialize the digest.");
+  }
+  for (const std::span<const uint8_t> &part : parts) {
+    if (EVP_DigestUpdate(ctx.get(), part.data(), part.size()) != 1) {
+      throw std::runtime_error("EncryptionUtility log | hashBytes(): "
+                               "EVP_DigestUpdate failed.");
+    }
+  }
+  std::vector<uint8_t> digest(EVP_MD_get_size(it->second));
+  unsigned int length{0};
+  if (EVP_DigestFinal_ex(ctx.get(), digest.data(), &length) != 1) {
+    throw std::runtime_error("EncryptionUtility log | hashBytes(): "
+                             "EVP_DigestFinal_ex failed.");
+  }
+  digest.resize(length);
+  return digest;
+}
+/******************************************************************************/
 /**
  * @brief Get a map containing the minimum required salt size for various
  * cryptographic hash functions, in bytes.
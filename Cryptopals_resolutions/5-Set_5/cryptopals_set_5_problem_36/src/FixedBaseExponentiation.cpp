@@ -0,0 +1,241 @@
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "./../include/FixedBaseExponentiation.hpp"
+
+/* constructor / destructor */
+
+/**
+ * @brief This method will execute the constructor of the
+ * FixedBaseExponentiation object.
+ *
+ * This method precomputes, in Montgomery form, every power
+ * base^(j * 2^(windowBits * i)) mod modulus with 0 <= j < 2^windowBits, for
+ * all the windows of an exponent with as many bits as the modulus.
+ *
+ * @param modulusHex The odd modulus, in hexadecimal format.
+ * @param baseHex The fixed base, in hexadecimal format.
+ *
+ * @throws std::invalid_argument if the modulus is not odd or greater than
+ * one, or if the base is not in [2, modulus - 1].
+ * @throws std::runtime_error if an OpenSSL operation fails.
+ */
+MyCryptoLibrary::FixedBaseExponentiation::FixedBaseExponentiation(
+    const std::string &modulusHex, const std::string &baseHex)
+    : _modulus{MessageExtractionFacility::hexToUniqueBIGNUM(modulusHex)},
+      _base{MessageExtractionFacility::hexToUniqueBIGNUM(baseHex)},
+      _montgomeryContext{BN_MONT_CTX_new()} {
+  if (!BN_is_odd(_modulus.get()) || BN_is_one(_modulus.get())) {
+    throw std::invalid_argument("Fixed Base Exponentiation log | "
+                                "constructor(): modulus must be odd and "
+                                "greater than one.");
+  }
+  if (BN_cmp(_base.get(), BN_value_one()) <= 0 ||
+      BN_cmp(_base.get(), _modulus.get()) >= 0) {
+    throw std::invalid_argument("Fixed Base Exponentiation log | "
+                                "constructor(): base must be in "
+                                "[2, modulus - 1].");
+  }
+  std::unique_ptr<BN_CTX, BN_CTX_deleter> ctx{BN_CTX_new()};
+  if (!ctx || !_montgomeryContext ||
+      !BN_MONT_CTX_set(_montgomeryContext.get(), _modulus.get(), ctx.get())) {
+    throw std::runtime_error("Fixed Base Exponentiation log | constructor(): "
+                             "Failed to create the Montgomery context.");
+  }
+  const unsigned int modulusBits = BN_num_bits(_modulus.get());
+  _windows = (modulusBits + _windowBits - 1) / _windowBits;
+  _entryWords = (BN_num_bytes(_modulus.get()) + sizeof(uint64_t) - 1) /
+                sizeof(uint64_t);
+  _table.resize(static_cast<std::size_t>(_windows) * _entriesPerWindow *
+                _entryWords);
+  // windowBase = base^(2^(windowBits * i)), power = windowBase^j, both in
+  // Montgomery form
+  MessageExtractionFacility::UniqueBIGNUM windowBase{BN_new()};
+  MessageExtractionFacility::UniqueBIGNUM power{BN_new()};
+  MessageExtractionFacility::UniqueBIGNUM montgomeryOne{BN_new()};
+  if (!windowBase || !power || !montgomeryOne ||
+      !BN_to_montgomery(windowBase.get(), _base.get(),
+                        _montgomeryContext.get(), ctx.get()) ||
+      !BN_to_montgomery(montgomeryOne.get(), BN_value_one(),
+                        _montgomeryContext.get(), ctx.get())) {
+    throw std::runtime_error("Fixed Base Exponentiation log | constructor(): "
+                             "Failed to convert the base to Montgomery form.");
+  }
+  const int entryBytes = static_cast<int>(_entryWords * sizeof(uint64_t));
+  for (unsigned int window = 0; window < _windows; ++window) {
+    if (!BN_copy(power.get(), montgomeryOne.get())) {
+      throw std::runtime_error("Fixed Base Exponentiation log | constructor(): "
+                               "BN_copy failed.");
+    }
+    for (unsigned int j = 0; j < _entriesPerWindow; ++j) {
+      uint64_t *entry =
+          &_table[(static_cast<std::size_t>(window) * _entriesPerWindow + j) *
+                  _entryWords];
+      if (BN_bn2lebinpad(power.get(), reinterpret_cast<unsigned char *>(entry),
+                         entryBytes) != entryBytes ||
+          !BN_mod_mul_montgomery(power.get(), power.get(), windowBase.get(),
+                                 _montgomeryContext.get(), ctx.get())) {
+        throw std::runtime_error("Fixed Base Exponentiation log | "
+                                 "constructor(): Failed to fill the table.");
+      }
+    }
+    // after the last entry power = windowBase^(2^windowBits), the base of the
+    // next window
+    std::swap(windowBase, power);
+  }
+}
+/******************************************************************************/
+MyCryptoLibrary::FixedBaseExponentiation::~FixedBaseExponentiation() {}
+/******************************************************************************/
+/**
+ * @brief This method calculates base^exponent mod modulus.
+ *
+ * Each window of the exponent selects one precomputed power, so the
+ * calculation only needs one Montgomery multiplication per window and no
+ * squarings. The whole table row of each window is read, so the memory
+ * accesses do not depend on the exponent. Exponents with more bits than the
+ * table covers fall back to BN_mod_exp.
+ *
+ * @param exponent The non negative exponent.
+ *
+ * @return base^exponent mod modulus.
+ * @throws std::invalid_argument if the exponent is null or negative.
+ * @throws std::runtime_error if an OpenSSL operation fails.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::FixedBaseExponentiation::exponentiate(
+    const BIGNUM *exponent) const {
+  if (!exponent || BN_is_negative(exponent)) {
+    throw std::invalid_argument("Fixed Base Exponentiation log | "
+                                "exponentiate(): exponent must be non "
+                                "negative.");
+  }
+  std::unique_ptr<BN_CTX, BN_CTX_deleter> ctx{BN_CTX_new()};
+  MessageExtractionFacility::UniqueBIGNUM result{BN_new()};
+  if (!ctx || !result) {
+    throw std::runtime_error("Fixed Base Exponentiation log | exponentiate(): "
+                             "Failed to allocate BIGNUM.");
+  }
+  if (static_cast<unsigned int>(BN_num_bits(exponent)) > getMaxExponentBits()) {
+    if (!BN_mod_exp(result.get(), _base.get(), exponent, _modulus.get(),
+                    ctx.get())) {
+      throw std::runtime_error("Fixed Base Exponentiation log | "
+                               "exponentiate(): BN_mod_exp failed.");
+    }
+    return result;
+  }
+  MessageExtractionFacility::UniqueBIGNUM factor{BN_new()};
+  if (!factor || !BN_to_montgomery(result.get(), BN_value_one(),
+                                   _montgomeryContext.get(), ctx.get())) {
+    throw std::runtime_error("Fixed Base Exponentiation log | exponentiate(): "
+                             "Failed to initialize the accumulator.");
+  }
+  std::vector<uint64_t> selected(_entryWords);
+  const int entryBytes = static_cast<int>(_entryWords * sizeof(uint64_t));
+  for (unsigned int window = 0; window < _windows; ++window) {
+    const unsigned int digit = windowDigit(exponent, window);
+    const uint64_t *row =
+        &_table[static_cast<std::size_t>(window) * _entriesPerWindow *
+                _entryWords];
+    std::memset(selected.data(), 0, entryBytes);
+    for (unsigned int j = 0; j < _entriesPerWindow; ++j) {
+      const uint64_t mask = 0 - static_cast<uint64_t>(j == digit);
+      const uint64_t *entry = row + j * _entryWords;
+      for (std::size_t word = 0; word < _entryWords; ++word) {
+        selected[word] |= entry[word] & mask;
+      }
+    }
+    if (!BN_lebin2bn(reinterpret_cast<const unsigned char *>(selected.data()),
+                     entryBytes, factor.get()) ||
+        !BN_mod_mul_montgomery(result.get(), result.get(), factor.get(),
+                               _montgomeryContext.get(), ctx.get())) {
+      throw std::runtime_error("Fixed Base Exponentiation log | "
+                               "exponentiate(): Montgomery multiplication "
+                               "failed.");
+    }
+  }
+  if (!BN_from_montgomery(result.get(), result.get(), _montgomeryContext.get(),
+                          ctx.get())) {
+    throw std::runtime_error("Fixed Base Exponentiation log | exponentiate(): "
+                             "BN_from_montgomery failed.");
+  }
+  return result;
+}
+/******************************************************************************/
+/**
+ * @brief This method returns the largest exponent size covered by the
+ * precomputed table.
+ *
+ * @return The maximum number of bits of the exponent.
+ */
+unsigned int
+MyCryptoLibrary::FixedBaseExponentiation::getMaxExponentBits() const {
+  return _windows * _windowBits;
+}
+/******************************************************************************/
+/**
+ * @brief This method returns the shared exponentiation engine of a group.
+ *
+ * The table of a group is built the first time the group is requested and
+ * then kept for the lifetime of the process, it is safe to call this method
+ * from several threads. The tables of different groups are built
+ * concurrently, the callers of a group whose table is being built wait for
+ * it.
+ *
+ * @param modulusHex The odd modulus of the group, in hexadecimal format.
+ * @param baseHex The generator of the group, in hexadecimal format.
+ *
+ * @return The exponentiation engine of the group.
+ */
+std::shared_ptr<const MyCryptoLibrary::FixedBaseExponentiation>
+MyCryptoLibrary::FixedBaseExponentiation::getInstance(
+    const std::string &modulusHex, const std::string &baseHex) {
+  // placeholder of a group, its table is built once, outside of the lock
+  struct InstanceSlot {
+    std::once_flag built;
+    std::shared_ptr<const FixedBaseExponentiation> instance;
+  };
+  static std::mutex instancesMutex;
+  static std::map<std::pair<std::string, std::string>,
+                  std::shared_ptr<InstanceSlot>>
+      instances;
+  std::shared_ptr<InstanceSlot> slot;
+  {
+    std::lock_guard<std::mutex> lock(instancesMutex);
+    std::shared_ptr<InstanceSlot> &entry = instances[{modulusHex, baseHex}];
+    if (!entry) {
+      entry = std::make_shared<InstanceSlot>();
+    }
+    slot = entry;
+  }
+  // if the constructor throws the flag stays unset and the next call retries
+  std::call_once(slot->built, [&]() {
+    slot->instance =
+        std::make_shared<const FixedBaseExponentiation>(modulusHex, baseHex);
+  });
+  return slot->instance;
+}
+/******************************************************************************/
+/**
+ * @brief This method returns the digit of a window of the exponent.
+ *
+ * @param exponent The exponent.
+ * @param window The index of the window, starting at the least significant
+ * bits.
+ *
+ * @return The value of the windowBits bits of the window.
+ */
+unsigned int MyCryptoLibrary::FixedBaseExponentiation::windowDigit(
+    const BIGNUM *exponent, const unsigned int window) {
+  unsigned int digit{0};
+  for (unsigned int bit = 0; bit < _windowBits; ++bit) {
+    digit |= static_cast<unsigned int>(BN_is_bit_set(
+                 exponent, static_cast<int>(window * _windowBits + bit)))
+             << bit;
+  }
+  return digit;
+}
+/******************************************************************************/
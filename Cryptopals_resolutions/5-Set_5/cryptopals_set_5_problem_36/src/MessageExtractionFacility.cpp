@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <charconv>
 #include <iomanip>
 #include <iostream>
@@ -151,6 +152,58 @@ std::string MessageExtractionFacility::BIGNUMToHex(BIGNUM *bn) {
   return hexStr;
 }
 /******************************************************************************/
+/**
+ * @brief This method will convert a number in a BIGNUM format to its big
+ * endian bytes.
+ *
+ * This method will convert a number in a BIGNUM format to its big endian
+ * bytes, left padded with zeros up to the given size. A number that needs
+ * more bytes than the given size is returned without padding.
+ *
+ * @param bn The number in a BIGNUM format.
+ * @param size The minimum amount of bytes of the result.
+ *
+ * @return The bytes of the number, big endian.
+ * @throws std::runtime_error if conversion fails.
+ */
+std::vector<unsigned char>
+MessageExtractionFacility::BIGNUMToBytes(const BIGNUM *bn, std::size_t size) {
+  if (!bn) {
+    throw std::runtime_error("MessageExtractionFacility log | BIGNUMToBytes(): "
+                             "BIGNUM is null.");
+  }
+  const std::size_t numberSize{static_cast<std::size_t>(BN_num_bytes(bn))};
+  std::vector<unsigned char> bytes(std::max(size, numberSize));
+  if (BN_bn2binpad(bn, bytes.data(), static_cast<int>(bytes.size())) < 0) {
+    throw std::runtime_error("MessageExtractionFacility log | BIGNUMToBytes(): "
+                             "Failed to convert BIGNUM to bytes.");
+  }
+  return bytes;
+}
+/******************************************************************************/
+/**
+ * @brief This method will convert big endian bytes to an unique big number.
+ *
+ * This method will convert big endian bytes to an unique big number.
+ *
+ * @param bytes The bytes of the number, big endian.
+ *
+ * @return The number in an UniqueBIGNUM format.
+ * @throws std::runtime_error if conversion fails.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MessageExtractionFacility::bytesToUniqueBIGNUM(
+    const std::vector<unsigned char> &bytes) {
+  UniqueBIGNUM bn{
+      BN_bin2bn(bytes.data(), static_cast<int>(bytes.size()), nullptr)};
+  if (!bn) {
+    throw std::runtime_error(
+        "MessageExtractionFacility log | bytesToUniqueBIGNUM(): "
+        "Failed to convert bytes to BIGNUM.");
+  }
+  return bn;
+}
+/******************************************************************************/
 /**
  * @brief This method will convert a number in a BIGNUM format to
  * a decimal format.
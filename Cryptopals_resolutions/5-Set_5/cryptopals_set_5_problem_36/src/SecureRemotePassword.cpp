@@ -3,6 +3,7 @@
 #include <openssl/bn.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 
@@ -23,6 +24,10 @@ const std::map<unsigned int, MessageExtractionFacility::UniqueBIGNUM>
         MyCryptoLibrary::SecureRemotePassword::
             calculateKMultiplierParameters()};
 
+const std::map<unsigned int, MyCryptoLibrary::SecureRemotePassword::SrpGroup>
+    MyCryptoLibrary::SecureRemotePassword::_srpGroups{
+        MyCryptoLibrary::SecureRemotePassword::loadSrpGroups()};
+
 /* constructor / destructor */
 
 /**
@@ -38,7 +43,7 @@ const std::map<unsigned int, MessageExtractionFacility::UniqueBIGNUM>
 MyCryptoLibrary::SecureRemotePassword::SecureRemotePassword(
     const bool debugFlag)
     : _debugFlag{debugFlag},
-      _srpParametersMap{SrpParametersLoader::loadSrpParameters(
+      _srpParametersMap{SrpParametersLoader::getSrpParameters(
           getSrpParametersFilenameLocation())} {
   if (_debugFlag) {
     std::cout << std::endl;
@@ -80,8 +85,8 @@ MyCryptoLibrary::SecureRemotePassword::~SecureRemotePassword() {}
  */
 std::map<unsigned int, MessageExtractionFacility::UniqueBIGNUM>
 MyCryptoLibrary::SecureRemotePassword::calculateKMultiplierParameters() {
-  std::map<unsigned int, SrpParametersLoader::SrpParameters> srpParametersMap{
-      SrpParametersLoader::loadSrpParameters(
+  const std::map<unsigned int, SrpParametersLoader::SrpParameters>
+      &srpParametersMap{SrpParametersLoader::getSrpParameters(
           getSrpParametersFilenameLocation())};
   std::map<unsigned int, MessageExtractionFacility::UniqueBIGNUM> kMap;
   for (const auto &entry : srpParametersMap) {
@@ -169,6 +174,27 @@ MyCryptoLibrary::SecureRemotePassword::getSrpParametersMap() const {
   return _srpParametersMap;
 }
 /******************************************************************************/
+/**
+ * @brief Returns the shared read only view of a SRP group.
+ *
+ * The groups are built once per process from the SRP parameters file, so
+ * the sessions do not parse N, g or k again.
+ *
+ * @param groupId The ID of the group.
+ * @return A constant reference to the group.
+ * @throw std::invalid_argument if the group ID is not in the SRP parameters
+ * file.
+ */
+const MyCryptoLibrary::SecureRemotePassword::SrpGroup &
+MyCryptoLibrary::SecureRemotePassword::getSrpGroup(const unsigned int groupId) {
+  const auto it = _srpGroups.find(groupId);
+  if (it == _srpGroups.end()) {
+    throw std::invalid_argument("Secure Remote Password log | getSrpGroup(): "
+                                "Group ID not found.");
+  }
+  return it->second;
+}
+/******************************************************************************/
 /**
  * @brief This method will generate a private key.
  *
@@ -190,21 +216,42 @@ std::string MyCryptoLibrary::SecureRemotePassword::generatePrivateKey(
         "SecureRemotePassword log | generatePrivateKey(): "
         "Invalid input parameters received.");
   }
-  // Convert N from hex to BIGNUM
   MessageExtractionFacility::UniqueBIGNUM nBn{
       MessageExtractionFacility::hexToUniqueBIGNUM(NHex)};
-  // Prepare context and result
-  EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
-  if (!ctx) {
-    throw std::runtime_error("SecureRemotePassword log | generatePrivateKey(): "
-                             "Failed to allocate BN_CTX.");
+  MessageExtractionFacility::UniqueBIGNUM privateKey{
+      generatePrivateKey(nBn.get(), minSizeBits)};
+  // Convert to hex string
+  return MessageExtractionFacility::BIGNUMToHex(privateKey.get());
+}
+/******************************************************************************/
+/**
+ * @brief This method will generate a private key.
+ *
+ * This method will generate a private key to be used at a SRP protocol.
+ * Requirements of the private key:
+ * - should be in the range [1, N-1];
+ * - should be at least minSizeBits;
+ *
+ * @param N The group prime N.
+ * @param minSizeBits The minimum amount of bits that the private key should
+ * have.
+ *
+ * @return The private key.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::generatePrivateKey(
+    const BIGNUM *N, const unsigned int minSizeBits) {
+  if (!N || minSizeBits == 0) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | generatePrivateKey(): "
+        "Invalid input parameters received.");
   }
-  EncryptionUtility::BnPtr privateKey(BN_new());
+  MessageExtractionFacility::UniqueBIGNUM privateKey(BN_new());
   if (!privateKey) {
     throw std::runtime_error("SecureRemotePassword log | generatePrivateKey(): "
                              "Failed to allocate BIGNUM.");
   }
-  int nBits{BN_num_bits(nBn.get())};
+  int nBits{BN_num_bits(N)};
   if (minSizeBits > nBits) {
     throw std::runtime_error("SecureRemotePassword log | "
                              "generatePrivateKey(): minSizeBits greater "
@@ -220,14 +267,13 @@ std::string MyCryptoLibrary::SecureRemotePassword::generatePrivateKey(
     }
     // Ensure 1 <= privateKey < N and at least minSizeBits bits
     if (BN_cmp(privateKey.get(), BN_value_one()) >= 0 &&
-        BN_cmp(privateKey.get(), nBn.get()) < 0 &&
+        BN_cmp(privateKey.get(), N) < 0 &&
         BN_num_bits(privateKey.get()) >= static_cast<int>(minSizeBits)) {
       break;
     }
     // Otherwise, try again
   }
-  // Convert to hex string
-  return MessageExtractionFacility::BIGNUMToHex(privateKey.get());
+  return privateKey;
 }
 /******************************************************************************/
 /**
@@ -268,65 +314,84 @@ std::string MyCryptoLibrary::SecureRemotePassword::calculatePublicKey(
       MessageExtractionFacility::hexToUniqueBIGNUM(gHex)};
   MessageExtractionFacility::UniqueBIGNUM privateKey{
       MessageExtractionFacility::hexToUniqueBIGNUM(privateKeyHex)};
+  MessageExtractionFacility::UniqueBIGNUM v;
+  if (isServer) {
+    v = MessageExtractionFacility::hexToUniqueBIGNUM(vHex);
+  }
+  MessageExtractionFacility::UniqueBIGNUM result{calculatePublicKey(
+      privateKey.get(), n.get(), g.get(), isServer, k, v.get())};
+  return MessageExtractionFacility::BIGNUMToHex(result.get());
+}
+/******************************************************************************/
+/**
+ * @brief Calculates the SRP public key (A or B).
+ *
+ * For the client: A = g^a mod N
+ * For the server: B = (k*v + g^b) mod N
+ *
+ * @param privateKey The private key (a or b).
+ * @param N The group prime N.
+ * @param g The generator g.
+ * @param isServer If true, computes B (server); if false, computes A
+ * (client).
+ * @param k Optional: the SRP multiplier parameter (required for B).
+ * @param v Optional: the verifier v (required for B).
+ * @return The public key (A or B).
+ * @throws std::runtime_error if constraints are not met.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::calculatePublicKey(
+    const BIGNUM *privateKey, const BIGNUM *N, const BIGNUM *g, bool isServer,
+    const BIGNUM *k, const BIGNUM *v) {
+  // Input parameter validation
+  if (!privateKey || !N || !g) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculatePublicKey(): One or more required "
+        "input parameters are empty.");
+  }
+  if (isServer && (!k || !v)) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculatePublicKey(): k or v is missing "
+        "for server public key calculation.");
+  }
   EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
   if (!ctx)
     throw std::runtime_error("SRP: Failed to allocate BN_CTX.");
 
-  EncryptionUtility::BnPtr result(BN_new());
+  MessageExtractionFacility::UniqueBIGNUM result(BN_new());
   if (!result)
     throw std::runtime_error("SRP: Failed to allocate BIGNUM.");
 
   if (isServer) {
     // B = (k*v + g^b) mod N
-    if (!k || vHex.empty()) {
-      throw std::runtime_error(
-          "Secure Remote Password log | calculatePublicKey(): k and v are "
-          "required for B calculation.");
-    }
-    MessageExtractionFacility::UniqueBIGNUM v{
-        MessageExtractionFacility::hexToUniqueBIGNUM(vHex)};
     EncryptionUtility::BnPtr kMultV(BN_new());
     if (!kMultV) {
       throw std::runtime_error(
           "Secure Remote Password log | calculatePublicKey(): Failed to "
           "allocate BIGNUM for k*V.");
     }
-    if (!BN_mod_mul(kMultV.get(), k, v.get(), n.get(), ctx.get())) {
+    if (!BN_mod_mul(kMultV.get(), k, v, N, ctx.get())) {
       throw std::runtime_error("SRP: BN_mod_mul failed for k*v.");
     }
-    EncryptionUtility::BnPtr gPowB(BN_new());
-    if (!gPowB) {
-      throw std::runtime_error(
-          "Secure Remote Password log | calculatePublicKey(): Failed to "
-          "allocate BIGNUM for g^b.");
-    }
-    if (!BN_mod_exp(gPowB.get(), g.get(), privateKey.get(), n.get(),
-                    ctx.get())) {
-      throw std::runtime_error("SRP: BN_mod_exp failed for g^b.");
-    }
-    if (!BN_mod_add(result.get(), kMultV.get(), gPowB.get(), n.get(),
-                    ctx.get())) {
+    MessageExtractionFacility::UniqueBIGNUM gPowB{
+        powerOfGenerator(g, privateKey, N, ctx.get())};
+    if (!BN_mod_add(result.get(), kMultV.get(), gPowB.get(), N, ctx.get())) {
       throw std::runtime_error(
           "Secure Remote Password log | calculatePublicKey(): BN_mod_add "
           "failed for B = kMultV + g^b mod N.");
     }
   } else {
     // A = g^a mod N
-    if (!BN_mod_exp(result.get(), g.get(), privateKey.get(), n.get(),
-                    ctx.get())) {
-      throw std::runtime_error(
-          "Secure Remote Password log | calculatePublicKey(): BN_mod_exp "
-          "failed for A = g^a mod N.");
-    }
+    result = powerOfGenerator(g, privateKey, N, ctx.get());
   }
   // Enforce 1 < result < N
   if (BN_cmp(result.get(), BN_value_one()) <= 0 ||
-      BN_cmp(result.get(), n.get()) >= 0) {
+      BN_cmp(result.get(), N) >= 0) {
     throw std::runtime_error("Secure Remote Password log | "
                              "calculatePublicKey(): Public key not in "
                              "valid range (1 < key < N).");
   }
-  return MessageExtractionFacility::BIGNUMToHex(result.get());
+  return result;
 }
 /******************************************************************************/
 /**
@@ -353,9 +418,29 @@ bool MyCryptoLibrary::SecureRemotePassword::validatePublicKey(
       MessageExtractionFacility::hexToUniqueBIGNUM(publicKeyHex)};
   MessageExtractionFacility::UniqueBIGNUM n{
       MessageExtractionFacility::hexToUniqueBIGNUM(NHex)};
-  EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
-  if (BN_cmp(publicKey.get(), BN_value_one()) <= 0 ||
-      BN_cmp(publicKey.get(), n.get()) >= 0) {
+  return validatePublicKey(publicKey.get(), n.get());
+}
+/******************************************************************************/
+/**
+ * @brief This method does the validation of the public key.
+ *
+ * This method does the validation of the public key. It enforces:
+ * 1 < public key < N
+ *
+ * @param publicKey The public key (A or B).
+ * @param N The group prime N.
+ * @return True if the validation passes, false otherwise.
+ */
+bool MyCryptoLibrary::SecureRemotePassword::validatePublicKey(
+    const BIGNUM *publicKey, const BIGNUM *N) {
+  // input parameter validation
+  if (!publicKey || !N) {
+    std::cerr << "Secure Remote Password log | validatePublicKey(): parameters "
+                 "received are empty."
+              << std::endl;
+    return false;
+  }
+  if (BN_cmp(publicKey, BN_value_one()) <= 0 || BN_cmp(publicKey, N) >= 0) {
     std::cerr << "Secure Remote Password log | validatePublicKey(): Public key "
                  "not in valid range (1 < key < N)."
               << std::endl;
@@ -451,42 +536,46 @@ const std::string MyCryptoLibrary::SecureRemotePassword::calculateV(
     throw std::invalid_argument("SecureRemotePassword::calculateV(): invalid "
                                 "input parameters received.");
   }
-  // Allocate with RAII
+  MessageExtractionFacility::UniqueBIGNUM xBn{
+      MessageExtractionFacility::hexToUniqueBIGNUM(xHex)};
+  MessageExtractionFacility::UniqueBIGNUM nBn{
+      MessageExtractionFacility::hexToUniqueBIGNUM(NHex)};
+  MessageExtractionFacility::UniqueBIGNUM gBn(BN_new());
+  if (!gBn || !BN_set_word(gBn.get(), g)) {
+    throw std::runtime_error("SecureRemotePassword log | calculateV(): "
+                             "Failed to allocate BIGNUMs.");
+  }
+  MessageExtractionFacility::UniqueBIGNUM vBn{
+      calculateV(xBn.get(), nBn.get(), gBn.get())};
+  return MessageExtractionFacility::BIGNUMToHex(vBn.get());
+}
+/******************************************************************************/
+/**
+ * @brief This method will perform the calculation v = g^x mod N.
+ *
+ * @param x The value of x.
+ * @param N The value of the large prime N.
+ * @param g The value of the generator g.
+ *
+ * @return The result of v = g^x mod N.
+ * @throw std::runtime_error if the calculation fails.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::calculateV(const BIGNUM *x,
+                                                  const BIGNUM *N,
+                                                  const BIGNUM *g) {
+  // Input parameters validation
+  if (!x || !N || !g || BN_cmp(g, BN_value_one()) <= 0) {
+    throw std::invalid_argument("SecureRemotePassword::calculateV(): invalid "
+                                "input parameters received.");
+  }
   EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
   if (!ctx) {
     throw std::runtime_error("SecureRemotePassword log | calculateV(): "
                              "Failed to allocate BN_CTX.");
   }
-  EncryptionUtility::BnPtr gBn(BN_new());
-  EncryptionUtility::BnPtr vBn(BN_new());
-  if (!gBn || !vBn) {
-    throw std::runtime_error("SecureRemotePassword log | calculateV(): "
-                             "Failed to allocate BIGNUMs.");
-  }
-  BIGNUM *xBn{nullptr};
-  BIGNUM *nBn{nullptr};
-  if (!BN_hex2bn(&xBn, xHex.c_str()) || !BN_hex2bn(&nBn, NHex.c_str())) {
-    BN_free(xBn);
-    BN_free(nBn);
-    throw std::runtime_error("SecureRemotePassword log | calculateV(): Failed "
-                             "to convert hex strings to BIGNUM.");
-  }
-  // Wrap xBn and nBn now that they're allocated
-  EncryptionUtility::BnPtr xPtr(xBn);
-  EncryptionUtility::BnPtr nPtr(nBn);
-  BN_set_word(gBn.get(), g);
   // Compute v = g^x mod N
-  if (!BN_mod_exp(vBn.get(), gBn.get(), xPtr.get(), nPtr.get(), ctx.get())) {
-    throw std::runtime_error(
-        "SecureRemotePassword log | calculateV(): BN_mod_exp failed.");
-  }
-  // Convert result to hex string
-  EncryptionUtility::OsslStr vHex(BN_bn2hex(vBn.get()));
-  if (!vHex) {
-    throw std::runtime_error("SecureRemotePassword log | calculateV(): Failed "
-                             "to convert result to hex.");
-  }
-  return std::string(vHex.get()); // safely copy to std::string
+  return powerOfGenerator(g, x, N, ctx.get());
 }
 /******************************************************************************/
 /**
@@ -516,27 +605,55 @@ const std::string MyCryptoLibrary::SecureRemotePassword::calculateU(
         "SecureRemotePassword log | calculateU(): "
         "invalid input parameters received, cannot be empty.");
   }
-  // Get byte length of N
-  const std::vector<uint8_t> NBytes{
-      MessageExtractionFacility::hexToBytes(NHex)};
-  const size_t padLen{NBytes.size()};
-  // Convert A and B to bytes and pad left
-  const std::vector<uint8_t> ABytes{
-      MessageExtractionFacility::hexToBytes(AHex)};
-  const std::vector<uint8_t> BBytes{
-      MessageExtractionFacility::hexToBytes(BHex)};
+  MessageExtractionFacility::UniqueBIGNUM A{
+      MessageExtractionFacility::hexToUniqueBIGNUM(AHex)};
+  MessageExtractionFacility::UniqueBIGNUM B{
+      MessageExtractionFacility::hexToUniqueBIGNUM(BHex)};
+  MessageExtractionFacility::UniqueBIGNUM N{
+      MessageExtractionFacility::hexToUniqueBIGNUM(NHex)};
+  MessageExtractionFacility::UniqueBIGNUM u{
+      calculateU(hashName, A.get(), B.get(), N.get())};
+  return digestToHex(hashName, u.get());
+}
+/******************************************************************************/
+/**
+ * @brief Calculates the SRP scrambling parameter u = H(PAD(A) | PAD(B))
+ * according to RFC 5054.
+ *
+ * PAD(X): left-pad X with zeros to the byte length of N.
+ * H: hash function (e.g., SHA-1, SHA-256, etc.)
+ *
+ * @param hashName The hash algorithm to use (e.g., "SHA-256").
+ * @param A The client's public key A.
+ * @param B The server's public key B.
+ * @param N The group prime N.
+ * @return The computed u value.
+ * @throws std::invalid_argument if any input is null or hash is unsupported.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::calculateU(const std::string &hashName,
+                                                  const BIGNUM *A,
+                                                  const BIGNUM *B,
+                                                  const BIGNUM *N) {
+  // Validate input
+  if (_hashMap.find(hashName) == _hashMap.end()) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateU(): "
+                                "hash algorithm not recognized.");
+  }
+  if (!A || !B || !N) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculateU(): "
+        "invalid input parameters received, cannot be empty.");
+  }
+  // PAD(A) and PAD(B) to the byte length of N
+  const std::size_t padLen{static_cast<std::size_t>(BN_num_bytes(N))};
   const std::vector<uint8_t> APadded{
-      EncryptionUtility::padLeft(ABytes, padLen)};
+      MessageExtractionFacility::BIGNUMToBytes(A, padLen)};
   const std::vector<uint8_t> BPadded{
-      EncryptionUtility::padLeft(BBytes, padLen)};
-  // Concatenate PAD(A) || PAD(B)
-  std::vector<uint8_t> input(APadded);
-  input.insert(input.end(), BPadded.begin(), BPadded.end());
-  // Hash
-  const std::string inputStr(input.begin(), input.end());
-  std::string uHex{_hashMap.at(hashName)(inputStr)};
-  std::transform(uHex.begin(), uHex.end(), uHex.begin(), ::toupper);
-  return uHex;
+      MessageExtractionFacility::BIGNUMToBytes(B, padLen)};
+  // Hash PAD(A) || PAD(B)
+  return MessageExtractionFacility::bytesToUniqueBIGNUM(
+      EncryptionUtility::hashBytes(hashName, {APadded, BPadded}));
 }
 /******************************************************************************/
 /**
@@ -569,26 +686,53 @@ const std::string MyCryptoLibrary::SecureRemotePassword::calculateX(
         "SecureRemotePassword log | calculateX(): "
         "invalid input parameters received, cannot be empty.");
   }
+  MessageExtractionFacility::UniqueBIGNUM x{
+      calculateX(hashName, username, password,
+                 MessageExtractionFacility::hexToBytes(saltHex))};
+  return digestToHex(hashName, x.get());
+}
+/******************************************************************************/
+/**
+ * @brief Calculates the SRP private key 'x' according to RFC 5054.
+ *
+ * RFC 5054 formula:
+ *   x = H(salt | H(username | ":" | password))
+ * where H is the agreed hash function (e.g., SHA-1, SHA-256, SHA-384,
+ * SHA-512), salt is provided as raw bytes, and username and password are in
+ * plaintext.
+ *
+ * @param hashName The hash algorithm to use (e.g., "SHA-256").
+ * @param username The username in plaintext.
+ * @param password The password in plaintext.
+ * @param salt The salt value, as raw bytes.
+ * @return The computed 'x' value.
+ * @throws std::invalid_argument if any input is empty or unsupported hash is
+ * specified.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::calculateX(
+    const std::string &hashName, const std::string &username,
+    const std::string &password, const std::vector<uint8_t> &salt) {
+  // Validate input
+  if (_hashMap.find(hashName) == _hashMap.end()) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateX(): "
+                                "hash algorithm not recognized.");
+  }
+  if (username.empty() || password.empty() || salt.empty()) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculateX(): "
+        "invalid input parameters received, cannot be empty.");
+  }
   // Step 1: Inner hash = H(username | ":" | password)
-  const std::string inner{username + ":" + password};
-  const std::string innerHashHex{_hashMap.at(hashName)(inner)};
-  // Step 2: Convert saltHex and innerHashHex to raw bytes
-  std::vector<uint8_t> saltBytes =
-      MessageExtractionFacility::hexToBytes(saltHex);
-  std::vector<uint8_t> innerHashBytes =
-      MessageExtractionFacility::hexToBytes(innerHashHex);
-  // Step 3: Concatenate saltBytes + innerHashBytes
-  std::vector<uint8_t> concatBytes;
-  concatBytes.reserve(saltBytes.size() + innerHashBytes.size());
-  concatBytes.insert(concatBytes.end(), saltBytes.begin(), saltBytes.end());
-  concatBytes.insert(concatBytes.end(), innerHashBytes.begin(),
-                     innerHashBytes.end());
-  std::string concat(concatBytes.begin(), concatBytes.end());
-  // Step 4: Outer hash = H(salt | H(username | ":" | password))
-  std::string xHex{_hashMap.at(hashName)(concat)};
-  // Step 5: Return as uppercase hex
-  std::transform(xHex.begin(), xHex.end(), xHex.begin(), ::toupper);
-  return xHex;
+  const uint8_t separator{':'};
+  const std::vector<uint8_t> innerHash{EncryptionUtility::hashBytes(
+      hashName,
+      {{reinterpret_cast<const uint8_t *>(username.data()), username.size()},
+       {&separator, 1},
+       {reinterpret_cast<const uint8_t *>(password.data()), password.size()}})};
+  // Step 2: Outer hash = H(salt | H(username | ":" | password))
+  return MessageExtractionFacility::bytesToUniqueBIGNUM(
+      EncryptionUtility::hashBytes(hashName, {salt, innerHash}));
 }
 /******************************************************************************/
 /**
@@ -624,73 +768,90 @@ std::string MyCryptoLibrary::SecureRemotePassword::calculateSClient(
         "SecureRemotePassword log | calculateSClient(): Generator g less or "
         "equal to 1.");
   }
-  BN_CTX *ctx = BN_CTX_new();
+  MessageExtractionFacility::UniqueBIGNUM gBn(BN_new());
+  if (!gBn || !BN_set_word(gBn.get(), g)) {
+    throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
+                             "BIGNUM allocation failed");
+  }
+  MessageExtractionFacility::UniqueBIGNUM S{calculateSClient(
+      MessageExtractionFacility::hexToUniqueBIGNUM(BHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(kHex).get(), gBn.get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(xHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(aHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(uHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(NHex).get())};
+  return MessageExtractionFacility::BIGNUMToHex(S.get());
+}
+/******************************************************************************/
+/**
+ * @brief This method calculates the session key S for the client in the SRP
+ * protocol.
+ *
+ * Formula: S = (B - k * g^x) ^ (a + u * x) mod N
+ *
+ * @param B The server's public key B.
+ * @param k The SRP multiplier parameter k.
+ * @param g The SRP generator.
+ * @param x The client's private value x.
+ * @param a The client's private key a.
+ * @param u The SRP scrambling parameter u.
+ * @param N The SRP modulus N.
+ * @return The session key S.
+ * @throw std::runtime_error if any of the calculations fail.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::calculateSClient(
+    const BIGNUM *B, const BIGNUM *k, const BIGNUM *g, const BIGNUM *x,
+    const BIGNUM *a, const BIGNUM *u, const BIGNUM *N) {
+  // Parameter validation
+  if (!B || !k || !g || !x || !a || !u || !N) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculateSClient(): One or more input "
+        "parameters are empty.");
+  } else if (BN_cmp(g, BN_value_one()) <= 0) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculateSClient(): Generator g less or "
+        "equal to 1.");
+  }
+  EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
   if (!ctx) {
     throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
                              "Failed to allocate BN_CTX.");
   }
-  BIGNUM *B{BN_new()}, *k{BN_new()}, *gx{BN_new()}, *x{BN_new()};
-  BIGNUM *a{BN_new()}, *u{BN_new()}, *N{BN_new()};
-  BIGNUM *tmp1{BN_new()}, *tmp2{BN_new()}, *S{BN_new()};
-  if (!B || !k || !gx || !x || !a || !u || !N || !tmp1 || !tmp2 || !S) {
+  EncryptionUtility::BnPtr tmp1(BN_new()), tmp2(BN_new());
+  MessageExtractionFacility::UniqueBIGNUM S(BN_new());
+  if (!tmp1 || !tmp2 || !S) {
     throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
                              "BIGNUM allocation failed");
   }
-  BN_hex2bn(&B, BHex.c_str());
-  BN_hex2bn(&k, kHex.c_str());
-  BN_set_word(gx, g);
-  BN_hex2bn(&x, xHex.c_str());
-  BN_hex2bn(&a, aHex.c_str());
-  BN_hex2bn(&u, uHex.c_str());
-  BN_hex2bn(&N, NHex.c_str());
   // Compute g^x mod N
-  if (!BN_mod_exp(gx, gx, x, N, ctx)) {
-    throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
-                             "BN_mod_exp(g^x) failed");
-  }
+  MessageExtractionFacility::UniqueBIGNUM gx{
+      powerOfGenerator(g, x, N, ctx.get())};
   // Compute k * g^x mod N
-  if (!BN_mod_mul(tmp1, k, gx, N, ctx)) {
+  if (!BN_mod_mul(tmp1.get(), k, gx.get(), N, ctx.get())) {
     throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
                              "BN_mod_mul(k * g^x) failed");
   }
   // Compute (B - k * g^x) mod N
-  if (!BN_mod_sub(tmp2, B, tmp1, N, ctx)) {
+  if (!BN_mod_sub(tmp2.get(), B, tmp1.get(), N, ctx.get())) {
     throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
                              "BN_mod_sub(B - k * g^x) failed");
   }
   // Compute (a + u * x)
-  if (!BN_mul(tmp1, u, x, ctx)) {
+  if (!BN_mul(tmp1.get(), u, x, ctx.get())) {
     throw std::runtime_error(
         "SecureRemotePassword log | calculateSClient(): BN_mul(u * x) failed");
   }
-  if (!BN_mod_add(tmp1, a, tmp1, N, ctx)) {
+  if (!BN_mod_add(tmp1.get(), a, tmp1.get(), N, ctx.get())) {
     throw std::runtime_error("SecureRemotePassword log | calculateSClient(): "
                              "BN_add(a + u * x) failed");
   }
   // Compute S = (B - k * g^x) ^ (a + u * x) mod N
-  if (!BN_mod_exp(S, tmp2, tmp1, N, ctx)) {
+  if (!modularExponentiation(S.get(), tmp2.get(), tmp1.get(), N, ctx.get())) {
     throw std::runtime_error(
         "SecureRemotePassword log | calculateSClient(): BN_mod_exp(S) failed");
   }
-  // Convert S to hex string (uppercase)
-  char *SHex{BN_bn2hex(S)};
-  std::string SStr{SHex ? SHex : ""};
-  OPENSSL_free(SHex);
-  // Free resources
-  BN_free(B);
-  BN_free(k);
-  BN_free(gx);
-  BN_free(x);
-  BN_free(a);
-  BN_free(u);
-  BN_free(N);
-  BN_free(tmp1);
-  BN_free(tmp2);
-  BN_free(S);
-  BN_CTX_free(ctx);
-  // To upper case conversion
-  std::transform(SStr.begin(), SStr.end(), SStr.begin(), ::toupper);
-  return SStr;
+  return S;
 }
 /******************************************************************************/
 /**
@@ -716,88 +877,67 @@ std::string MyCryptoLibrary::SecureRemotePassword::calculateSServer(
         "SecureRemotePassword log | calculateSServer(): One or more input "
         "parameters are empty.");
   }
-  BN_CTX *ctx{BN_CTX_new()};
+  MessageExtractionFacility::UniqueBIGNUM S{calculateSServer(
+      MessageExtractionFacility::hexToUniqueBIGNUM(AHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(vHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(uHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(bHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(NHex).get())};
+  return MessageExtractionFacility::BIGNUMToHex(S.get());
+}
+/******************************************************************************/
+/**
+ * @brief Calculates the SRP shared secret S for the server side.
+ *
+ * Formula: S = (A * v^u) ^ b mod N
+ *
+ * @param A The client's public key A.
+ * @param v The verifier v.
+ * @param u The scrambling parameter u.
+ * @param b The server's private key b.
+ * @param N The modulus N.
+ * @return The shared secret S.
+ * @throw std::runtime_error if any of the calculations fail.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::calculateSServer(const BIGNUM *A,
+                                                        const BIGNUM *v,
+                                                        const BIGNUM *u,
+                                                        const BIGNUM *b,
+                                                        const BIGNUM *N) {
+  // Parameter validation
+  if (!A || !v || !u || !b || !N) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculateSServer(): One or more input "
+        "parameters are empty.");
+  }
+  EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
   if (!ctx) {
     throw std::runtime_error("SecureRemotePassword log | calculateSServer(): "
                              "Failed to allocate BN_CTX.");
   }
-  BIGNUM *A{BN_new()}, *v{BN_new()}, *u{BN_new()}, *b{BN_new()}, *N{BN_new()};
-  BIGNUM *vu{BN_new()}, *Avu{BN_new()}, *S{BN_new()};
-  if (!A || !v || !u || !b || !N || !vu || !Avu || !S) {
-    BN_CTX_free(ctx);
-    BN_free(A);
-    BN_free(v);
-    BN_free(u);
-    BN_free(b);
-    BN_free(N);
-    BN_free(vu);
-    BN_free(Avu);
-    BN_free(S);
+  EncryptionUtility::BnPtr vu(BN_new()), Avu(BN_new());
+  MessageExtractionFacility::UniqueBIGNUM S(BN_new());
+  if (!vu || !Avu || !S) {
     throw std::runtime_error("SecureRemotePassword log | calculateSServer(): "
                              "BIGNUM allocation failed");
   }
-  BN_hex2bn(&A, AHex.c_str());
-  BN_hex2bn(&v, vHex.c_str());
-  BN_hex2bn(&u, uHex.c_str());
-  BN_hex2bn(&b, bHex.c_str());
-  BN_hex2bn(&N, NHex.c_str());
   // Compute v^u mod N
-  if (!BN_mod_exp(vu, v, u, N, ctx)) {
-    BN_CTX_free(ctx);
-    BN_free(A);
-    BN_free(v);
-    BN_free(u);
-    BN_free(b);
-    BN_free(N);
-    BN_free(vu);
-    BN_free(Avu);
-    BN_free(S);
+  if (!modularExponentiation(vu.get(), v, u, N, ctx.get())) {
     throw std::runtime_error("SecureRemotePassword log | calculateSServer(): "
                              "BN_mod_exp(v^u) failed");
   }
   // Compute A * v^u mod N
-  if (!BN_mod_mul(Avu, A, vu, N, ctx)) {
-    BN_CTX_free(ctx);
-    BN_free(A);
-    BN_free(v);
-    BN_free(u);
-    BN_free(b);
-    BN_free(N);
-    BN_free(vu);
-    BN_free(Avu);
-    BN_free(S);
+  if (!BN_mod_mul(Avu.get(), A, vu.get(), N, ctx.get())) {
     throw std::runtime_error("SecureRemotePassword log | calculateSServer(): "
                              "BN_mod_mul(A * v^u) failed");
   }
   // Compute S = (A * v^u) ^ b mod N
-  if (!BN_mod_exp(S, Avu, b, N, ctx)) {
-    BN_CTX_free(ctx);
-    BN_free(A);
-    BN_free(v);
-    BN_free(u);
-    BN_free(b);
-    BN_free(N);
-    BN_free(vu);
-    BN_free(Avu);
-    BN_free(S);
+  if (!modularExponentiation(S.get(), Avu.get(), b, N, ctx.get())) {
     throw std::runtime_error(
         "SecureRemotePassword log | calculateSServer(): BN_mod_exp(S) failed");
   }
-  // Convert S to hex string (uppercase)
-  char *SHex{BN_bn2hex(S)};
-  std::string SStr{SHex ? SHex : ""};
-  OPENSSL_free(SHex);
-  BN_free(A);
-  BN_free(v);
-  BN_free(u);
-  BN_free(b);
-  BN_free(N);
-  BN_free(vu);
-  BN_free(Avu);
-  BN_free(S);
-  BN_CTX_free(ctx);
-  std::transform(SStr.begin(), SStr.end(), SStr.begin(), ::toupper);
-  return SStr;
+  return S;
 }
 /******************************************************************************/
 /**
@@ -825,16 +965,38 @@ MyCryptoLibrary::SecureRemotePassword::calculateK(const std::string &hash,
     throw std::invalid_argument("SecureRemotePassword log | calculateK(): "
                                 "SHex in empty.");
   }
-  // Convert S from hex string to bytes
-  const std::vector<uint8_t> SBytes{
-      MessageExtractionFacility::hexToBytes(SHex)};
-  // Convert bytes to string for hashing
-  const std::string SPlaintext(SBytes.begin(), SBytes.end());
-  // Hash the byte string
-  std::string KHex{_hashMap.at(hash)(SPlaintext)};
-  // Return as uppercase hex
-  std::transform(KHex.begin(), KHex.end(), KHex.begin(), ::toupper);
-  return KHex;
+  MessageExtractionFacility::UniqueBIGNUM S{
+      MessageExtractionFacility::hexToUniqueBIGNUM(SHex)};
+  return MessageExtractionFacility::toHexString(calculateK(hash, S.get()));
+}
+/******************************************************************************/
+/**
+ * @brief This method calculates the session key K for the client in the SRP
+ * protocol.
+ *
+ * Formula: K = H(S)
+ * Clarification:
+ * - H: hash algorithm;
+ * - S: shared secret, hashed as its big endian bytes;
+ *
+ * @param hash The hash algorithm (e.g., "SHA-256").
+ * @param S The shared secret.
+ * @return The session key K, as raw bytes.
+ * @throw std::runtime_error if any of the calculations fail.
+ */
+std::vector<uint8_t>
+MyCryptoLibrary::SecureRemotePassword::calculateK(const std::string &hash,
+                                                  const BIGNUM *S) {
+  // Check hash algorithm exists
+  if (_hashMap.find(hash) == _hashMap.end()) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateK(): "
+                                "hash algorithm not recognized.");
+  } else if (!S) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateK(): "
+                                "S is null.");
+  }
+  return EncryptionUtility::hashBytes(
+      hash, {MessageExtractionFacility::BIGNUMToBytes(S)});
 }
 /******************************************************************************/
 /**
@@ -878,48 +1040,68 @@ std::string MyCryptoLibrary::SecureRemotePassword::calculateM(
     throw std::invalid_argument("SecureRemotePassword log | calculateM(): "
                                 "hash algorithm not recognized.");
   }
-  EncryptionUtility::HashFn hashFn{_hashMap.at(hashName)};
-  // H(N)
-  std::vector<uint8_t> NBytes{MessageExtractionFacility::hexToBytes(NHex)};
-  const std::string NPlain(NBytes.begin(), NBytes.end());
-  const std::string hashN{hashFn(NPlain)};
-  // H(g)
-  std::vector<uint8_t> gBytes{MessageExtractionFacility::hexToBytes(gHex)};
-  const std::string gPlain(gBytes.begin(), gBytes.end());
-  const std::string hashG{hashFn(gPlain)};
-  // H(U)
-  std::string hashU{hashFn(username)};
-  std::vector<uint8_t> hashUBytes{MessageExtractionFacility::hexToBytes(hashU)};
-  const std::string hashUPlain(hashUBytes.begin(), hashUBytes.end());
+  return MessageExtractionFacility::toHexString(calculateM(
+      hashName, MessageExtractionFacility::hexToUniqueBIGNUM(NHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(gHex).get(), username,
+      MessageExtractionFacility::hexToBytes(saltHex),
+      MessageExtractionFacility::hexToUniqueBIGNUM(AHex).get(),
+      MessageExtractionFacility::hexToUniqueBIGNUM(BHex).get(),
+      MessageExtractionFacility::hexToBytes(KHex)));
+}
+/******************************************************************************/
+/**
+ * @brief This method calculates the SRP M value (message authentication code)
+ * for the client.
+ *
+ * Formula: H(H(N) XOR H(g) | H(U) | s | A | B | K)
+ * The numbers N, g, A and B are hashed as their big endian bytes.
+ *
+ * @param hashName The hash algorithm to use (e.g., "SHA-256").
+ * @param N The modulus N.
+ * @param g The generator g.
+ * @param username The username.
+ * @param salt The salt, as raw bytes.
+ * @param A The client's public key A.
+ * @param B The server's public key B.
+ * @param K The session key K, as raw bytes.
+ * @return The computed M value, as raw bytes.
+ * @throw std::runtime_error if any of the calculations fail.
+ */
+std::vector<uint8_t> MyCryptoLibrary::SecureRemotePassword::calculateM(
+    const std::string &hashName, const BIGNUM *N, const BIGNUM *g,
+    const std::string &username, const std::vector<uint8_t> &salt,
+    const BIGNUM *A, const BIGNUM *B, const std::vector<uint8_t> &K) {
+  if (hashName.empty() || !N || !g || username.empty() || salt.empty() ||
+      !A || !B || K.empty()) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateM(): "
+                                "empty input parameters received.");
+  }
+  // Check hash algorithm exists
+  if (_hashMap.find(hashName) == _hashMap.end()) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateM(): "
+                                "hash algorithm not recognized.");
+  }
   // H(N) XOR H(g)
-  if (hashN.size() != hashG.size()) {
+  std::vector<uint8_t> hashNXorHashG{EncryptionUtility::hashBytes(
+      hashName, {MessageExtractionFacility::BIGNUMToBytes(N)})};
+  const std::vector<uint8_t> hashG{EncryptionUtility::hashBytes(
+      hashName, {MessageExtractionFacility::BIGNUMToBytes(g)})};
+  if (hashNXorHashG.size() != hashG.size()) {
     throw std::runtime_error("SecureRemotePassword log | calculateM(): "
                              "H(N) and H(g) length mismatch.");
   }
-  std::vector<uint8_t> hashNBytes{MessageExtractionFacility::hexToBytes(hashN)};
-  std::vector<uint8_t> hashGBytes{MessageExtractionFacility::hexToBytes(hashG)};
-  std::string hashN_xor_hashG(hashNBytes.size(), '\0');
-  for (size_t i = 0; i < hashNBytes.size(); ++i) {
-    hashN_xor_hashG[i] = hashNBytes[i] ^ hashGBytes[i];
-  }
-  // Prepare salt, A, B, K as bytes
-  std::vector<uint8_t> saltBytes{
-      MessageExtractionFacility::hexToBytes(saltHex)};
-  const std::string saltPlain(saltBytes.begin(), saltBytes.end());
-  std::vector<uint8_t> ABytes{MessageExtractionFacility::hexToBytes(AHex)};
-  const std::string APlain(ABytes.begin(), ABytes.end());
-  std::vector<uint8_t> BBytes{MessageExtractionFacility::hexToBytes(BHex)};
-  const std::string BPlain(BBytes.begin(), BBytes.end());
-  std::vector<uint8_t> KBytes{MessageExtractionFacility::hexToBytes(KHex)};
-  const std::string KPlain(KBytes.begin(), KBytes.end());
-  // Concatenate all parts
-  const std::string MInput{hashN_xor_hashG + hashUPlain + saltPlain + APlain +
-                           BPlain + KPlain};
-  // Hash the concatenated value
-  std::string MHex{hashFn(MInput)};
-  // Return as uppercase hex
-  std::transform(MHex.begin(), MHex.end(), MHex.begin(), ::toupper);
-  return MHex;
+  for (std::size_t i = 0; i < hashNXorHashG.size(); ++i) {
+    hashNXorHashG[i] ^= hashG[i];
+  }
+  // H(U)
+  const std::vector<uint8_t> hashU{EncryptionUtility::hashBytes(
+      hashName, {{reinterpret_cast<const uint8_t *>(username.data()),
+                  username.size()}})};
+  // Hash the concatenation of all parts
+  return EncryptionUtility::hashBytes(
+      hashName, {hashNXorHashG, hashU, salt,
+                 MessageExtractionFacility::BIGNUMToBytes(A),
+                 MessageExtractionFacility::BIGNUMToBytes(B), K});
 }
 /******************************************************************************/
 /**
@@ -948,22 +1130,169 @@ const std::string MyCryptoLibrary::SecureRemotePassword::calculateM2(
         "SecureRemotePassword log | calculateM2(): "
         "invalid input parameters received, cannot be empty.");
   }
-  // Convert hex inputs to raw bytes
-  const std::vector<uint8_t> ABytes{
-      MessageExtractionFacility::hexToBytes(AHex)};
-  const std::vector<uint8_t> MBytes{
-      MessageExtractionFacility::hexToBytes(MHex)};
-  const std::vector<uint8_t> KBytes{
-      MessageExtractionFacility::hexToBytes(KHex)};
-  // Concatenate A | M | K
-  std::vector<uint8_t> input;
-  input.reserve(ABytes.size() + MBytes.size() + KBytes.size());
-  input.insert(input.end(), ABytes.begin(), ABytes.end());
-  input.insert(input.end(), MBytes.begin(), MBytes.end());
-  input.insert(input.end(), KBytes.begin(), KBytes.end());
-  const std::string inputStr(input.begin(), input.end());
-  std::string M2Hex = _hashMap.at(hashName)(inputStr);
-  std::transform(M2Hex.begin(), M2Hex.end(), M2Hex.begin(), ::toupper);
-  return M2Hex;
+  MessageExtractionFacility::UniqueBIGNUM A{
+      MessageExtractionFacility::hexToUniqueBIGNUM(AHex)};
+  return MessageExtractionFacility::toHexString(calculateM2(
+      hashName, A.get(), MessageExtractionFacility::hexToBytes(MHex),
+      MessageExtractionFacility::hexToBytes(KHex)));
+}
+/******************************************************************************/
+/**
+ * @brief Calculates the SRP server proof M2 = H(A | M | K) according to RFC
+ * 5054.
+ *
+ * The hash is computed over the concatenation of the big endian bytes of A
+ * and the raw bytes of M and K.
+ *
+ * @param hashName The hash algorithm to use (e.g., "SHA-256").
+ * @param A The client's public key A.
+ * @param M The client proof M, as raw bytes.
+ * @param K The session key K, as raw bytes.
+ * @return The computed M2 value, as raw bytes.
+ * @throws std::invalid_argument if any input is empty or hash is unsupported.
+ */
+std::vector<uint8_t> MyCryptoLibrary::SecureRemotePassword::calculateM2(
+    const std::string &hashName, const BIGNUM *A,
+    const std::vector<uint8_t> &M, const std::vector<uint8_t> &K) {
+  // input parameter's validation
+  if (_hashMap.find(hashName) == _hashMap.end()) {
+    throw std::invalid_argument("SecureRemotePassword log | calculateM2(): "
+                                "hash algorithm not recognized.");
+  } else if (!A || M.empty() || K.empty()) {
+    throw std::invalid_argument(
+        "SecureRemotePassword log | calculateM2(): "
+        "invalid input parameters received, cannot be empty.");
+  }
+  return EncryptionUtility::hashBytes(
+      hashName, {MessageExtractionFacility::BIGNUMToBytes(A), M, K});
+}
+/******************************************************************************/
+/**
+ * @brief Converts a digest kept as a BIGNUM back to hexadecimal format.
+ *
+ * The leading zero bytes of the digest are restored, so the result has the
+ * fixed size of the digests of the hash algorithm.
+ *
+ * @param hashName The hash algorithm of the digest (e.g., "SHA-256").
+ * @param digest The digest.
+ * @return The digest as an uppercase hexadecimal string.
+ */
+std::string
+MyCryptoLibrary::SecureRemotePassword::digestToHex(const std::string &hashName,
+                                                   const BIGNUM *digest) {
+  const std::size_t digestSize{static_cast<std::size_t>(
+      EVP_MD_get_size(EncryptionUtility::getDigestMap().at(hashName)))};
+  return MessageExtractionFacility::toHexString(
+      MessageExtractionFacility::BIGNUMToBytes(digest, digestSize));
+}
+/******************************************************************************/
+/**
+ * @brief Builds the groups of the SRP parameters file.
+ *
+ * @return A map from group ID to the group, with N, g and k as BIGNUMs and
+ * the Montgomery context of N.
+ * @throw std::runtime_error if an OpenSSL operation fails.
+ */
+std::map<unsigned int, MyCryptoLibrary::SecureRemotePassword::SrpGroup>
+MyCryptoLibrary::SecureRemotePassword::loadSrpGroups() {
+  EncryptionUtility::BnCtxPtr ctx(BN_CTX_new());
+  if (!ctx) {
+    throw std::runtime_error("SecureRemotePassword log | loadSrpGroups(): "
+                             "BN_CTX_new failed.");
+  }
+  std::map<unsigned int, SrpGroup> srpGroups;
+  for (const auto &[groupId, params] : SrpParametersLoader::getSrpParameters(
+           getSrpParametersFilenameLocation())) {
+    SrpGroup group;
+    group._parameters = params;
+    group._N = MessageExtractionFacility::hexToUniqueBIGNUM(params._nHex);
+    group._g = MessageExtractionFacility::hexToUniqueBIGNUM(
+        MessageExtractionFacility::uintToHex(params._g));
+    // _kMap is initialized before _srpGroups
+    group._k.reset(BN_dup(_kMap.at(groupId).get()));
+    group._montgomeryContext.reset(BN_MONT_CTX_new());
+    if (!group._k || !group._montgomeryContext ||
+        !BN_MONT_CTX_set(group._montgomeryContext.get(), group._N.get(),
+                         ctx.get())) {
+      throw std::runtime_error("SecureRemotePassword log | loadSrpGroups(): "
+                               "Failed to build the group.");
+    }
+    group._NHex = MessageExtractionFacility::BIGNUMToHex(group._N.get());
+    group._gHex = MessageExtractionFacility::BIGNUMToHex(group._g.get());
+    srpGroups.emplace(groupId, std::move(group));
+  }
+  return srpGroups;
+}
+/******************************************************************************/
+/**
+ * @brief Finds the group of the SRP parameters file with a given prime.
+ *
+ * @param N The group prime N.
+ * @return The group, or nullptr if N is not the prime of any group.
+ */
+const MyCryptoLibrary::SecureRemotePassword::SrpGroup *
+MyCryptoLibrary::SecureRemotePassword::findSrpGroup(const BIGNUM *N) {
+  for (const auto &[groupId, group] : _srpGroups) {
+    if (BN_cmp(group._N.get(), N) == 0) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+/******************************************************************************/
+/**
+ * @brief Calculates base^exponent mod N.
+ *
+ * The primes of the SRP parameters file reuse the Montgomery context of
+ * their group instead of building one per call.
+ *
+ * @param result The result of base^exponent mod N.
+ * @param base The base.
+ * @param exponent The exponent.
+ * @param N The modulus N.
+ * @param ctx The BIGNUM context.
+ * @return True if the calculation succeeded, false otherwise.
+ */
+bool MyCryptoLibrary::SecureRemotePassword::modularExponentiation(
+    BIGNUM *result, const BIGNUM *base, const BIGNUM *exponent,
+    const BIGNUM *N, BN_CTX *ctx) {
+  const SrpGroup *group{findSrpGroup(N)};
+  if (group) {
+    return BN_mod_exp_mont(result, base, exponent, N, ctx,
+                           group->_montgomeryContext.get());
+  }
+  return BN_mod_exp(result, base, exponent, N, ctx);
+}
+/******************************************************************************/
+/**
+ * @brief Calculates g^exponent mod N.
+ *
+ * The groups of the SRP parameters file use the precomputed powers of g of
+ * FixedBaseExponentiation, shared by every call. Any other N and g, e.g.
+ * received from a peer, use BN_mod_exp so that no table is built for them.
+ *
+ * @param g The generator g.
+ * @param exponent The exponent.
+ * @param N The group prime N.
+ * @param ctx The BIGNUM context used by BN_mod_exp.
+ * @return The result of g^exponent mod N.
+ * @throw std::runtime_error if the calculation fails.
+ */
+MessageExtractionFacility::UniqueBIGNUM
+MyCryptoLibrary::SecureRemotePassword::powerOfGenerator(const BIGNUM *g,
+                                                        const BIGNUM *exponent,
+                                                        const BIGNUM *N,
+                                                        BN_CTX *ctx) {
+  const SrpGroup *group{findSrpGroup(N)};
+  if (group && BN_cmp(group->_g.get(), g) == 0) {
+    return FixedBaseExponentiation::getInstance(group->_NHex, group->_gHex)
+        ->exponentiate(exponent);
+  }
+  MessageExtractionFacility::UniqueBIGNUM result{BN_new()};
+  if (!result || !BN_mod_exp(result.get(), g, exponent, N, ctx)) {
+    throw std::runtime_error("SecureRemotePassword log | powerOfGenerator(): "
+                             "BN_mod_exp failed.");
+  }
+  return result;
 }
 /******************************************************************************/
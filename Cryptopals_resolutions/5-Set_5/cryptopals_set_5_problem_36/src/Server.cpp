@@ -1,5 +1,6 @@
 #include <nlohmann/json.hpp>
 #include <openssl/conf.h>
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/sha.h>
@@ -29,7 +30,7 @@ Server::Server(const bool debugFlag, const unsigned int defaultGroupId)
                                  getSrpParametersFilenameLocation()},
       _minSaltSizesMap{EncryptionUtility::getMinSaltSizes()},
       _hashMap{EncryptionUtility::getHashMap()} {
-  _srpParametersMap = SrpParametersLoader::loadSrpParameters(
+  _srpParametersMap = SrpParametersLoader::getSrpParameters(
       getSrpParametersFilenameLocation());
   const unsigned int minimumValueGroupId{3};
   _minGroupId = _srpParametersMap.begin()->first;
@@ -198,19 +199,10 @@ void Server::handleRegisterInit() {
                               extractedGroupId <= _maxGroupId)
                                  ? extractedGroupId
                                  : _defaultGroupId;
-          std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
           // cliend ID validation
           if (extractedClientId.size() == 0) {
             throw std::runtime_error("Server log | handleRegisterInit(): "
                                      "ClientId is null");
-          } else if (_secureRemotePasswordMap.find(extractedClientId) !=
-                         _secureRemotePasswordMap.end() &&
-                     _secureRemotePasswordMap[extractedClientId]
-                         ->_registrationComplete) {
-            crow::json::wvalue err;
-            err["message"] = "Server log | handleRegisterInit(): Conflict, "
-                             "client is already registered";
-            return crow::response(409, err);
           }
           if (_debugFlag) {
             std::cout << "\n--- Server log | Extracted Data from a new client "
@@ -220,22 +212,40 @@ void Server::handleRegisterInit() {
             std::cout << "\tRequested group: " << extractedGroupId << std::endl;
             std::cout << "----------------------" << std::endl;
           }
-          const unsigned int minSaltSize = _minSaltSizesMap.at(
-              _srpParametersMap.at(extractedGroupId)._hashName);
+          const SrpParametersLoader::SrpParameters &srpParameters =
+              _srpParametersMap.at(extractedGroupId);
+          const unsigned int minSaltSize =
+              _minSaltSizesMap.at(srpParameters._hashName);
           const std::string salt =
               EncryptionUtility::generateCryptographicNonce(minSaltSize);
-          const std::string hash =
-              _srpParametersMap[extractedGroupId]._hashName;
-          _secureRemotePasswordMap[extractedClientId] =
-              std::make_unique<SessionData>(extractedGroupId, salt, hash,
+          // the session is built before taking the lock, its constructor loads
+          // the SRP parameters file
+          std::shared_ptr<SessionData> sessionData =
+              std::make_shared<SessionData>(extractedGroupId, salt,
+                                            srpParameters._hashName,
                                             _debugFlag);
+          {
+            std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
+            const auto it = _secureRemotePasswordMap.find(extractedClientId);
+            if (it != _secureRemotePasswordMap.end()) {
+              std::lock_guard<std::mutex> sessionLock(it->second->_mutex);
+              if (it->second->_state !=
+                  SessionData::State::RegistrationStarted) {
+                crow::json::wvalue err;
+                err["message"] = "Server log | handleRegisterInit(): Conflict, "
+                                 "client is already registered";
+                return crow::response(409, err);
+              }
+            }
+            _secureRemotePasswordMap[extractedClientId] = sessionData;
+          }
           // reply to the client with the group ID parameters and the salt s
           res["clientId"] = extractedClientId;
           res["groupId"] = extractedGroupId;
-          res["groupName"] = _srpParametersMap[extractedGroupId]._groupName;
-          res["primeN"] = _srpParametersMap[extractedGroupId]._nHex;
-          res["generatorG"] = _srpParametersMap[extractedGroupId]._g;
-          res["sha"] = _srpParametersMap[extractedGroupId]._hashName;
+          res["groupName"] = srpParameters._groupName;
+          res["primeN"] = srpParameters._nHex;
+          res["generatorG"] = srpParameters._g;
+          res["sha"] = srpParameters._hashName;
           res["salt"] = salt;
           return crow::response(201, res);
         } catch (const nlohmann::json::exception &e) {
@@ -275,41 +285,73 @@ void Server::handleRegisterComplete() {
               parsedJson.at("clientId").get<std::string>();
           std::string extractedVHex = parsedJson.at("v").get<std::string>();
           // client ID validation
-          std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
           if (extractedClientId.empty()) {
             throw std::runtime_error("Server log | handleRegisterComplete(): "
                                      "ClientId is null");
-          } else if (_secureRemotePasswordMap.find(extractedClientId) ==
-                     _secureRemotePasswordMap.end()) {
+          }
+          const std::shared_ptr<SessionData> sessionData =
+              findSession(extractedClientId);
+          if (!sessionData) {
             throw std::runtime_error("Server log | handleRegisterComplete(): "
                                      "ClientId not found.");
-          } else if (_secureRemotePasswordMap.find(extractedClientId) !=
-                         _secureRemotePasswordMap.end() &&
-                     _secureRemotePasswordMap[extractedClientId]
-                         ->_registrationComplete) {
-            crow::json::wvalue err;
-            err["message"] = "Server log | handleRegisterInit(): Conflict, "
-                             "client is already registered";
-            return crow::response(409, err);
+          }
+          unsigned int groupId;
+          unsigned long version;
+          {
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            if (sessionData->_state !=
+                SessionData::State::RegistrationStarted) {
+              crow::json::wvalue err;
+              err["message"] = "Server log | handleRegisterInit(): Conflict, "
+                               "client is already registered";
+              return crow::response(409, err);
+            }
+            groupId = sessionData->_groupId;
+            version = sessionData->_version;
           }
           // v validation
           if (extractedVHex.empty()) {
             throw std::runtime_error("Server log | handleRegisterComplete(): "
                                      "extractedVHex is null");
           }
+          const auto srpParametersIt = _srpParametersMap.find(groupId);
+          if (srpParametersIt == _srpParametersMap.end()) {
+            throw std::runtime_error("Server log | handleRegisterComplete(): "
+                                     "Group ID not found.");
+          }
+          MessageExtractionFacility::UniqueBIGNUM v{
+              MessageExtractionFacility::hexToUniqueBIGNUM(extractedVHex)};
+          const BIGNUM *N{
+              MyCryptoLibrary::SecureRemotePassword::getSrpGroup(groupId)
+                  ._N.get()};
           const bool vValidationResult =
-              vValidation(extractedClientId, extractedVHex);
+              vValidation(extractedClientId, v.get(), N);
           if (!vValidationResult) {
             throw std::runtime_error("Server log | handleRegisterComplete(): v "
                                      "received is not valid for client: " +
                                      extractedClientId);
           }
-          // store the v parameter
-          _secureRemotePasswordMap[extractedClientId]->_vHex = extractedVHex;
+          // store the v parameter, only if the session was neither replaced
+          // by a new registration nor completed in the meantime
+          {
+            std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            const auto it = _secureRemotePasswordMap.find(extractedClientId);
+            if (it == _secureRemotePasswordMap.end() ||
+                it->second != sessionData ||
+                sessionData->_version != version) {
+              crow::json::wvalue err;
+              err["message"] =
+                  "Server log | handleRegisterComplete(): Conflict, "
+                  "registration changed concurrently";
+              return crow::response(409, err);
+            }
+            sessionData->_v = std::move(v);
+            sessionData->_state = SessionData::State::Registered;
+            ++sessionData->_version;
+          }
           // reply to the client with the acknowledgment of successful
           // registration completion
-          _secureRemotePasswordMap[extractedClientId]->_registrationComplete =
-              true;
           res["confirmation"] = "Ack";
           return crow::response(201, res);
         } catch (const nlohmann::json::exception &e) {
@@ -337,7 +379,9 @@ void Server::handleRegisterComplete() {
  *
  * This method runs the route that performs the Secure Remote Password protocol
  * initialization step, and the verifications and calculations associated with
- * that exchange.
+ * that exchange. The private and public keys are calculated without holding
+ * any lock, they are published in the session only if no other step of the
+ * same session was published in the meantime.
  */
 void Server::handleAuthenticationInit() {
   CROW_ROUTE(_app, "/srp/auth/init")
@@ -355,43 +399,61 @@ void Server::handleAuthenticationInit() {
             std::cout << "----------------------" << std::endl;
           }
           // client ID verification
-          std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
           if (extractedClientId.empty()) {
             throw std::runtime_error("Server log | handleAuthenticationInit(): "
                                      "Client received is null");
-          } else if (_secureRemotePasswordMap.find(extractedClientId) ==
-                     _secureRemotePasswordMap.end()) {
+          }
+          const std::shared_ptr<SessionData> sessionData =
+              findSession(extractedClientId);
+          if (!sessionData) {
             throw std::runtime_error("Server log | handleAuthenticationInit(): "
                                      "Client " +
                                      extractedClientId +
                                      " has not registered before.");
-          } else if (!_secureRemotePasswordMap[extractedClientId]
-                          ->_registrationComplete) {
+          }
+          unsigned int groupId;
+          std::string salt;
+          MessageExtractionFacility::UniqueBIGNUM v;
+          unsigned long version;
+          {
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            if (sessionData->_state ==
+                SessionData::State::RegistrationStarted) {
+              throw std::runtime_error(
+                  "Server log | handleAuthenticationInit(): "
+                  "Client " +
+                  extractedClientId + " has not a completed registration.");
+            }
+            groupId = sessionData->_groupId;
+            salt = sessionData->_salt;
+            v.reset(BN_dup(sessionData->_v.get()));
+            version = sessionData->_version;
+          }
+          if (!v) {
             throw std::runtime_error("Server log | handleAuthenticationInit(): "
-                                     "Client " +
-                                     extractedClientId +
-                                     " has not a completed registration.");
+                                     "Failed to copy the session data.");
           }
-          const unsigned int groupId{
-              _secureRemotePasswordMap[extractedClientId]->_groupId};
-          const long unsigned int saltSize{
-              _secureRemotePasswordMap[extractedClientId]->_salt.size()};
-          const long unsigned int minSaltSize{
-              _minSaltSizesMap.at(_srpParametersMap.at(groupId)._hashName)};
-          const std::string extractedVHex{
-              _secureRemotePasswordMap[extractedClientId]->_vHex};
-          if (_srpParametersMap.find(groupId) == _srpParametersMap.end()) {
+          const auto srpParametersIt = _srpParametersMap.find(groupId);
+          if (srpParametersIt == _srpParametersMap.end()) {
             throw std::runtime_error("Server log | handleAuthenticationInit(): "
                                      "Client " +
                                      extractedClientId +
                                      ": stored group ID is not valid.");
-          } else if (saltSize < minSaltSize) {
+          }
+          const SrpParametersLoader::SrpParameters &srpParameters =
+              srpParametersIt->second;
+          const MyCryptoLibrary::SecureRemotePassword::SrpGroup &group{
+              MyCryptoLibrary::SecureRemotePassword::getSrpGroup(groupId)};
+          const BIGNUM *N{group._N.get()};
+          const long unsigned int minSaltSize{
+              _minSaltSizesMap.at(srpParameters._hashName)};
+          if (salt.size() < minSaltSize) {
             throw std::runtime_error(
                 "Server log | handleAuthenticationInit(): "
                 "Client " +
                 extractedClientId +
                 ": stored salt doesn't meet minimum size criteria.");
-          } else if (!vValidation(extractedClientId, extractedVHex)) {
+          } else if (!vValidation(extractedClientId, v.get(), N)) {
             throw std::runtime_error(
                 "Server log | handleAuthenticationInit(): "
                 "Client " +
@@ -399,51 +461,58 @@ void Server::handleAuthenticationInit() {
                 ": stored v doesn't meet the minimum criteria.");
           }
           // private key generation
-          const unsigned int minPrivateKeyBits =
-              _secureRemotePasswordMap[extractedClientId]
-                  ->_secureRemotePassword->getMinSizePrivateKey();
-          _secureRemotePasswordMap[extractedClientId]->_privateKeyHex =
+          MessageExtractionFacility::UniqueBIGNUM privateKey{
               MyCryptoLibrary::SecureRemotePassword::generatePrivateKey(
-                  _srpParametersMap.at(groupId)._nHex, minPrivateKeyBits);
+                  N, MyCryptoLibrary::SecureRemotePassword::
+                         getMinSizePrivateKey())};
           if (_debugFlag) {
             std::cout << "\n--- Server log | Private key generated at the "
                          "authentication phase---"
                       << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
-            std::cout
-                << "\tPrivate key: "
-                << _secureRemotePasswordMap[extractedClientId]->_privateKeyHex
-                << std::endl;
+            std::cout << "\tPrivate key: "
+                      << MessageExtractionFacility::BIGNUMToHex(
+                             privateKey.get())
+                      << std::endl;
             std::cout << "----------------------" << std::endl;
           }
           // public key generation
-          _secureRemotePasswordMap[extractedClientId]->_publicKeyHex =
+          const BIGNUM *g{group._g.get()};
+          MessageExtractionFacility::UniqueBIGNUM publicKey{
               MyCryptoLibrary::SecureRemotePassword::calculatePublicKey(
-                  _secureRemotePasswordMap[extractedClientId]->_privateKeyHex,
-                  _srpParametersMap.at(groupId)._nHex,
-                  MessageExtractionFacility::uintToHex(
-                      _srpParametersMap[groupId]._g),
-                  Server::getIsServerFlag(),
-                  _secureRemotePasswordMap[extractedClientId]
-                      ->_secureRemotePassword->getKMap()
-                      .at(groupId)
-                      .get(),
-                  _secureRemotePasswordMap[extractedClientId]->_vHex);
+                  privateKey.get(), N, g, Server::getIsServerFlag(),
+                  group._k.get(), v.get())};
+          // B is only converted to hexadecimal to be sent to the client
+          const std::string publicKeyHex{
+              MessageExtractionFacility::BIGNUMToHex(publicKey.get())};
           if (_debugFlag) {
             std::cout << "\n--- Server log | Public key generated at the "
                          "authentication phase---"
                       << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
-            std::cout
-                << "\tPublic key: "
-                << _secureRemotePasswordMap[extractedClientId]->_publicKeyHex
-                << std::endl;
+            std::cout << "\tPublic key: " << publicKeyHex << std::endl;
             std::cout << "----------------------" << std::endl;
           }
+          // publish b and B, unless another step of this session was
+          // published while they were calculated
+          {
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            if (sessionData->_version != version) {
+              crow::json::wvalue err;
+              err["message"] =
+                  "Server log | handleAuthenticationInit(): Conflict, "
+                  "authentication changed concurrently";
+              return crow::response(409, err);
+            }
+            sessionData->_privateKey = std::move(privateKey);
+            sessionData->_publicKey = std::move(publicKey);
+            sessionData->_state = SessionData::State::AuthenticationStarted;
+            ++sessionData->_version;
+          }
           // Send s, B and group ID to the client
           res["clientId"] = extractedClientId;
-          res["salt"] = _secureRemotePasswordMap[extractedClientId]->_salt;
-          res["B"] = _secureRemotePasswordMap[extractedClientId]->_publicKeyHex;
+          res["salt"] = salt;
+          res["B"] = publicKeyHex;
           res["groupId"] = groupId;
           return crow::response(201, res);
         } catch (const nlohmann::json::exception &e) {
@@ -471,7 +540,9 @@ void Server::handleAuthenticationInit() {
  *
  * This method runs the route that performs the Secure Remote Password
  * protocol finalization step, and the verifications and calculations
- * associated with that exchange.
+ * associated with that exchange. The calculations use a copy of the session
+ * data taken under the session lock, the results are published only if b and
+ * B were not replaced in the meantime.
  */
 void Server::handleAuthenticationComplete() {
   CROW_ROUTE(_app, "/srp/auth/complete")
@@ -493,23 +564,50 @@ void Server::handleAuthenticationComplete() {
             std::cout << "----------------------" << std::endl;
           }
           // client ID verification
-          std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
           if (extractedClientId.empty()) {
             throw std::runtime_error(
                 "Server log | handleAuthenticationComplete(): "
                 "Client received is null");
-          } else if (_secureRemotePasswordMap.find(extractedClientId) ==
-                     _secureRemotePasswordMap.end()) {
+          }
+          const std::shared_ptr<SessionData> sessionData =
+              findSession(extractedClientId);
+          if (!sessionData) {
             throw std::runtime_error(
                 "Server log | handleAuthenticationComplete(): "
                 "Client " +
                 extractedClientId + " has not registered before.");
-          } else if (!_secureRemotePasswordMap[extractedClientId]
-                          ->_registrationComplete) {
+          }
+          unsigned int groupId;
+          std::string hash;
+          std::vector<uint8_t> salt;
+          MessageExtractionFacility::UniqueBIGNUM v, privateKey, publicKey;
+          unsigned long version;
+          {
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            if (sessionData->_state ==
+                SessionData::State::RegistrationStarted) {
+              throw std::runtime_error(
+                  "Server log | handleAuthenticationComplete(): "
+                  "Client " +
+                  extractedClientId + " has not a completed registration.");
+            } else if (sessionData->_state == SessionData::State::Registered) {
+              throw std::runtime_error(
+                  "Server log | handleAuthenticationComplete(): "
+                  "Client " +
+                  extractedClientId + " has not started the authentication.");
+            }
+            groupId = sessionData->_groupId;
+            hash = sessionData->_hash;
+            salt = sessionData->_saltBytes;
+            v.reset(BN_dup(sessionData->_v.get()));
+            privateKey.reset(BN_dup(sessionData->_privateKey.get()));
+            publicKey.reset(BN_dup(sessionData->_publicKey.get()));
+            version = sessionData->_version;
+          }
+          if (!v || !privateKey || !publicKey) {
             throw std::runtime_error(
                 "Server log | handleAuthenticationComplete(): "
-                "Client " +
-                extractedClientId + " has not a completed registration.");
+                "Failed to copy the session data.");
           }
           // other parameters verification
           if (extractedMHex.empty() || extractedAHex.empty()) {
@@ -517,20 +615,22 @@ void Server::handleAuthenticationComplete() {
                 "Server log | handleAuthenticationComplete(): "
                 "Parameters received are empty.");
           }
-          // Client's public key A update at the server side
-          _secureRemotePasswordMap.at(extractedClientId)->_peerPublicKeyHex =
-              extractedAHex;
+          const SrpParametersLoader::SrpParameters &srpParameters =
+              _srpParametersMap.at(groupId);
+          // the values received are converted once, the calculations below
+          // only use BIGNUMs and raw bytes
+          const MyCryptoLibrary::SecureRemotePassword::SrpGroup &group{
+              MyCryptoLibrary::SecureRemotePassword::getSrpGroup(groupId)};
+          const BIGNUM *N{group._N.get()};
+          const BIGNUM *g{group._g.get()};
+          MessageExtractionFacility::UniqueBIGNUM A{
+              MessageExtractionFacility::hexToUniqueBIGNUM(extractedAHex)};
+          const std::vector<uint8_t> extractedM{
+              MessageExtractionFacility::hexToBytes(extractedMHex)};
           // u calculation
-          _secureRemotePasswordMap.at(extractedClientId)
-              ->_uHex = MyCryptoLibrary::SecureRemotePassword::calculateU(
-              _srpParametersMap
-                  .at(_secureRemotePasswordMap.at(extractedClientId)->_groupId)
-                  ._hashName,
-              _secureRemotePasswordMap.at(extractedClientId)->_peerPublicKeyHex,
-              _secureRemotePasswordMap.at(extractedClientId)->_publicKeyHex,
-              _srpParametersMap
-                  .at(_secureRemotePasswordMap.at(extractedClientId)->_groupId)
-                  ._nHex);
+          MessageExtractionFacility::UniqueBIGNUM u{
+              MyCryptoLibrary::SecureRemotePassword::calculateU(
+                  srpParameters._hashName, A.get(), publicKey.get(), N)};
           if (_debugFlag) {
             std::cout
                 << "\n--- Server log | Scrambling parameter u generated at the "
@@ -538,64 +638,44 @@ void Server::handleAuthenticationComplete() {
                 << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
             std::cout << "\tu = H(PAD(A) | PAD(B)): "
-                      << _secureRemotePasswordMap.at(extractedClientId)->_uHex
+                      << MessageExtractionFacility::BIGNUMToHex(u.get())
                       << std::endl;
             std::cout << "----------------------" << std::endl;
           }
           // S server calculation
-          _secureRemotePasswordMap.at(extractedClientId)
-              ->_SHex = MyCryptoLibrary::SecureRemotePassword::calculateSServer(
-              _secureRemotePasswordMap.at(extractedClientId)->_peerPublicKeyHex,
-              _secureRemotePasswordMap.at(extractedClientId)->_vHex,
-              _secureRemotePasswordMap.at(extractedClientId)->_uHex,
-              _secureRemotePasswordMap.at(extractedClientId)->_privateKeyHex,
-              _srpParametersMap
-                  .at(_secureRemotePasswordMap.at(extractedClientId)->_groupId)
-                  ._nHex);
+          MessageExtractionFacility::UniqueBIGNUM S{
+              MyCryptoLibrary::SecureRemotePassword::calculateSServer(
+                  A.get(), v.get(), u.get(), privateKey.get(), N)};
           if (_debugFlag) {
             std::cout << "\n--- Server log | Shared secret S generated at the "
                          "authentication phase---"
                       << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
             std::cout << "\tS = (A * v^u) ^ b mod N: "
-                      << _secureRemotePasswordMap.at(extractedClientId)->_SHex
+                      << MessageExtractionFacility::BIGNUMToHex(S.get())
                       << std::endl;
             std::cout << "----------------------" << std::endl;
           }
           // K calculation
-          _secureRemotePasswordMap.at(extractedClientId)->_KHex =
-              MyCryptoLibrary::SecureRemotePassword::calculateK(
-                  _secureRemotePasswordMap.at(extractedClientId)->_hash,
-                  _secureRemotePasswordMap.at(extractedClientId)->_SHex);
+          std::vector<uint8_t> K{
+              MyCryptoLibrary::SecureRemotePassword::calculateK(hash, S.get())};
           if (_debugFlag) {
             std::cout << "\n--- Server log | Session key K generated at the "
                          "authentication phase---"
                       << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
             std::cout << "\tK(hex) = H(S): '"
-                      << _secureRemotePasswordMap.at(extractedClientId)->_KHex
-                      << "'." << std::endl;
+                      << MessageExtractionFacility::toHexString(K) << "'."
+                      << std::endl;
             std::cout << "----------------------" << std::endl;
           }
           // M calculation
-          _secureRemotePasswordMap.at(extractedClientId)
-              ->_MHex = MyCryptoLibrary::SecureRemotePassword::calculateM(
-              _secureRemotePasswordMap.at(extractedClientId)->_hash,
-              _srpParametersMap
-                  .at(_secureRemotePasswordMap.at(extractedClientId)->_groupId)
-                  ._nHex,
-              MessageExtractionFacility::uintToHex(
-                  _srpParametersMap
-                      .at(_secureRemotePasswordMap.at(extractedClientId)
-                              ->_groupId)
-                      ._g),
-              extractedClientId,
-              _secureRemotePasswordMap.at(extractedClientId)->_salt,
-              _secureRemotePasswordMap.at(extractedClientId)
-                  ->_peerPublicKeyHex, // A
-              _secureRemotePasswordMap.at(extractedClientId)
-                  ->_publicKeyHex, // B
-              _secureRemotePasswordMap.at(extractedClientId)->_KHex);
+          std::vector<uint8_t> M{
+              MyCryptoLibrary::SecureRemotePassword::calculateM(
+                  hash, N, g, extractedClientId, salt,
+                  A.get(),         // A
+                  publicKey.get(), // B
+                  K)};
           if (_debugFlag) {
             std::cout
                 << "\n--- Server log | Verification value M generated at the "
@@ -603,36 +683,53 @@ void Server::handleAuthenticationComplete() {
                 << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
             std::cout << "\tM(hex): '"
-                      << _secureRemotePasswordMap.at(extractedClientId)->_MHex
-                      << "'." << std::endl;
+                      << MessageExtractionFacility::toHexString(M) << "'."
+                      << std::endl;
             std::cout << "----------------------" << std::endl;
           }
-          if (_secureRemotePasswordMap.at(extractedClientId)->_MHex !=
-              extractedMHex) {
+          if (M.size() != extractedM.size() ||
+              CRYPTO_memcmp(M.data(), extractedM.data(), M.size()) != 0) {
             crow::json::wvalue err;
             err["message"] = "SRP authentication failed";
             return crow::response(403, err);
           }
           // M2 calculation
-          _secureRemotePasswordMap.at(extractedClientId)
-              ->_M2Hex = MyCryptoLibrary::SecureRemotePassword::calculateM2(
-              _secureRemotePasswordMap.at(extractedClientId)->_hash,
-              _secureRemotePasswordMap.at(extractedClientId)->_peerPublicKeyHex,
-              _secureRemotePasswordMap.at(extractedClientId)->_MHex,
-              _secureRemotePasswordMap.at(extractedClientId)->_KHex);
+          std::vector<uint8_t> M2{
+              MyCryptoLibrary::SecureRemotePassword::calculateM2(hash, A.get(),
+                                                                 M, K)};
+          // M2 is only converted to hexadecimal to be sent to the client
+          const std::string M2Hex{MessageExtractionFacility::toHexString(M2)};
           if (_debugFlag) {
             std::cout
                 << "\n--- Server log | Verification value M2 generated at the "
                    "authentication phase---"
                 << std::endl;
             std::cout << "\tClient ID: " << extractedClientId << std::endl;
-            std::cout << "\tM2(hex): '"
-                      << _secureRemotePasswordMap.at(extractedClientId)->_M2Hex
-                      << "'." << std::endl;
+            std::cout << "\tM2(hex): '" << M2Hex << "'." << std::endl;
             std::cout << "----------------------" << std::endl;
           }
+          // publish the session key, unless b and B were replaced by another
+          // authentication initialization in the meantime
+          {
+            std::lock_guard<std::mutex> sessionLock(sessionData->_mutex);
+            if (sessionData->_version != version) {
+              crow::json::wvalue err;
+              err["message"] =
+                  "Server log | handleAuthenticationComplete(): Conflict, "
+                  "authentication changed concurrently";
+              return crow::response(409, err);
+            }
+            sessionData->_peerPublicKey = std::move(A);
+            sessionData->_u = std::move(u);
+            sessionData->_S = std::move(S);
+            sessionData->_K = std::move(K);
+            sessionData->_M = std::move(M);
+            sessionData->_M2 = std::move(M2);
+            sessionData->_state = SessionData::State::Authenticated;
+            ++sessionData->_version;
+          }
           res["message"] = "SRP authentication successful";
-          res["M2"] = _secureRemotePasswordMap.at(extractedClientId)->_M2Hex;
+          res["M2"] = M2Hex;
           return crow::response(201, res);
         } catch (const nlohmann::json::exception &e) {
           crow::json::wvalue err;
@@ -653,6 +750,27 @@ void Server::handleAuthenticationComplete() {
       });
 }
 /******************************************************************************/
+/**
+ * @brief This method returns the session of a client ID.
+ *
+ * This method returns the session of a client ID, the session map lock is
+ * only held during the lookup. The session returned stays valid even if it
+ * is removed from the map afterwards.
+ *
+ * @param clientId The client ID of the session.
+ *
+ * @return The session of the client ID, or nullptr if there is none.
+ */
+std::shared_ptr<SessionData>
+Server::findSession(const std::string &clientId) const {
+  std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
+  const auto it = _secureRemotePasswordMap.find(clientId);
+  if (it == _secureRemotePasswordMap.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+/******************************************************************************/
 /**
  * @brief This method perform the validation of the extracted v parameter
  * at the registration step.
@@ -661,44 +779,30 @@ void Server::handleAuthenticationComplete() {
  * at the registration step, it will test if v ∈ [1, N-1].
  *
  * @param clientId The clientId involved in this registration step.
- * @param vHex The v parameter in hexadecimal format.
+ * @param v The v parameter.
+ * @param N The group prime N of the session of the client.
  *
  * @return True if the validation passes, false otherwise.
  */
-bool Server::vValidation(const std::string &clientId, const std::string &vHex) {
+bool Server::vValidation(const std::string &clientId, const BIGNUM *v,
+                         const BIGNUM *N) const {
   try {
     if (clientId.empty()) {
       throw std::runtime_error("Server log | vValidation(): "
                                "ClientId is null");
-    } else if (_secureRemotePasswordMap.find(clientId) ==
-               _secureRemotePasswordMap.end()) {
+    } else if (!N) {
       throw std::runtime_error("Server log | vValidation(): "
-                               "ClientId not found.");
-    } else if (vHex.empty()) {
+                               "N is null.");
+    } else if (!v) {
       throw std::runtime_error("Server log | vValidation(): "
-                               "vHex is null");
+                               "v is null");
     }
-    const std::string &nHex =
-        _srpParametersMap[_secureRemotePasswordMap[clientId]->_groupId]._nHex;
-    BIGNUM *vBn = nullptr;
-    BIGNUM *nBn = nullptr;
-    if (!BN_hex2bn(&vBn, vHex.c_str()) || !BN_hex2bn(&nBn, nHex.c_str())) {
-      BN_free(vBn);
-      BN_free(nBn);
-      throw std::runtime_error(
-          "Server log | handleRegisterComplete(): Failed to "
-          "convert v or N to BIGNUM.");
-    }
-    if (BN_is_zero(vBn) || BN_is_negative(vBn) || BN_cmp(vBn, nBn) >= 0) {
-      BN_free(vBn);
-      BN_free(nBn);
+    if (BN_is_zero(v) || BN_is_negative(v) || BN_cmp(v, N) >= 0) {
       throw std::runtime_error(
           "Server log | handleRegisterComplete(): v is not "
           "in the valid range (0 < v < N) for client: " +
           clientId);
     }
-    BN_free(vBn);
-    BN_free(nBn);
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     return false;
@@ -719,13 +823,18 @@ void Server::registeredUsersEndpoint() {
   CROW_ROUTE(_app, "/srp/registered/users").methods("GET"_method)([this]() {
     crow::json::wvalue res;
     try {
-      std::vector<std::string> registeredUsers;
+      std::vector<std::pair<std::string, std::shared_ptr<SessionData>>>
+          sessions;
       {
         std::lock_guard<std::mutex> lock(_secureRemotePasswordMapMutex);
-        for (const auto &pair : _secureRemotePasswordMap) {
-          if (pair.second && pair.second->_registrationComplete) {
-            registeredUsers.push_back(pair.first);
-          }
+        sessions.assign(_secureRemotePasswordMap.begin(),
+                        _secureRemotePasswordMap.end());
+      }
+      std::vector<std::string> registeredUsers;
+      for (const auto &pair : sessions) {
+        std::lock_guard<std::mutex> sessionLock(pair.second->_mutex);
+        if (pair.second->_state != SessionData::State::RegistrationStarted) {
+          registeredUsers.push_back(pair.first);
         }
       }
       res["users"] = registeredUsers;
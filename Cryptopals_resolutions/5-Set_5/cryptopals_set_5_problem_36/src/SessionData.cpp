@@ -25,6 +25,7 @@ SessionData::SessionData(const unsigned int groupId, const std::string &salt,
   }
   _groupId = groupId;
   _salt = salt;
+  _saltBytes = MessageExtractionFacility::hexToBytes(salt);
   _hash = hash;
 };
 /******************************************************************************/
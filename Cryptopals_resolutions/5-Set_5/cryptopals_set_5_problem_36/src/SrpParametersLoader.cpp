@@ -1,6 +1,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 
@@ -67,3 +68,29 @@ SrpParametersLoader::loadSrpParameters(const std::string &filename) {
   }
   return paramsMap;
 }
+/******************************************************************************/
+/**
+ * @brief This method returns the public configurations of a given file.
+ *
+ * The file is only read and parsed the first time it is requested, the
+ * result is kept for the lifetime of the process. It is safe to call this
+ * method from several threads.
+ *
+ * @param filename The file address where the public configurations of
+ * the Secure Remote Password protocol are.
+ *
+ * @return The file content in a structured dictionary.
+ */
+const std::map<unsigned int, SrpParametersLoader::SrpParameters> &
+SrpParametersLoader::getSrpParameters(const std::string &filename) {
+  static std::mutex filesMutex;
+  static std::map<std::string, std::map<unsigned int, SrpParameters>> files;
+  std::lock_guard<std::mutex> lock(filesMutex);
+  auto it = files.find(filename);
+  if (it == files.end()) {
+    // the entries are never erased, so the returned reference stays valid
+    it = files.emplace(filename, loadSrpParameters(filename)).first;
+  }
+  return it->second;
+}
+/******************************************************************************/
@@ -1610,3 +1610,108 @@ TEST_F(SessionDataTest, CalculateM2_UnknownHash_ShouldThrowAnError) {
                 ::testing::EndsWith("hash algorithm not recognized."));
   }
 }
+
+/**
+ * @test Test the binary API of the SRP calculations with the RFC 5054 test
+ * vector.
+ * @brief Verifies that the client and the server agree on the premaster
+ * secret S when the calculations are done on BIGNUMs, and that S, u and x
+ * match the reference values.
+ */
+TEST_F(SessionDataTest,
+       BinaryApi_WithRFC5054TestVector_ShouldMatchReference) {
+  const SrpParametersLoader::SrpParameters &parameters{
+      _srpParametersMap.at(_groupIdRFC5054TestVector)};
+  MessageExtractionFacility::UniqueBIGNUM N{
+      MessageExtractionFacility::hexToUniqueBIGNUM(parameters._nHex)};
+  MessageExtractionFacility::UniqueBIGNUM g{BN_new()};
+  ASSERT_TRUE(BN_set_word(g.get(), parameters._g));
+  MessageExtractionFacility::UniqueBIGNUM a{
+      MessageExtractionFacility::hexToUniqueBIGNUM(_aRFC5054TestVectorValue)};
+  MessageExtractionFacility::UniqueBIGNUM b{
+      MessageExtractionFacility::hexToUniqueBIGNUM(_bRFC5054TestVectorValue)};
+  MessageExtractionFacility::UniqueBIGNUM k{
+      MessageExtractionFacility::hexToUniqueBIGNUM(
+          _kMultiplierRFC5054TestVectorValue)};
+  const std::vector<uint8_t> salt{
+      MessageExtractionFacility::hexToBytes(_saltRFC5054TestVectorValue)};
+
+  MessageExtractionFacility::UniqueBIGNUM x{
+      MyCryptoLibrary::SecureRemotePassword::calculateX(
+          _hashNameRFC5054TestVectorValue, _usernameRFC5054TestVectorValue,
+          _passwordRFC5054TestVectorValue, salt)};
+  MessageExtractionFacility::UniqueBIGNUM v{
+      MyCryptoLibrary::SecureRemotePassword::calculateV(x.get(), N.get(),
+                                                        g.get())};
+  MessageExtractionFacility::UniqueBIGNUM A{
+      MyCryptoLibrary::SecureRemotePassword::calculatePublicKey(
+          a.get(), N.get(), g.get(), false)};
+  MessageExtractionFacility::UniqueBIGNUM B{
+      MyCryptoLibrary::SecureRemotePassword::calculatePublicKey(
+          b.get(), N.get(), g.get(), true, k.get(), v.get())};
+  MessageExtractionFacility::UniqueBIGNUM u{
+      MyCryptoLibrary::SecureRemotePassword::calculateU(
+          _hashNameRFC5054TestVectorValue, A.get(), B.get(), N.get())};
+  MessageExtractionFacility::UniqueBIGNUM SClient{
+      MyCryptoLibrary::SecureRemotePassword::calculateSClient(
+          B.get(), k.get(), g.get(), x.get(), a.get(), u.get(), N.get())};
+  MessageExtractionFacility::UniqueBIGNUM SServer{
+      MyCryptoLibrary::SecureRemotePassword::calculateSServer(
+          A.get(), v.get(), u.get(), b.get(), N.get())};
+
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(x.get()),
+            _xRFC5054TestVectorValue);
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(v.get()),
+            _vRFC5054TestVectorValue);
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(A.get()),
+            _A_RFC5054TestVectorValue);
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(B.get()),
+            _B_RFC5054TestVectorValue);
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(u.get()),
+            _uRFC5054TestVectorValue);
+  EXPECT_EQ(BN_cmp(SClient.get(), SServer.get()), 0);
+  EXPECT_EQ(MessageExtractionFacility::BIGNUMToHex(SClient.get()),
+            _S_RFC5054TestVectorValue);
+}
+
+/**
+ * @test Test that the binary API of the proofs matches the hexadecimal API.
+ * @brief Verifies that K, M and M2 computed from raw bytes are the same values
+ * returned in hexadecimal format by the string overloads.
+ */
+TEST_F(SessionDataTest, BinaryApi_Proofs_ShouldMatchHexApi) {
+  const std::string hash{"SHA-256"};
+  const SrpParametersLoader::SrpParameters &parameters{
+      _srpParametersMap.at(_groupIdRFC5054TestVector)};
+  MessageExtractionFacility::UniqueBIGNUM N{
+      MessageExtractionFacility::hexToUniqueBIGNUM(parameters._nHex)};
+  MessageExtractionFacility::UniqueBIGNUM g{BN_new()};
+  ASSERT_TRUE(BN_set_word(g.get(), parameters._g));
+  MessageExtractionFacility::UniqueBIGNUM A{
+      MessageExtractionFacility::hexToUniqueBIGNUM(_A_RFC5054TestVectorValue)};
+  MessageExtractionFacility::UniqueBIGNUM B{
+      MessageExtractionFacility::hexToUniqueBIGNUM(_B_RFC5054TestVectorValue)};
+  MessageExtractionFacility::UniqueBIGNUM S{
+      MessageExtractionFacility::hexToUniqueBIGNUM(_S_RFC5054TestVectorValue)};
+
+  const std::vector<uint8_t> K{
+      MyCryptoLibrary::SecureRemotePassword::calculateK(hash, S.get())};
+  const std::vector<uint8_t> M{MyCryptoLibrary::SecureRemotePassword::calculateM(
+      hash, N.get(), g.get(), _usernameRFC5054TestVectorValue,
+      MessageExtractionFacility::hexToBytes(_saltRFC5054TestVectorValue),
+      A.get(), B.get(), K)};
+  const std::vector<uint8_t> M2{
+      MyCryptoLibrary::SecureRemotePassword::calculateM2(hash, A.get(), M, K)};
+
+  const std::string KHex{MyCryptoLibrary::SecureRemotePassword::calculateK(
+      hash, _S_RFC5054TestVectorValue)};
+  const std::string MHex{MyCryptoLibrary::SecureRemotePassword::calculateM(
+      hash, parameters._nHex, MessageExtractionFacility::BIGNUMToHex(g.get()),
+      _usernameRFC5054TestVectorValue, _saltRFC5054TestVectorValue,
+      _A_RFC5054TestVectorValue, _B_RFC5054TestVectorValue, KHex)};
+  EXPECT_EQ(MessageExtractionFacility::toHexString(K), KHex);
+  EXPECT_EQ(MessageExtractionFacility::toHexString(M), MHex);
+  EXPECT_EQ(MessageExtractionFacility::toHexString(M2),
+            MyCryptoLibrary::SecureRemotePassword::calculateM2(
+                hash, _A_RFC5054TestVectorValue, MHex, KHex));
+}
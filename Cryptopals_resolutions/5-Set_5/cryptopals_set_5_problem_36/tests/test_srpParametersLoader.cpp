@@ -218,3 +218,46 @@ TEST_F(SrpParametersLoaderTest,
     FAIL() << "Expected std::invalid_argument, but got a different exception";
   }
 }
+
+/**
+ * @test Test the method getSrpParameters
+ * @brief Ensures that the SRP parameters file is only parsed once per process
+ * and matches loadSrpParameters.
+ */
+TEST_F(SrpParametersLoaderTest, getSrpParameters_SameFile_ShouldBeShared) {
+  const std::string filename =
+      MyCryptoLibrary::SecureRemotePassword::getSrpParametersFilenameLocation();
+  const auto &srpParametersMap{SrpParametersLoader::getSrpParameters(filename)};
+  EXPECT_EQ(&SrpParametersLoader::getSrpParameters(filename),
+            &srpParametersMap);
+  _srpParametersMap = SrpParametersLoader::loadSrpParameters(filename);
+  ASSERT_EQ(srpParametersMap.size(), _srpParametersMap.size());
+  EXPECT_EQ(srpParametersMap.at(1)._nHex, _srpParametersMap.at(1)._nHex);
+}
+
+/**
+ * @test Test the method getSrpGroup
+ * @brief Ensures that the groups hold N, g and k of the SRP parameters file,
+ * and that an unknown group ID throws an error.
+ */
+TEST_F(SrpParametersLoaderTest,
+       getSrpGroup_WithGroupId_ShouldMatchParameters) {
+  _srpParametersMap = SrpParametersLoader::loadSrpParameters(
+      MyCryptoLibrary::SecureRemotePassword::
+          getSrpParametersFilenameLocation());
+  for (const auto &[groupId, parameters] : _srpParametersMap) {
+    const MyCryptoLibrary::SecureRemotePassword::SrpGroup &group{
+        MyCryptoLibrary::SecureRemotePassword::getSrpGroup(groupId)};
+    EXPECT_EQ(&MyCryptoLibrary::SecureRemotePassword::getSrpGroup(groupId),
+              &group);
+    EXPECT_EQ(group._NHex, parameters._nHex);
+    EXPECT_TRUE(BN_is_word(group._g.get(), parameters._g));
+    const BIGNUM *k{
+        MyCryptoLibrary::SecureRemotePassword::getKMap().at(groupId).get()};
+    EXPECT_EQ(BN_cmp(group._k.get(), k), 0);
+    EXPECT_NE(group._montgomeryContext, nullptr);
+  }
+  EXPECT_THROW(MyCryptoLibrary::SecureRemotePassword::getSrpGroup(
+                   _srpParametersMap.rbegin()->first + 1),
+               std::invalid_argument);
+}
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "BenchmarkSupport.hpp"
+
+namespace {
+
+std::atomic<std::size_t> allocationCount{0};
+
+} // namespace
+
+#if defined(__GLIBC__)
+// glibc lets the program interpose the allocator, the calls are forwarded to
+// its own implementation, so free does not need to be replaced
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *pointer, std::size_t size);
+
+void *malloc(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+}
+#else
+void *operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *pointer = std::malloc(size == 0 ? 1 : size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+#endif
+
+/******************************************************************************/
+std::size_t BenchmarkSupport::allocations() {
+  return allocationCount.load(std::memory_order_relaxed);
+}
+/******************************************************************************/
+std::vector<int64_t> BenchmarkSupport::messageSizeList() {
+  std::vector<int64_t> sizes{0};
+  for (int64_t size = 1; size < (64 << 20); size *= 8) {
+    sizes.push_back(size);
+  }
+  sizes.push_back(64 << 20);
+  return sizes;
+}
+/******************************************************************************/
+void BenchmarkSupport::messageSizes(
+    benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("bytes");
+  for (int64_t size : BenchmarkSupport::messageSizeList()) {
+    benchmark->Arg(size);
+  }
+}
+/******************************************************************************/
+void BenchmarkSupport::nonEmptyMessageSizes(
+    benchmark::internal::Benchmark *benchmark) {
+  benchmark->ArgName("bytes");
+  for (int64_t size : BenchmarkSupport::messageSizeList()) {
+    if (size != 0) {
+      benchmark->Arg(size);
+    }
+  }
+}
+/******************************************************************************/
+std::vector<unsigned char> BenchmarkSupport::message(std::size_t size) {
+  std::vector<unsigned char> messageV(size);
+  uint32_t x{0x12345678};
+  for (unsigned char &byte : messageV) {
+    // xorshift32, the content does not matter, only that it is not constant
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    byte = static_cast<unsigned char>(x);
+  }
+  return messageV;
+}
+/******************************************************************************/
+void BenchmarkSupport::report(benchmark::State &state, std::size_t size,
+                              std::size_t allocationsBefore) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(size));
+  state.counters["allocs/call"] = benchmark::Counter(
+      static_cast<double>(BenchmarkSupport::allocations() - allocationsBefore),
+      benchmark::Counter::kAvgIterations);
+}
+/******************************************************************************/
+void BenchmarkSupport::openSSLEncryption(benchmark::State &state,
+                                         const EVP_CIPHER *cipher) {
+  const std::size_t keySize{16}; // bytes
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  const std::vector<unsigned char> keyV = BenchmarkSupport::message(keySize);
+  const std::vector<unsigned char> ivV(EVP_MAX_IV_LENGTH, 0);
+  std::vector<unsigned char> encryptedV(size + EVP_MAX_BLOCK_LENGTH);
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  EVP_EncryptInit_ex(ctx, cipher, nullptr, keyV.data(), ivV.data());
+  int length{0};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, ivV.data());
+    EVP_EncryptUpdate(ctx, encryptedV.data(), &length, messageV.data(),
+                      static_cast<int>(messageV.size()));
+    EVP_EncryptFinal_ex(ctx, encryptedV.data() + length, &length);
+    benchmark::DoNotOptimize(encryptedV.data());
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+  EVP_CIPHER_CTX_free(ctx);
+}
+/******************************************************************************/
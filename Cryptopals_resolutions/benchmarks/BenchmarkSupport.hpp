@@ -0,0 +1,84 @@
+#ifndef BENCHMARK_SUPPORT_HPP
+#define BENCHMARK_SUPPORT_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <openssl/evp.h>
+#include <string>
+#include <vector>
+
+namespace BenchmarkSupport {
+
+/**
+ * @brief Number of heap allocations made by the process so far
+ *
+ * Every malloc, calloc and realloc is counted, including the ones done by
+ * operator new and by OpenSSL. On platforms other than glibc only operator new
+ * is counted.
+ *
+ * @return The number of allocations since the start of the process
+ */
+std::size_t allocations();
+
+/**
+ * @brief Message sizes of the benchmarks
+ *
+ * The sizes go from 0 B to 64 MiB, multiplying by 8 at each step.
+ *
+ * @return The sizes in bytes
+ */
+std::vector<int64_t> messageSizeList();
+
+/**
+ * @brief Registers the message sizes of messageSizeList() as the only argument
+ * of a benchmark
+ *
+ * @param benchmark The benchmark to register the sizes in
+ */
+void messageSizes(benchmark::internal::Benchmark *benchmark);
+
+/**
+ * @brief Registers the message sizes of messageSizeList() but 0 B as the only
+ * argument of a benchmark
+ *
+ * Used by the block cipher benchmarks: the library functions return early on
+ * an empty message, while OpenSSL still pads and encrypts a full block, so a
+ * 0 B row would not compare the same work.
+ *
+ * @param benchmark The benchmark to register the sizes in
+ */
+void nonEmptyMessageSizes(benchmark::internal::Benchmark *benchmark);
+
+/**
+ * @brief Builds a deterministic pseudo random message
+ *
+ * @param size The size of the message in bytes
+ * @return The message
+ */
+std::vector<unsigned char> message(std::size_t size);
+
+/**
+ * @brief Reports the throughput and the allocations per call of a benchmark
+ *
+ * @param state The state of the benchmark, after the timed loop
+ * @param size The size of the message processed by each call
+ * @param allocationsBefore The value of allocations() before the timed loop
+ */
+void report(benchmark::State &state, std::size_t size,
+            std::size_t allocationsBefore);
+
+/**
+ * @brief Benchmarks the encryption of a message with an OpenSSL EVP cipher
+ *
+ * The message size is the first argument of the benchmark. The cipher context
+ * is reused, the key is set once and only the iv is reset on every call.
+ *
+ * @param state The state of the benchmark
+ * @param cipher The 128-bit key cipher
+ */
+void openSSLEncryption(benchmark::State &state, const EVP_CIPHER *cipher);
+
+} // namespace BenchmarkSupport
+
+#endif // BENCHMARK_SUPPORT_HPP
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <openssl/evp.h>
+
+#include "../4-Set_4/cryptopals_set_4_problem_27/include/AesCbcMachine.h"
+#include "../4-Set_4/cryptopals_set_4_problem_27/include/PadPKCS_7.h"
+#include "BenchmarkSupport.hpp"
+
+namespace {
+
+const unsigned int blockSize{16}; // bytes
+
+} // namespace
+
+/**
+ * @brief AesCbcMachine::aesCbcEncryption of set 4 problem 27, with PKCS#7
+ * padding
+ */
+static void BM_AesCbcMachine(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  // built once, the constructor logs the key it generates
+  static AesCbcMachine aesCbcMachine(blockSize,
+                                     std::make_shared<PadPKCS_7>(blockSize));
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  bool b{false};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aesCbcMachine.aesCbcEncryption(messageV, &b));
+  }
+  if (b == false) {
+    state.SkipWithError("the encryption failed");
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK(BM_AesCbcMachine)->Apply(BenchmarkSupport::nonEmptyMessageSizes);
+
+/**
+ * @brief OpenSSL EVP AES-128-CBC, with PKCS#7 padding
+ */
+static void BM_OpenSSLAes128Cbc(benchmark::State &state) {
+  BenchmarkSupport::openSSLEncryption(state, EVP_aes_128_cbc());
+}
+BENCHMARK(BM_OpenSSLAes128Cbc)->Apply(BenchmarkSupport::nonEmptyMessageSizes);
+
+BENCHMARK_MAIN();
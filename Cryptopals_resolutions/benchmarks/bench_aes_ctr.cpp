@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <openssl/evp.h>
+
+#include "../4-Set_4/cryptopals_set_4_problem_26/include/AesCtrMachine.h"
+#include "BenchmarkSupport.hpp"
+
+namespace {
+
+const unsigned int blockSize{16}; // bytes
+
+} // namespace
+
+/**
+ * @brief AesCtrMachine::encryption of set 4 problem 26
+ */
+static void BM_AesCtrMachine(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  // built once, the constructor logs the key it generates
+  static AesCtrMachine aesCtrMachine(blockSize);
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  bool b{false};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    aesCtrMachine.resetIVCtrMode();
+    benchmark::DoNotOptimize(aesCtrMachine.encryption(messageV, &b));
+  }
+  if (b == false) {
+    state.SkipWithError("the encryption failed");
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK(BM_AesCtrMachine)->Apply(BenchmarkSupport::nonEmptyMessageSizes);
+
+/**
+ * @brief OpenSSL EVP AES-128-CTR
+ */
+static void BM_OpenSSLAes128Ctr(benchmark::State &state) {
+  BenchmarkSupport::openSSLEncryption(state, EVP_aes_128_ctr());
+}
+BENCHMARK(BM_OpenSSLAes128Ctr)->Apply(BenchmarkSupport::nonEmptyMessageSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <openssl/evp.h>
+#include <string>
+
+#include "../5-Set_5/cryptopals_set_5_problem_36/include/EncryptionUtility.hpp"
+#include "BenchmarkSupport.hpp"
+
+namespace {
+
+/**
+ * @brief Builds the input of the EncryptionUtility hash functions, which take
+ * the plaintext as a string
+ */
+std::string messageString(std::size_t size) {
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  return std::string(messageV.begin(), messageV.end());
+}
+
+} // namespace
+
+/**
+ * @brief EncryptionUtility::sha1/256/384/512 of set 5 problem 36, they return
+ * the digest in hexadecimal format
+ */
+template <std::string (*hashFunction)(const std::string &)>
+static void BM_EncryptionUtility(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  const std::string message = messageString(size);
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hashFunction(message));
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK_TEMPLATE(BM_EncryptionUtility, EncryptionUtility::sha1)
+    ->Apply(BenchmarkSupport::messageSizes);
+BENCHMARK_TEMPLATE(BM_EncryptionUtility, EncryptionUtility::sha256)
+    ->Apply(BenchmarkSupport::messageSizes);
+BENCHMARK_TEMPLATE(BM_EncryptionUtility, EncryptionUtility::sha384)
+    ->Apply(BenchmarkSupport::messageSizes);
+BENCHMARK_TEMPLATE(BM_EncryptionUtility, EncryptionUtility::sha512)
+    ->Apply(BenchmarkSupport::messageSizes);
+
+/**
+ * @brief OpenSSL EVP digest over a reused digest context, returning the raw
+ * digest
+ */
+template <const EVP_MD *(*mdFunction)()>
+static void BM_OpenSSLDigest(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  const std::string message = messageString(size);
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digestLength{0};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    EVP_DigestInit_ex(ctx, mdFunction(), nullptr);
+    EVP_DigestUpdate(ctx, message.data(), message.size());
+    EVP_DigestFinal_ex(ctx, digest, &digestLength);
+    benchmark::DoNotOptimize(digest);
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+  EVP_MD_CTX_free(ctx);
+}
+BENCHMARK_TEMPLATE(BM_OpenSSLDigest, EVP_sha1)
+    ->Apply(BenchmarkSupport::messageSizes);
+BENCHMARK_TEMPLATE(BM_OpenSSLDigest, EVP_sha256)
+    ->Apply(BenchmarkSupport::messageSizes);
+BENCHMARK_TEMPLATE(BM_OpenSSLDigest, EVP_sha384)
+    ->Apply(BenchmarkSupport::messageSizes);
+BENCHMARK_TEMPLATE(BM_OpenSSLDigest, EVP_sha512)
+    ->Apply(BenchmarkSupport::messageSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+
+#include "../4-Set_4/cryptopals_set_4_problem_31_32/include/HMAC_SHA1.hpp"
+#include "BenchmarkSupport.hpp"
+
+namespace {
+
+const std::size_t keySize{64}; // bytes
+
+} // namespace
+
+/**
+ * @brief MyCryptoLibrary::HMAC_SHA1::hmac of set 4 problem 31_32, starting
+ * from the key, as the server did before caching its key schedule
+ */
+static void BM_MyCryptoLibraryHMAC_SHA1(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  MyCryptoLibrary::HMAC_SHA1 hmacSha1;
+  const std::vector<unsigned char> keyV = BenchmarkSupport::message(keySize);
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hmacSha1.hmac(keyV, messageV));
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK(BM_MyCryptoLibraryHMAC_SHA1)->Apply(BenchmarkSupport::messageSizes);
+
+/**
+ * @brief MyCryptoLibrary::HMAC_SHA1::hmac of set 4 problem 31_32, from a key
+ * schedule computed once
+ */
+static void BM_MyCryptoLibraryHMAC_SHA1KeySchedule(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  MyCryptoLibrary::HMAC_SHA1 hmacSha1;
+  const std::vector<unsigned char> keyV = BenchmarkSupport::message(keySize);
+  const MyCryptoLibrary::HMAC_SHA1::KeySchedule keySchedule =
+      hmacSha1.computeKeySchedule(keyV);
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hmacSha1.hmac(keySchedule, messageV));
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK(BM_MyCryptoLibraryHMAC_SHA1KeySchedule)
+    ->Apply(BenchmarkSupport::messageSizes);
+
+/**
+ * @brief OpenSSL EVP_MAC HMAC-SHA1 over a reused MAC context, initialised
+ * with the key on every call
+ */
+static void BM_OpenSSLHMAC_SHA1(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  const std::vector<unsigned char> keyV = BenchmarkSupport::message(keySize);
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  EVP_MAC *mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+  EVP_MAC_CTX *ctx = EVP_MAC_CTX_new(mac);
+  char digestName[] = "SHA1";
+  const OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digestName, 0),
+      OSSL_PARAM_construct_end()};
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  std::size_t digestLength{0};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    EVP_MAC_init(ctx, keyV.data(), keyV.size(), params);
+    EVP_MAC_update(ctx, messageV.data(), messageV.size());
+    EVP_MAC_final(ctx, digest, &digestLength, sizeof(digest));
+    benchmark::DoNotOptimize(digest);
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+  EVP_MAC_CTX_free(ctx);
+  EVP_MAC_free(mac);
+}
+BENCHMARK(BM_OpenSSLHMAC_SHA1)->Apply(BenchmarkSupport::messageSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <openssl/evp.h>
+#include <openssl/provider.h>
+
+#include "../4-Set_4/cryptopals_set_4_problem_30/include/MD4.hpp"
+#include "BenchmarkSupport.hpp"
+
+/**
+ * @brief MyCryptoLibrary::MD4::hash of set 4 problem 30
+ */
+static void BM_MyCryptoLibraryMD4(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  MyCryptoLibrary::MD4 md4;
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(md4.hash(messageV));
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK(BM_MyCryptoLibraryMD4)->Apply(BenchmarkSupport::messageSizes);
+
+/**
+ * @brief OpenSSL EVP MD4 over a reused digest context, MD4 lives in the legacy
+ * provider of OpenSSL 3
+ */
+static void BM_OpenSSLMD4(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  static OSSL_PROVIDER *legacy = OSSL_PROVIDER_load(nullptr, "legacy");
+  static OSSL_PROVIDER *defaultProvider = OSSL_PROVIDER_load(nullptr, "default");
+  EVP_MD *md4 = EVP_MD_fetch(nullptr, "MD4", nullptr);
+  if (legacy == nullptr || defaultProvider == nullptr || md4 == nullptr) {
+    state.SkipWithError("MD4 is not available in this OpenSSL");
+    return;
+  }
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digestLength{0};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    EVP_DigestInit_ex(ctx, md4, nullptr);
+    EVP_DigestUpdate(ctx, messageV.data(), messageV.size());
+    EVP_DigestFinal_ex(ctx, digest, &digestLength);
+    benchmark::DoNotOptimize(digest);
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+  EVP_MD_CTX_free(ctx);
+  EVP_MD_free(md4);
+}
+BENCHMARK(BM_OpenSSLMD4)->Apply(BenchmarkSupport::messageSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <openssl/evp.h>
+
+#include "../4-Set_4/cryptopals_set_4_problem_29/include/SHA1.hpp"
+#include "BenchmarkSupport.hpp"
+
+/**
+ * @brief MyCryptoLibrary::SHA1::hash of set 4 problem 29, with the backend
+ * given as the second argument
+ */
+static void BM_MyCryptoLibrarySHA1(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  const auto backend =
+      static_cast<MyCryptoLibrary::SHA1::Backend>(state.range(1));
+  if (backend == MyCryptoLibrary::SHA1::Backend::ShaNi &&
+      !MyCryptoLibrary::SHA1::shaNiSupported()) {
+    state.SkipWithError("the SHA extensions are not supported by this cpu");
+    return;
+  }
+  MyCryptoLibrary::SHA1 sha1(backend);
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sha1.hash(messageV));
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+}
+BENCHMARK(BM_MyCryptoLibrarySHA1)
+    ->ArgNames({"bytes", "backend"})
+    ->ArgsProduct(
+        {BenchmarkSupport::messageSizeList(),
+         {static_cast<int64_t>(MyCryptoLibrary::SHA1::Backend::Portable),
+          static_cast<int64_t>(MyCryptoLibrary::SHA1::Backend::ShaNi)}});
+
+/**
+ * @brief OpenSSL EVP SHA1 over a reused digest context
+ */
+static void BM_OpenSSLSHA1(benchmark::State &state) {
+  const std::size_t size = static_cast<std::size_t>(state.range(0));
+  const std::vector<unsigned char> messageV = BenchmarkSupport::message(size);
+  EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int digestLength{0};
+  const std::size_t allocationsBefore = BenchmarkSupport::allocations();
+  for (auto _ : state) {
+    EVP_DigestInit_ex(ctx, EVP_sha1(), nullptr);
+    EVP_DigestUpdate(ctx, messageV.data(), messageV.size());
+    EVP_DigestFinal_ex(ctx, digest, &digestLength);
+    benchmark::DoNotOptimize(digest);
+  }
+  BenchmarkSupport::report(state, size, allocationsBefore);
+  EVP_MD_CTX_free(ctx);
+}
+BENCHMARK(BM_OpenSSLSHA1)->Apply(BenchmarkSupport::messageSizes);
+
+BENCHMARK_MAIN();